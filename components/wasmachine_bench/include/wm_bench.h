@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "sdkconfig.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WM_BENCH_NAME_MAX_LEN   32  /*!< Max length of workload name, including the terminating NUL */
+
+/**
+ * @brief Benchmark configuration.
+ */
+typedef struct wm_bench_config {
+    uint32_t stack_size;    /*!< WASM application stack size */
+    uint32_t heap_size;     /*!< WASM application heap size */
+    uint32_t min_time_ms;   /*!< Minimum measured time, the iteration count grows until a run lasts this long */
+} wm_bench_config_t;
+
+#define WM_BENCH_CONFIG_DEFAULT() {                             \
+    .stack_size = CONFIG_WASMACHINE_BENCH_WASM_STACK_SIZE,      \
+    .heap_size = 0,                                             \
+    .min_time_ms = CONFIG_WASMACHINE_BENCH_MIN_TIME_MS,         \
+}
+
+/**
+ * @brief Checksum verification result.
+ */
+typedef enum wm_bench_verify {
+    WM_BENCH_VERIFY_UNKNOWN = 0,    /*!< Workload has no known checksum */
+    WM_BENCH_VERIFY_OK,             /*!< Checksum matches */
+    WM_BENCH_VERIFY_FAIL,           /*!< Checksum mismatches */
+} wm_bench_verify_t;
+
+/**
+ * @brief Benchmark result.
+ */
+typedef struct wm_bench_result {
+    char name[WM_BENCH_NAME_MAX_LEN];   /*!< Workload name, it is the file name without extension */
+    const char *mode;                   /*!< Execution mode, "interp", "fast-interp", "aot" or "xip" */
+    uint32_t iterations;                /*!< Iteration count of the measured run */
+    int64_t elapsed_us;                 /*!< Time of the measured run */
+    uint32_t checksum;                  /*!< Return value of bench_run() */
+    wm_bench_verify_t verify;           /*!< Checksum verification result */
+    size_t mem;                         /*!< WAMR memory held by file image, module, instance and execution environment */
+    size_t peak;                        /*!< WAMR memory peak during the whole benchmark */
+} wm_bench_result_t;
+
+/**
+ * @brief  Get execution mode of a WASM or AOT file image.
+ *
+ * @param  buffer File image
+ * @param  size   File image size
+ *
+ * @return Execution mode string or NULL if the file image is not supported by this build.
+ */
+const char *wm_bench_get_mode(const uint8_t *buffer, uint32_t size);
+
+/**
+ * @brief  Run a benchmark workload file, which exports "uint32_t bench_run(uint32_t iterations)".
+ *
+ * @note   The workload runs in a new thread whose stack size is CONFIG_WASMACHINE_BENCH_TASK_STACK_SIZE,
+ *         and this function blocks until it finishes.
+ *
+ * @param  path   Full path of the workload file
+ * @param  config Benchmark configuration, NULL means WM_BENCH_CONFIG_DEFAULT()
+ * @param  result Benchmark result, it's cleared and its name is set even if failed
+ *
+ * @return ESP_OK if success or others if failed.
+ */
+esp_err_t wm_bench_run_file(const char *path, const wm_bench_config_t *config, wm_bench_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,304 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "wasm_export.h"
+
+#include "wm_wamr.h"
+#include "wm_bench.h"
+#include "bench_checksum.h"
+
+#define BENCH_ENTRY_NAME        "bench_run"
+#define BENCH_MAX_ITERATIONS    (1u << 30)
+
+typedef struct bench_arg {
+    const char *path;
+    const wm_bench_config_t *config;
+    wm_bench_result_t *result;
+    esp_err_t ret;
+} bench_arg_t;
+
+static const char *TAG = "wm_bench";
+
+static int bench_read_file(const char *path, uint8_t **buffer, uint32_t *size)
+{
+    int fd;
+    off_t len;
+    uint8_t *pbuf;
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        ESP_LOGE(TAG, "failed to open file %s errno=%d", path, errno);
+        return -1;
+    }
+
+    len = lseek(fd, 0, SEEK_END);
+    if (len <= 0 || lseek(fd, 0, SEEK_SET) != 0) {
+        ESP_LOGE(TAG, "failed to seek file %s errno=%d", path, errno);
+        goto errout_lseek;
+    }
+
+    pbuf = wasm_runtime_malloc(len);
+    if (!pbuf) {
+        ESP_LOGE(TAG, "failed to malloc %ld bytes", (long)len);
+        goto errout_lseek;
+    }
+
+    if (read(fd, pbuf, len) != len) {
+        ESP_LOGE(TAG, "failed to read file %s", path);
+        goto errout_read;
+    }
+
+    close(fd);
+
+    *buffer = pbuf;
+    *size = len;
+
+    return 0;
+
+errout_read:
+    wasm_runtime_free(pbuf);
+errout_lseek:
+    close(fd);
+    return -1;
+}
+
+static void bench_get_name(const char *path, char *name)
+{
+    const char *base = strrchr(path, '/');
+    size_t len;
+
+    base = base ? base + 1 : path;
+    len = strcspn(base, ".");
+    if (len >= WM_BENCH_NAME_MAX_LEN) {
+        len = WM_BENCH_NAME_MAX_LEN - 1;
+    }
+
+    memcpy(name, base, len);
+    name[len] = '\0';
+}
+
+static wm_bench_verify_t bench_verify(const char *name, uint32_t checksum)
+{
+    for (int i = 0; i < sizeof(bench_checksum) / sizeof(bench_checksum[0]); i++) {
+        if (!strcmp(bench_checksum[i].name, name)) {
+            return bench_checksum[i].checksum == checksum ? WM_BENCH_VERIFY_OK : WM_BENCH_VERIFY_FAIL;
+        }
+    }
+
+    return WM_BENCH_VERIFY_UNKNOWN;
+}
+
+static bool bench_call(wasm_exec_env_t exec_env, wasm_function_inst_t func,
+                       uint32_t iterations, uint32_t *checksum)
+{
+    uint32_t argv[1] = { iterations };
+
+    if (!wasm_runtime_call_wasm(exec_env, func, 1, argv)) {
+        return false;
+    }
+
+    *checksum = argv[0];
+
+    return true;
+}
+
+static esp_err_t bench_run(bench_arg_t *arg)
+{
+    esp_err_t ret = ESP_FAIL;
+    const wm_bench_config_t *config = arg->config;
+    wm_bench_result_t *result = arg->result;
+    uint8_t *buffer;
+    uint32_t size;
+    uint32_t iterations;
+    size_t base;
+    size_t used;
+    size_t peak;
+    char error_buf[128];
+    const char *exception;
+    wasm_module_t module;
+    wasm_module_inst_t module_inst;
+    wasm_exec_env_t exec_env;
+    wasm_function_inst_t func;
+
+    wm_wamr_mem_get_usage(&base, NULL);
+    wm_wamr_mem_reset_peak();
+
+    if (bench_read_file(arg->path, &buffer, &size) < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    result->mode = wm_bench_get_mode(buffer, size);
+    if (!result->mode) {
+        ESP_LOGE(TAG, "%s is not supported by this build", arg->path);
+        ret = ESP_ERR_NOT_SUPPORTED;
+        goto errout_load;
+    }
+
+    module = wasm_runtime_load(buffer, size, error_buf, sizeof(error_buf));
+    if (!module) {
+        ESP_LOGE(TAG, "%s", error_buf);
+        goto errout_load;
+    }
+
+    module_inst = wasm_runtime_instantiate(module, config->stack_size, config->heap_size,
+                                           error_buf, sizeof(error_buf));
+    if (!module_inst) {
+        ESP_LOGE(TAG, "%s", error_buf);
+        goto errout_instantiate;
+    }
+
+    func = wasm_runtime_lookup_function(module_inst, BENCH_ENTRY_NAME);
+    if (!func) {
+        ESP_LOGE(TAG, "%s doesn't export %s", arg->path, BENCH_ENTRY_NAME);
+        goto errout_lookup;
+    }
+
+    exec_env = wasm_runtime_create_exec_env(module_inst, config->stack_size);
+    if (!exec_env) {
+        ESP_LOGE(TAG, "failed to create execution environment");
+        goto errout_lookup;
+    }
+
+    wm_wamr_mem_get_usage(&used, NULL);
+    result->mem = used - base;
+
+    /* Warm up, then grow the iteration count until the run is long enough */
+    iterations = 1;
+    if (!bench_call(exec_env, func, iterations, &result->checksum)) {
+        goto errout_call;
+    }
+
+    for (;;) {
+        uint64_t next;
+        int64_t start = esp_timer_get_time();
+
+        if (!bench_call(exec_env, func, iterations, &result->checksum)) {
+            goto errout_call;
+        }
+
+        result->elapsed_us = esp_timer_get_time() - start;
+        result->iterations = iterations;
+        if (result->elapsed_us >= (int64_t)config->min_time_ms * 1000 || iterations >= BENCH_MAX_ITERATIONS) {
+            break;
+        }
+
+        if (result->elapsed_us < 1000) {
+            next = iterations * 10ull;
+        } else {
+            next = (uint64_t)iterations * config->min_time_ms * 1100 / result->elapsed_us;
+            next = next > iterations * 10ull ? iterations * 10ull :
+                   next > iterations ? next : iterations + 1ull;
+        }
+
+        /* Saturate, so the count never wraps around and the last run takes the maximum */
+        iterations = next > BENCH_MAX_ITERATIONS ? BENCH_MAX_ITERATIONS : (uint32_t)next;
+    }
+
+    result->verify = bench_verify(result->name, result->checksum);
+    ret = ESP_OK;
+    goto out;
+
+errout_call:
+    if ((exception = wasm_runtime_get_exception(module_inst))) {
+        ESP_LOGE(TAG, "%s", exception);
+    }
+out:
+    wasm_runtime_destroy_exec_env(exec_env);
+errout_lookup:
+    wasm_runtime_deinstantiate(module_inst);
+errout_instantiate:
+    wasm_runtime_unload(module);
+errout_load:
+    wasm_runtime_free(buffer);
+
+    wm_wamr_mem_get_usage(NULL, &peak);
+    result->peak = peak > base ? peak - base : 0;
+
+    return ret;
+}
+
+static void *bench_thread(void *p)
+{
+    bench_arg_t *arg = (bench_arg_t *)p;
+
+    arg->ret = bench_run(arg);
+
+    return NULL;
+}
+
+const char *wm_bench_get_mode(const uint8_t *buffer, uint32_t size)
+{
+    package_type_t pkg_type = get_package_type(buffer, size);
+
+    if (pkg_type == Wasm_Module_Bytecode) {
+#ifdef CONFIG_WAMR_INTERP_FAST
+        return "fast-interp";
+#else
+        return "interp";
+#endif
+    }
+#ifdef CONFIG_WAMR_ENABLE_AOT
+    else if (pkg_type == Wasm_Module_AoT) {
+        return wasm_runtime_is_xip_file(buffer, size) ? "xip" : "aot";
+    }
+#endif
+
+    return NULL;
+}
+
+esp_err_t wm_bench_run_file(const char *path, const wm_bench_config_t *config, wm_bench_result_t *result)
+{
+    int ret;
+    pthread_t tid;
+    pthread_attr_t attr;
+    const wm_bench_config_t default_config = WM_BENCH_CONFIG_DEFAULT();
+    bench_arg_t arg = {
+        .path = path,
+        .config = config ? config : &default_config,
+        .result = result,
+        .ret = ESP_FAIL
+    };
+
+    if (!path || !result) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Callers print the name of failed workloads too, even if the task can't start */
+    memset(result, 0, sizeof(wm_bench_result_t));
+    bench_get_name(path, result->name);
+
+    ret = pthread_attr_init(&attr);
+    if (ret != 0) {
+        return ESP_FAIL;
+    }
+
+    ret = pthread_attr_setstacksize(&attr, CONFIG_WASMACHINE_BENCH_TASK_STACK_SIZE);
+    if (ret != 0) {
+        goto errout;
+    }
+
+    ret = pthread_create(&tid, &attr, bench_thread, &arg);
+    if (ret != 0) {
+        ESP_LOGE(TAG, "failed to create task errno=%d", ret);
+        goto errout;
+    }
+
+    pthread_join(tid, NULL);
+
+errout:
+    pthread_attr_destroy(&attr);
+    return ret ? ESP_FAIL : arg.ret;
+}
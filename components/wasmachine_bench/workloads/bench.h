@@ -0,0 +1,34 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Every workload is built as a standalone WASM module which exports
+ * "uint32_t bench_run(uint32_t iterations)", and is linked into the host
+ * runner as "bench_<name>_run" so all workloads can live in one binary.
+ *
+ * The return value is the checksum of the last iteration, it doesn't depend
+ * on the iteration count, so results of any run can be verified against
+ * bench_checksum.h.
+ */
+#ifdef __wasm__
+#define BENCH_ENTRY(name) \
+    __attribute__((export_name("bench_run"))) uint32_t bench_run(uint32_t iterations)
+#else
+#define BENCH_ENTRY(name) \
+    uint32_t bench_##name##_run(uint32_t iterations)
+#endif
+
+/**
+ * Always 0, but the compiler can't know it, mixing it into the input of every
+ * iteration keeps the work from being hoisted out of the iteration loop.
+ */
+static volatile uint32_t bench_seed;
+
+#define BENCH_SEED()    (bench_seed)
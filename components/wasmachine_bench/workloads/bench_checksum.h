@@ -0,0 +1,35 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct bench_checksum {
+    const char *name;   /*!< Workload name, also the file name stem of its WASM/AOT files */
+    uint32_t checksum;  /*!< Return value of bench_run() */
+} bench_checksum_t;
+
+static const bench_checksum_t bench_checksum[] = {
+    { "coremark",   0x0000ce80 },
+    { "dhrystone",  0x8c8f57ac },
+    { "sha256",     0xb54e72e8 },
+    { "json",       0xbe91109c },
+    { "json_write", 0x7caba7ed },
+    { "matmul",     0x05be1000 },
+    { "fft",        0x8b2b64a8 },
+    { "fft_native", 0x8b2b64a8 },
+    { "memops",     0x7e291f5a },
+    { "memops_native", 0x7e291f5a },
+    { "sha256_native", 0xb54e72e8 },
+    { "compress",   0xf01adf61 },
+    { "compress_native", 0xf01adf61 },
+    { "json_native", 0xbe91109c },
+    { "json_write_native", 0x7caba7ed },
+    { "parallel_sum", 0xded30551 },
+    { "lvgl_map",   0xf63b8b7c },
+    { "lvgl_map_old", 0xf63b8b7c },
+};
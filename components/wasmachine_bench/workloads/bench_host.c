@@ -0,0 +1,153 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Native host runner of the workloads, it verifies checksums of
+ * bench_checksum.h and gives a native baseline to compare WASM results with.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "bench.h"
+#include "bench_checksum.h"
+
+#define BENCH_DEFAULT_MIN_TIME_MS   1000
+
+typedef struct workload {
+    const char *name;
+    uint32_t (*run)(uint32_t iterations);
+} workload_t;
+
+uint32_t bench_coremark_run(uint32_t iterations);
+uint32_t bench_dhrystone_run(uint32_t iterations);
+uint32_t bench_sha256_run(uint32_t iterations);
+uint32_t bench_json_run(uint32_t iterations);
+uint32_t bench_json_write_run(uint32_t iterations);
+uint32_t bench_matmul_run(uint32_t iterations);
+uint32_t bench_fft_run(uint32_t iterations);
+uint32_t bench_memops_run(uint32_t iterations);
+uint32_t bench_compress_run(uint32_t iterations);
+uint32_t bench_parallel_sum_run(uint32_t iterations);
+uint32_t bench_lvgl_map_old_run(uint32_t iterations);
+uint32_t bench_lvgl_map_run(uint32_t iterations);
+
+static const workload_t s_workloads[] = {
+    { "coremark",   bench_coremark_run },
+    { "dhrystone",  bench_dhrystone_run },
+    { "sha256",     bench_sha256_run },
+    { "json",       bench_json_run },
+    { "json_write", bench_json_write_run },
+    { "matmul",     bench_matmul_run },
+    { "fft",        bench_fft_run },
+    { "memops",     bench_memops_run },
+    { "compress",   bench_compress_run },
+    { "parallel_sum", bench_parallel_sum_run },
+    { "lvgl_map_old", bench_lvgl_map_old_run },
+    { "lvgl_map",   bench_lvgl_map_run },
+};
+
+static int64_t time_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static const bench_checksum_t *find_checksum(const char *name)
+{
+    for (size_t i = 0; i < sizeof(bench_checksum) / sizeof(bench_checksum[0]); i++) {
+        if (!strcmp(bench_checksum[i].name, name)) {
+            return &bench_checksum[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void usage(const char *prog)
+{
+    printf("Usage: %s [-t <min time ms>] [workload ...]\n", prog);
+}
+
+int main(int argc, char **argv)
+{
+    int failed = 0;
+    int64_t min_time_us = BENCH_DEFAULT_MIN_TIME_MS * 1000;
+    int first_name = argc;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            min_time_us = atoll(argv[++i]) * 1000;
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            first_name = i;
+            break;
+        }
+    }
+
+    printf("%-12s %14s %12s %10s %10s  %s\n", "workload", "iter/s", "iterations", "time(ms)", "checksum", "result");
+
+    for (size_t w = 0; w < sizeof(s_workloads) / sizeof(s_workloads[0]); w++) {
+        const workload_t *workload = &s_workloads[w];
+        const bench_checksum_t *expected = find_checksum(workload->name);
+        uint32_t iterations = 1;
+        uint32_t checksum;
+        int64_t elapsed;
+        int selected = first_name == argc;
+        const char *result;
+
+        for (int i = first_name; i < argc; i++) {
+            selected |= !strcmp(argv[i], workload->name);
+        }
+
+        if (!selected) {
+            continue;
+        }
+
+        /* Warm up, then grow the iteration count until the run is long enough */
+        workload->run(1);
+        for (;;) {
+            int64_t start = time_us();
+
+            checksum = workload->run(iterations);
+            elapsed = time_us() - start;
+            if (elapsed >= min_time_us || iterations >= (1u << 30)) {
+                break;
+            }
+
+            if (elapsed < 1000) {
+                iterations *= 10;
+            } else {
+                uint64_t next = (uint64_t)iterations * min_time_us * 11 / 10 / elapsed;
+
+                iterations = next > iterations * 10ull ? iterations * 10 :
+                             next > iterations ? (uint32_t)next : iterations + 1;
+            }
+        }
+
+        if (!expected) {
+            result = "unknown";
+        } else if (expected->checksum == checksum) {
+            result = "ok";
+        } else {
+            result = "FAIL";
+            failed++;
+        }
+
+        printf("%-12s %14.2f %12u %10.1f   %08x  %s\n", workload->name,
+               elapsed ? iterations * 1000000.0 / elapsed : 0.0, iterations,
+               elapsed / 1000.0, checksum, result);
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,246 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Compress 4 KiB of telemetry-like text with LZ4 and decompress it back per
+ * iteration, the checksum is taken from the decompressed text. When
+ * BENCH_NATIVE is defined, both directions run as LZ4 frame streams of the
+ * compression natives of the extended native component through
+ * wm_native_compress.h, instead of the LZ4 block codec below.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef BENCH_NATIVE
+#include "wm_native_compress.h"
+#endif
+
+#include "bench.h"
+
+#define COMPRESS_TEXT_SIZE      4096
+#define COMPRESS_WINDOW_BITS    12
+
+static uint8_t s_text[COMPRESS_TEXT_SIZE];
+static uint8_t s_packed[COMPRESS_TEXT_SIZE * 2];
+static uint8_t s_unpacked[COMPRESS_TEXT_SIZE];
+
+#ifdef BENCH_NATIVE
+static uint32_t compress_run(int compress, const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len)
+{
+    int stream = wm_native_compress_create(WM_NATIVE_COMPRESS_LZ4, compress, -1, COMPRESS_WINDOW_BITS);
+    wm_native_compress_buf_t buf = { .in = in, .in_len = in_len, .out = out, .out_len = out_len };
+    int ret;
+
+    if (stream < 0) {
+        return 0;
+    }
+
+    ret = wm_native_compress_update(stream, &buf, 1);
+    wm_native_compress_destroy(stream);
+
+    return ret == 1 ? out_len - buf.out_len : 0;
+}
+
+static uint32_t lz4_compress(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len)
+{
+    return compress_run(1, in, in_len, out, out_len);
+}
+
+static uint32_t lz4_decompress(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len)
+{
+    return compress_run(0, in, in_len, out, out_len);
+}
+#else
+
+#define LZ4_MIN_MATCH   4
+#define LZ4_HASH_BITS   COMPRESS_WINDOW_BITS
+
+static uint16_t s_hash[1 << LZ4_HASH_BITS];
+
+static uint32_t lz4_read32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint8_t *lz4_put_len(uint8_t *op, uint32_t len)
+{
+    for (; len >= 255; len -= 255) {
+        *op++ = 255;
+    }
+    *op++ = (uint8_t)len;
+
+    return op;
+}
+
+static uint8_t *lz4_put_seq(uint8_t *op, const uint8_t *lit, uint32_t lit_len, uint32_t offset, uint32_t match_len)
+{
+    uint8_t *token = op++;
+
+    *token = (uint8_t)((lit_len < 15 ? lit_len : 15) << 4);
+    if (lit_len >= 15) {
+        op = lz4_put_len(op, lit_len - 15);
+    }
+    memcpy(op, lit, lit_len);
+    op += lit_len;
+
+    if (match_len) {
+        *op++ = (uint8_t)offset;
+        *op++ = (uint8_t)(offset >> 8);
+        match_len -= LZ4_MIN_MATCH;
+        *token |= match_len < 15 ? match_len : 15;
+        if (match_len >= 15) {
+            op = lz4_put_len(op, match_len - 15);
+        }
+    }
+
+    return op;
+}
+
+/* Greedy LZ4 block compressor, matches end 5 bytes before the end as LZ4 requires */
+static uint32_t lz4_compress(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len)
+{
+    uint32_t anchor = 0;
+    uint32_t i = 0;
+    uint8_t *op = out;
+
+    (void)out_len;
+    memset(s_hash, 0, sizeof(s_hash));
+
+    while (i + 12 < in_len) {
+        uint32_t v = lz4_read32(in + i);
+        uint32_t h = (v * 2654435761u) >> (32 - LZ4_HASH_BITS);
+        uint32_t ref = s_hash[h];
+        uint32_t len;
+
+        s_hash[h] = (uint16_t)i;
+        if (ref >= i || i - ref >= (1 << COMPRESS_WINDOW_BITS) || lz4_read32(in + ref) != v) {
+            i++;
+            continue;
+        }
+
+        len = LZ4_MIN_MATCH;
+        while (i + len + 5 < in_len && in[ref + len] == in[i + len]) {
+            len++;
+        }
+
+        op = lz4_put_seq(op, in + anchor, i - anchor, i - ref, len);
+        i += len;
+        anchor = i;
+    }
+
+    op = lz4_put_seq(op, in + anchor, in_len - anchor, 0, 0);
+
+    return (uint32_t)(op - out);
+}
+
+static uint32_t lz4_get_len(const uint8_t **ip, uint32_t len)
+{
+    uint8_t b;
+
+    if (len == 15) {
+        do {
+            b = *(*ip)++;
+            len += b;
+        } while (b == 255);
+    }
+
+    return len;
+}
+
+static uint32_t lz4_decompress(const uint8_t *in, uint32_t in_len, uint8_t *out, uint32_t out_len)
+{
+    const uint8_t *ip = in;
+    const uint8_t *end = in + in_len;
+    uint8_t *op = out;
+
+    while (ip < end) {
+        uint8_t token = *ip++;
+        uint32_t len = lz4_get_len(&ip, token >> 4);
+        uint32_t offset;
+
+        if (len > (uint32_t)(end - ip) || len > out_len - (uint32_t)(op - out)) {
+            return 0;
+        }
+        memcpy(op, ip, len);
+        ip += len;
+        op += len;
+        if (ip == end) {
+            break;
+        }
+
+        offset = ip[0] | ((uint32_t)ip[1] << 8);
+        ip += 2;
+        len = lz4_get_len(&ip, token & 15) + LZ4_MIN_MATCH;
+        if (!offset || offset > (uint32_t)(op - out) || len > out_len - (uint32_t)(op - out)) {
+            return 0;
+        }
+        /* Overlapping copy, a match may repeat its own output */
+        for (uint32_t j = 0; j < len; j++, op++) {
+            *op = *(op - offset);
+        }
+    }
+
+    return (uint32_t)(op - out);
+}
+#endif
+
+/* Lines like "id=123 temp=21.4 hum=47 ok\n" */
+static void compress_text(uint8_t *text, uint32_t len, uint32_t seed)
+{
+    static const char *const s_status[] = { "ok", "warn", "ok", "idle" };
+    uint32_t n = 0;
+
+    for (uint32_t i = 0; n < len; i++) {
+        char line[48];
+        uint32_t l = 0;
+        uint32_t v = i + seed;
+
+        memcpy(line + l, "id=", 3);
+        l += 3;
+        line[l++] = (char)('0' + v / 100 % 10);
+        line[l++] = (char)('0' + v / 10 % 10);
+        line[l++] = (char)('0' + v % 10);
+        memcpy(line + l, " temp=2", 7);
+        l += 7;
+        line[l++] = (char)('0' + v % 7);
+        line[l++] = '.';
+        line[l++] = (char)('0' + v * 7 % 10);
+        memcpy(line + l, " hum=4", 6);
+        l += 6;
+        line[l++] = (char)('0' + v % 9);
+        line[l++] = ' ';
+        memcpy(line + l, s_status[v % 4], strlen(s_status[v % 4]));
+        l += strlen(s_status[v % 4]);
+        line[l++] = '\n';
+
+        for (uint32_t j = 0; j < l && n < len; j++) {
+            text[n++] = (uint8_t)line[j];
+        }
+    }
+}
+
+BENCH_ENTRY(compress)
+{
+    uint32_t checksum = 0;
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        uint32_t packed_len;
+        uint32_t unpacked_len;
+
+        compress_text(s_text, sizeof(s_text), BENCH_SEED());
+
+        packed_len = lz4_compress(s_text, sizeof(s_text), s_packed, sizeof(s_packed));
+        unpacked_len = lz4_decompress(s_packed, packed_len, s_unpacked, sizeof(s_unpacked));
+
+        checksum = unpacked_len;
+        for (uint32_t i = 0; i < unpacked_len; i++) {
+            checksum = checksum * 31 + s_unpacked[i];
+        }
+    }
+
+    return checksum;
+}
@@ -0,0 +1,279 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * CoreMark-style workload: linked list find/reverse/sort, small integer
+ * matrix operations and a number-scanning state machine, all results are
+ * folded into a CRC-16. It follows the structure of CoreMark but is not
+ * CoreMark, so scores are not comparable with published CoreMark results.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "bench.h"
+
+#define LIST_NODES      64
+#define MATRIX_N        16
+
+typedef struct list_node {
+    struct list_node *next;
+    int16_t data;
+    int16_t idx;
+} list_node_t;
+
+typedef enum {
+    STATE_START = 0,
+    STATE_INT,
+    STATE_FLOAT,
+    STATE_EXP,
+    STATE_SCI,
+    STATE_INVALID,
+    STATE_MAX
+} state_t;
+
+static list_node_t s_nodes[LIST_NODES];
+static int16_t s_ma[MATRIX_N][MATRIX_N];
+static int16_t s_mb[MATRIX_N][MATRIX_N];
+static int32_t s_mc[MATRIX_N][MATRIX_N];
+
+static const char s_input[] =
+    "5012,1234,-874,+122,7.45,3.14e-2,0.9,1e9,abc,12x4,-.5,+4.0E+3,"
+    "77,-3,9.9e,8.,6e66,321,0x10,00042,1.5.2,-0,42E-1,,.,+,-,9";
+
+static uint16_t crc16_byte(uint8_t data, uint16_t crc)
+{
+    crc ^= (uint16_t)data << 8;
+    for (int i = 0; i < 8; i++) {
+        crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+
+    return crc;
+}
+
+static uint16_t crc16(int32_t v, uint16_t crc)
+{
+    crc = crc16_byte((uint8_t)v, crc);
+    crc = crc16_byte((uint8_t)(v >> 8), crc);
+    crc = crc16_byte((uint8_t)(v >> 16), crc);
+    return crc16_byte((uint8_t)(v >> 24), crc);
+}
+
+static list_node_t *list_init(uint32_t seed)
+{
+    for (int i = 0; i < LIST_NODES; i++) {
+        s_nodes[i].next = i + 1 < LIST_NODES ? &s_nodes[i + 1] : NULL;
+        s_nodes[i].idx = (int16_t)i;
+        s_nodes[i].data = (int16_t)(((i * 0x3d + seed) ^ 0x5a5a) & 0x7fff);
+    }
+
+    return &s_nodes[0];
+}
+
+static list_node_t *list_reverse(list_node_t *list)
+{
+    list_node_t *prev = NULL;
+
+    while (list) {
+        list_node_t *next = list->next;
+        list->next = prev;
+        prev = list;
+        list = next;
+    }
+
+    return prev;
+}
+
+static list_node_t *list_find(list_node_t *list, int16_t data)
+{
+    while (list && (list->data & 0xff) != data) {
+        list = list->next;
+    }
+
+    return list;
+}
+
+/* Bottom-up merge sort, compare by data or by idx */
+static list_node_t *list_sort(list_node_t *list, int by_data)
+{
+    for (size_t width = 1;; width *= 2) {
+        list_node_t *p = list;
+        list_node_t *tail = NULL;
+        int merges = 0;
+
+        list = NULL;
+        while (p) {
+            list_node_t *q = p;
+            size_t psize = 0;
+            size_t qsize = width;
+
+            merges++;
+            while (q && psize < width) {
+                psize++;
+                q = q->next;
+            }
+
+            while (psize > 0 || (qsize > 0 && q)) {
+                list_node_t *e;
+
+                if (psize == 0) {
+                    e = q;
+                    q = q->next;
+                    qsize--;
+                } else if (qsize == 0 || !q ||
+                           (by_data ? p->data <= q->data : p->idx <= q->idx)) {
+                    e = p;
+                    p = p->next;
+                    psize--;
+                } else {
+                    e = q;
+                    q = q->next;
+                    qsize--;
+                }
+
+                if (tail) {
+                    tail->next = e;
+                } else {
+                    list = e;
+                }
+                tail = e;
+            }
+
+            p = q;
+        }
+
+        tail->next = NULL;
+        if (merges <= 1) {
+            return list;
+        }
+    }
+}
+
+static uint16_t bench_list(uint32_t seed, uint16_t crc)
+{
+    list_node_t *list = list_init(seed);
+
+    list = list_reverse(list);
+    for (int16_t i = 0; i < 32; i++) {
+        list_node_t *node = list_find(list, (int16_t)(i * 5));
+        crc = crc16(node ? node->idx : -1, crc);
+    }
+
+    list = list_sort(list, 1);
+    for (list_node_t *p = list; p; p = p->next) {
+        crc = crc16(p->data, crc);
+    }
+
+    list = list_sort(list, 0);
+    return crc16(list->data, crc);
+}
+
+static uint16_t bench_matrix(uint32_t seed, uint16_t crc)
+{
+    int32_t sum = 0;
+
+    for (int i = 0; i < MATRIX_N; i++) {
+        for (int j = 0; j < MATRIX_N; j++) {
+            s_ma[i][j] = (int16_t)((int)(((i * MATRIX_N + j + seed) * 37) % 255) - 127);
+            s_mb[i][j] = (int16_t)((int)(((j * MATRIX_N + i + seed) * 91) % 255) - 127);
+        }
+    }
+
+    /* Add constant, then matrix * matrix */
+    for (int i = 0; i < MATRIX_N; i++) {
+        for (int j = 0; j < MATRIX_N; j++) {
+            s_ma[i][j] = (int16_t)(s_ma[i][j] + 3);
+        }
+    }
+
+    for (int i = 0; i < MATRIX_N; i++) {
+        for (int j = 0; j < MATRIX_N; j++) {
+            int32_t acc = 0;
+
+            for (int k = 0; k < MATRIX_N; k++) {
+                acc += (int32_t)s_ma[i][k] * s_mb[k][j];
+            }
+            s_mc[i][j] = acc;
+        }
+    }
+
+    /* Bit extraction and matrix * vector */
+    for (int i = 0; i < MATRIX_N; i++) {
+        int32_t acc = 0;
+
+        for (int j = 0; j < MATRIX_N; j++) {
+            acc += ((s_mc[i][j] >> 2) & 0xf) * s_mb[j][i];
+        }
+        sum += acc;
+        crc = crc16(acc, crc);
+    }
+
+    return crc16(sum, crc);
+}
+
+static state_t state_next(state_t state, char c)
+{
+    int digit = c >= '0' && c <= '9';
+    int sign = c == '+' || c == '-';
+
+    switch (state) {
+    case STATE_START:
+        return digit || sign ? STATE_INT : c == '.' ? STATE_FLOAT : STATE_INVALID;
+    case STATE_INT:
+        return digit ? STATE_INT : c == '.' ? STATE_FLOAT : (c == 'e' || c == 'E') ? STATE_EXP : STATE_INVALID;
+    case STATE_FLOAT:
+        return digit ? STATE_FLOAT : (c == 'e' || c == 'E') ? STATE_EXP : STATE_INVALID;
+    case STATE_EXP:
+        return digit || sign ? STATE_SCI : STATE_INVALID;
+    case STATE_SCI:
+        return digit ? STATE_SCI : STATE_INVALID;
+    default:
+        return STATE_INVALID;
+    }
+}
+
+static uint16_t bench_state(uint32_t seed, uint16_t crc)
+{
+    uint32_t final[STATE_MAX] = { 0 };
+    uint32_t transitions = 0;
+    state_t state = STATE_START;
+
+    for (size_t i = seed % 2; i < sizeof(s_input) - 1; i++) {
+        char c = s_input[i];
+
+        if (c == ',') {
+            final[state]++;
+            state = STATE_START;
+            continue;
+        }
+
+        state_t next = state_next(state, c);
+        transitions += next != state;
+        state = next;
+    }
+    final[state]++;
+
+    for (int i = 0; i < STATE_MAX; i++) {
+        crc = crc16((int32_t)final[i], crc);
+    }
+
+    return crc16((int32_t)transitions, crc);
+}
+
+BENCH_ENTRY(coremark)
+{
+    uint16_t crc = 0;
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        uint32_t seed = BENCH_SEED();
+
+        crc = bench_list(seed, 0);
+        crc = bench_matrix(seed, crc);
+        crc = bench_state(seed, crc);
+    }
+
+    return crc;
+}
@@ -0,0 +1,278 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Dhrystone 2.1 main loop and procedures (R. P. Weicker), rewritten in
+ * ANSI C without the timing harness. One iteration is one Dhrystone run.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "bench.h"
+
+typedef enum {
+    IDENT_1,
+    IDENT_2,
+    IDENT_3,
+    IDENT_4,
+    IDENT_5
+} enumeration_t;
+
+typedef struct record {
+    struct record *ptr_comp;
+    enumeration_t discr;
+    enumeration_t enum_comp;
+    int int_comp;
+    char str_comp[31];
+} record_t;
+
+static record_t s_rec_1;
+static record_t s_rec_2;
+static record_t *s_ptr_glob;
+static record_t *s_next_ptr_glob;
+static int s_int_glob;
+static bool s_bool_glob;
+static char s_ch_1_glob;
+static char s_ch_2_glob;
+static int s_arr_1_glob[50];
+static int s_arr_2_glob[50][50];
+
+static void proc_7(int int_1_par_val, int int_2_par_val, int *int_par_ref)
+{
+    int int_loc = int_1_par_val + 2;
+
+    *int_par_ref = int_2_par_val + int_loc;
+}
+
+static bool func_3(enumeration_t enum_par_val)
+{
+    return enum_par_val == IDENT_3;
+}
+
+static void proc_6(enumeration_t enum_val_par, enumeration_t *enum_ref_par)
+{
+    *enum_ref_par = enum_val_par;
+    if (!func_3(enum_val_par)) {
+        *enum_ref_par = IDENT_4;
+    }
+
+    switch (enum_val_par) {
+    case IDENT_1:
+        *enum_ref_par = IDENT_1;
+        break;
+    case IDENT_2:
+        *enum_ref_par = s_int_glob > 100 ? IDENT_1 : IDENT_4;
+        break;
+    case IDENT_3:
+        *enum_ref_par = IDENT_2;
+        break;
+    case IDENT_4:
+        break;
+    case IDENT_5:
+        *enum_ref_par = IDENT_3;
+        break;
+    }
+}
+
+static void proc_3(record_t **ptr_ref_par)
+{
+    if (s_ptr_glob) {
+        *ptr_ref_par = s_ptr_glob->ptr_comp;
+    }
+
+    proc_7(10, s_int_glob, &s_ptr_glob->int_comp);
+}
+
+static void proc_1(record_t *ptr_val_par)
+{
+    record_t *next_record = ptr_val_par->ptr_comp;
+
+    *ptr_val_par->ptr_comp = *s_ptr_glob;
+    ptr_val_par->int_comp = 5;
+    next_record->int_comp = ptr_val_par->int_comp;
+    next_record->ptr_comp = ptr_val_par->ptr_comp;
+    proc_3(&next_record->ptr_comp);
+
+    if (next_record->discr == IDENT_1) {
+        next_record->int_comp = 6;
+        proc_6(ptr_val_par->enum_comp, &next_record->enum_comp);
+        next_record->ptr_comp = s_ptr_glob->ptr_comp;
+        proc_7(next_record->int_comp, 10, &next_record->int_comp);
+    } else {
+        *ptr_val_par = *ptr_val_par->ptr_comp;
+    }
+}
+
+static void proc_2(int *int_par_ref)
+{
+    int int_loc = *int_par_ref + 10;
+    enumeration_t enum_loc = IDENT_2;
+
+    do {
+        if (s_ch_1_glob == 'A') {
+            int_loc -= 1;
+            *int_par_ref = int_loc - s_int_glob;
+            enum_loc = IDENT_1;
+        }
+    } while (enum_loc != IDENT_1);
+}
+
+static void proc_4(void)
+{
+    bool bool_loc = s_ch_1_glob == 'A';
+
+    s_bool_glob = bool_loc | s_bool_glob;
+    s_ch_2_glob = 'B';
+}
+
+static void proc_5(void)
+{
+    s_ch_1_glob = 'A';
+    s_bool_glob = false;
+}
+
+static void proc_8(int arr_1_par_ref[50], int arr_2_par_ref[50][50], int int_1_par_val, int int_2_par_val)
+{
+    int int_loc = int_1_par_val + 5;
+
+    arr_1_par_ref[int_loc] = int_2_par_val;
+    arr_1_par_ref[int_loc + 1] = arr_1_par_ref[int_loc];
+    arr_1_par_ref[int_loc + 30] = int_loc;
+    for (int int_index = int_loc; int_index <= int_loc + 1; ++int_index) {
+        arr_2_par_ref[int_loc][int_index] = int_loc;
+    }
+    arr_2_par_ref[int_loc][int_loc - 1] += 1;
+    arr_2_par_ref[int_loc + 20][int_loc] = arr_1_par_ref[int_loc];
+    s_int_glob = 5;
+}
+
+static enumeration_t func_1(char ch_1_par_val, char ch_2_par_val)
+{
+    char ch_1_loc = ch_1_par_val;
+    char ch_2_loc = ch_1_loc;
+
+    if (ch_2_loc != ch_2_par_val) {
+        return IDENT_1;
+    }
+
+    s_ch_1_glob = ch_1_loc;
+    return IDENT_2;
+}
+
+static bool func_2(const char *str_1_par_ref, const char *str_2_par_ref)
+{
+    int int_loc = 2;
+    char ch_loc = 'A';
+
+    while (int_loc <= 2) {
+        if (func_1(str_1_par_ref[int_loc], str_2_par_ref[int_loc + 1]) == IDENT_1) {
+            ch_loc = 'A';
+            int_loc += 1;
+        }
+    }
+
+    if (ch_loc >= 'W' && ch_loc < 'Z') {
+        int_loc = 7;
+    }
+
+    if (ch_loc == 'R') {
+        return true;
+    }
+
+    if (strcmp(str_1_par_ref, str_2_par_ref) > 0) {
+        int_loc += 7;
+        s_int_glob = int_loc;
+        return true;
+    }
+
+    return false;
+}
+
+static uint32_t fnv1a(uint32_t hash, int32_t v)
+{
+    for (int i = 0; i < 4; i++) {
+        hash = (hash ^ (uint8_t)(v >> (i * 8))) * 16777619u;
+    }
+
+    return hash;
+}
+
+BENCH_ENTRY(dhrystone)
+{
+    int int_1_loc = 0;
+    int int_2_loc = 0;
+    int int_3_loc = 0;
+    enumeration_t enum_loc = IDENT_1;
+    char str_1_loc[31];
+    char str_2_loc[31];
+    uint32_t checksum;
+
+    s_next_ptr_glob = &s_rec_2;
+    s_ptr_glob = &s_rec_1;
+    s_ptr_glob->ptr_comp = s_next_ptr_glob;
+    s_ptr_glob->discr = IDENT_1;
+    s_ptr_glob->enum_comp = IDENT_3;
+    s_ptr_glob->int_comp = 40;
+    strcpy(s_ptr_glob->str_comp, "DHRYSTONE PROGRAM, SOME STRING");
+    strcpy(str_1_loc, "DHRYSTONE PROGRAM, 1'ST STRING");
+    s_arr_2_glob[8][7] = 10;
+
+    for (uint32_t run_index = 1; run_index <= iterations; ++run_index) {
+        proc_5();
+        proc_4();
+        int_1_loc = 2 + (int)BENCH_SEED();
+        int_2_loc = 3;
+        strcpy(str_2_loc, "DHRYSTONE PROGRAM, 2'ND STRING");
+        enum_loc = IDENT_2;
+        s_bool_glob = !func_2(str_1_loc, str_2_loc);
+
+        while (int_1_loc < int_2_loc) {
+            int_3_loc = 5 * int_1_loc - int_2_loc;
+            proc_7(int_1_loc, int_2_loc, &int_3_loc);
+            int_1_loc += 1;
+        }
+
+        proc_8(s_arr_1_glob, s_arr_2_glob, int_1_loc, int_3_loc);
+        proc_1(s_ptr_glob);
+
+        for (char ch_index = 'A'; ch_index <= s_ch_2_glob; ++ch_index) {
+            if (enum_loc == func_1(ch_index, 'C')) {
+                proc_6(IDENT_1, &enum_loc);
+                strcpy(str_2_loc, "DHRYSTONE PROGRAM, 3'RD STRING");
+                int_2_loc = (int)run_index;
+                s_int_glob = (int)run_index;
+            }
+        }
+
+        int_2_loc = int_2_loc * int_1_loc;
+        int_1_loc = int_2_loc / int_3_loc;
+        int_2_loc = 7 * (int_2_loc - int_3_loc) - int_1_loc;
+        proc_2(&int_1_loc);
+    }
+
+    /* s_arr_2_glob[8][7] counts runs, so it is left out of the checksum */
+    checksum = 2166136261u;
+    checksum = fnv1a(checksum, s_int_glob);
+    checksum = fnv1a(checksum, s_bool_glob);
+    checksum = fnv1a(checksum, s_ch_1_glob);
+    checksum = fnv1a(checksum, s_ch_2_glob);
+    checksum = fnv1a(checksum, s_arr_1_glob[8]);
+    checksum = fnv1a(checksum, s_ptr_glob->discr);
+    checksum = fnv1a(checksum, s_ptr_glob->enum_comp);
+    checksum = fnv1a(checksum, s_ptr_glob->int_comp);
+    checksum = fnv1a(checksum, s_next_ptr_glob->discr);
+    checksum = fnv1a(checksum, s_next_ptr_glob->enum_comp);
+    checksum = fnv1a(checksum, s_next_ptr_glob->int_comp);
+    checksum = fnv1a(checksum, int_1_loc);
+    checksum = fnv1a(checksum, int_2_loc);
+    checksum = fnv1a(checksum, int_3_loc);
+    checksum = fnv1a(checksum, enum_loc);
+    checksum = fnv1a(checksum, str_2_loc[20]);
+
+    return checksum;
+}
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * 256-point complex FFT of three tones per iteration. The checksum is built
+ * from rounded power of every bin, so it is the same whether the FFT runs in
+ * WASM or in the wasm_dsp_fft native of the DSP extension, which is called
+ * through wm_native_dsp.h when BENCH_NATIVE is defined.
+ */
+
+#include <stdint.h>
+#include <math.h>
+
+#ifdef BENCH_NATIVE
+#include "wm_native_dsp.h"
+#endif
+
+#include "bench.h"
+
+#define FFT_N       256
+
+#ifndef BENCH_NATIVE
+static float s_twiddle[FFT_N];
+
+static void fft_init(void)
+{
+    for (int i = 0; i < FFT_N / 2; i++) {
+        s_twiddle[2 * i] = cosf(-2 * (float)M_PI * i / FFT_N);
+        s_twiddle[2 * i + 1] = sinf(-2 * (float)M_PI * i / FFT_N);
+    }
+}
+
+static void fft(float *data)
+{
+    for (uint32_t i = 1, j = 0; i < FFT_N; i++) {
+        uint32_t bit = FFT_N >> 1;
+
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j) {
+            float re = data[2 * i];
+            float im = data[2 * i + 1];
+
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    for (uint32_t len = 2; len <= FFT_N; len <<= 1) {
+        uint32_t half = len / 2;
+        uint32_t stride = FFT_N / len;
+
+        for (uint32_t k = 0; k < half; k++) {
+            float wr = s_twiddle[2 * k * stride];
+            float wi = s_twiddle[2 * k * stride + 1];
+
+            for (uint32_t i = k; i < FFT_N; i += len) {
+                float *a = &data[2 * i];
+                float *b = &data[2 * (i + half)];
+                float tr = b[0] * wr - b[1] * wi;
+                float ti = b[0] * wi + b[1] * wr;
+
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+        }
+    }
+}
+#endif
+
+static float s_signal[2 * FFT_N];
+static float s_data[2 * FFT_N] __attribute__((aligned(16)));
+
+BENCH_ENTRY(fft)
+{
+    uint32_t checksum = 0;
+
+#ifndef BENCH_NATIVE
+    fft_init();
+#endif
+
+    for (int i = 0; i < FFT_N; i++) {
+        s_signal[2 * i] = cosf(2 * (float)M_PI * 10 * i / FFT_N) +
+                          0.5f * cosf(2 * (float)M_PI * 33 * i / FFT_N) +
+                          0.25f * cosf(2 * (float)M_PI * 71 * i / FFT_N);
+        s_signal[2 * i + 1] = 0;
+    }
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        uint32_t seed = BENCH_SEED();
+
+        for (int i = 0; i < 2 * FFT_N; i++) {
+            s_data[i] = s_signal[i] + (float)seed;
+        }
+
+#ifdef BENCH_NATIVE
+        wm_native_dsp_fft(s_data, FFT_N);
+#else
+        fft(s_data);
+#endif
+
+        /* Tones give 64, 16 and 4, other bins are rounded to 0 */
+        checksum = 0;
+        for (int i = 0; i < FFT_N; i++) {
+            float power = (s_data[2 * i] * s_data[2 * i] + s_data[2 * i + 1] * s_data[2 * i + 1]) / FFT_N;
+
+            checksum = checksum * 31 + (uint32_t)(power + 0.5f);
+        }
+    }
+
+    return checksum;
+}
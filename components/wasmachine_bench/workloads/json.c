@@ -0,0 +1,351 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Parse a ~1 KiB JSON document per iteration with a recursive-descent
+ * parser, numbers are parsed as Q16 fixed-point and strings are hashed
+ * so that every byte is touched. When BENCH_NATIVE is defined, the document
+ * is parsed into tokens by the JSON natives of the extended native component
+ * through wm_native_json.h, and the same work is done on the tokens.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef BENCH_NATIVE
+#include "wm_native_json.h"
+#endif
+
+#include "bench.h"
+
+#define JSON_MAX_DEPTH  16
+
+typedef struct json_parser {
+    const char *p;
+    const char *end;
+    int depth;
+    uint32_t objects;
+    uint32_t arrays;
+    uint32_t strings;
+    uint32_t literals;
+    int64_t number_sum;
+    uint32_t string_hash;
+} json_parser_t;
+
+static const char s_doc[] =
+    "{\"device\":{\"name\":\"esp32-s3-box\",\"mac\":\"7c:df:a1:00:11:22\",\"fw\":\"1.4.2\","
+    "\"uptime\":86400,\"heap\":{\"free\":214532,\"min\":180224,\"psram\":8123456}},"
+    "\"sensors\":[{\"id\":1,\"type\":\"temperature\",\"value\":23.75,\"unit\":\"C\",\"ok\":true},"
+    "{\"id\":2,\"type\":\"humidity\",\"value\":41.5,\"unit\":\"%\",\"ok\":true},"
+    "{\"id\":3,\"type\":\"pressure\",\"value\":1013.25,\"unit\":\"hPa\",\"ok\":false},"
+    "{\"id\":4,\"type\":\"light\",\"value\":-0.125,\"unit\":\"lx\",\"ok\":null}],"
+    "\"history\":[[0,12.5,13.25],[1,12.75,13.5],[2,13.0,13.75],[3,13.25,14.0],[4,13.5,14.25],"
+    "[5,13.75,14.5],[6,14.0,14.75],[7,14.25,15.0],[8,14.5,15.25],[9,14.75,15.5]],"
+    "\"config\":{\"interval_ms\":500,\"threshold\":1.5e2,\"labels\":[\"kitchen\",\"living room\","
+    "\"bedroom\",\"garage\"],\"escape\":\"line\\nbreak \\\"quoted\\\" \\u00e9\",\"nested\":{\"a\":"
+    "{\"b\":{\"c\":{\"d\":[1,2,3,{\"e\":\"deep\"}]}}}}},\"empty\":{},\"none\":[]}";
+
+#ifdef BENCH_NATIVE
+#define JSON_MAX_TOKENS 256
+
+static wm_native_json_token_t s_tokens[JSON_MAX_TOKENS];
+
+/* Hash a string from its text in the document, like json_string() below does */
+static uint32_t json_hash(uint32_t hash, const char *s, uint32_t len)
+{
+    const char *end = s + len;
+
+    while (s < end) {
+        char c = *s++;
+
+        if (c == '\\') {
+            c = *s++;
+            if (c == 'u') {
+                uint32_t cp = 0;
+
+                for (int i = 0; i < 4; i++, s++) {
+                    char h = *s;
+
+                    cp = (cp << 4) | (uint32_t)(h >= 'a' ? h - 'a' + 10 : h >= 'A' ? h - 'A' + 10 : h - '0');
+                }
+                c = (char)cp;
+            }
+        }
+
+        hash = (hash ^ (uint8_t)c) * 16777619u;
+    }
+
+    return hash;
+}
+
+static int json_document(json_parser_t *jp)
+{
+    wm_native_json_t doc = {
+        .json = jp->p,
+        .len = (uint32_t)(jp->end - jp->p),
+        .tokens = s_tokens,
+        .max_tokens = JSON_MAX_TOKENS
+    };
+    int count = wm_native_json_parse(&doc);
+
+    for (int i = 0; i < count; i++) {
+        double value;
+
+        switch (s_tokens[i].type) {
+        case WM_NATIVE_JSON_OBJECT:
+            jp->objects++;
+            break;
+        case WM_NATIVE_JSON_ARRAY:
+            jp->arrays++;
+            break;
+        case WM_NATIVE_JSON_STRING:
+            jp->strings++;
+            jp->string_hash = json_hash(jp->string_hash, wm_native_json_text(&doc, i), s_tokens[i].len);
+            break;
+        case WM_NATIVE_JSON_NUMBER:
+            if (wm_native_json_get_number(&doc, i, &value) < 0) {
+                return -1;
+            }
+            jp->number_sum += (int64_t)(value * 65536);
+            break;
+        default:
+            jp->literals++;
+            break;
+        }
+    }
+
+    return count < 0 ? -1 : 0;
+}
+#else
+static int json_value(json_parser_t *jp);
+
+static void json_skip_ws(json_parser_t *jp)
+{
+    while (jp->p < jp->end && (*jp->p == ' ' || *jp->p == '\t' || *jp->p == '\n' || *jp->p == '\r')) {
+        jp->p++;
+    }
+}
+
+static int json_string(json_parser_t *jp)
+{
+    uint32_t hash = jp->string_hash;
+
+    if (*jp->p++ != '"') {
+        return -1;
+    }
+
+    while (jp->p < jp->end && *jp->p != '"') {
+        char c = *jp->p++;
+
+        if (c == '\\') {
+            if (jp->p >= jp->end) {
+                return -1;
+            }
+
+            c = *jp->p++;
+            if (c == 'u') {
+                uint32_t cp = 0;
+
+                for (int i = 0; i < 4; i++, jp->p++) {
+                    char h;
+
+                    if (jp->p >= jp->end) {
+                        return -1;
+                    }
+                    h = *jp->p;
+                    cp = (cp << 4) | (uint32_t)(h >= 'a' ? h - 'a' + 10 : h >= 'A' ? h - 'A' + 10 : h - '0');
+                }
+                c = (char)cp;
+            }
+        }
+
+        hash = (hash ^ (uint8_t)c) * 16777619u;
+    }
+
+    if (jp->p >= jp->end) {
+        return -1;
+    }
+
+    jp->p++;
+    jp->strings++;
+    jp->string_hash = hash;
+
+    return 0;
+}
+
+static int json_number(json_parser_t *jp)
+{
+    int neg = 0;
+    int64_t ipart = 0;
+    int64_t frac = 0;
+    int64_t scale = 1;
+    int exp = 0;
+    int exp_neg = 0;
+    int64_t q16;
+
+    if (*jp->p == '-') {
+        neg = 1;
+        jp->p++;
+    }
+
+    if (jp->p >= jp->end || *jp->p < '0' || *jp->p > '9') {
+        return -1;
+    }
+
+    while (jp->p < jp->end && *jp->p >= '0' && *jp->p <= '9') {
+        ipart = ipart * 10 + (*jp->p++ - '0');
+    }
+
+    if (jp->p < jp->end && *jp->p == '.') {
+        jp->p++;
+        while (jp->p < jp->end && *jp->p >= '0' && *jp->p <= '9') {
+            if (scale < 100000000) {
+                frac = frac * 10 + (*jp->p - '0');
+                scale *= 10;
+            }
+            jp->p++;
+        }
+    }
+
+    if (jp->p < jp->end && (*jp->p == 'e' || *jp->p == 'E')) {
+        jp->p++;
+        if (jp->p < jp->end && (*jp->p == '-' || *jp->p == '+')) {
+            exp_neg = *jp->p++ == '-';
+        }
+        while (jp->p < jp->end && *jp->p >= '0' && *jp->p <= '9') {
+            exp = exp * 10 + (*jp->p++ - '0');
+        }
+    }
+
+    q16 = ipart * 65536 + frac * 65536 / scale;
+    for (int i = 0; i < exp && i < 9; i++) {
+        q16 = exp_neg ? q16 / 10 : q16 * 10;
+    }
+
+    jp->number_sum += neg ? -q16 : q16;
+
+    return 0;
+}
+
+static int json_literal(json_parser_t *jp, const char *lit)
+{
+    while (*lit) {
+        if (jp->p >= jp->end || *jp->p++ != *lit++) {
+            return -1;
+        }
+    }
+
+    jp->literals++;
+
+    return 0;
+}
+
+static int json_container(json_parser_t *jp, char close, int is_object)
+{
+    if (++jp->depth > JSON_MAX_DEPTH) {
+        return -1;
+    }
+
+    jp->p++;
+    json_skip_ws(jp);
+    if (jp->p < jp->end && *jp->p == close) {
+        jp->p++;
+        jp->depth--;
+        return 0;
+    }
+
+    for (;;) {
+        json_skip_ws(jp);
+        if (is_object) {
+            if (jp->p >= jp->end || json_string(jp) < 0) {
+                return -1;
+            }
+
+            json_skip_ws(jp);
+            if (jp->p >= jp->end || *jp->p++ != ':') {
+                return -1;
+            }
+        }
+
+        if (json_value(jp) < 0) {
+            return -1;
+        }
+
+        json_skip_ws(jp);
+        if (jp->p >= jp->end) {
+            return -1;
+        } else if (*jp->p == ',') {
+            jp->p++;
+        } else if (*jp->p == close) {
+            jp->p++;
+            break;
+        } else {
+            return -1;
+        }
+    }
+
+    jp->depth--;
+
+    return 0;
+}
+
+static int json_value(json_parser_t *jp)
+{
+    json_skip_ws(jp);
+    if (jp->p >= jp->end) {
+        return -1;
+    }
+
+    switch (*jp->p) {
+    case '{':
+        jp->objects++;
+        return json_container(jp, '}', 1);
+    case '[':
+        jp->arrays++;
+        return json_container(jp, ']', 0);
+    case '"':
+        return json_string(jp);
+    case 't':
+        return json_literal(jp, "true");
+    case 'f':
+        return json_literal(jp, "false");
+    case 'n':
+        return json_literal(jp, "null");
+    default:
+        return json_number(jp);
+    }
+}
+
+static int json_document(json_parser_t *jp)
+{
+    return json_value(jp);
+}
+#endif
+
+BENCH_ENTRY(json)
+{
+    uint32_t checksum = 0;
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        json_parser_t jp = {
+            .p = s_doc + BENCH_SEED(),
+            .end = s_doc + sizeof(s_doc) - 1,
+            .string_hash = 2166136261u
+        };
+
+        if (json_document(&jp) < 0) {
+            return 0;
+        }
+
+        checksum = jp.string_hash ^ (uint32_t)jp.number_sum ^ (uint32_t)(jp.number_sum >> 32);
+        checksum = checksum * 31 + jp.objects;
+        checksum = checksum * 31 + jp.arrays;
+        checksum = checksum * 31 + jp.strings;
+        checksum = checksum * 31 + jp.literals;
+    }
+
+    return checksum;
+}
@@ -0,0 +1,228 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Write a ~1.5 KiB JSON reply per iteration, strings are escaped and
+ * numbers are printed like cJSON does, with 15 significant digits or 17 if
+ * 15 don't read back the same value. When BENCH_NATIVE is defined, the
+ * reply is written by the JSON natives of the extended native component
+ * through wm_native_json.h, which give the same text.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef BENCH_NATIVE
+#include "wm_native_json.h"
+#endif
+
+#include "bench.h"
+
+#define JSON_WRITE_BUF_SIZE     2048
+#define JSON_WRITE_SENSORS      12
+#define JSON_WRITE_HISTORY      24
+
+static char s_buf[JSON_WRITE_BUF_SIZE];
+
+#ifdef BENCH_NATIVE
+typedef wm_native_json_writer_t json_writer_t;
+
+#define json_writer_init    wm_native_json_writer_init
+#define json_write_begin    wm_native_json_write_begin
+#define json_write_end      wm_native_json_write_end
+#define json_write_string   wm_native_json_write_string
+#define json_write_number   wm_native_json_write_number
+#define json_write_int      wm_native_json_write_int
+#define json_write_bool     wm_native_json_write_bool
+#else
+
+#define JSON_WRITE_MAX_DEPTH    8
+
+typedef struct json_writer {
+    char *buf;
+    uint32_t size;
+    uint32_t len;
+    uint32_t depth;
+    uint8_t comma[JSON_WRITE_MAX_DEPTH];   /* Container at the depth has a value */
+    uint8_t array[JSON_WRITE_MAX_DEPTH];   /* Container at the depth is an array */
+} json_writer_t;
+
+static void json_writer_init(json_writer_t *w, char *buf, uint32_t size)
+{
+    memset(w, 0, sizeof(json_writer_t));
+    w->buf = buf;
+    w->size = size;
+}
+
+static void json_put(json_writer_t *w, const char *s, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++, w->len++) {
+        if (w->len < w->size) {
+            w->buf[w->len] = s[i];
+        }
+    }
+}
+
+static void json_put_string(json_writer_t *w, const char *s, uint32_t len)
+{
+    static const char s_hex[] = "0123456789abcdef";
+
+    json_put(w, "\"", 1);
+    for (uint32_t i = 0; i < len; i++) {
+        uint8_t c = (uint8_t)s[i];
+        char esc[6] = { '\\', (char)c, '0', '0', 0, 0 };
+
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            json_put(w, (const char *)&s[i], 1);
+        } else if (c == '\n') {
+            esc[1] = 'n';
+            json_put(w, esc, 2);
+        } else if (c == '"' || c == '\\') {
+            json_put(w, esc, 2);
+        } else {
+            esc[1] = 'u';
+            esc[4] = s_hex[c >> 4];
+            esc[5] = s_hex[c & 0xf];
+            json_put(w, esc, 6);
+        }
+    }
+    json_put(w, "\"", 1);
+}
+
+static void json_key(json_writer_t *w, const char *key)
+{
+    if (w->comma[w->depth]) {
+        json_put(w, ",", 1);
+    }
+    w->comma[w->depth] = 1;
+
+    if (key) {
+        json_put_string(w, key, strlen(key));
+        json_put(w, ":", 1);
+    }
+}
+
+static int json_write_begin(json_writer_t *w, const char *key, int array)
+{
+    json_key(w, key);
+    json_put(w, array ? "[" : "{", 1);
+    w->depth++;
+    w->comma[w->depth] = 0;
+    w->array[w->depth] = (uint8_t)array;
+
+    return 0;
+}
+
+static int json_write_end(json_writer_t *w)
+{
+    json_put(w, w->array[w->depth] ? "]" : "}", 1);
+    w->depth--;
+
+    return 0;
+}
+
+static int json_write_string(json_writer_t *w, const char *key, const char *str, uint32_t len)
+{
+    json_key(w, key);
+    json_put_string(w, str, len);
+
+    return 0;
+}
+
+static int json_write_number(json_writer_t *w, const char *key, double value)
+{
+    char text[32];
+    int n = snprintf(text, sizeof(text), "%.15g", value);
+
+    if (strtod(text, NULL) != value) {
+        n = snprintf(text, sizeof(text), "%.17g", value);
+    }
+
+    json_key(w, key);
+    json_put(w, text, (uint32_t)n);
+
+    return 0;
+}
+
+static int json_write_int(json_writer_t *w, const char *key, int64_t value)
+{
+    char text[24];
+    int n = snprintf(text, sizeof(text), "%lld", (long long)value);
+
+    json_key(w, key);
+    json_put(w, text, (uint32_t)n);
+
+    return 0;
+}
+
+static int json_write_bool(json_writer_t *w, const char *key, int value)
+{
+    json_key(w, key);
+    json_put(w, value ? "true" : "false", value ? 4 : 5);
+
+    return 0;
+}
+#endif
+
+static uint32_t json_write_reply(json_writer_t *w, uint32_t seed)
+{
+    static const char *const s_types[] = { "temperature", "humidity", "pressure", "light \"lux\"" };
+    static const char s_label[] = "kitchen\nliving room";
+
+    json_writer_init(w, s_buf, sizeof(s_buf));
+
+    json_write_begin(w, NULL, 0);
+    json_write_string(w, "device", "esp32-s3-box", 12);
+    json_write_int(w, "seq", 1234567 + seed);
+    json_write_string(w, "label", s_label, sizeof(s_label) - 1);
+
+    json_write_begin(w, "sensors", 1);
+    for (uint32_t i = 0; i < JSON_WRITE_SENSORS; i++) {
+        const char *type = s_types[(i + seed) % 4];
+
+        json_write_begin(w, NULL, 0);
+        json_write_int(w, "id", i);
+        json_write_string(w, "type", type, strlen(type));
+        json_write_number(w, "value", (double)((i * 37 + seed) % 1000) / 8.0 - 20.0);
+        json_write_number(w, "drift", (double)(i + seed) * 0.1);
+        json_write_bool(w, "ok", i % 3 != 0);
+        json_write_end(w);
+    }
+    json_write_end(w);
+
+    json_write_begin(w, "history", 1);
+    for (uint32_t i = 0; i < JSON_WRITE_HISTORY; i++) {
+        json_write_number(w, NULL, 1013.25 + (double)(i + seed) / 3.0);
+    }
+    json_write_end(w);
+
+    json_write_end(w);
+
+    return w->len;
+}
+
+BENCH_ENTRY(json_write)
+{
+    uint32_t checksum = 0;
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        json_writer_t w;
+        uint32_t len = json_write_reply(&w, BENCH_SEED());
+
+        if (len > sizeof(s_buf)) {
+            return 0;
+        }
+
+        checksum = len;
+        for (uint32_t i = 0; i < len; i++) {
+            checksum = checksum * 31 + (uint8_t)s_buf[i];
+        }
+    }
+
+    return checksum;
+}
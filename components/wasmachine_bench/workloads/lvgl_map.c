@@ -0,0 +1,336 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Pointer translation of the LVGL native bridge, it is host only because it
+ * models the native side. Every iteration is one frame of label, style and
+ * position calls whose arguments are application addresses, LVGL objects
+ * which are native pointers, and plain values.
+ *
+ * "lvgl_map_old" translates every argument as the bridges did before the
+ * shared helpers of wm_ext_wasm_native_common.h: range checks of all memory
+ * regions, then an out-of-line runtime call per address, and one more to
+ * validate a string before mapping it. "lvgl_map" follows the shared
+ * helpers: linear memory is resolved once per native call, one range check
+ * selected at compile time, then a bound check and an add, and strings are
+ * checked for a terminator in the same pass. Both return the same checksum,
+ * the ratio of their iter/s is the per-call saving.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "bench.h"
+
+#define LVGL_MAP_MEM_SIZE   65536
+#define LVGL_MAP_OBJS       32
+#define LVGL_MAP_TEXTS      16
+#define LVGL_MAP_STYLES     8
+#define LVGL_MAP_CALLS      1024        /* Native calls of a frame */
+
+#define LVGL_MAP_TEXT_BASE  1024
+#define LVGL_MAP_STYLE_BASE 8192
+
+/* Stands for the module instance, the runtime looks its memory up for every call */
+typedef struct lvgl_map_module {
+    uint8_t *base;
+    uint32_t size;
+} lvgl_map_module_t;
+
+/* Stands for wm_ext_wasm_native_mem_t, it lives on the stack of one native call */
+typedef struct lvgl_map_mem {
+    const lvgl_map_module_t *module;
+    uint8_t *base;
+    uint32_t size;
+} lvgl_map_mem_t;
+
+typedef struct lvgl_map_style {
+    uint32_t radius;
+    uint32_t bg_opa;
+} lvgl_map_style_t;
+
+typedef struct lvgl_map_obj {
+    int32_t x;
+    int32_t y;
+    uint32_t text_hash;
+    uint32_t style;
+} lvgl_map_obj_t;
+
+static uint8_t s_mem[LVGL_MAP_MEM_SIZE];
+static lvgl_map_module_t s_module = { s_mem, sizeof(s_mem) };
+
+/* LVGL objects are native, so their pointers stand for internal DRAM */
+static lvgl_map_obj_t s_objs[LVGL_MAP_OBJS];
+
+/* Other memory regions the old checks went through, nothing is in them on host */
+static const uint8_t s_drom[64];
+static const uint8_t s_psram[64];
+
+/* Runtime calls are out of line, as they are in WAMR */
+__attribute__((noinline)) static void *lvgl_map_runtime_addr_app_to_native(const lvgl_map_module_t *module, uint32_t addr)
+{
+    const lvgl_map_module_t *m = *(const lvgl_map_module_t *volatile *)&module;
+
+    return addr < m->size ? m->base + addr : NULL;
+}
+
+__attribute__((noinline)) static bool lvgl_map_runtime_validate_app_str(const lvgl_map_module_t *module, uint32_t addr)
+{
+    const lvgl_map_module_t *m = *(const lvgl_map_module_t *volatile *)&module;
+
+    return addr < m->size && memchr(m->base + addr, '\0', m->size - addr);
+}
+
+__attribute__((noinline)) static bool lvgl_map_runtime_resolve(lvgl_map_mem_t *mem)
+{
+    const lvgl_map_module_t *m = *(const lvgl_map_module_t *volatile *)&mem->module;
+
+    mem->base = m->base;
+    mem->size = m->size;
+
+    return true;
+}
+
+static inline bool lvgl_map_in(const void *ptr, const void *start, uint32_t size)
+{
+    return (uintptr_t)ptr >= (uintptr_t)start && (uintptr_t)ptr < (uintptr_t)start + size;
+}
+
+static inline bool lvgl_map_is_native_old(const void *ptr)
+{
+    return lvgl_map_in(ptr, s_objs, sizeof(s_objs)) || lvgl_map_in(ptr, s_drom, sizeof(s_drom)) ||
+           lvgl_map_in(ptr, s_psram, sizeof(s_psram));
+}
+
+static void *lvgl_map_ptr_old(const lvgl_map_module_t *module, const void *ptr)
+{
+    if (lvgl_map_is_native_old(ptr)) {
+        return (void *)ptr;
+    }
+
+    return lvgl_map_runtime_addr_app_to_native(module, (uint32_t)(uintptr_t)ptr);
+}
+
+static char *lvgl_map_string_old(const lvgl_map_module_t *module, const char *str)
+{
+    if (lvgl_map_is_native_old(str)) {
+        return (char *)str;
+    }
+
+    if (!lvgl_map_runtime_validate_app_str(module, (uint32_t)(uintptr_t)str)) {
+        return NULL;
+    }
+
+    return lvgl_map_runtime_addr_app_to_native(module, (uint32_t)(uintptr_t)str);
+}
+
+static void *lvgl_map_ptr(lvgl_map_mem_t *mem, const void *ptr)
+{
+    uintptr_t offset = (uintptr_t)ptr;
+
+    if (lvgl_map_in(ptr, s_objs, sizeof(s_objs))) {
+        return (void *)ptr;
+    }
+
+    if (!mem->base && !lvgl_map_runtime_resolve(mem)) {
+        return NULL;
+    }
+
+    return offset < mem->size ? mem->base + offset : NULL;
+}
+
+static char *lvgl_map_string(lvgl_map_mem_t *mem, const char *str)
+{
+    uintptr_t offset = (uintptr_t)str;
+
+    if (lvgl_map_in(str, s_objs, sizeof(s_objs))) {
+        return (char *)str;
+    }
+
+    if (!mem->base && !lvgl_map_runtime_resolve(mem)) {
+        return NULL;
+    }
+
+    if (offset >= mem->size || !memchr(mem->base + offset, '\0', mem->size - offset)) {
+        return NULL;
+    }
+
+    return (char *)mem->base + offset;
+}
+
+static void lvgl_map_label_set_text(lvgl_map_obj_t *obj, const char *txt)
+{
+    uint32_t hash = 2166136261u;
+
+    while (*txt) {
+        hash = (hash ^ (uint8_t)*txt++) * 16777619u;
+    }
+    obj->text_hash = hash;
+}
+
+static void lvgl_map_style_set_radius(lvgl_map_style_t *style, uint32_t radius)
+{
+    style->radius = radius;
+}
+
+static void lvgl_map_obj_add_style(lvgl_map_obj_t *obj, const lvgl_map_style_t *style)
+{
+    obj->style = style->radius * 31 + style->bg_opa;
+}
+
+static void lvgl_map_obj_set_pos(lvgl_map_obj_t *obj, int32_t x, int32_t y)
+{
+    obj->x = x;
+    obj->y = y;
+}
+
+/* Application side of a frame, argv is what the application passes for call i */
+static uint32_t lvgl_map_args(uint32_t i, uint32_t seed, uintptr_t argv[3])
+{
+    argv[0] = (uintptr_t)&s_objs[(i * 7 + seed) % LVGL_MAP_OBJS];
+
+    switch (i % 4) {
+    case 0:
+        argv[1] = LVGL_MAP_TEXT_BASE + (i % LVGL_MAP_TEXTS) * 32;
+        break;
+    case 1:
+        argv[0] = LVGL_MAP_STYLE_BASE + (i % LVGL_MAP_STYLES) * sizeof(lvgl_map_style_t);
+        argv[1] = i & 0xff;
+        break;
+    case 2:
+        argv[1] = LVGL_MAP_STYLE_BASE + (i % LVGL_MAP_STYLES) * sizeof(lvgl_map_style_t);
+        break;
+    default:
+        argv[1] = i % 480;
+        argv[2] = i % 272;
+        break;
+    }
+
+    return i % 4;
+}
+
+static void lvgl_map_init(void)
+{
+    memset(s_objs, 0, sizeof(s_objs));
+    memset(s_mem, 0, sizeof(s_mem));
+
+    for (int i = 0; i < LVGL_MAP_TEXTS; i++) {
+        char *txt = (char *)s_mem + LVGL_MAP_TEXT_BASE + i * 32;
+
+        memcpy(txt, "Temperature: 00.0 C", 20);
+        txt[13] = (char)('0' + i % 10);
+        txt[15] = (char)('0' + i * 3 % 10);
+    }
+}
+
+static uint32_t lvgl_map_checksum(void)
+{
+    uint32_t checksum = 0;
+
+    for (int i = 0; i < LVGL_MAP_OBJS; i++) {
+        checksum = checksum * 31 + s_objs[i].text_hash;
+        checksum = checksum * 31 + s_objs[i].style;
+        checksum = checksum * 31 + (uint32_t)(s_objs[i].x * 1000 + s_objs[i].y);
+    }
+
+    return checksum;
+}
+
+BENCH_ENTRY(lvgl_map_old)
+{
+    lvgl_map_init();
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        uint32_t seed = BENCH_SEED();
+
+        for (uint32_t i = 0; i < LVGL_MAP_CALLS; i++) {
+            uintptr_t argv[3];
+            uint32_t call = lvgl_map_args(i, seed, argv);
+            lvgl_map_obj_t *obj;
+            void *arg;
+
+            switch (call) {
+            case 0:
+                obj = lvgl_map_ptr_old(&s_module, (void *)argv[0]);
+                arg = lvgl_map_string_old(&s_module, (const char *)argv[1]);
+                if (obj && arg) {
+                    lvgl_map_label_set_text(obj, arg);
+                }
+                break;
+            case 1:
+                arg = lvgl_map_ptr_old(&s_module, (void *)argv[0]);
+                if (arg) {
+                    lvgl_map_style_set_radius(arg, (uint32_t)argv[1]);
+                }
+                break;
+            case 2:
+                obj = lvgl_map_ptr_old(&s_module, (void *)argv[0]);
+                arg = lvgl_map_ptr_old(&s_module, (void *)argv[1]);
+                if (obj && arg) {
+                    lvgl_map_obj_add_style(obj, arg);
+                }
+                break;
+            default:
+                obj = lvgl_map_ptr_old(&s_module, (void *)argv[0]);
+                if (obj) {
+                    lvgl_map_obj_set_pos(obj, (int32_t)argv[1], (int32_t)argv[2]);
+                }
+                break;
+            }
+        }
+    }
+
+    return lvgl_map_checksum();
+}
+
+BENCH_ENTRY(lvgl_map)
+{
+    lvgl_map_init();
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        uint32_t seed = BENCH_SEED();
+
+        for (uint32_t i = 0; i < LVGL_MAP_CALLS; i++) {
+            uintptr_t argv[3];
+            uint32_t call = lvgl_map_args(i, seed, argv);
+            lvgl_map_mem_t mem = { .module = &s_module };
+            lvgl_map_obj_t *obj;
+            void *arg;
+
+            switch (call) {
+            case 0:
+                obj = lvgl_map_ptr(&mem, (void *)argv[0]);
+                arg = lvgl_map_string(&mem, (const char *)argv[1]);
+                if (obj && arg) {
+                    lvgl_map_label_set_text(obj, arg);
+                }
+                break;
+            case 1:
+                arg = lvgl_map_ptr(&mem, (void *)argv[0]);
+                if (arg) {
+                    lvgl_map_style_set_radius(arg, (uint32_t)argv[1]);
+                }
+                break;
+            case 2:
+                obj = lvgl_map_ptr(&mem, (void *)argv[0]);
+                arg = lvgl_map_ptr(&mem, (void *)argv[1]);
+                if (obj && arg) {
+                    lvgl_map_obj_add_style(obj, arg);
+                }
+                break;
+            default:
+                obj = lvgl_map_ptr(&mem, (void *)argv[0]);
+                if (obj) {
+                    lvgl_map_obj_set_pos(obj, (int32_t)argv[1], (int32_t)argv[2]);
+                }
+                break;
+            }
+        }
+    }
+
+    return lvgl_map_checksum();
+}
@@ -0,0 +1,56 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Multiply two 32x32 Q16 fixed-point matrices per iteration, integer math
+ * keeps the checksum identical on every target and execution mode.
+ */
+
+#include <stdint.h>
+
+#include "bench.h"
+
+#define MATMUL_N    32
+
+static int32_t s_a[MATMUL_N][MATMUL_N];
+static int32_t s_b[MATMUL_N][MATMUL_N];
+static int32_t s_c[MATMUL_N][MATMUL_N];
+
+BENCH_ENTRY(matmul)
+{
+    uint32_t checksum = 0;
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        uint32_t seed = BENCH_SEED();
+
+        for (int i = 0; i < MATMUL_N; i++) {
+            for (int j = 0; j < MATMUL_N; j++) {
+                s_a[i][j] = ((int32_t)((i * 7 + j * 3 + seed) % 17) - 8) * 16384;
+                s_b[i][j] = ((int32_t)((i * 5 + j * 11 + seed) % 13) - 6) * 16384;
+            }
+        }
+
+        for (int i = 0; i < MATMUL_N; i++) {
+            for (int j = 0; j < MATMUL_N; j++) {
+                int64_t sum = 0;
+
+                for (int k = 0; k < MATMUL_N; k++) {
+                    sum += (int64_t)s_a[i][k] * s_b[k][j];
+                }
+                s_c[i][j] = (int32_t)(sum >> 16);
+            }
+        }
+
+        checksum = 0;
+        for (int i = 0; i < MATMUL_N; i++) {
+            for (int j = 0; j < MATMUL_N; j++) {
+                checksum = checksum * 31 + (uint32_t)s_c[i][j];
+            }
+        }
+    }
+
+    return checksum;
+}
@@ -0,0 +1,68 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * memcpy, memmove, memset, memcmp, memchr and strlen on 16, 256 and 4096 byte
+ * buffers, every size processes the same number of bytes per iteration. When
+ * BENCH_NATIVE is defined, calls go to the string natives of the extended
+ * native component through wm_native_string.h, calls shorter than its
+ * threshold stay in wasi-libc.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef BENCH_NATIVE
+#include "wm_native_string.h"
+#endif
+
+#include "bench.h"
+
+#define MEMOPS_BUF      8192
+#define MEMOPS_BYTES    16384
+
+static const uint32_t s_sizes[] = { 16, 256, 4096 };
+
+static uint8_t s_src[MEMOPS_BUF];
+static uint8_t s_dst[MEMOPS_BUF];
+
+BENCH_ENTRY(memops)
+{
+    uint32_t checksum = 0;
+
+    /* No zero bytes, so strlen stops at the terminator of each buffer */
+    for (int i = 0; i < MEMOPS_BUF; i++) {
+        s_src[i] = (uint8_t)(i % 251 + 1);
+    }
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        uint32_t seed = BENCH_SEED();
+
+        checksum = 0;
+        for (uint32_t s = 0; s < sizeof(s_sizes) / sizeof(s_sizes[0]); s++) {
+            uint32_t size = s_sizes[s];
+
+            for (uint32_t i = 0; i < MEMOPS_BYTES / size; i++) {
+                uint32_t pos = (i * 61 + seed) % (MEMOPS_BUF - size);
+                int diff;
+                uint8_t *found;
+
+                memcpy(s_dst, s_src + pos, size);
+                memset(s_dst + size / 2, (int)(pos % 255 + 1), size / 2);
+                diff = memcmp(s_dst, s_src + pos, size);
+                found = memchr(s_dst, s_src[pos + size - 1], size);
+                memmove(s_dst + 1, s_dst, size - 1);
+                s_dst[size - 1] = 0;
+
+                checksum = checksum * 31 + (uint32_t)((diff > 0) - (diff < 0));
+                checksum = checksum * 31 + (found ? (uint32_t)(found - s_dst) : size);
+                checksum = checksum * 31 + (uint32_t)strlen((const char *)s_dst);
+            }
+        }
+    }
+
+    return checksum;
+}
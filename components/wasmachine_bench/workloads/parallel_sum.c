@@ -0,0 +1,101 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Split an integer mixing loop into equal chunks and run them in parallel,
+ * the calling thread takes the first chunk and spawned threads take the others.
+ * Every thread runs all iterations on its own chunk, so threads only meet at
+ * creation and join, and the result measures how well execution scales over
+ * cores, including the cost of spawning threads once per call.
+ *
+ * The WASM module must be built for wasm32-wasi-threads with shared memory.
+ */
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "bench.h"
+
+#define PSUM_THREADS        4
+#define PSUM_ITEMS          4096
+#define PSUM_ROUNDS         8
+#define PSUM_STACK_SIZE     16384
+
+typedef struct psum_worker {
+    uint32_t index;
+    uint32_t iterations;
+    uint32_t result;
+} psum_worker_t;
+
+static void *psum_worker(void *p)
+{
+    psum_worker_t *worker = (psum_worker_t *)p;
+    uint32_t begin = worker->index * (PSUM_ITEMS / PSUM_THREADS);
+    uint32_t end = begin + PSUM_ITEMS / PSUM_THREADS;
+
+    for (uint32_t n = 0; n < worker->iterations; n++) {
+        uint32_t seed = BENCH_SEED();
+        uint32_t sum = 0;
+
+        for (uint32_t i = begin; i < end; i++) {
+            uint32_t x = i * 0x9e3779b9u + seed + 1;
+
+            for (int r = 0; r < PSUM_ROUNDS; r++) {
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+            }
+
+            sum += x;
+        }
+
+        worker->result = sum;
+    }
+
+    return NULL;
+}
+
+BENCH_ENTRY(parallel_sum)
+{
+    uint32_t checksum = 0;
+    pthread_t tid[PSUM_THREADS];
+    pthread_attr_t attr;
+    psum_worker_t worker[PSUM_THREADS];
+    uint32_t spawned = 0;
+
+    for (uint32_t i = 0; i < PSUM_THREADS; i++) {
+        worker[i].index = i;
+        worker[i].iterations = iterations;
+        worker[i].result = 0;
+    }
+
+    if (pthread_attr_init(&attr) != 0) {
+        return 0;
+    }
+
+    pthread_attr_setstacksize(&attr, PSUM_STACK_SIZE);
+
+    for (spawned = 1; spawned < PSUM_THREADS; spawned++) {
+        if (pthread_create(&tid[spawned], &attr, psum_worker, &worker[spawned]) != 0) {
+            break;
+        }
+    }
+
+    pthread_attr_destroy(&attr);
+
+    psum_worker(&worker[0]);
+
+    for (uint32_t i = 1; i < spawned; i++) {
+        pthread_join(tid[i], NULL);
+    }
+
+    /* A failed spawn leaves its chunk unprocessed, so the checksum fails */
+    for (uint32_t i = 0; i < PSUM_THREADS; i++) {
+        checksum = (checksum << 7 | checksum >> 25) ^ worker[i].result;
+    }
+
+    return checksum;
+}
@@ -0,0 +1,188 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Hash a 1 KiB message with SHA-256 (FIPS 180-4) per iteration. When
+ * BENCH_NATIVE is defined, the message is hashed by the crypto natives of the
+ * extended native component, which give the same digest.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef BENCH_NATIVE
+#include "wm_native_crypto.h"
+#endif
+
+#include "bench.h"
+
+#define SHA256_MSG_SIZE     1024
+
+static uint8_t s_msg[SHA256_MSG_SIZE];
+
+#ifdef BENCH_NATIVE
+static void sha256(const uint8_t *data, size_t len, uint8_t *hash)
+{
+    int handle = wm_native_crypto_hash_start(WM_NATIVE_CRYPTO_SHA256);
+
+    wm_native_crypto_update(handle, data, NULL, len);
+    wm_native_crypto_finish(handle, hash, 32);
+}
+#else
+
+#define ROTR(x, n)  (((x) >> (n)) | ((x) << (32 - (n))))
+#define CH(x, y, z)  (((x) & (y)) ^ (~(x) & (z)))
+#define MAJ(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define EP0(x) (ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22))
+#define EP1(x) (ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25))
+#define SIG0(x) (ROTR(x, 7) ^ ROTR(x, 18) ^ ((x) >> 3))
+#define SIG1(x) (ROTR(x, 17) ^ ROTR(x, 19) ^ ((x) >> 10))
+
+typedef struct sha256_ctx {
+    uint32_t state[8];
+    uint64_t bits;
+    uint8_t block[64];
+    size_t len;
+} sha256_ctx_t;
+
+static const uint32_t s_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static void sha256_transform(sha256_ctx_t *ctx, const uint8_t *data)
+{
+    uint32_t a, b, c, d, e, f, g, h, t1, t2, w[64];
+
+    for (int i = 0; i < 16; i++) {
+        w[i] = ((uint32_t)data[i * 4] << 24) | ((uint32_t)data[i * 4 + 1] << 16) |
+               ((uint32_t)data[i * 4 + 2] << 8) | data[i * 4 + 3];
+    }
+    for (int i = 16; i < 64; i++) {
+        w[i] = SIG1(w[i - 2]) + w[i - 7] + SIG0(w[i - 15]) + w[i - 16];
+    }
+
+    a = ctx->state[0];
+    b = ctx->state[1];
+    c = ctx->state[2];
+    d = ctx->state[3];
+    e = ctx->state[4];
+    f = ctx->state[5];
+    g = ctx->state[6];
+    h = ctx->state[7];
+
+    for (int i = 0; i < 64; i++) {
+        t1 = h + EP1(e) + CH(e, f, g) + s_k[i] + w[i];
+        t2 = EP0(a) + MAJ(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    ctx->state[0] += a;
+    ctx->state[1] += b;
+    ctx->state[2] += c;
+    ctx->state[3] += d;
+    ctx->state[4] += e;
+    ctx->state[5] += f;
+    ctx->state[6] += g;
+    ctx->state[7] += h;
+}
+
+static void sha256_init(sha256_ctx_t *ctx)
+{
+    ctx->state[0] = 0x6a09e667;
+    ctx->state[1] = 0xbb67ae85;
+    ctx->state[2] = 0x3c6ef372;
+    ctx->state[3] = 0xa54ff53a;
+    ctx->state[4] = 0x510e527f;
+    ctx->state[5] = 0x9b05688c;
+    ctx->state[6] = 0x1f83d9ab;
+    ctx->state[7] = 0x5be0cd19;
+    ctx->bits = 0;
+    ctx->len = 0;
+}
+
+static void sha256_update(sha256_ctx_t *ctx, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        ctx->block[ctx->len++] = data[i];
+        if (ctx->len == 64) {
+            sha256_transform(ctx, ctx->block);
+            ctx->bits += 512;
+            ctx->len = 0;
+        }
+    }
+}
+
+static void sha256_final(sha256_ctx_t *ctx, uint8_t *hash)
+{
+    size_t i = ctx->len;
+
+    ctx->bits += ctx->len * 8;
+    ctx->block[i++] = 0x80;
+    if (i > 56) {
+        while (i < 64) {
+            ctx->block[i++] = 0;
+        }
+        sha256_transform(ctx, ctx->block);
+        i = 0;
+    }
+    while (i < 56) {
+        ctx->block[i++] = 0;
+    }
+    for (int j = 0; j < 8; j++) {
+        ctx->block[63 - j] = (uint8_t)(ctx->bits >> (j * 8));
+    }
+    sha256_transform(ctx, ctx->block);
+
+    for (int j = 0; j < 8; j++) {
+        hash[j * 4] = (uint8_t)(ctx->state[j] >> 24);
+        hash[j * 4 + 1] = (uint8_t)(ctx->state[j] >> 16);
+        hash[j * 4 + 2] = (uint8_t)(ctx->state[j] >> 8);
+        hash[j * 4 + 3] = (uint8_t)ctx->state[j];
+    }
+}
+
+static void sha256(const uint8_t *data, size_t len, uint8_t *hash)
+{
+    sha256_ctx_t ctx;
+
+    sha256_init(&ctx);
+    sha256_update(&ctx, data, len);
+    sha256_final(&ctx, hash);
+}
+#endif
+
+BENCH_ENTRY(sha256)
+{
+    uint8_t hash[32];
+    uint32_t checksum = 0;
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        for (int i = 0; i < SHA256_MSG_SIZE; i++) {
+            s_msg[i] = (uint8_t)(i * 31 + BENCH_SEED());
+        }
+
+        sha256(s_msg, sizeof(s_msg), hash);
+
+        checksum = ((uint32_t)hash[0] << 24) | ((uint32_t)hash[1] << 16) |
+                   ((uint32_t)hash[2] << 8) | hash[3];
+    }
+
+    return checksum;
+}
@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief WASM application startup phases, every mark closes the phase
+ *        which started at the previous mark.
+ */
+typedef enum wm_startup_phase {
+    WM_STARTUP_PHASE_FILE_READ = 0,     /*!< Application file has been read into memory */
+    WM_STARTUP_PHASE_PKG_DETECT,        /*!< Package type has been detected */
+    WM_STARTUP_PHASE_LOAD,              /*!< Module has been loaded */
+    WM_STARTUP_PHASE_WASI_SETUP,        /*!< WASI arguments have been set */
+    WM_STARTUP_PHASE_INSTANTIATE,       /*!< Module has been instantiated */
+    WM_STARTUP_PHASE_MAIN_ENTRY,        /*!< Application's main function is about to be called */
+    WM_STARTUP_PHASE_MAIN_EXIT,         /*!< Application's main function has returned */
+    WM_STARTUP_PHASE_MAX
+} wm_startup_phase_t;
+
+/**
+ * @brief WASM application startup profile.
+ */
+typedef struct wm_startup_profile {
+    int64_t     begin_us;                           /*!< Timestamp of wm_startup_profile_begin */
+    int64_t     mark_us[WM_STARTUP_PHASE_MAX];      /*!< Timestamp of every phase mark */
+    size_t      mem_used[WM_STARTUP_PHASE_MAX];     /*!< WAMR memory in use at every phase mark */
+    size_t      mem_peak[WM_STARTUP_PHASE_MAX];     /*!< WAMR memory peak above the start of every phase */
+    size_t      mem_begin;                          /*!< WAMR memory in use at wm_startup_profile_begin */
+    uint32_t    marked;                             /*!< Bitmap of marked phases */
+} wm_startup_profile_t;
+
+/**
+ * @brief  Start profiling, this resets the WAMR memory peak counter.
+ *
+ * @param  profile Startup profile pointer
+ *
+ * @return None.
+ */
+void wm_startup_profile_begin(wm_startup_profile_t *profile);
+
+/**
+ * @brief  Mark the end of a startup phase.
+ *
+ * @param  profile Startup profile pointer, NULL is allowed and ignored
+ * @param  phase   Phase which is finished
+ *
+ * @return None.
+ */
+void wm_startup_profile_mark(wm_startup_profile_t *profile, wm_startup_phase_t phase);
+
+/**
+ * @brief  Get the name of a startup phase.
+ *
+ * @param  phase Startup phase
+ *
+ * @return Phase name string.
+ */
+const char *wm_startup_profile_phase_name(wm_startup_phase_t phase);
+
+/**
+ * @brief  Print the profile as a table.
+ *
+ * @param  profile Startup profile pointer
+ *
+ * @return None.
+ */
+void wm_startup_profile_print(const wm_startup_profile_t *profile);
+
+/**
+ * @brief  Print the profile as a single line JSON object.
+ *
+ * @param  profile Startup profile pointer
+ *
+ * @return None.
+ */
+void wm_startup_profile_print_json(const wm_startup_profile_t *profile);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,12 +1,15 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #pragma once
 
+#include <stddef.h>
+
 #include "sdkconfig.h"
+#include "esp_err.h"
 #include "wm_config.h"
 #ifdef CONFIG_WASMACHINE_APP_MGR
 #include "bi-inc/shared_utils.h"
@@ -16,15 +19,122 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+/**
+ * @brief Memory region which WAMR allocates WASM application data from.
+ */
+typedef enum wm_wamr_mem_region {
+    WM_WAMR_MEM_DEFAULT = 0,    /*!< PSRAM if it is enabled, or internal DRAM */
+    WM_WAMR_MEM_DRAM,           /*!< Internal DRAM */
+    WM_WAMR_MEM_PSRAM,          /*!< PSRAM */
+} wm_wamr_mem_region_t;
+#endif
+
 #ifdef CONFIG_WASMACHINE_APP_MGR
 void wm_wamr_app_mgr_init(void);
 void wm_wamr_app_mgr_lock(void);
 void wm_wamr_app_mgr_unlock(void);
 int wm_wamr_app_send_request(request_t *request, uint16_t msg_type);
+
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+/**
+ * @brief Finish installing an application, allocations of the application manager
+ *        stop following the "mem_caps" parameter of the install request.
+ */
+void wm_wamr_app_mgr_end_install(void);
+
+/**
+ * @brief Get memory region of an installed application.
+ *
+ * @param name Name of the application
+ *
+ * @return Memory region given by the "mem_caps" parameter of the install request.
+ */
+wm_wamr_mem_region_t wm_wamr_app_mgr_get_mem_region(const char *name);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WPROF
+/**
+ * @brief Attach all installed applications to the sampling profiler, each of them
+ *        attaches itself when its thread handles the posted message.
+ */
+void wm_wamr_app_mgr_wprof_attach(void);
+#endif
 #endif
 
 void wm_wamr_init(void);
 
+#ifdef CONFIG_WASMACHINE_WASM_THREADS
+/**
+ * @brief Set core affinity and priority of threads spawned by WASM applications
+ *        which run in the calling thread, spawned threads inherit the setting
+ *        so nested spawns follow it too.
+ *
+ * @param core_id Core to pin spawned threads to, -1 means no affinity
+ * @param prio    FreeRTOS priority of spawned threads
+ *
+ * @return ESP_OK if success or ESP_ERR_INVALID_ARG if core_id or prio is invalid.
+ */
+esp_err_t wm_wamr_set_thread_cfg(int core_id, int prio);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+/**
+ * @brief Parse a memory region name, which is "default", "dram" or "psram".
+ *
+ * @param str    Region name
+ * @param region Pointer to store the region
+ *
+ * @return ESP_OK if success, ESP_ERR_INVALID_ARG if the name is unknown or
+ *         ESP_ERR_NOT_SUPPORTED if PSRAM is not enabled.
+ */
+esp_err_t wm_wamr_mem_region_from_str(const char *str, wm_wamr_mem_region_t *region);
+
+/**
+ * @brief Get name of a memory region.
+ *
+ * @param region Memory region
+ *
+ * @return Region name.
+ */
+const char *wm_wamr_mem_region_to_str(wm_wamr_mem_region_t region);
+
+/**
+ * @brief Set memory region of WAMR allocations made by the calling thread,
+ *        it covers module data, linear memory and execution environments.
+ *
+ * @param region Memory region
+ *
+ * @return Previous memory region of the calling thread.
+ */
+wm_wamr_mem_region_t wm_wamr_set_thread_mem_region(wm_wamr_mem_region_t region);
+
+/**
+ * @brief Make WAMR allocations of the calling thread follow a region variable,
+ *        so the region can be changed by other threads.
+ *
+ * @param region Pointer to the region variable, NULL to use the region set by
+ *               wm_wamr_set_thread_mem_region
+ */
+void wm_wamr_bind_thread_mem_region(const volatile wm_wamr_mem_region_t *region);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_STATS
+/**
+ * @brief Get the number of bytes currently allocated by WAMR's allocator
+ *        and the high-water mark since the last wm_wamr_mem_reset_peak().
+ *
+ * @param used Pointer to store current usage, can be NULL
+ * @param peak Pointer to store peak usage, can be NULL
+ */
+void wm_wamr_mem_get_usage(size_t *used, size_t *peak);
+
+/**
+ * @brief Reset the high-water mark to the current usage.
+ */
+void wm_wamr_mem_reset_peak(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+#include "wasm_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief  Attach an execution environment to the sampling profiler.
+ *
+ * @note   This must be called from the thread which runs the execution environment,
+ *         and wm_wprof_detach must be called before the module instance is destroyed.
+ *         The execution environment is detached when the thread exits, so it must
+ *         not be freed before then if the thread attaches it and never detaches it.
+ *
+ * @param  exec_env Execution environment of the running WASM application
+ * @param  wasm     WASM file whose name section names the sampled functions, it must be
+ *                  valid until the execution environment is detached, NULL if none
+ * @param  size     Size of the WASM file
+ *
+ * @return ESP_OK if success or attached already, ESP_ERR_NO_MEM if no free target slot.
+ */
+esp_err_t wm_wprof_attach(wasm_exec_env_t exec_env, const uint8_t *wasm, uint32_t size);
+
+/**
+ * @brief  Detach an execution environment from the sampling profiler.
+ *
+ * @param  exec_env Execution environment attached by wm_wprof_attach
+ *
+ * @return None.
+ */
+void wm_wprof_detach(wasm_exec_env_t exec_env);
+
+/**
+ * @brief  Clear previous samples and start sampling all attached execution
+ *         environments, including ones which are attached later. Applications
+ *         installed by the application manager are attached when it starts.
+ *
+ * @param  period_us Sampling period in microseconds
+ *
+ * @return ESP_OK if success or others if failed.
+ */
+esp_err_t wm_wprof_start(uint32_t period_us);
+
+/**
+ * @brief  Stop sampling, collected samples are kept until next wm_wprof_start.
+ *
+ * @return ESP_OK if success or ESP_ERR_INVALID_STATE if profiler is not running.
+ */
+esp_err_t wm_wprof_stop(void);
+
+/**
+ * @brief  Check if profiler is sampling.
+ *
+ * @return true if profiler is running or false if not.
+ */
+bool wm_wprof_is_running(void);
+
+/**
+ * @brief  Dump collected samples.
+ *
+ * @param  stream Output stream
+ * @param  folded true to print one "outer;...;inner count" line per unique call stack,
+ *                which can be fed to flamegraph.pl directly, or false to print per-function
+ *                self and total sample counts.
+ *
+ * @return ESP_OK if success or ESP_ERR_INVALID_STATE if profiler is running or no sample.
+ */
+esp_err_t wm_wprof_dump(FILE *stream, bool folded);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,118 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "esp_timer.h"
+
+#include "wm_wamr.h"
+#include "wm_startup_profile.h"
+
+static const char *const s_phase_name[WM_STARTUP_PHASE_MAX] = {
+    [WM_STARTUP_PHASE_FILE_READ]    = "file_read",
+    [WM_STARTUP_PHASE_PKG_DETECT]   = "pkg_detect",
+    [WM_STARTUP_PHASE_LOAD]         = "load",
+    [WM_STARTUP_PHASE_WASI_SETUP]   = "wasi_setup",
+    [WM_STARTUP_PHASE_INSTANTIATE]  = "instantiate",
+    [WM_STARTUP_PHASE_MAIN_ENTRY]   = "main_entry",
+    [WM_STARTUP_PHASE_MAIN_EXIT]    = "main_exit",
+};
+
+/* Phases which are not marked, e.g. WASI setup without libc WASI, take no time. */
+static int64_t phase_start_us(const wm_startup_profile_t *profile, int phase)
+{
+    for (int i = phase - 1; i >= 0; i--) {
+        if (profile->marked & (1 << i)) {
+            return profile->mark_us[i];
+        }
+    }
+
+    return profile->begin_us;
+}
+
+void wm_startup_profile_begin(wm_startup_profile_t *profile)
+{
+    memset(profile, 0, sizeof(wm_startup_profile_t));
+
+    wm_wamr_mem_reset_peak();
+    wm_wamr_mem_get_usage(&profile->mem_begin, NULL);
+    profile->begin_us = esp_timer_get_time();
+}
+
+void wm_startup_profile_mark(wm_startup_profile_t *profile, wm_startup_phase_t phase)
+{
+    size_t used;
+    size_t peak;
+    size_t base;
+
+    if (!profile || phase >= WM_STARTUP_PHASE_MAX) {
+        return;
+    }
+
+    profile->mark_us[phase] = esp_timer_get_time();
+
+    base = profile->mem_begin;
+    for (int i = phase - 1; i >= 0; i--) {
+        if (profile->marked & (1 << i)) {
+            base = profile->mem_used[i];
+            break;
+        }
+    }
+
+    wm_wamr_mem_get_usage(&used, &peak);
+    profile->mem_used[phase] = used;
+    profile->mem_peak[phase] = peak > base ? peak - base : 0;
+    profile->marked |= 1 << phase;
+
+    wm_wamr_mem_reset_peak();
+}
+
+const char *wm_startup_profile_phase_name(wm_startup_phase_t phase)
+{
+    if (phase >= WM_STARTUP_PHASE_MAX) {
+        return "unknown";
+    }
+
+    return s_phase_name[phase];
+}
+
+void wm_startup_profile_print(const wm_startup_profile_t *profile)
+{
+    printf("%-12s %12s %12s %12s %12s\n", "phase", "at(us)", "cost(us)", "mem(B)", "peak+(B)");
+    for (int i = 0; i < WM_STARTUP_PHASE_MAX; i++) {
+        if (!(profile->marked & (1 << i))) {
+            continue;
+        }
+
+        printf("%-12s %12" PRId64 " %12" PRId64 " %12zu %12zu\n", s_phase_name[i],
+               profile->mark_us[i] - profile->begin_us,
+               profile->mark_us[i] - phase_start_us(profile, i),
+               profile->mem_used[i], profile->mem_peak[i]);
+    }
+}
+
+void wm_startup_profile_print_json(const wm_startup_profile_t *profile)
+{
+    bool first = true;
+
+    printf("{\"phases\":[");
+    for (int i = 0; i < WM_STARTUP_PHASE_MAX; i++) {
+        if (!(profile->marked & (1 << i))) {
+            continue;
+        }
+
+        printf("%s{\"name\":\"%s\",\"at_us\":%" PRId64 ",\"cost_us\":%" PRId64 ",\"mem\":%zu,\"peak_delta\":%zu}",
+               first ? "" : ",", s_phase_name[i],
+               profile->mark_us[i] - profile->begin_us,
+               profile->mark_us[i] - phase_start_us(profile, i),
+               profile->mem_used[i], profile->mem_peak[i]);
+        first = false;
+    }
+    printf("]}\n");
+}
@@ -1,14 +1,21 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <string.h>
 #include <sys/param.h>
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_STATS
+#include <stdatomic.h>
+#endif
 
 #include "esp_log.h"
 #include "esp_heap_caps.h"
+#if defined(CONFIG_WASMACHINE_WASM_THREADS) && !defined(CONFIG_IDF_TARGET_LINUX)
+#include "freertos/FreeRTOS.h"
+#include "esp_pthread.h"
+#endif
 
 #include "wasm_export.h"
 
@@ -26,6 +33,93 @@
 
 static const char *TAG = "wm_wamr";
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+static __thread wm_wamr_mem_region_t s_thread_region;
+static __thread const volatile wm_wamr_mem_region_t *s_thread_region_ptr;
+
+static const char *const s_region_name[] = {
+    [WM_WAMR_MEM_DEFAULT]   = "default",
+    [WM_WAMR_MEM_DRAM]      = "dram",
+    [WM_WAMR_MEM_PSRAM]     = "psram",
+};
+
+esp_err_t wm_wamr_mem_region_from_str(const char *str, wm_wamr_mem_region_t *region)
+{
+    for (int i = 0; i < sizeof(s_region_name) / sizeof(s_region_name[0]); i++) {
+        if (!strcmp(str, s_region_name[i])) {
+#ifndef CONFIG_SPIRAM
+            if (i == WM_WAMR_MEM_PSRAM) {
+                return ESP_ERR_NOT_SUPPORTED;
+            }
+#endif
+            *region = (wm_wamr_mem_region_t)i;
+            return ESP_OK;
+        }
+    }
+
+    return ESP_ERR_INVALID_ARG;
+}
+
+const char *wm_wamr_mem_region_to_str(wm_wamr_mem_region_t region)
+{
+    if (region >= sizeof(s_region_name) / sizeof(s_region_name[0])) {
+        return "unknown";
+    }
+
+    return s_region_name[region];
+}
+
+wm_wamr_mem_region_t wm_wamr_set_thread_mem_region(wm_wamr_mem_region_t region)
+{
+    wm_wamr_mem_region_t old = s_thread_region;
+
+    s_thread_region = region;
+
+    return old;
+}
+
+void wm_wamr_bind_thread_mem_region(const volatile wm_wamr_mem_region_t *region)
+{
+    s_thread_region_ptr = region;
+}
+#endif
+
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_STATS
+static atomic_size_t s_mem_used;
+static atomic_size_t s_mem_peak;
+
+static void wamr_mem_stats_add(void *ptr)
+{
+    size_t size = heap_caps_get_allocated_size(ptr);
+    size_t used = atomic_fetch_add(&s_mem_used, size) + size;
+    size_t peak = atomic_load(&s_mem_peak);
+
+    while (used > peak && !atomic_compare_exchange_weak(&s_mem_peak, &peak, used)) {
+    }
+}
+
+static void wamr_mem_stats_sub(void *ptr)
+{
+    atomic_fetch_sub(&s_mem_used, heap_caps_get_allocated_size(ptr));
+}
+
+void wm_wamr_mem_get_usage(size_t *used, size_t *peak)
+{
+    if (used) {
+        *used = atomic_load(&s_mem_used);
+    }
+
+    if (peak) {
+        *peak = atomic_load(&s_mem_peak);
+    }
+}
+
+void wm_wamr_mem_reset_peak(void)
+{
+    atomic_store(&s_mem_peak, atomic_load(&s_mem_used));
+}
+#endif
+
 static void *wamr_malloc(unsigned int size)
 {
     void *ptr;
@@ -34,8 +128,22 @@ static void *wamr_malloc(unsigned int size)
 #else
     uint32_t caps = MALLOC_CAP_8BIT;
 #endif
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    wm_wamr_mem_region_t region = s_thread_region_ptr ? *s_thread_region_ptr : s_thread_region;
+
+    if (region == WM_WAMR_MEM_DRAM) {
+        caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    } else if (region == WM_WAMR_MEM_PSRAM) {
+        caps = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT;
+    }
+#endif
 
     ptr = heap_caps_aligned_alloc(MALLOC_ALIGN_SIZE, size, caps);
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_STATS
+    if (ptr) {
+        wamr_mem_stats_add(ptr);
+    }
+#endif
     ESP_LOGV(TAG, "malloc ptr=%p size=%u", ptr, size);
 
     return ptr;
@@ -45,6 +153,11 @@ static void wamr_free(void *ptr)
 {
     ESP_LOGV(TAG, "free ptr=%p", ptr);
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_STATS
+    if (ptr) {
+        wamr_mem_stats_sub(ptr);
+    }
+#endif
     heap_caps_free(ptr);
 }
 
@@ -67,6 +180,32 @@ static void *wamr_realloc(void *ptr, unsigned int size)
     return new_ptr;
 }
 
+#ifdef CONFIG_WASMACHINE_WASM_THREADS
+esp_err_t wm_wamr_set_thread_cfg(int core_id, int prio)
+{
+#ifndef CONFIG_IDF_TARGET_LINUX
+    esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+
+    if (core_id < -1 || core_id >= portNUM_PROCESSORS || prio <= 0 || prio >= configMAX_PRIORITIES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /**
+     * WAMR creates native threads by pthread_create() with its own stack size
+     * attribute, so only core and priority of the configuration take effect.
+     */
+    cfg.thread_name = "wasm_thread";
+    cfg.pin_to_core = core_id < 0 ? tskNO_AFFINITY : core_id;
+    cfg.prio = prio;
+    cfg.inherit_cfg = true;
+
+    return esp_pthread_set_cfg(&cfg);
+#else
+    return ESP_OK;
+#endif
+}
+#endif
+
 void wm_wamr_init(void)
 {
     RuntimeInitArgs init_args;
@@ -76,6 +215,9 @@ void wm_wamr_init(void)
     init_args.mem_alloc_option.allocator.malloc_func  = wamr_malloc;
     init_args.mem_alloc_option.allocator.realloc_func = wamr_realloc;
     init_args.mem_alloc_option.allocator.free_func    = wamr_free;
+#ifdef CONFIG_WASMACHINE_WASM_THREADS
+    init_args.max_thread_num = CONFIG_WASMACHINE_WASM_THREADS_MAX_NUM;
+#endif
 
     assert(wasm_runtime_full_init(&init_args));
 
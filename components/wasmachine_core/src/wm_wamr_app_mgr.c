@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -7,28 +7,57 @@
 #include "wm_wamr.h"
 
 #include "app_manager_export.h"
+#include "coap_ext.h"
 #include "module_wasm_app.h"
 #include "runtime_lib.h"
 #include "wasm_export.h"
 
-#ifdef CONFIG_WASMACHINE_TCP_SERVER
 #include <string.h>
 #include <pthread.h>
-#include <sys/socket.h>
 
 #include "esp_log.h"
 
+#ifdef CONFIG_WASMACHINE_WPROF
+#include "wm_wprof.h"
+#endif
+
+#ifdef CONFIG_WASMACHINE_TCP_SERVER
+#include <sys/socket.h>
+
 #define TCP_TX_BUFFER_SIZE      2048
 #define TCP_SERVER_LISTEN       5
 #endif
 
 #define APP_MGR_TASK_STACK_SIZE    8192
 
+#ifdef CONFIG_WASMACHINE_WPROF
+#define APP_MGR_WPROF_ATTACH_WASM  WASM_Msg_Start + 8
+#endif
+
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+#define APP_MGR_PLACEMENT_NUM      8
+#define APP_MGR_NAME_MAX_LEN       32
+
+typedef struct app_mgr_placement {
+    char name[APP_MGR_NAME_MAX_LEN];
+    wm_wamr_mem_region_t region;
+} app_mgr_placement_t;
+#endif
+
 static pthread_mutex_t app_lock = PTHREAD_MUTEX_INITIALIZER;
 
-#ifdef CONFIG_WASMACHINE_TCP_SERVER
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+/* Followed by allocations of the application manager thread */
+static volatile wm_wamr_mem_region_t s_install_region;
+static app_mgr_placement_t s_placement[APP_MGR_PLACEMENT_NUM];
+#endif
+
+#if defined(CONFIG_WASMACHINE_TCP_SERVER) || defined(CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT) || \
+    defined(CONFIG_WASMACHINE_WPROF)
 static const char *TAG = "wm_wamr_app_mgr";
+#endif
 
+#ifdef CONFIG_WASMACHINE_TCP_SERVER
 static int listenfd = -1;
 static int sockfd = -1;
 static pthread_mutex_t sock_lock = PTHREAD_MUTEX_INITIALIZER;
@@ -163,6 +192,144 @@ errout_create_sock:
 }
 #endif
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+static int app_mgr_get_url_value(const char *url, const char *key, char *value, size_t size)
+{
+    size_t key_len = strlen(key);
+    const char *p = strchr(url, '?');
+
+    while (p) {
+        p++;
+        if (!strncmp(p, key, key_len) && p[key_len] == '=') {
+            const char *s = p + key_len + 1;
+            size_t len = strcspn(s, "&");
+
+            if (len >= size) {
+                return -1;
+            }
+
+            memcpy(value, s, len);
+            value[len] = '\0';
+            return 0;
+        }
+
+        p = strchr(p, '&');
+    }
+
+    return -1;
+}
+
+static app_mgr_placement_t *app_mgr_find_placement(const char *name)
+{
+    for (int i = 0; i < APP_MGR_PLACEMENT_NUM; i++) {
+        if (s_placement[i].name[0] && !strcmp(s_placement[i].name, name)) {
+            return &s_placement[i];
+        }
+    }
+
+    return NULL;
+}
+
+/* Slots of applications which failed to install or were uninstalled remotely are free too */
+static app_mgr_placement_t *app_mgr_alloc_placement(const char *name)
+{
+    for (int i = 0; i < APP_MGR_PLACEMENT_NUM; i++) {
+        if (!s_placement[i].name[0] || !app_manager_lookup_module_data(s_placement[i].name)) {
+            strcpy(s_placement[i].name, name);
+            return &s_placement[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void app_mgr_free_placement(const char *url)
+{
+    char name[APP_MGR_NAME_MAX_LEN];
+    app_mgr_placement_t *placement;
+
+    if (strncmp(url, "/applet", 7) || app_mgr_get_url_value(url, "name", name, sizeof(name))) {
+        return;
+    }
+
+    placement = app_mgr_find_placement(name);
+    if (placement) {
+        placement->name[0] = '\0';
+        placement->region = WM_WAMR_MEM_DEFAULT;
+    }
+}
+
+static int app_mgr_begin_install(const char *url)
+{
+    char name[APP_MGR_NAME_MAX_LEN];
+    char caps[16];
+    wm_wamr_mem_region_t region = WM_WAMR_MEM_DEFAULT;
+    app_mgr_placement_t *placement;
+
+    if (app_mgr_get_url_value(url, "name", name, sizeof(name))) {
+        return 0;
+    }
+
+    if (!app_mgr_get_url_value(url, "mem_caps", caps, sizeof(caps)) &&
+            wm_wamr_mem_region_from_str(caps, &region) != ESP_OK) {
+        ESP_LOGW(TAG, "invalid mem_caps=%s of %s, use default", caps, name);
+        region = WM_WAMR_MEM_DEFAULT;
+    }
+
+    placement = app_mgr_find_placement(name);
+    if (!placement) {
+        placement = app_mgr_alloc_placement(name);
+        if (!placement) {
+            ESP_LOGE(TAG, "no free placement slot for %s, %d applications are installed",
+                     name, APP_MGR_PLACEMENT_NUM);
+            return -1;
+        }
+    }
+
+    placement->region = region;
+    s_install_region = region;
+
+    return 0;
+}
+
+void wm_wamr_app_mgr_end_install(void)
+{
+    s_install_region = WM_WAMR_MEM_DEFAULT;
+}
+
+wm_wamr_mem_region_t wm_wamr_app_mgr_get_mem_region(const char *name)
+{
+    app_mgr_placement_t *placement = app_mgr_find_placement(name);
+
+    return placement ? placement->region : WM_WAMR_MEM_DEFAULT;
+}
+#endif
+
+#ifdef CONFIG_WASMACHINE_WPROF
+/* Runs in the thread of the application, which is detached when the thread exits */
+static void app_mgr_wprof_attach_callback(module_data *m_data, bh_message_t msg)
+{
+    wasm_data *wasm_app_data = (wasm_data *)m_data->internal_data;
+
+    bh_assert(APP_MGR_WPROF_ATTACH_WASM == bh_message_type(msg));
+
+    /* Applications are loaded from sections, so there is no name section */
+    wm_wprof_attach(wasm_app_data->exec_env, NULL, 0);
+}
+
+void wm_wamr_app_mgr_wprof_attach(void)
+{
+    os_mutex_lock(&module_data_list_lock);
+    for (module_data *m_data = module_data_list; m_data; m_data = m_data->next) {
+        if (m_data->module_type == Module_WASM_App &&
+                !bh_post_msg(m_data->queue, APP_MGR_WPROF_ATTACH_WASM, NULL, 0)) {
+            ESP_LOGW(TAG, "failed to attach %s to profiler", m_data->module_name);
+        }
+    }
+    os_mutex_unlock(&module_data_list_lock);
+}
+#endif
+
 static void *_app_mgr_thread(void *p)
 {
 #ifdef CONFIG_WASMACHINE_TCP_SERVER
@@ -179,11 +346,25 @@ static void *_app_mgr_thread(void *p)
         .destroy = NULL
     };
 #endif
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    /**
+     * Applications are loaded, instantiated and get their execution environment
+     * in this thread, so all of them follow the region of the install request.
+     */
+    wm_wamr_bind_thread_mem_region(&s_install_region);
+#endif
+
     /* timer manager */
     if (!init_wasm_timer()) {
         goto fail1;
     }
 
+#ifdef CONFIG_WASMACHINE_WPROF
+    if (!wasm_register_msg_callback(APP_MGR_WPROF_ATTACH_WASM, app_mgr_wprof_attach_callback)) {
+        goto fail1;
+    }
+#endif
+
 #ifdef CONFIG_WAMR_ENABLE_LIBC_WASI
     if ( !wasm_set_wasi_root_dir(WM_FILE_SYSTEM_BASE_PATH)) {
         goto fail1;
@@ -221,6 +402,15 @@ int wm_wamr_app_send_request(request_t *request, uint16_t msg_type)
 
     extern int aee_host_msg_callback(void *msg, uint32_t msg_len);
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    if (msg_type == INSTALL_WASM_APP && request->url && app_mgr_begin_install(request->url)) {
+        return -1;
+    }
+    if (msg_type == REQUEST_PACKET && request->action == COAP_DELETE && request->url) {
+        app_mgr_free_placement(request->url);
+    }
+#endif
+
     req_p = pack_request(request, &req_size);
     if (!req_p) {
         return -1;
@@ -0,0 +1,761 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "esp_log.h"
+
+#ifdef CONFIG_IDF_TARGET_LINUX
+#include <sched.h>
+#include <signal.h>
+#include <time.h>
+#else
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_timer.h"
+#endif
+
+#include "wm_wprof.h"
+#ifdef CONFIG_WASMACHINE_APP_MGR
+#include "wm_wamr.h"
+#endif
+
+#define WPROF_TARGET_NUM        4
+#define WPROF_STACK_DEPTH       CONFIG_WASMACHINE_WPROF_STACK_DEPTH
+#define WPROF_STACK_NUM         CONFIG_WASMACHINE_WPROF_STACK_NUM
+#define WPROF_FUNC_NUM          CONFIG_WASMACHINE_WPROF_FUNC_NUM
+#define WPROF_FUNC_NAME_LEN     32
+
+#ifndef CONFIG_IDF_TARGET_LINUX
+#define WPROF_TASK_PRIORITY     (configMAX_PRIORITIES - 1)
+#define WPROF_OFF_CPU_TIMEOUT   100     /* Microseconds to wait for a suspended task to leave CPU */
+#endif
+
+#define FNV_OFFSET_BASIS        2166136261u
+#define FNV_PRIME               16777619u
+
+typedef struct wprof_target {
+    wasm_exec_env_t exec_env;
+    uint32_t module_id;
+    const uint8_t *names;               /* function names subsection of the name section, NULL if none */
+    uint32_t names_size;
+#ifdef CONFIG_IDF_TARGET_LINUX
+    pthread_t thread;
+#else
+    TaskHandle_t task;
+#endif
+} wprof_target_t;
+
+typedef struct wprof_stack {
+    uint32_t count;
+    uint32_t hash;
+    uint32_t module_id;
+    uint32_t depth;
+    uint32_t func[WPROF_STACK_DEPTH];   /* function indexes, innermost first */
+} wprof_stack_t;
+
+typedef struct wprof_func {
+    uint32_t module_id;                 /* 0 means free slot */
+    uint32_t index;
+    char name[WPROF_FUNC_NAME_LEN];
+} wprof_func_t;
+
+typedef struct wprof {
+    wprof_stack_t stack[WPROF_STACK_NUM];
+    wprof_func_t func[WPROF_FUNC_NUM];
+    WASMCApiFrame frame[WPROF_STACK_DEPTH];
+    uint32_t samples;
+    uint32_t idle;
+    uint32_t dropped;
+    uint32_t errors;
+} wprof_t;
+
+static const char *TAG = "wm_wprof";
+
+static wprof_t *s_wprof;
+static wprof_target_t s_target[WPROF_TARGET_NUM];
+static uint32_t s_module_id;
+static atomic_bool s_running;
+static pthread_key_t s_thread_key;
+static pthread_once_t s_thread_once = PTHREAD_ONCE_INIT;
+
+#ifdef CONFIG_IDF_TARGET_LINUX
+/**
+ * Samples are taken by the SIGPROF handler in the sampled thread itself, so
+ * a spinning flag is used instead of a mutex, and SIGPROF is blocked while a
+ * normal thread holds the lock to avoid deadlock with its own handler.
+ */
+static atomic_flag s_lock = ATOMIC_FLAG_INIT;
+static pthread_t s_sampler;
+static uint32_t s_period_us;
+
+static void wprof_spin_lock(void)
+{
+    while (atomic_flag_test_and_set(&s_lock)) {
+        sched_yield();
+    }
+}
+
+static void wprof_lock(sigset_t *old)
+{
+    sigset_t set;
+
+    sigemptyset(&set);
+    sigaddset(&set, SIGPROF);
+    pthread_sigmask(SIG_BLOCK, &set, old);
+    wprof_spin_lock();
+}
+
+static void wprof_unlock(sigset_t *old)
+{
+    atomic_flag_clear(&s_lock);
+    pthread_sigmask(SIG_SETMASK, old, NULL);
+}
+
+#define WPROF_LOCK_DECLARE()    sigset_t wprof_sigset
+#define WPROF_LOCK()            wprof_lock(&wprof_sigset)
+#define WPROF_UNLOCK()          wprof_unlock(&wprof_sigset)
+#else
+static pthread_mutex_t s_lock = PTHREAD_MUTEX_INITIALIZER;
+static esp_timer_handle_t s_timer;
+static TaskHandle_t s_task;
+
+#define WPROF_LOCK_DECLARE()
+#define WPROF_LOCK()            pthread_mutex_lock(&s_lock)
+#define WPROF_UNLOCK()          pthread_mutex_unlock(&s_lock)
+#endif
+
+static uint32_t wprof_hash(uint32_t module_id, const WASMCApiFrame *frame, uint32_t depth)
+{
+    uint32_t hash = (FNV_OFFSET_BASIS ^ module_id) * FNV_PRIME;
+
+    for (uint32_t i = 0; i < depth; i++) {
+        hash = (hash ^ frame[i].func_index) * FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static int wprof_find_func(uint32_t module_id, uint32_t index, bool insert)
+{
+    uint32_t slot = ((module_id * FNV_PRIME) ^ index) % WPROF_FUNC_NUM;
+
+    for (int n = 0; n < WPROF_FUNC_NUM; n++) {
+        wprof_func_t *func = &s_wprof->func[slot];
+
+        if (!func->module_id) {
+            if (!insert) {
+                return -1;
+            }
+
+            func->module_id = module_id;
+            func->index = index;
+            return slot;
+        } else if (func->module_id == module_id && func->index == index) {
+            return slot;
+        }
+
+        slot = (slot + 1) % WPROF_FUNC_NUM;
+    }
+
+    return -1;
+}
+
+static bool wprof_read_leb(const uint8_t **p, const uint8_t *end, uint32_t *val)
+{
+    uint32_t v = 0;
+
+    for (int shift = 0; shift < 35 && *p < end; shift += 7) {
+        uint8_t byte = *(*p)++;
+
+        v |= (uint32_t)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            *val = v;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Find the function names subsection of the "name" custom section, whose entries
+ * map function indexes, the same ones as frames, to names. AOT files have no such
+ * section, so their functions are shown by index.
+ */
+static const uint8_t *wprof_find_names(const uint8_t *buf, uint32_t size, uint32_t *names_size)
+{
+    uint32_t len;
+    const uint8_t *p = buf + 8;
+    const uint8_t *end = buf + size;
+
+    if (!buf || size < 8 || memcmp(buf, "\0asm", 4)) {
+        return NULL;
+    }
+
+    while (p < end) {
+        uint8_t id = *p++;
+        const uint8_t *next;
+
+        if (!wprof_read_leb(&p, end, &len) || len > end - p) {
+            return NULL;
+        }
+        next = p + len;
+
+        if (id == 0 && wprof_read_leb(&p, next, &len) && len == 4 && next - p >= 4 && !memcmp(p, "name", 4)) {
+            for (p += 4; p < next; p += len) {
+                uint8_t subsection = *p++;
+
+                if (!wprof_read_leb(&p, next, &len) || len > next - p) {
+                    return NULL;
+                } else if (subsection == 1) {
+                    *names_size = len;
+                    return p;
+                }
+            }
+            return NULL;
+        }
+
+        p = next;
+    }
+
+    return NULL;
+}
+
+/* Name recorded functions of a target, caller must hold the lock. */
+static void wprof_resolve_names(const wprof_target_t *target)
+{
+    uint32_t count;
+    uint32_t index;
+    uint32_t len;
+    const uint8_t *p = target->names;
+    const uint8_t *end = p + target->names_size;
+
+    if (!s_wprof || !p || !wprof_read_leb(&p, end, &count)) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++, p += len) {
+        int slot;
+
+        if (!wprof_read_leb(&p, end, &index) || !wprof_read_leb(&p, end, &len) || len > end - p) {
+            return;
+        }
+
+        slot = wprof_find_func(target->module_id, index, false);
+        if (slot >= 0 && !s_wprof->func[slot].name[0]) {
+            uint32_t n = len < WPROF_FUNC_NAME_LEN - 1 ? len : WPROF_FUNC_NAME_LEN - 1;
+
+            memcpy(s_wprof->func[slot].name, p, n);
+            s_wprof->func[slot].name[n] = '\0';
+        }
+    }
+}
+
+static bool wprof_stack_equal(const wprof_stack_t *stack, uint32_t module_id,
+                              const WASMCApiFrame *frame, uint32_t depth)
+{
+    if (stack->module_id != module_id || stack->depth != depth) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < depth; i++) {
+        if (stack->func[i] != frame[i].func_index) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void wprof_record(uint32_t module_id, uint32_t depth)
+{
+    const WASMCApiFrame *frame = s_wprof->frame;
+    uint32_t hash = wprof_hash(module_id, frame, depth);
+    uint32_t slot = hash % WPROF_STACK_NUM;
+
+    for (int n = 0; n < WPROF_STACK_NUM; n++) {
+        wprof_stack_t *stack = &s_wprof->stack[slot];
+
+        if (!stack->count) {
+            stack->count = 1;
+            stack->hash = hash;
+            stack->module_id = module_id;
+            stack->depth = depth;
+            for (uint32_t i = 0; i < depth; i++) {
+                stack->func[i] = frame[i].func_index;
+                wprof_find_func(module_id, frame[i].func_index, true);
+            }
+            return;
+        } else if (stack->hash == hash && wprof_stack_equal(stack, module_id, frame, depth)) {
+            stack->count++;
+            return;
+        }
+
+        slot = (slot + 1) % WPROF_STACK_NUM;
+    }
+
+    s_wprof->dropped++;
+}
+
+/* Caller must hold the lock, and the sampled thread must not be running. */
+static void wprof_sample(const wprof_target_t *target)
+{
+    char error_buf[64];
+    uint32_t depth;
+
+    error_buf[0] = '\0';
+    depth = wasm_copy_callstack(target->exec_env, s_wprof->frame, WPROF_STACK_DEPTH, 0,
+                                error_buf, sizeof(error_buf));
+
+    s_wprof->samples++;
+    if (!depth) {
+        if (error_buf[0]) {
+            s_wprof->errors++;
+        } else {
+            s_wprof->idle++;
+        }
+        return;
+    }
+
+    wprof_record(target->module_id, depth);
+}
+
+#ifdef CONFIG_IDF_TARGET_LINUX
+static void wprof_signal_handler(int sig)
+{
+    pthread_t self = pthread_self();
+
+    wprof_spin_lock();
+
+    if (atomic_load(&s_running)) {
+        for (int i = 0; i < WPROF_TARGET_NUM; i++) {
+            if (s_target[i].exec_env && pthread_equal(s_target[i].thread, self)) {
+                wprof_sample(&s_target[i]);
+                break;
+            }
+        }
+    }
+
+    atomic_flag_clear(&s_lock);
+}
+
+static void *wprof_sampler_thread(void *arg)
+{
+    struct timespec ts = {
+        .tv_sec = s_period_us / 1000000,
+        .tv_nsec = (s_period_us % 1000000) * 1000
+    };
+
+    while (atomic_load(&s_running)) {
+        nanosleep(&ts, NULL);
+
+        WPROF_LOCK_DECLARE();
+        WPROF_LOCK();
+        for (int i = 0; i < WPROF_TARGET_NUM; i++) {
+            if (s_target[i].exec_env) {
+                pthread_kill(s_target[i].thread, SIGPROF);
+            }
+        }
+        WPROF_UNLOCK();
+    }
+
+    return NULL;
+}
+
+static esp_err_t wprof_timer_start(uint32_t period_us)
+{
+    struct sigaction sa;
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = wprof_signal_handler;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGPROF, &sa, NULL) != 0) {
+        return ESP_FAIL;
+    }
+
+    s_period_us = period_us;
+    if (pthread_create(&s_sampler, NULL, wprof_sampler_thread, NULL) != 0) {
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+static void wprof_timer_stop(void)
+{
+    pthread_join(s_sampler, NULL);
+}
+#else
+/* Only tasks which are ready or running are sampled, blocked tasks consume no CPU. */
+static bool wprof_task_is_runnable(TaskHandle_t task)
+{
+    eTaskState state = eTaskGetState(task);
+
+    return state == eRunning || state == eReady;
+}
+
+/* vTaskSuspend only requests a yield if the task is running on the other core */
+static bool wprof_wait_task_off_cpu(TaskHandle_t task)
+{
+    int64_t deadline = esp_timer_get_time() + WPROF_OFF_CPU_TIMEOUT;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        while (xTaskGetCurrentTaskHandleForCore(core) == task) {
+            if (esp_timer_get_time() > deadline) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Samples are taken by a task of the highest priority, the esp_timer callback
+ * only notifies it, so a sampled task which doesn't leave CPU in time only
+ * costs one dropped sample instead of stalling all esp_timer callbacks.
+ */
+static void wprof_task(void *arg)
+{
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        pthread_mutex_lock(&s_lock);
+
+        for (int i = 0; i < WPROF_TARGET_NUM && atomic_load(&s_running); i++) {
+            wprof_target_t *target = &s_target[i];
+
+            if (!target->exec_env) {
+                continue;
+            }
+
+            if (!wprof_task_is_runnable(target->task)) {
+                s_wprof->samples++;
+                s_wprof->idle++;
+                continue;
+            }
+
+            vTaskSuspend(target->task);
+            if (wprof_wait_task_off_cpu(target->task)) {
+                wprof_sample(target);
+            } else {
+                s_wprof->samples++;
+                s_wprof->dropped++;
+            }
+            vTaskResume(target->task);
+        }
+
+        pthread_mutex_unlock(&s_lock);
+    }
+}
+
+static void wprof_timer_cb(void *arg)
+{
+    xTaskNotifyGive(s_task);
+}
+
+static esp_err_t wprof_timer_start(uint32_t period_us)
+{
+    esp_err_t ret;
+
+    if (!s_task) {
+        if (xTaskCreate(wprof_task, "wprof", CONFIG_WASMACHINE_WPROF_TASK_STACK_SIZE, NULL,
+                        WPROF_TASK_PRIORITY, &s_task) != pdPASS) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    if (!s_timer) {
+        const esp_timer_create_args_t args = {
+            .callback = wprof_timer_cb,
+            .name = "wprof",
+            .skip_unhandled_events = true
+        };
+
+        ret = esp_timer_create(&args, &s_timer);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    return esp_timer_start_periodic(s_timer, period_us);
+}
+
+static void wprof_timer_stop(void)
+{
+    esp_timer_stop(s_timer);
+}
+#endif
+
+static void wprof_thread_exit(void *exec_env)
+{
+    wm_wprof_detach(exec_env);
+}
+
+static void wprof_thread_key_init(void)
+{
+    if (pthread_key_create(&s_thread_key, wprof_thread_exit)) {
+        ESP_LOGE(TAG, "failed to create thread key");
+    }
+}
+
+esp_err_t wm_wprof_attach(wasm_exec_env_t exec_env, const uint8_t *wasm, uint32_t size)
+{
+    esp_err_t ret = ESP_ERR_NO_MEM;
+    wprof_target_t *target = NULL;
+    WPROF_LOCK_DECLARE();
+
+    pthread_once(&s_thread_once, wprof_thread_key_init);
+
+    WPROF_LOCK();
+    for (int i = 0; i < WPROF_TARGET_NUM; i++) {
+        if (s_target[i].exec_env == exec_env) {
+            WPROF_UNLOCK();
+            return ESP_OK;
+        } else if (!s_target[i].exec_env && !target) {
+            target = &s_target[i];
+        }
+    }
+
+    if (target) {
+        target->module_id = ++s_module_id;
+        target->names = wprof_find_names(wasm, size, &target->names_size);
+#ifdef CONFIG_IDF_TARGET_LINUX
+        target->thread = pthread_self();
+#else
+        target->task = xTaskGetCurrentTaskHandle();
+#endif
+        target->exec_env = exec_env;
+        ret = ESP_OK;
+    }
+    WPROF_UNLOCK();
+
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "only %d execution environments can be attached", WPROF_TARGET_NUM);
+        return ret;
+    }
+
+    /* Sampling a thread which has exited would touch a deleted task */
+    pthread_setspecific(s_thread_key, exec_env);
+
+    return ESP_OK;
+}
+
+void wm_wprof_detach(wasm_exec_env_t exec_env)
+{
+    WPROF_LOCK_DECLARE();
+
+    pthread_once(&s_thread_once, wprof_thread_key_init);
+    if (pthread_getspecific(s_thread_key) == exec_env) {
+        pthread_setspecific(s_thread_key, NULL);
+    }
+
+    WPROF_LOCK();
+    for (int i = 0; i < WPROF_TARGET_NUM; i++) {
+        if (s_target[i].exec_env == exec_env) {
+            /* The name section may be freed along with the module */
+            wprof_resolve_names(&s_target[i]);
+            s_target[i].exec_env = NULL;
+            break;
+        }
+    }
+    WPROF_UNLOCK();
+}
+
+esp_err_t wm_wprof_start(uint32_t period_us)
+{
+    esp_err_t ret;
+    WPROF_LOCK_DECLARE();
+
+    if (!period_us) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (atomic_load(&s_running)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    WPROF_LOCK();
+    if (!s_wprof) {
+        s_wprof = calloc(1, sizeof(wprof_t));
+    } else {
+        memset(s_wprof, 0, sizeof(wprof_t));
+    }
+    WPROF_UNLOCK();
+
+    if (!s_wprof) {
+        ESP_LOGE(TAG, "failed to malloc %u bytes", (unsigned int)sizeof(wprof_t));
+        return ESP_ERR_NO_MEM;
+    }
+
+    atomic_store(&s_running, true);
+
+    ret = wprof_timer_start(period_us);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "failed to start sampling timer ret=%d", ret);
+        atomic_store(&s_running, false);
+        return ret;
+    }
+
+#ifdef CONFIG_WASMACHINE_APP_MGR
+    wm_wamr_app_mgr_wprof_attach();
+#endif
+
+    return ESP_OK;
+}
+
+esp_err_t wm_wprof_stop(void)
+{
+    WPROF_LOCK_DECLARE();
+
+    if (!atomic_load(&s_running)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    atomic_store(&s_running, false);
+    wprof_timer_stop();
+
+    /* Wait for the sample in progress, and name functions of attached targets */
+    WPROF_LOCK();
+    for (int i = 0; i < WPROF_TARGET_NUM; i++) {
+        if (s_target[i].exec_env) {
+            wprof_resolve_names(&s_target[i]);
+        }
+    }
+    WPROF_UNLOCK();
+
+    return ESP_OK;
+}
+
+bool wm_wprof_is_running(void)
+{
+    return atomic_load(&s_running);
+}
+
+static const char *wprof_func_name(uint32_t module_id, uint32_t index, char *buf, size_t size)
+{
+    int slot = wprof_find_func(module_id, index, false);
+
+    if (slot >= 0 && s_wprof->func[slot].name[0]) {
+        return s_wprof->func[slot].name;
+    }
+
+    snprintf(buf, size, "func[%" PRIu32 "]", index);
+    return buf;
+}
+
+static void wprof_dump_folded(FILE *stream)
+{
+    char buf[24];
+
+    for (int i = 0; i < WPROF_STACK_NUM; i++) {
+        const wprof_stack_t *stack = &s_wprof->stack[i];
+
+        if (!stack->count) {
+            continue;
+        }
+
+        for (int j = stack->depth - 1; j >= 0; j--) {
+            fprintf(stream, "%s%s", wprof_func_name(stack->module_id, stack->func[j], buf, sizeof(buf)),
+                    j ? ";" : "");
+        }
+        fprintf(stream, " %" PRIu32 "\n", stack->count);
+    }
+}
+
+static esp_err_t wprof_dump_flat(FILE *stream)
+{
+    uint32_t *self;
+    uint32_t *total;
+    char buf[24];
+    uint32_t sampled = s_wprof->samples - s_wprof->idle - s_wprof->errors;
+
+    self = calloc(2 * WPROF_FUNC_NUM, sizeof(uint32_t));
+    if (!self) {
+        return ESP_ERR_NO_MEM;
+    }
+    total = self + WPROF_FUNC_NUM;
+
+    for (int i = 0; i < WPROF_STACK_NUM; i++) {
+        const wprof_stack_t *stack = &s_wprof->stack[i];
+
+        for (uint32_t j = 0; j < stack->depth && stack->count; j++) {
+            int slot = wprof_find_func(stack->module_id, stack->func[j], false);
+            bool counted = false;
+
+            if (slot < 0) {
+                continue;
+            }
+
+            if (j == 0) {
+                self[slot] += stack->count;
+            }
+
+            /* Recursive calls count only once toward total */
+            for (uint32_t k = 0; k < j; k++) {
+                if (stack->func[k] == stack->func[j]) {
+                    counted = true;
+                    break;
+                }
+            }
+
+            if (!counted) {
+                total[slot] += stack->count;
+            }
+        }
+    }
+
+    fprintf(stream, "samples: %" PRIu32 ", idle: %" PRIu32 ", dropped: %" PRIu32 ", errors: %" PRIu32 "\n",
+            s_wprof->samples, s_wprof->idle, s_wprof->dropped, s_wprof->errors);
+    fprintf(stream, "%10s %7s %10s %7s  %s\n", "self", "self%", "total", "total%", "function");
+
+    /* Print in descending order of self samples */
+    for (;;) {
+        int max = -1;
+
+        for (int i = 0; i < WPROF_FUNC_NUM; i++) {
+            if (s_wprof->func[i].module_id && total[i] &&
+                    (max < 0 || self[i] > self[max] || (self[i] == self[max] && total[i] > total[max]))) {
+                max = i;
+            }
+        }
+
+        if (max < 0) {
+            break;
+        }
+
+        fprintf(stream, "%10" PRIu32 " %6.2f%% %10" PRIu32 " %6.2f%%  %s\n",
+                self[max], sampled ? 100.0 * self[max] / sampled : 0.0,
+                total[max], sampled ? 100.0 * total[max] / sampled : 0.0,
+                wprof_func_name(s_wprof->func[max].module_id, s_wprof->func[max].index, buf, sizeof(buf)));
+        total[max] = 0;
+    }
+
+    free(self);
+
+    return ESP_OK;
+}
+
+esp_err_t wm_wprof_dump(FILE *stream, bool folded)
+{
+    if (atomic_load(&s_running) || !s_wprof) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (folded) {
+        wprof_dump_folded(stream);
+        return ESP_OK;
+    }
+
+    return wprof_dump_flat(stream);
+}
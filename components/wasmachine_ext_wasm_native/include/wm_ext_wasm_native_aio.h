@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WM_EXT_WASM_NATIVE_AIO_MAX_ENTRIES  256     /*!< Max number of entries of a ring */
+#define WM_EXT_WASM_NATIVE_AIO_MAX_RINGS    2       /*!< Max number of rings of a module instance */
+
+/**
+ * @brief Asynchronous I/O operations.
+ */
+typedef enum wm_ext_wasm_native_aio_op {
+    WM_EXT_WASM_NATIVE_AIO_OP_NOP = 0,      /*!< Do nothing, complete with 0 */
+    WM_EXT_WASM_NATIVE_AIO_OP_READ,         /*!< read or pread */
+    WM_EXT_WASM_NATIVE_AIO_OP_WRITE,        /*!< write or pwrite */
+    WM_EXT_WASM_NATIVE_AIO_OP_FSYNC,        /*!< fsync */
+    WM_EXT_WASM_NATIVE_AIO_OP_IOCTL,        /*!< ioctl */
+    WM_EXT_WASM_NATIVE_AIO_OP_MAX
+} wm_ext_wasm_native_aio_op_t;
+
+/**
+ * @brief Submission queue entry, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_native_aio_sqe {
+    uint8_t opcode;             /*!< Operation, @ref wm_ext_wasm_native_aio_op_t */
+    uint8_t flags;              /*!< Reserved, must be 0 */
+    uint16_t reserved;          /*!< Reserved, must be 0 */
+    int32_t fd;                 /*!< File descriptor */
+    uint32_t addr;              /*!< Application address of buffer, or argument block of ioctl */
+    uint32_t len;               /*!< Length of buffer, or command of ioctl, read and write longer than the bounce buffer complete with a short count */
+    int64_t offset;             /*!< File offset, -1 to use and update current file position */
+    uint64_t user_data;         /*!< Copied to completion queue entry */
+} wm_ext_wasm_native_aio_sqe_t;
+
+/**
+ * @brief Completion queue entry, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_native_aio_cqe {
+    uint64_t user_data;         /*!< user_data of submission queue entry */
+    int32_t res;                /*!< Result of operation, or negative errno if failed */
+    uint32_t flags;             /*!< Reserved */
+} wm_ext_wasm_native_aio_cqe_t;
+
+/**
+ * @brief Ring header in application memory, layout is shared with wasm32 applications.
+ *
+ * Applications fill entries at sq_tail and consume entries at cq_head. Native code takes
+ * entries at sq_head and fills entries at cq_tail in wm_ext_wasm_native_aio_submit() and
+ * wm_ext_wasm_native_aio_wait() only, which run in the application thread, so the worker
+ * task never accesses application memory which may move when it grows. Indexes are free
+ * running and wrap by entries which must be a power of 2.
+ */
+typedef struct wm_ext_wasm_native_aio_ring {
+    uint32_t sq_head;           /*!< Next submission queue entry to take, written by native */
+    uint32_t sq_tail;           /*!< Next submission queue entry to fill, written by application */
+    uint32_t cq_head;           /*!< Next completion queue entry to consume, written by application */
+    uint32_t cq_tail;           /*!< Next completion queue entry to fill, written by native */
+    uint32_t entries;           /*!< Number of entries of each queue */
+    uint32_t sqes;              /*!< Application address of submission queue entry array */
+    uint32_t cqes;              /*!< Application address of completion queue entry array */
+    uint32_t reserved;          /*!< Reserved, must be 0 */
+} wm_ext_wasm_native_aio_ring_t;
+
+/**
+ * @brief Operations to access application memory and devices, they're called in the
+ *        application thread only.
+ */
+typedef struct wm_ext_wasm_native_aio_ops {
+
+    /*!< Transform application address range to native pointer, return NULL if it's invalid */
+    void *(*map)(void *arg, uint32_t addr, uint32_t size);
+
+    /*!< Run ioctl with argument block, optional */
+    int (*ioctl)(void *arg, int fd, int cmd, void *va_args);
+
+    /*!< Transform native errno to application errno, optional */
+    int (*map_errno)(void *arg, int error);
+} wm_ext_wasm_native_aio_ops_t;
+
+typedef struct wm_ext_wasm_native_aio wm_ext_wasm_native_aio_t;
+
+/**
+  * @brief  Validate ring header and start a worker task to run its submission queue entries.
+  *
+  * @param  ring application address of ring header
+  * @param  ops operations to access application memory
+  * @param  arg argument of operations
+  * @param  aio returned asynchronous I/O handle
+  *
+  * @return ESP_OK if success, ESP_ERR_INVALID_ARG if ring is invalid, or ESP_ERR_NO_MEM if failed.
+  */
+esp_err_t wm_ext_wasm_native_aio_create(uint32_t ring, const wm_ext_wasm_native_aio_ops_t *ops,
+                                        void *arg, wm_ext_wasm_native_aio_t **aio);
+
+/**
+  * @brief  Take submitted entries into native bounce buffers for worker task, and post
+  *         completed entries while there is room in completion queue. ioctl entries run
+  *         in the calling thread in order.
+  *
+  * @param  aio asynchronous I/O handle
+  *
+  * @return 0 if success, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_native_aio_submit(wm_ext_wasm_native_aio_t *aio);
+
+/**
+  * @brief  Wait until there are at least min_complete unconsumed completion queue entries,
+  *         entries are submitted and posted as wm_ext_wasm_native_aio_submit() does.
+  *
+  * @param  aio asynchronous I/O handle
+  * @param  min_complete number of entries to wait for, 0 to return immediately
+  * @param  timeout_ms max time to wait, negative value to wait forever
+  *
+  * @return Number of unconsumed completion queue entries, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_native_aio_wait(wm_ext_wasm_native_aio_t *aio, uint32_t min_complete, int32_t timeout_ms);
+
+/**
+  * @brief  Stop worker task and free asynchronous I/O handle, entries which are not started
+  *         yet are dropped. It doesn't wait for the running entry, which may block forever,
+  *         the worker task frees the handle when the entry returns.
+  *
+  * @param  aio asynchronous I/O handle
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_aio_destroy(wm_ext_wasm_native_aio_t *aio);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,13 +1,25 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #pragma once
 
+#include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "sdkconfig.h"
+#include "esp_err.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_memory_utils.h"
+#endif
 #include "data_seq.h"
 #include "wasm_export.h"
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_AIO
+#include "wm_ext_wasm_native_aio.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,6 +28,72 @@ extern "C" {
 #define WASM_INTSIZEOF(n)       (((uint32_t)sizeof(n) + 3) & (uint32_t)~3)
 #define WASM_VA_ARG(ap, t)      (*(t *)((ap += WASM_INTSIZEOF(t)) - WASM_INTSIZEOF(t)))
 
+#define WM_EXT_WASM_NATIVE_MMAP_MAX_FILES   4   /*!< Max number of read-only file mappings of a module instance */
+
+/**
+ * @brief WASM functions exported by applications and called by native code.
+ */
+typedef enum wm_ext_wasm_native_func {
+    WM_EXT_WASM_NATIVE_FUNC_SET_ERRNO = 0,      /*!< libc_builtin_set_errno */
+    WM_EXT_WASM_NATIVE_FUNC_MQTT_DISPATCH,      /*!< on_mqtt_dispatch_event */
+    WM_EXT_WASM_NATIVE_FUNC_HRTIMER_DISPATCH,   /*!< on_hrtimer_dispatch */
+    WM_EXT_WASM_NATIVE_FUNC_GPIO_DISPATCH,      /*!< on_gpio_events */
+    WM_EXT_WASM_NATIVE_FUNC_MAX
+} wm_ext_wasm_native_func_t;
+
+/**
+ * @brief Pooled execution environment for callbacks from native tasks.
+ */
+typedef struct wm_ext_wasm_native_exec_env {
+    wasm_exec_env_t exec_env;   /*!< Execution environment, NULL if the slot is free */
+    void *owner;                /*!< Task which uses the execution environment */
+    uint32_t stack_size;        /*!< WASM stack size of the execution environment */
+    bool busy;                  /*!< Execution environment is running a callback */
+} wm_ext_wasm_native_exec_env_t;
+
+/**
+ * @brief Linear memory of the module instance which calls a native, it lives on the stack
+ *        of the native call and is resolved when an application address is mapped for the
+ *        first time, so later mappings of the same call are a bound check and an add.
+ */
+typedef struct wm_ext_wasm_native_mem {
+    wasm_exec_env_t exec_env;   /*!< Execution environment of the native call */
+    uint8_t *base;              /*!< Native address of linear memory, NULL if not resolved yet */
+    uint64_t size;              /*!< Size of linear memory in bytes */
+} wm_ext_wasm_native_mem_t;
+
+#define WM_EXT_WASM_NATIVE_MEM_INIT(_exec_env)  { .exec_env = (_exec_env), .base = NULL, .size = 0 }
+
+/**
+ * @brief Native context of a module instance, it is created when native code
+ *        uses it for the first time and freed when the module instance is
+ *        deinstantiated.
+ */
+typedef struct wm_ext_wasm_native_ctx {
+    wasm_function_inst_t func[WM_EXT_WASM_NATIVE_FUNC_MAX];    /*!< Resolved functions, NULL if not exported */
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_EXEC_ENV_POOL_SIZE > 0
+    pthread_mutex_t lock;                                       /*!< Lock of the execution environment pool */
+    uint32_t exec_env_next;                                     /*!< Next slot to evict when the pool is full */
+    wm_ext_wasm_native_exec_env_t exec_env[CONFIG_WASMACHINE_WASM_EXT_NATIVE_EXEC_ENV_POOL_SIZE];
+#endif
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_AIO
+    void *aio[WM_EXT_WASM_NATIVE_AIO_MAX_RINGS];                /*!< Asynchronous I/O rings, NULL if the slot is free */
+#endif
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP
+    void *mmap[WM_EXT_WASM_NATIVE_MMAP_MAX_FILES];              /*!< Read-only file mappings, NULL if the slot is free */
+#endif
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_CRYPTO
+    void *crypto[CONFIG_WASMACHINE_WASM_EXT_NATIVE_CRYPTO_MAX_CTX];  /*!< Streaming crypto operations, NULL if the slot is free */
+#endif
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_COMPRESS
+    void *compress[CONFIG_WASMACHINE_WASM_EXT_NATIVE_COMPRESS_MAX_CTX]; /*!< Compression streams, NULL if the slot is free */
+#endif
+#if defined(CONFIG_WASMACHINE_EXT_VFS) && (defined(CONFIG_EXTENDED_VFS_I2C) || defined(CONFIG_EXTENDED_VFS_SPI))
+    pthread_mutex_t vfs_xfer_lock;                              /*!< Lock of prepared bus transfer slots */
+    void *vfs_xfer[CONFIG_WASMACHINE_EXT_VFS_PREPARED_XFERS];  /*!< Prepared bus transfers, NULL if the slot is free */
+#endif
+} wm_ext_wasm_native_ctx_t;
+
 /**
   * @brief  Check data sequence space and transform pointer address from WASM to runtime.
   *
@@ -36,6 +114,252 @@ int wm_ext_data_seq_addr_wasm2c(wasm_exec_env_t exec_env, data_seq_t *ds);
   */
 data_seq_t *wm_ext_wasm_native_get_data_seq(wasm_exec_env_t exec_env, char *va_args);
 
+/**
+  * @brief  Initialize native context of module instances, it must be called after WAMR is initialized.
+  *
+  * @return ESP_OK if success or ESP_ERR_NO_MEM if failed.
+  */
+esp_err_t wm_ext_wasm_native_ctx_init(void);
+
+/**
+  * @brief  Get native context of a module instance, create it and resolve all functions if it doesn't exist.
+  *
+  * @param  module_inst WAMR module instance pointer
+  *
+  * @return Native context pointer if success or NULL if failed.
+  */
+wm_ext_wasm_native_ctx_t *wm_ext_wasm_native_get_ctx(wasm_module_inst_t module_inst);
+
+/**
+  * @brief  Get a function exported by a module instance from its native context.
+  *
+  * @param  module_inst WAMR module instance pointer
+  * @param  func function to get
+  *
+  * @return Function instance pointer if success or NULL if the function isn't exported.
+  */
+wasm_function_inst_t wm_ext_wasm_native_get_func(wasm_module_inst_t module_inst, wm_ext_wasm_native_func_t func);
+
+/**
+  * @brief  Get an execution environment to run WASM callbacks in the calling task, it is reused from
+  *         the pool of the module instance if possible, and must be given back by
+  *         wm_ext_wasm_native_put_exec_env after the callback returns.
+  *
+  * @param  module_inst WAMR module instance pointer
+  * @param  stack_size minimum WASM stack size
+  *
+  * @return Execution environment pointer if success or NULL if failed.
+  */
+wasm_exec_env_t wm_ext_wasm_native_get_exec_env(wasm_module_inst_t module_inst, uint32_t stack_size);
+
+/**
+  * @brief  Give back an execution environment got by wm_ext_wasm_native_get_exec_env.
+  *
+  * @param  module_inst WAMR module instance pointer
+  * @param  exec_env execution environment pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_put_exec_env(wasm_module_inst_t module_inst, wasm_exec_env_t exec_env);
+
+/**
+  * @brief  Resolve base address and size of linear memory, use wm_ext_wasm_native_map_ptr instead.
+  *
+  * @param  mem linear memory of the native call
+  *
+  * @return true if success or false if the module instance has no linear memory.
+  */
+bool wm_ext_wasm_native_mem_resolve(wm_ext_wasm_native_mem_t *mem);
+
+/**
+  * @brief  Check if a pointer passed by WASM application is already a native pointer, like LVGL
+  *         objects, native strings and constant data, the memory map is selected at compile time.
+  *
+  * @param  ptr pointer passed by WASM application
+  *
+  * @return true if it is a native pointer or false if it is an application address.
+  */
+static inline bool wm_ext_wasm_native_ptr_is_native(const void *ptr)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    (void)ptr;
+    return false;
+#else
+    if (esp_ptr_in_dram(ptr) || esp_ptr_in_drom(ptr)) {
+        return true;
+    }
+#if CONFIG_IDF_TARGET_ESP32P4
+    return ((intptr_t)ptr >= SOC_EXTRAM_LOW) && ((intptr_t)ptr < SOC_EXTRAM_HIGH);
+#elif CONFIG_SPIRAM
+    return esp_ptr_external_ram(ptr);
+#else
+    return false;
+#endif
+#endif
+}
+
+/**
+  * @brief  Transform a pointer passed by WASM application to native pointer, native pointers
+  *         are returned as they are, and the mapping is valid until the application runs again.
+  *
+  * @param  mem linear memory of the native call
+  * @param  app_addr pointer passed by WASM application
+  *
+  * @return Native pointer if success or NULL if app_addr is NULL or out of linear memory.
+  */
+static inline void *wm_ext_wasm_native_map_ptr(wm_ext_wasm_native_mem_t *mem, const void *app_addr)
+{
+    uintptr_t offset = (uintptr_t)app_addr;
+
+    if (!app_addr || wm_ext_wasm_native_ptr_is_native(app_addr)) {
+        return (void *)app_addr;
+    }
+
+    if (!mem->base && !wm_ext_wasm_native_mem_resolve(mem)) {
+        return NULL;
+    }
+
+    return offset < mem->size ? mem->base + offset : NULL;
+}
+
+/**
+  * @brief  Transform a buffer address passed by WASM application to native pointer, the
+  *         address is always an offset in linear memory and the whole buffer must be in it,
+  *         so unlike wm_ext_wasm_native_map_ptr native pointers are never accepted.
+  *
+  * @param  mem linear memory of the native call
+  * @param  app_addr buffer address passed by WASM application
+  * @param  size buffer size in bytes
+  *
+  * @return Native pointer if success or NULL if the buffer is out of linear memory.
+  */
+static inline void *wm_ext_wasm_native_map_range(wm_ext_wasm_native_mem_t *mem, uint32_t app_addr, uint32_t size)
+{
+    if (!mem->base && !wm_ext_wasm_native_mem_resolve(mem)) {
+        return NULL;
+    }
+
+    return (uint64_t)app_addr + size <= mem->size ? mem->base + app_addr : NULL;
+}
+
+/**
+  * @brief  Transform a string passed by WASM application to native string, and check that the
+  *         string is terminated inside linear memory in the same pass.
+  *
+  * @param  mem linear memory of the native call
+  * @param  str string passed by WASM application
+  *
+  * @return Native string if success or NULL if str is NULL, out of linear memory or not terminated.
+  */
+static inline char *wm_ext_wasm_native_map_string(wm_ext_wasm_native_mem_t *mem, const char *str)
+{
+    uintptr_t offset = (uintptr_t)str;
+
+    if (!str || wm_ext_wasm_native_ptr_is_native(str)) {
+        return (char *)str;
+    }
+
+    if (!mem->base && !wm_ext_wasm_native_mem_resolve(mem)) {
+        return NULL;
+    }
+
+    if (offset >= mem->size || !memchr(mem->base + offset, '\0', mem->size - offset)) {
+        return NULL;
+    }
+
+    return (char *)mem->base + offset;
+}
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_LIBC
+/**
+  * @brief  Set errno of WASM application.
+  *
+  * @param  exec_env WAMR execution envirenment pointer
+  * @param  c_errno native errno
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_set_errno(wasm_exec_env_t exec_env, int c_errno);
+
+/**
+  * @brief  Transform native errno to WASI errno.
+  *
+  * @param  error native errno
+  *
+  * @return WASI errno.
+  */
+uint32_t wm_ext_wasm_native_errno_c2wasm(int error);
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS
+/**
+  * @brief  Run extended VFS ioctl command of WASM application without setting its errno.
+  *
+  * @param  exec_env WAMR execution envirenment pointer
+  * @param  fd file descriptor
+  * @param  cmd ioctl command
+  * @param  va_args arguments list pointer
+  *
+  * @return 0 or positive value if success, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_native_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args);
+#endif
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_AIO
+/**
+  * @brief  Stop and free all asynchronous I/O rings of a native context.
+  *
+  * @param  ctx native context pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_aio_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP
+/**
+  * @brief  Close all read-only file mappings of a native context.
+  *
+  * @param  ctx native context pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_mmap_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_CRYPTO
+/**
+  * @brief  Free all streaming crypto operations of a native context.
+  *
+  * @param  ctx native context pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_crypto_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_COMPRESS
+/**
+  * @brief  Free all compression streams of a native context.
+  *
+  * @param  ctx native context pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_compress_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx);
+#endif
+
+#if defined(CONFIG_WASMACHINE_WASM_EXT_NATIVE_TIMER) && defined(CONFIG_WASMACHINE_APP_MGR)
+/**
+  * @brief  Stop and delete all high-resolution timers of a native context.
+  *
+  * @param  ctx native context pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_timer_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
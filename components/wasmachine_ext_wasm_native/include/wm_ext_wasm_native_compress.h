@@ -0,0 +1,90 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Compression formats, values are shared with wasm32 applications.
+ */
+typedef enum wm_ext_wasm_native_compress_format {
+    WM_EXT_WASM_NATIVE_COMPRESS_ZLIB = 0,       /*!< Deflate with zlib header, window bits are 9 to 15 */
+    WM_EXT_WASM_NATIVE_COMPRESS_DEFLATE,        /*!< Raw deflate, window bits are 9 to 15 */
+    WM_EXT_WASM_NATIVE_COMPRESS_GZIP,           /*!< Deflate with gzip header, window bits are 9 to 15 */
+    WM_EXT_WASM_NATIVE_COMPRESS_LZ4,            /*!< LZ4 frame, window bits are 10 to 16 */
+    WM_EXT_WASM_NATIVE_COMPRESS_MAX
+} wm_ext_wasm_native_compress_format_t;
+
+/**
+ * @brief Streaming compressor or decompressor.
+ */
+typedef struct wm_ext_wasm_native_compress wm_ext_wasm_native_compress_t;
+
+/**
+  * @brief  Create a streaming compressor or decompressor.
+  *
+  * Memory is bound by the window, a deflate compressor takes about
+  * 6 << window_bits bytes and a decompressor 1 << window_bits bytes plus 7 KiB, an LZ4
+  * compressor takes about 3 << window_bits bytes and a decompressor 1 << window_bits bytes.
+  * A decompressor fails on data compressed with a larger window.
+  *
+  * @param  format compression format
+  * @param  compress true to compress, false to decompress
+  * @param  level deflate compression level from 0 to 9, or -1 for the default, LZ4 ignores it
+  * @param  window_bits log2 of window size
+  * @param  stream stream pointer
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_compress_create(wm_ext_wasm_native_compress_format_t format, bool compress,
+                                             int level, uint32_t window_bits,
+                                             wm_ext_wasm_native_compress_t **stream);
+
+/**
+  * @brief  Run a stream on input until input is consumed or output is full, call it again
+  *         with the rest of input or more output space.
+  *
+  * @param  stream stream
+  * @param  in input data
+  * @param  in_len available input bytes as input, and consumed bytes as output
+  * @param  out output buffer
+  * @param  out_len output buffer length as input, and produced bytes as output
+  * @param  finish no more input follows, a compressor flushes and ends its stream, a
+  *                decompressor ignores it
+  * @param  end stream is complete and all its data is output
+  *
+  * @return
+  *     - ESP_OK if success
+  *     - ESP_ERR_INVALID_RESPONSE if input of a decompressor is not valid
+  *     - ESP_ERR_NOT_SUPPORTED if LZ4 input needs a larger window or deflate input needs a
+  *       preset dictionary
+  *     - other value if failed
+  */
+esp_err_t wm_ext_wasm_native_compress_update(wm_ext_wasm_native_compress_t *stream,
+                                             const uint8_t *in, uint32_t *in_len,
+                                             uint8_t *out, uint32_t *out_len,
+                                             bool finish, bool *end);
+
+/**
+  * @brief  Free a stream.
+  *
+  * @param  stream stream
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_compress_destroy(wm_ext_wasm_native_compress_t *stream);
+
+#ifdef __cplusplus
+}
+#endif
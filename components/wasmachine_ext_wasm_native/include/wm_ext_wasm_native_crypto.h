@@ -0,0 +1,154 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WM_EXT_WASM_NATIVE_CRYPTO_AES_BLOCK_SIZE    16  /*!< AES block size, and size of AES-CTR nonce counter */
+#define WM_EXT_WASM_NATIVE_CRYPTO_GCM_TAG_MAX       16  /*!< Max size of AES-GCM authentication tag */
+#define WM_EXT_WASM_NATIVE_CRYPTO_DIGEST_MAX        64  /*!< Max size of digest */
+
+/**
+ * @brief Hash algorithms, values are shared with wasm32 applications.
+ */
+typedef enum wm_ext_wasm_native_crypto_hash {
+    WM_EXT_WASM_NATIVE_CRYPTO_HASH_SHA256 = 0,  /*!< SHA-256, 32 bytes digest */
+    WM_EXT_WASM_NATIVE_CRYPTO_HASH_SHA512,      /*!< SHA-512, 64 bytes digest */
+    WM_EXT_WASM_NATIVE_CRYPTO_HASH_MAX
+} wm_ext_wasm_native_crypto_hash_t;
+
+/**
+ * @brief Elliptic curves of ECDSA, values are shared with wasm32 applications.
+ */
+typedef enum wm_ext_wasm_native_crypto_curve {
+    WM_EXT_WASM_NATIVE_CRYPTO_CURVE_P256 = 0,   /*!< NIST P-256 */
+    WM_EXT_WASM_NATIVE_CRYPTO_CURVE_P384,       /*!< NIST P-384 */
+    WM_EXT_WASM_NATIVE_CRYPTO_CURVE_MAX
+} wm_ext_wasm_native_crypto_curve_t;
+
+/**
+ * @brief Streaming hash, HMAC or cipher operation.
+ */
+typedef struct wm_ext_wasm_native_crypto wm_ext_wasm_native_crypto_t;
+
+/**
+  * @brief  Start a hash or HMAC operation.
+  *
+  * @param  alg hash algorithm
+  * @param  key HMAC key, NULL to calculate a plain hash
+  * @param  key_len HMAC key length
+  * @param  crypto operation pointer
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_crypto_hash_start(wm_ext_wasm_native_crypto_hash_t alg, const uint8_t *key,
+                                               uint32_t key_len, wm_ext_wasm_native_crypto_t **crypto);
+
+/**
+  * @brief  Start an AES-CTR operation, encryption and decryption are the same.
+  *
+  * @param  key AES key
+  * @param  key_len AES key length, 16, 24 or 32
+  * @param  iv WM_EXT_WASM_NATIVE_CRYPTO_AES_BLOCK_SIZE bytes initial counter block
+  * @param  crypto operation pointer
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_crypto_aes_ctr_start(const uint8_t *key, uint32_t key_len, const uint8_t *iv,
+                                                  wm_ext_wasm_native_crypto_t **crypto);
+
+/**
+  * @brief  Start an AES-GCM operation.
+  *
+  * @param  key AES key
+  * @param  key_len AES key length, 16, 24 or 32
+  * @param  iv initialization vector
+  * @param  iv_len initialization vector length, 12 is recommended
+  * @param  aad additional authenticated data, it can be NULL if aad_len is 0
+  * @param  aad_len additional authenticated data length
+  * @param  decrypt true to decrypt, false to encrypt
+  * @param  crypto operation pointer
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_crypto_aes_gcm_start(const uint8_t *key, uint32_t key_len,
+                                                  const uint8_t *iv, uint32_t iv_len,
+                                                  const uint8_t *aad, uint32_t aad_len,
+                                                  bool decrypt, wm_ext_wasm_native_crypto_t **crypto);
+
+/**
+  * @brief  Feed data into an operation. Hashes only read input, ciphers write the same
+  *         length of output, which can be the same as input.
+  *
+  * @param  crypto operation
+  * @param  in input data
+  * @param  out output data, it is not used by hashes
+  * @param  len data length
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_crypto_update(wm_ext_wasm_native_crypto_t *crypto, const uint8_t *in,
+                                           uint8_t *out, uint32_t len);
+
+/**
+  * @brief  Finish an operation and free it. Hashes write the digest, AES-GCM encryption
+  *         writes the tag, AES-GCM decryption checks the tag in out and AES-CTR writes
+  *         nothing.
+  *
+  * @param  crypto operation
+  * @param  out digest or tag buffer
+  * @param  out_len buffer length as input, and digest or tag length as output, a tag
+  *                 is truncated to the buffer length
+  *
+  * @return
+  *     - ESP_OK if success
+  *     - ESP_ERR_INVALID_SIZE if the buffer is too small for a digest or a tag is shorter than 4 bytes
+  *     - ESP_ERR_INVALID_CRC if the tag of AES-GCM decryption does not match
+  *     - other value if failed
+  */
+esp_err_t wm_ext_wasm_native_crypto_finish(wm_ext_wasm_native_crypto_t *crypto, uint8_t *out, uint32_t *out_len);
+
+/**
+  * @brief  Free an operation without finishing it.
+  *
+  * @param  crypto operation
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_crypto_free(wm_ext_wasm_native_crypto_t *crypto);
+
+/**
+  * @brief  Verify an ECDSA signature of a hash.
+  *
+  * @param  curve elliptic curve
+  * @param  pubkey public key in uncompressed format, 0x04 || X || Y
+  * @param  pubkey_len public key length
+  * @param  hash hash of the message
+  * @param  hash_len hash length
+  * @param  sig signature in raw format, r || s, each is as long as the curve order
+  * @param  sig_len signature length
+  *
+  * @return
+  *     - ESP_OK if the signature is valid
+  *     - ESP_ERR_INVALID_CRC if the signature is not valid
+  *     - other value if failed
+  */
+esp_err_t wm_ext_wasm_native_crypto_ecdsa_verify(wm_ext_wasm_native_crypto_curve_t curve,
+                                                 const uint8_t *pubkey, uint32_t pubkey_len,
+                                                 const uint8_t *hash, uint32_t hash_len,
+                                                 const uint8_t *sig, uint32_t sig_len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,259 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WM_EXT_WASM_NATIVE_JSON_ESCAPED     0x01    /*!< Token flag, string contains escape sequences */
+#define WM_EXT_WASM_NATIVE_JSON_MAX_DEPTH   31      /*!< Max nesting depth of writer containers */
+
+/**
+ * @brief JSON token types, values are shared with wasm32 applications.
+ */
+typedef enum wm_ext_wasm_native_json_type {
+    WM_EXT_WASM_NATIVE_JSON_OBJECT = 1,
+    WM_EXT_WASM_NATIVE_JSON_ARRAY,
+    WM_EXT_WASM_NATIVE_JSON_STRING,
+    WM_EXT_WASM_NATIVE_JSON_NUMBER,
+    WM_EXT_WASM_NATIVE_JSON_TRUE,
+    WM_EXT_WASM_NATIVE_JSON_FALSE,
+    WM_EXT_WASM_NATIVE_JSON_NULL,
+} wm_ext_wasm_native_json_type_t;
+
+/**
+ * @brief Token of a JSON value, layout is shared with wasm32 applications.
+ *
+ * Tokens are in document order, a container is followed by tokens of its children and
+ * a member of an object is a key string token followed by tokens of its value.
+ */
+typedef struct wm_ext_wasm_native_json_token {
+    uint8_t type;                               /*!< Value type, wm_ext_wasm_native_json_type_t */
+    uint8_t flags;                              /*!< WM_EXT_WASM_NATIVE_JSON_ESCAPED */
+    uint16_t reserved;
+    uint32_t start;                             /*!< Offset of value text, strings start after the quote */
+    uint32_t len;                               /*!< Length of value text, strings exclude quotes */
+    uint32_t next;                              /*!< Index of the token after this value and its children */
+    uint32_t size;                              /*!< Number of members of an object or elements of an array */
+} wm_ext_wasm_native_json_token_t;
+
+/**
+ * @brief JSON document and its tokens.
+ */
+typedef struct wm_ext_wasm_native_json {
+    const char *json;                           /*!< Text, it doesn't need to be NUL-terminated */
+    uint32_t len;                               /*!< Length of text */
+    wm_ext_wasm_native_json_token_t *tokens;    /*!< Token array */
+    uint32_t max_tokens;                        /*!< Number of tokens in token array */
+    uint32_t count;                             /*!< Number of parsed tokens */
+} wm_ext_wasm_native_json_t;
+
+/**
+ * @brief Streaming JSON writer.
+ */
+typedef struct wm_ext_wasm_native_json_writer {
+    char *buf;                                  /*!< Output buffer, output is not NUL-terminated */
+    uint32_t size;                              /*!< Output buffer size */
+    uint32_t len;                               /*!< Output length, it keeps counting when the buffer is full */
+    uint32_t depth;                             /*!< Number of open containers */
+    uint32_t comma;                             /*!< Bit n is set if container at depth n has a value */
+    uint32_t object;                            /*!< Bit n is set if container at depth n is an object */
+} wm_ext_wasm_native_json_writer_t;
+
+/**
+  * @brief  Parse text of a document into its tokens, strings are not copied and tokens
+  *         refer to the text by offsets. Text of len bytes never needs more than
+  *         len / 2 + 1 tokens.
+  *
+  * @param  doc document, json, len, tokens and max_tokens are input, count is output
+  *
+  * @return
+  *     - ESP_OK if success
+  *     - ESP_ERR_INVALID_RESPONSE if text is not valid JSON
+  *     - ESP_ERR_NO_MEM if tokens run out
+  *     - other value if failed
+  */
+esp_err_t wm_ext_wasm_native_json_parse(wm_ext_wasm_native_json_t *doc);
+
+/**
+  * @brief  Find a value by its path from a container token, e.g. "sensors[2].value".
+  *
+  * Keys of the path are compared with keys of the text as they are written, so keys
+  * containing escape sequences, '.' or '[' can't be found by path.
+  *
+  * @param  doc parsed document
+  * @param  parent index of token where the path starts, 0 is the root value
+  * @param  path path, an empty path finds the parent itself
+  * @param  index index of found token
+  *
+  * @return
+  *     - ESP_OK if success
+  *     - ESP_ERR_NOT_FOUND if no value is at the path
+  *     - other value if failed
+  */
+esp_err_t wm_ext_wasm_native_json_find(const wm_ext_wasm_native_json_t *doc, uint32_t parent, const char *path,
+                                       uint32_t *index);
+
+/**
+  * @brief  Get value of a number token.
+  *
+  * @param  doc parsed document
+  * @param  index index of token
+  * @param  value number value
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_json_get_number(const wm_ext_wasm_native_json_t *doc, uint32_t index, double *value);
+
+/**
+  * @brief  Get value of a number token which has no fraction or exponent.
+  *
+  * @param  doc parsed document
+  * @param  index index of token
+  * @param  value integer value
+  *
+  * @return
+  *     - ESP_OK if success
+  *     - ESP_ERR_INVALID_SIZE if value is out of range of int64_t
+  *     - other value if failed
+  */
+esp_err_t wm_ext_wasm_native_json_get_int(const wm_ext_wasm_native_json_t *doc, uint32_t index, int64_t *value);
+
+/**
+  * @brief  Copy a string token with escape sequences decoded to UTF-8, like snprintf
+  *         output is truncated to out_size bytes including the NUL terminator.
+  *
+  * @param  doc parsed document
+  * @param  index index of token
+  * @param  out output buffer
+  * @param  out_size output buffer size
+  * @param  out_len length of decoded string without NUL terminator, even if it's truncated
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_json_get_string(const wm_ext_wasm_native_json_t *doc, uint32_t index,
+                                             char *out, uint32_t out_size, uint32_t *out_len);
+
+/**
+  * @brief  Initialize a writer.
+  *
+  * @param  writer writer
+  * @param  buf output buffer
+  * @param  size output buffer size
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_json_writer_init(wm_ext_wasm_native_json_writer_t *writer, char *buf, uint32_t size);
+
+/**
+  * @brief  Begin an object or an array.
+  *
+  * Values of all writer functions need a key when they are in an object and no key
+  * otherwise. Once the buffer is full, writer functions return ESP_ERR_INVALID_SIZE
+  * and len keeps counting, so the needed buffer size is known at the end.
+  *
+  * @param  writer writer
+  * @param  key key, or NULL
+  * @param  array true to begin an array, false to begin an object
+  *
+  * @return
+  *     - ESP_OK if success
+  *     - ESP_ERR_INVALID_STATE if key is wrong or containers are nested too deep
+  *     - ESP_ERR_INVALID_SIZE if the buffer is full
+  */
+esp_err_t wm_ext_wasm_native_json_write_begin(wm_ext_wasm_native_json_writer_t *writer, const char *key, bool array);
+
+/**
+  * @brief  End the innermost object or array.
+  *
+  * @param  writer writer
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_json_write_end(wm_ext_wasm_native_json_writer_t *writer);
+
+/**
+  * @brief  Write a string, it's escaped as needed.
+  *
+  * @param  writer writer
+  * @param  key key, or NULL
+  * @param  str string
+  * @param  len length of string
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_json_write_string(wm_ext_wasm_native_json_writer_t *writer, const char *key,
+                                               const char *str, uint32_t len);
+
+/**
+  * @brief  Write a number with the shortest of 15 or 17 significant digits which reads
+  *         back the same value, NaN and infinity are written as null.
+  *
+  * @param  writer writer
+  * @param  key key, or NULL
+  * @param  value number
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_json_write_number(wm_ext_wasm_native_json_writer_t *writer, const char *key,
+                                               double value);
+
+/**
+  * @brief  Write an integer.
+  *
+  * @param  writer writer
+  * @param  key key, or NULL
+  * @param  value integer
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_json_write_int(wm_ext_wasm_native_json_writer_t *writer, const char *key,
+                                            int64_t value);
+
+/**
+  * @brief  Write true or false.
+  *
+  * @param  writer writer
+  * @param  key key, or NULL
+  * @param  value boolean
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_json_write_bool(wm_ext_wasm_native_json_writer_t *writer, const char *key, bool value);
+
+/**
+  * @brief  Write null.
+  *
+  * @param  writer writer
+  * @param  key key, or NULL
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_json_write_null(wm_ext_wasm_native_json_writer_t *writer, const char *key);
+
+/**
+  * @brief  Write text which is already JSON as a value, it's not checked.
+  *
+  * @param  writer writer
+  * @param  key key, or NULL
+  * @param  json JSON text
+  * @param  len length of text
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_json_write_raw(wm_ext_wasm_native_json_writer_t *writer, const char *key,
+                                            const char *json, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
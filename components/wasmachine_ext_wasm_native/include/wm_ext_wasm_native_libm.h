@@ -0,0 +1,135 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Element-wise math functions of float arrays.
+ */
+typedef enum wm_ext_wasm_native_libm_op {
+    WM_EXT_WASM_NATIVE_LIBM_OP_SIN = 0,     /*!< sinf */
+    WM_EXT_WASM_NATIVE_LIBM_OP_COS,         /*!< cosf */
+    WM_EXT_WASM_NATIVE_LIBM_OP_EXP,         /*!< expf */
+    WM_EXT_WASM_NATIVE_LIBM_OP_LOG,         /*!< logf */
+    WM_EXT_WASM_NATIVE_LIBM_OP_SQRT,        /*!< sqrtf */
+    WM_EXT_WASM_NATIVE_LIBM_OP_MAX
+} wm_ext_wasm_native_libm_op_t;
+
+/**
+ * @brief Statistics of an array, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_native_libm_stat {
+    float min;                  /*!< Minimum value */
+    float max;                  /*!< Maximum value */
+    float mean;                 /*!< Arithmetic mean */
+} wm_ext_wasm_native_libm_stat_t;
+
+/**
+  * @brief  Apply a math function to each element, dst = op(src).
+  *
+  * @param  op math function
+  * @param  dst output array, it can be the same as src
+  * @param  src input array
+  * @param  n number of elements
+  *
+  * @return ESP_OK if success or ESP_ERR_INVALID_ARG if op is not supported.
+  */
+esp_err_t wm_ext_wasm_native_libm_vmathf(wm_ext_wasm_native_libm_op_t op, float *dst, const float *src, uint32_t n);
+
+/**
+  * @brief  Calculate dst = atan2f(y, x) of each element.
+  *
+  * @param  dst output array, it can be the same as y or x
+  * @param  y input array of y
+  * @param  x input array of x
+  * @param  n number of elements
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_libm_vatan2f(float *dst, const float *y, const float *x, uint32_t n);
+
+/**
+  * @brief  Calculate dst = src * scale + offset of each element.
+  *
+  * @param  dst output array, it can be the same as src
+  * @param  src input array
+  * @param  n number of elements
+  * @param  scale scale
+  * @param  offset offset
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_libm_vscalef(float *dst, const float *src, uint32_t n, float scale, float offset);
+
+/**
+  * @brief  Calculate dst = src * scale + offset of each element, results are rounded to nearest
+  *         and saturated to int16_t.
+  *
+  * @param  dst output array, it can be the same as src
+  * @param  src input array
+  * @param  n number of elements
+  * @param  scale scale
+  * @param  offset offset
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_libm_vscale_s16(int16_t *dst, const int16_t *src, uint32_t n, float scale, float offset);
+
+/**
+  * @brief  Calculate dot product of two float arrays.
+  *
+  * @param  a first array
+  * @param  b second array
+  * @param  n number of elements
+  *
+  * @return Dot product.
+  */
+float wm_ext_wasm_native_libm_vdotf(const float *a, const float *b, uint32_t n);
+
+/**
+  * @brief  Calculate dot product of two int16_t arrays without overflow.
+  *
+  * @param  a first array
+  * @param  b second array
+  * @param  n number of elements
+  *
+  * @return Dot product.
+  */
+int64_t wm_ext_wasm_native_libm_vdot_s16(const int16_t *a, const int16_t *b, uint32_t n);
+
+/**
+  * @brief  Calculate minimum, maximum and mean of a float array, all are 0 if n is 0.
+  *
+  * @param  src input array
+  * @param  n number of elements
+  * @param  stat statistics
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_libm_vstatf(const float *src, uint32_t n, wm_ext_wasm_native_libm_stat_t *stat);
+
+/**
+  * @brief  Calculate minimum, maximum and mean of an int16_t array, all are 0 if n is 0.
+  *
+  * @param  src input array
+  * @param  n number of elements
+  * @param  stat statistics
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_libm_vstat_s16(const int16_t *src, uint32_t n, wm_ext_wasm_native_libm_stat_t *stat);
+
+#ifdef __cplusplus
+}
+#endif
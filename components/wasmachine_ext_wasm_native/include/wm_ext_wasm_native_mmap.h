@@ -0,0 +1,84 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Page cache counters of a file mapping.
+ */
+typedef struct wm_ext_wasm_native_mmap_stats {
+    uint32_t hits;              /*!< Pages which were found in cache */
+    uint32_t misses;            /*!< Pages which were read from the file into cache */
+    uint32_t evictions;         /*!< Cached pages which were replaced by other pages */
+} wm_ext_wasm_native_mmap_stats_t;
+
+/**
+ * @brief Read-only window of a file or a data partition.
+ */
+typedef struct wm_ext_wasm_native_mmap wm_ext_wasm_native_mmap_t;
+
+/**
+  * @brief  Open a read-only window of a file, or of a data partition by "partition:<label>",
+  *         which must be listed in CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PARTITIONS.
+  *
+  * @param  path file path or partition label
+  * @param  offset window offset in the file or partition
+  * @param  length window size, 0 for the rest of the file or partition
+  *
+  * @return Mapping pointer if success, or NULL with errno set if failed.
+  */
+wm_ext_wasm_native_mmap_t *wm_ext_wasm_native_mmap_open(const char *path, uint32_t offset, uint32_t length);
+
+/**
+  * @brief  Copy bytes of a window, reads at the end of the window are short.
+  *
+  * @param  m mapping pointer
+  * @param  offset offset in the window
+  * @param  buf buffer
+  * @param  len number of bytes to read
+  *
+  * @return Number of bytes read, 0 if offset is not below the window size, or -1 with
+  *         errno set if the file can't be read.
+  */
+int wm_ext_wasm_native_mmap_read(wm_ext_wasm_native_mmap_t *m, uint32_t offset, void *buf, uint32_t len);
+
+/**
+  * @brief  Get the window size of a mapping.
+  *
+  * @param  m mapping pointer
+  *
+  * @return Window size in bytes.
+  */
+uint32_t wm_ext_wasm_native_mmap_size(wm_ext_wasm_native_mmap_t *m);
+
+/**
+  * @brief  Get page cache counters of a mapping, they are 0 for data partitions.
+  *
+  * @param  m mapping pointer
+  * @param  stats counters
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_mmap_get_stats(wm_ext_wasm_native_mmap_t *m, wm_ext_wasm_native_mmap_stats_t *stats);
+
+/**
+  * @brief  Close a mapping and free it.
+  *
+  * @param  m mapping pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_mmap_close(wm_ext_wasm_native_mmap_t *m);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief  Get time of the monotonic clock in microseconds, it's esp_timer time which
+  *         starts at boot, or CLOCK_MONOTONIC time on linux target.
+  *
+  * @return Time in microseconds.
+  */
+int64_t wm_ext_wasm_native_timer_now_us(void);
+
+/**
+  * @brief  Block the calling task until the monotonic clock reaches a deadline.
+  *
+  * The task sleeps for whole RTOS ticks while the deadline is ticks away, then blocks
+  * on a one-shot esp_timer for the rest, and spins only for the last microseconds which
+  * are shorter than arming the timer, so other tasks keep the CPU until the deadline.
+  *
+  * @param  deadline_us deadline in microseconds of wm_ext_wasm_native_timer_now_us, it
+  *                     returns at once if the deadline has passed
+  *
+  * @return Time in microseconds by which the deadline was passed when it returns.
+  */
+int64_t wm_ext_wasm_native_timer_delay_until(int64_t deadline_us);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,247 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "sdkconfig.h"
+#include "esp_err.h"
+#include "wasm_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Native call which is being traced, it lives on the stack of the native wrapper.
+ */
+typedef struct wm_ext_wasm_native_trace {
+    const char *name;           /*!< Native name, NULL if tracing is stopped when the call starts */
+    uint32_t id;                /*!< Function ID inside the bridge, 0 if the bridge has no IDs */
+    uint32_t module;            /*!< Module instance which calls the native */
+    uint32_t args_hash;         /*!< FNV-1a hash of arguments */
+    int64_t start_us;           /*!< Start time in microseconds */
+} wm_ext_wasm_native_trace_t;
+
+/**
+ * @brief Recorded native call.
+ */
+typedef struct wm_ext_wasm_native_trace_entry {
+    const char *name;           /*!< Native name */
+    uint32_t id;                /*!< Function ID inside the bridge */
+    uint32_t module;            /*!< Module instance which calls the native */
+    uint32_t args_hash;         /*!< FNV-1a hash of arguments */
+    uint32_t dur_us;            /*!< Duration in microseconds */
+    int64_t start_us;           /*!< Start time in microseconds */
+    int32_t result;             /*!< Result of the native call */
+} wm_ext_wasm_native_trace_entry_t;
+
+/**
+ * @brief Visit a recorded native call.
+ */
+typedef void (*wm_ext_wasm_native_trace_visit_t)(const wm_ext_wasm_native_trace_entry_t *entry, void *arg);
+
+typedef struct wm_ext_wasm_native_trace_ring wm_ext_wasm_native_trace_ring_t;
+
+extern bool wm_ext_wasm_native_trace_running;
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_TRACE
+/**
+ * @brief Start tracing a native call in a native wrapper which has exec_env, arguments
+ *        are hashed as uint32_t values and only evaluated when tracing is running, there
+ *        may be no arguments.
+ *        Nothing is compiled in if tracing is disabled.
+ */
+#define WM_EXT_WASM_NATIVE_TRACE_BEGIN(_name, _id, ...)                                     \
+    wm_ext_wasm_native_trace_t _trace = { .name = NULL };                                   \
+    if (wm_ext_wasm_native_trace_is_running()) {                                            \
+        const uint32_t _trace_args[] = { 0, ##__VA_ARGS__ };                                \
+        wm_ext_wasm_native_trace_begin(&_trace, exec_env, _name, _id, _trace_args + 1,      \
+                                       sizeof(_trace_args) / sizeof(uint32_t) - 1);         \
+    }
+
+/**
+ * @brief Start tracing a native call whose arguments are in an uint32_t array, like LVGL calls.
+ */
+#define WM_EXT_WASM_NATIVE_TRACE_BEGIN_ARGV(_name, _id, _argv, _argc)                       \
+    wm_ext_wasm_native_trace_t _trace = { .name = NULL };                                   \
+    if (wm_ext_wasm_native_trace_is_running()) {                                            \
+        wm_ext_wasm_native_trace_begin(&_trace, exec_env, _name, _id, _argv, _argc);        \
+    }
+
+/**
+ * @brief Record the native call started by WM_EXT_WASM_NATIVE_TRACE_BEGIN with its result.
+ */
+#define WM_EXT_WASM_NATIVE_TRACE_END(_ret)  wm_ext_wasm_native_trace_end(&_trace, (int32_t)(_ret))
+
+/**
+ * @brief Address of a native pointer in linear memory of the caller, so arguments hashes
+ *        of the same call match across runs and module instances.
+ */
+#define WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(_ptr)                                             \
+    (uint32_t)wasm_runtime_addr_native_to_app(wasm_runtime_get_module_inst(exec_env), (void *)(_ptr))
+#else
+#define WM_EXT_WASM_NATIVE_TRACE_BEGIN(_name, _id, ...)
+#define WM_EXT_WASM_NATIVE_TRACE_BEGIN_ARGV(_name, _id, _argv, _argc)
+#define WM_EXT_WASM_NATIVE_TRACE_END(_ret)
+#define WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(_ptr)     0
+#endif
+
+/**
+  * @brief  Check if native calls are being recorded, it's a relaxed load so native wrappers
+  *         don't evaluate arguments to hash when tracing is stopped.
+  *
+  * @return true if tracing is running or false if not.
+  */
+static inline bool wm_ext_wasm_native_trace_is_running(void)
+{
+    return __atomic_load_n(&wm_ext_wasm_native_trace_running, __ATOMIC_RELAXED);
+}
+
+/**
+  * @brief  Start tracing a native call if tracing is running, use WM_EXT_WASM_NATIVE_TRACE_BEGIN instead.
+  *
+  * @param  trace trace of the native call
+  * @param  exec_env WAMR execution envirenment pointer
+  * @param  name native name, it must be a static string
+  * @param  id function ID inside the bridge
+  * @param  args arguments to hash
+  * @param  num number of arguments
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_trace_begin(wm_ext_wasm_native_trace_t *trace, wasm_exec_env_t exec_env,
+                                    const char *name, uint32_t id, const uint32_t *args, uint32_t num);
+
+/**
+  * @brief  Record a native call into the trace ring of the current core, use WM_EXT_WASM_NATIVE_TRACE_END instead.
+  *
+  * @param  trace trace of the native call
+  * @param  result result of the native call
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_trace_end(wm_ext_wasm_native_trace_t *trace, int32_t result);
+
+/**
+  * @brief  Start recording native calls, rings are allocated when tracing starts for the first time.
+  *
+  * @return ESP_OK if success, ESP_ERR_INVALID_STATE if tracing is running, or ESP_ERR_NO_MEM if failed.
+  */
+esp_err_t wm_ext_wasm_native_trace_start(void);
+
+/**
+  * @brief  Stop recording native calls, recorded calls are kept until cleared or tracing starts again.
+  *
+  * @return ESP_OK if success or ESP_ERR_INVALID_STATE if tracing is not running.
+  */
+esp_err_t wm_ext_wasm_native_trace_stop(void);
+
+/**
+  * @brief  Drop all recorded native calls.
+  *
+  * @return ESP_OK if success or ESP_ERR_INVALID_STATE if tracing is running.
+  */
+esp_err_t wm_ext_wasm_native_trace_clear(void);
+
+/**
+  * @brief  Dump recorded native calls in Chrome trace event JSON format, which can be opened
+  *         by chrome://tracing or Perfetto UI. Process ID is the module instance and thread
+  *         ID is the core.
+  *
+  * @param  stream output stream
+  *
+  * @return ESP_OK if success or ESP_ERR_INVALID_STATE if tracing is running or never started.
+  */
+esp_err_t wm_ext_wasm_native_trace_dump(FILE *stream);
+
+/**
+  * @brief  Create a trace ring which many tasks record native calls into, it's stopped.
+  *
+  * @param  size number of entries, rounded up to a power of 2
+  *
+  * @return Ring pointer if success or NULL if failed.
+  */
+wm_ext_wasm_native_trace_ring_t *wm_ext_wasm_native_trace_ring_create(uint32_t size);
+
+/**
+  * @brief  Free a trace ring, it must be stopped.
+  *
+  * @param  ring ring pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_trace_ring_destroy(wm_ext_wasm_native_trace_ring_t *ring);
+
+/**
+  * @brief  Drop all entries of a stopped trace ring and start recording into it.
+  *
+  * @param  ring ring pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_trace_ring_start(wm_ext_wasm_native_trace_ring_t *ring);
+
+/**
+  * @brief  Stop recording into a trace ring and wait for tasks which are writing entries.
+  *
+  * @param  ring ring pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_trace_ring_stop(wm_ext_wasm_native_trace_ring_t *ring);
+
+/**
+  * @brief  Drop all entries of a stopped trace ring.
+  *
+  * @param  ring ring pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_trace_ring_clear(wm_ext_wasm_native_trace_ring_t *ring);
+
+/**
+  * @brief  Reserve an entry of a trace ring, the writer must commit it after. The oldest
+  *         entry is overwritten when the ring is full.
+  *
+  * @param  ring ring pointer
+  * @param  index free running index of the reserved entry
+  *
+  * @return true if success or false if the ring is stopped.
+  */
+bool wm_ext_wasm_native_trace_ring_reserve(wm_ext_wasm_native_trace_ring_t *ring, uint32_t *index);
+
+/**
+  * @brief  Write a reserved entry of a trace ring. An entry whose writer is lapped by
+  *         other writers before committing is skipped by wm_ext_wasm_native_trace_ring_foreach.
+  *
+  * @param  ring ring pointer
+  * @param  index index returned by wm_ext_wasm_native_trace_ring_reserve
+  * @param  entry recorded native call
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_trace_ring_commit(wm_ext_wasm_native_trace_ring_t *ring, uint32_t index,
+                                          const wm_ext_wasm_native_trace_entry_t *entry);
+
+/**
+  * @brief  Visit committed entries of a stopped trace ring, oldest first.
+  *
+  * @param  ring ring pointer
+  * @param  visit function called for each entry
+  * @param  arg argument of visit
+  *
+  * @return Number of visited entries.
+  */
+uint32_t wm_ext_wasm_native_trace_ring_foreach(const wm_ext_wasm_native_trace_ring_t *ring,
+                                               wm_ext_wasm_native_trace_visit_t visit, void *arg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,72 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WM_EXT_WASM_NATIVE_LZ4_WINDOW_BITS_MIN  10  /*!< 1 KiB window */
+#define WM_EXT_WASM_NATIVE_LZ4_WINDOW_BITS_MAX  16  /*!< 64 KiB window, the largest match offset of LZ4 */
+
+/**
+ * @brief Streaming LZ4 frame compressor or decompressor.
+ */
+typedef struct wm_ext_wasm_native_lz4 wm_ext_wasm_native_lz4_t;
+
+/**
+  * @brief  Create an LZ4 frame compressor or decompressor.
+  *
+  * The compressor writes frames of linked blocks which are not larger than the window,
+  * and only references data inside the window, it takes about 3 windows of memory.
+  * The decompressor keeps a window of output history, it takes about 1 window of memory
+  * and fails to decompress frames which reference data before the window.
+  *
+  * @param  compress true to compress, false to decompress
+  * @param  window_bits log2 of window size
+  * @param  lz4 codec pointer
+  *
+  * @return ESP_OK if success or other value if failed.
+  */
+esp_err_t wm_ext_wasm_native_lz4_create(bool compress, uint32_t window_bits, wm_ext_wasm_native_lz4_t **lz4);
+
+/**
+  * @brief  Run the codec on input until input is consumed or output is full.
+  *
+  * @param  lz4 codec
+  * @param  in input data
+  * @param  in_len available input bytes as input, and consumed input bytes as output
+  * @param  out output buffer
+  * @param  out_len output buffer length as input, and produced bytes as output
+  * @param  finish no more input follows, the compressor ends the frame
+  * @param  end frame is complete and all its data is output
+  *
+  * @return
+  *     - ESP_OK if success
+  *     - ESP_ERR_INVALID_RESPONSE if input is not a valid LZ4 frame
+  *     - ESP_ERR_NOT_SUPPORTED if the frame uses a dictionary or references data before the window
+  */
+esp_err_t wm_ext_wasm_native_lz4_update(wm_ext_wasm_native_lz4_t *lz4, const uint8_t *in, uint32_t *in_len,
+                                        uint8_t *out, uint32_t *out_len, bool finish, bool *end);
+
+/**
+  * @brief  Free an LZ4 codec.
+  *
+  * @param  lz4 codec
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_lz4_destroy(wm_ext_wasm_native_lz4_t *lz4);
+
+#ifdef __cplusplus
+}
+#endif
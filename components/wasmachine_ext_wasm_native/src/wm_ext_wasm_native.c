@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,9 +8,12 @@
 
 #include "wm_ext_wasm_native.h"
 #include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
 
 void wm_ext_wasm_native_export(void)
 {
+    ESP_ERROR_CHECK(wm_ext_wasm_native_ctx_init());
+
     for (wm_ext_wasm_native_export_fn_t *p = &__wm_ext_wasm_native_export_fn_array_start; p < &__wm_ext_wasm_native_export_fn_array_end; ++p) {
         ESP_ERROR_CHECK((*(p->fn))());
     }
@@ -0,0 +1,723 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+
+#include "wasm_export.h"
+#include "wasm_native.h"
+
+#include "wm_ext_wasm_native_macro.h"
+#include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
+#include "wm_ext_wasm_native_aio.h"
+
+#define AIO_BUF_SIZE            CONFIG_WASMACHINE_WASM_EXT_NATIVE_AIO_BUF_SIZE
+
+#define RING_LOAD(p)            __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define RING_STORE(p, v)        __atomic_store_n(p, v, __ATOMIC_RELEASE)
+
+/* Native copy of a submission queue entry, worker task runs it on bounce buffer */
+typedef struct aio_entry {
+    wm_ext_wasm_native_aio_sqe_t sqe;
+    uint8_t *buf;                           /*!< Bounce buffer of read and write */
+    uint32_t len;                           /*!< Length of bounce buffer, at most AIO_BUF_SIZE */
+    int32_t res;                            /*!< Result of operation, or negative native errno if failed */
+    bool done;                              /*!< Completed, or failed before running */
+} aio_entry_t;
+
+struct wm_ext_wasm_native_aio {
+    uint32_t ring;                          /*!< Application address of ring header */
+    uint32_t entries;                       /*!< Number of entries, copied from ring header */
+    uint32_t sqes;                          /*!< Application address of SQE array */
+    uint32_t cqes;                          /*!< Application address of CQE array */
+    const wm_ext_wasm_native_aio_ops_t *ops;
+    void *arg;
+
+    /* Entries from post_head to run_head are completed, from run_head to take_tail are pending */
+    aio_entry_t *queue;
+    uint32_t post_head;                     /*!< Next entry to post to completion queue */
+    uint32_t run_head;                      /*!< Next entry to run */
+    uint32_t take_tail;                     /*!< Next free entry */
+    bool running;                           /*!< Entry at run_head is running */
+
+    pthread_t tid;
+    pthread_mutex_t lock;
+    pthread_cond_t submit_cond;             /*!< Signaled when entries are taken */
+    pthread_cond_t complete_cond;           /*!< Signaled when an entry is completed */
+    uint32_t complete_seq;
+    bool stop;
+    bool orphan;                            /*!< Destroyed while running an entry, worker task frees the handle */
+};
+
+/* Native state of a ring created by wasm_aio_setup */
+typedef struct wasm_aio {
+    wm_ext_wasm_native_aio_t *aio;
+    wasm_module_inst_t module_inst;
+    wasm_exec_env_t exec_env;               /*!< Execution environment of the caller, used by ioctl handlers */
+} wasm_aio_t;
+
+static const char *TAG = "wm_aio";
+
+static pthread_mutex_t s_aio_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static int aio_errno(wm_ext_wasm_native_aio_t *aio, int error)
+{
+    return aio->ops->map_errno ? aio->ops->map_errno(aio->arg, error) : error;
+}
+
+static void aio_fail(wm_ext_wasm_native_aio_t *aio, aio_entry_t *e, int error)
+{
+    e->res = -error;
+    e->done = true;
+}
+
+/* Check an entry and copy data of write into its bounce buffer, in application thread */
+static void aio_take(wm_ext_wasm_native_aio_t *aio, aio_entry_t *e)
+{
+    const void *src;
+
+    e->buf = NULL;
+    e->len = 0;
+    e->res = 0;
+    e->done = false;
+
+    switch (e->sqe.opcode) {
+    case WM_EXT_WASM_NATIVE_AIO_OP_NOP:
+    case WM_EXT_WASM_NATIVE_AIO_OP_FSYNC:
+        break;
+    case WM_EXT_WASM_NATIVE_AIO_OP_READ:
+    case WM_EXT_WASM_NATIVE_AIO_OP_WRITE:
+        if ((int32_t)e->sqe.len < 0) {
+            aio_fail(aio, e, EINVAL);
+            break;
+        }
+
+        src = aio->ops->map(aio->arg, e->sqe.addr, e->sqe.len ? e->sqe.len : 1);
+        if (!src) {
+            aio_fail(aio, e, EFAULT);
+            break;
+        }
+
+        /* Longer operations complete with a short count */
+        e->len = e->sqe.len < AIO_BUF_SIZE ? e->sqe.len : AIO_BUF_SIZE;
+        e->buf = malloc(e->len ? e->len : 1);
+        if (!e->buf) {
+            aio_fail(aio, e, ENOMEM);
+            break;
+        }
+
+        if (e->sqe.opcode == WM_EXT_WASM_NATIVE_AIO_OP_WRITE) {
+            memcpy(e->buf, src, e->len);
+        }
+        break;
+    case WM_EXT_WASM_NATIVE_AIO_OP_IOCTL:
+        if (!aio->ops->ioctl) {
+            aio_fail(aio, e, ENOTSUP);
+        }
+        break;
+    default:
+        aio_fail(aio, e, EINVAL);
+        break;
+    }
+}
+
+/*
+ * Run an entry in worker task, it never touches application memory or operations, so
+ * it can finish a blocking operation after the handle is destroyed.
+ */
+static int32_t aio_run(aio_entry_t *e)
+{
+    int ret;
+    const wm_ext_wasm_native_aio_sqe_t *sqe = &e->sqe;
+
+    switch (sqe->opcode) {
+    case WM_EXT_WASM_NATIVE_AIO_OP_NOP:
+        ret = 0;
+        break;
+    case WM_EXT_WASM_NATIVE_AIO_OP_READ:
+        ret = sqe->offset < 0 ? read(sqe->fd, e->buf, e->len) : pread(sqe->fd, e->buf, e->len, (off_t)sqe->offset);
+        break;
+    case WM_EXT_WASM_NATIVE_AIO_OP_WRITE:
+        ret = sqe->offset < 0 ? write(sqe->fd, e->buf, e->len) : pwrite(sqe->fd, e->buf, e->len, (off_t)sqe->offset);
+        break;
+    case WM_EXT_WASM_NATIVE_AIO_OP_FSYNC:
+        ret = fsync(sqe->fd);
+        break;
+    default:
+        errno = EINVAL;
+        ret = -1;
+        break;
+    }
+
+    return ret < 0 ? -errno : ret;
+}
+
+/* ioctl handlers access application memory, so it runs in application thread */
+static int32_t aio_run_ioctl(wm_ext_wasm_native_aio_t *aio, aio_entry_t *e)
+{
+    int ret;
+    void *buf = aio->ops->map(aio->arg, e->sqe.addr, sizeof(uint32_t));
+
+    if (!buf) {
+        return -EFAULT;
+    }
+
+    ret = aio->ops->ioctl(aio->arg, e->sqe.fd, e->sqe.len, buf);
+
+    return ret < 0 ? -errno : ret;
+}
+
+static bool aio_runnable(wm_ext_wasm_native_aio_t *aio)
+{
+    aio_entry_t *e = &aio->queue[aio->run_head & (aio->entries - 1)];
+
+    return aio->run_head != aio->take_tail && !aio->running &&
+           (e->done || e->sqe.opcode != WM_EXT_WASM_NATIVE_AIO_OP_IOCTL);
+}
+
+static void aio_free(wm_ext_wasm_native_aio_t *aio)
+{
+    for (uint32_t i = aio->post_head; i != aio->take_tail; i++) {
+        free(aio->queue[i & (aio->entries - 1)].buf);
+    }
+
+    pthread_cond_destroy(&aio->complete_cond);
+    pthread_cond_destroy(&aio->submit_cond);
+    pthread_mutex_destroy(&aio->lock);
+    free(aio->queue);
+    free(aio);
+}
+
+static void *aio_worker(void *p)
+{
+    wm_ext_wasm_native_aio_t *aio = (wm_ext_wasm_native_aio_t *)p;
+    uint32_t mask = aio->entries - 1;
+    bool orphan;
+
+    pthread_mutex_lock(&aio->lock);
+
+    while (!aio->stop) {
+        aio_entry_t *e;
+
+        /* ioctl entries are left to application thread */
+        if (!aio_runnable(aio)) {
+            pthread_cond_wait(&aio->submit_cond, &aio->lock);
+            continue;
+        }
+
+        e = &aio->queue[aio->run_head & mask];
+        if (!e->done) {
+            aio->running = true;
+            pthread_mutex_unlock(&aio->lock);
+
+            e->res = aio_run(e);
+
+            pthread_mutex_lock(&aio->lock);
+            e->done = true;
+            aio->running = false;
+        }
+
+        aio->run_head++;
+        aio->complete_seq++;
+        pthread_cond_broadcast(&aio->complete_cond);
+    }
+
+    orphan = aio->orphan;
+    pthread_mutex_unlock(&aio->lock);
+
+    if (orphan) {
+        aio_free(aio);
+    }
+
+    return NULL;
+}
+
+/*
+ * Take submitted entries, run ioctl entries and post completed entries, in application
+ * thread which is the only one accessing application memory, so memory may move freely
+ * when it grows. It returns complete_seq when it's done, or -1 with errno set if failed.
+ */
+static int aio_sync(wm_ext_wasm_native_aio_t *aio, uint32_t *seq)
+{
+    uint32_t mask = aio->entries - 1;
+    uint32_t sq_head;
+    uint32_t sq_tail;
+    uint32_t cq_tail;
+    aio_entry_t *e;
+    wm_ext_wasm_native_aio_ring_t *ring;
+    wm_ext_wasm_native_aio_sqe_t *sqes;
+    wm_ext_wasm_native_aio_cqe_t *cqes;
+    uint8_t *dst;
+
+    /* Transform addresses for every call, application memory may be moved when it grows */
+    ring = aio->ops->map(aio->arg, aio->ring, sizeof(wm_ext_wasm_native_aio_ring_t));
+    sqes = aio->ops->map(aio->arg, aio->sqes, aio->entries * sizeof(wm_ext_wasm_native_aio_sqe_t));
+    cqes = aio->ops->map(aio->arg, aio->cqes, aio->entries * sizeof(wm_ext_wasm_native_aio_cqe_t));
+    if (!ring || !sqes || !cqes) {
+        ESP_LOGE(TAG, "failed to map ring=%"PRIx32, aio->ring);
+        errno = EFAULT;
+        return -1;
+    }
+
+    pthread_mutex_lock(&aio->lock);
+
+    if (aio->stop) {
+        pthread_mutex_unlock(&aio->lock);
+        errno = EIO;
+        return -1;
+    }
+
+    sq_head = ring->sq_head;
+    sq_tail = RING_LOAD(&ring->sq_tail);
+    while (sq_head != sq_tail && aio->take_tail - aio->post_head < aio->entries) {
+        e = &aio->queue[aio->take_tail & mask];
+        memcpy(&e->sqe, &sqes[sq_head & mask], sizeof(e->sqe));
+        aio_take(aio, e);
+        aio->take_tail++;
+        sq_head++;
+    }
+    RING_STORE(&ring->sq_head, sq_head);
+    pthread_cond_signal(&aio->submit_cond);
+
+    /* Worker task stops at an ioctl entry, so entries still complete in order */
+    while (aio->run_head != aio->take_tail && !aio->running) {
+        e = &aio->queue[aio->run_head & mask];
+        if (e->done || e->sqe.opcode != WM_EXT_WASM_NATIVE_AIO_OP_IOCTL) {
+            break;
+        }
+
+        aio->running = true;
+        pthread_mutex_unlock(&aio->lock);
+
+        e->res = aio_run_ioctl(aio, e);
+
+        pthread_mutex_lock(&aio->lock);
+        e->done = true;
+        aio->running = false;
+        aio->run_head++;
+        aio->complete_seq++;
+        pthread_cond_signal(&aio->submit_cond);
+    }
+
+    /* ioctl handlers may grow memory */
+    ring = aio->ops->map(aio->arg, aio->ring, sizeof(wm_ext_wasm_native_aio_ring_t));
+    cqes = aio->ops->map(aio->arg, aio->cqes, aio->entries * sizeof(wm_ext_wasm_native_aio_cqe_t));
+    if (!ring || !cqes) {
+        pthread_mutex_unlock(&aio->lock);
+        errno = EFAULT;
+        return -1;
+    }
+
+    cq_tail = ring->cq_tail;
+    while (aio->post_head != aio->run_head && cq_tail - RING_LOAD(&ring->cq_head) < aio->entries) {
+        e = &aio->queue[aio->post_head & mask];
+        if (e->sqe.opcode == WM_EXT_WASM_NATIVE_AIO_OP_READ && e->res > 0) {
+            dst = aio->ops->map(aio->arg, e->sqe.addr, e->res);
+            if (dst) {
+                memcpy(dst, e->buf, e->res);
+            } else {
+                e->res = -EFAULT;
+            }
+        }
+
+        cqes[cq_tail & mask].user_data = e->sqe.user_data;
+        cqes[cq_tail & mask].res = e->res < 0 ? -aio_errno(aio, -e->res) : e->res;
+        cqes[cq_tail & mask].flags = 0;
+
+        free(e->buf);
+        e->buf = NULL;
+        aio->post_head++;
+        cq_tail++;
+    }
+    RING_STORE(&ring->cq_tail, cq_tail);
+
+    *seq = aio->complete_seq;
+
+    pthread_mutex_unlock(&aio->lock);
+
+    return 0;
+}
+
+esp_err_t wm_ext_wasm_native_aio_create(uint32_t ring, const wm_ext_wasm_native_aio_ops_t *ops,
+                                        void *arg, wm_ext_wasm_native_aio_t **aio)
+{
+    int ret;
+    pthread_attr_t attr;
+    wm_ext_wasm_native_aio_ring_t *pring;
+    wm_ext_wasm_native_aio_t *paio;
+
+    if (!ops || !ops->map || !aio) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    pring = ops->map(arg, ring, sizeof(wm_ext_wasm_native_aio_ring_t));
+    if (!pring) {
+        ESP_LOGE(TAG, "failed to map ring=%"PRIx32, ring);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!pring->entries || pring->entries > WM_EXT_WASM_NATIVE_AIO_MAX_ENTRIES ||
+            (pring->entries & (pring->entries - 1)) ||
+            !ops->map(arg, pring->sqes, pring->entries * sizeof(wm_ext_wasm_native_aio_sqe_t)) ||
+            !ops->map(arg, pring->cqes, pring->entries * sizeof(wm_ext_wasm_native_aio_cqe_t))) {
+        ESP_LOGE(TAG, "invalid ring entries=%"PRIu32" sqes=%"PRIx32" cqes=%"PRIx32,
+                 pring->entries, pring->sqes, pring->cqes);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    paio = calloc(1, sizeof(wm_ext_wasm_native_aio_t));
+    if (!paio) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    paio->queue = calloc(pring->entries, sizeof(aio_entry_t));
+    if (!paio->queue) {
+        free(paio);
+        return ESP_ERR_NO_MEM;
+    }
+
+    paio->ring = ring;
+    paio->entries = pring->entries;
+    paio->sqes = pring->sqes;
+    paio->cqes = pring->cqes;
+    paio->ops = ops;
+    paio->arg = arg;
+
+    /* Entries which are submitted before setup are dropped */
+    pring->sq_head = pring->sq_tail;
+    pring->cq_tail = pring->cq_head;
+
+    pthread_mutex_init(&paio->lock, NULL);
+    pthread_cond_init(&paio->submit_cond, NULL);
+    pthread_cond_init(&paio->complete_cond, NULL);
+
+    ret = pthread_attr_init(&attr);
+    if (ret) {
+        goto errout_attr;
+    }
+
+    ret = pthread_attr_setstacksize(&attr, CONFIG_WASMACHINE_WASM_EXT_NATIVE_AIO_TASK_STACK_SIZE);
+    if (!ret) {
+        ret = pthread_create(&paio->tid, &attr, aio_worker, paio);
+    }
+    pthread_attr_destroy(&attr);
+    if (ret) {
+        ESP_LOGE(TAG, "failed to create task errno=%d", ret);
+        goto errout_attr;
+    }
+
+    *aio = paio;
+
+    return ESP_OK;
+
+errout_attr:
+    pthread_cond_destroy(&paio->complete_cond);
+    pthread_cond_destroy(&paio->submit_cond);
+    pthread_mutex_destroy(&paio->lock);
+    free(paio->queue);
+    free(paio);
+    return ESP_ERR_NO_MEM;
+}
+
+int wm_ext_wasm_native_aio_submit(wm_ext_wasm_native_aio_t *aio)
+{
+    uint32_t seq;
+
+    return aio_sync(aio, &seq);
+}
+
+int wm_ext_wasm_native_aio_wait(wm_ext_wasm_native_aio_t *aio, uint32_t min_complete, int32_t timeout_ms)
+{
+    int ret = 0;
+    uint32_t n = 0;
+    uint32_t seq;
+    struct timespec ts;
+    wm_ext_wasm_native_aio_ring_t *ring;
+
+    if (min_complete > aio->entries) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (timeout_ms >= 0) {
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec += timeout_ms / 1000;
+        ts.tv_nsec += (timeout_ms % 1000) * 1000000;
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+    }
+
+    for (;;) {
+        ret = aio_sync(aio, &seq);
+        if (ret < 0) {
+            break;
+        }
+
+        ring = aio->ops->map(aio->arg, aio->ring, sizeof(wm_ext_wasm_native_aio_ring_t));
+        if (!ring) {
+            errno = EFAULT;
+            ret = -1;
+            break;
+        }
+
+        n = ring->cq_tail - ring->cq_head;
+        if (n >= min_complete) {
+            break;
+        }
+
+        /* Completed entries are posted by the next aio_sync() */
+        pthread_mutex_lock(&aio->lock);
+        while (aio->complete_seq == seq && ret == 0) {
+            if (timeout_ms < 0) {
+                pthread_cond_wait(&aio->complete_cond, &aio->lock);
+            } else if (pthread_cond_timedwait(&aio->complete_cond, &aio->lock, &ts) == ETIMEDOUT) {
+                errno = ETIMEDOUT;
+                ret = -1;
+            }
+        }
+        pthread_mutex_unlock(&aio->lock);
+
+        if (ret < 0) {
+            break;
+        }
+    }
+
+    return ret < 0 ? ret : (int)n;
+}
+
+void wm_ext_wasm_native_aio_destroy(wm_ext_wasm_native_aio_t *aio)
+{
+    bool orphan;
+
+    pthread_mutex_lock(&aio->lock);
+    aio->stop = true;
+    pthread_cond_signal(&aio->submit_cond);
+
+    /*
+     * A read of a pipe, socket or UART may block forever, so the worker task isn't
+     * waited for, it frees the handle when the operation returns.
+     */
+    orphan = aio->orphan = aio->running;
+    pthread_mutex_unlock(&aio->lock);
+
+    if (orphan) {
+        pthread_detach(aio->tid);
+        return;
+    }
+
+    pthread_join(aio->tid, NULL);
+    aio_free(aio);
+}
+
+static void *wasm_aio_map(void *arg, uint32_t addr, uint32_t size)
+{
+    wasm_aio_t *waio = (wasm_aio_t *)arg;
+    wasm_module_inst_t module_inst = waio->module_inst;
+
+    if (!validate_app_addr(addr, size)) {
+        return NULL;
+    }
+
+    return addr_app_to_native(addr);
+}
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS
+static int wasm_aio_ioctl(void *arg, int fd, int cmd, void *va_args)
+{
+    wasm_aio_t *waio = (wasm_aio_t *)arg;
+
+    return wm_ext_wasm_native_ioctl(waio->exec_env, fd, cmd, va_args);
+}
+#endif
+
+static const wm_ext_wasm_native_aio_ops_t s_wasm_aio_ops = {
+    .map        = wasm_aio_map,
+#ifdef CONFIG_WASMACHINE_EXT_VFS
+    .ioctl      = wasm_aio_ioctl,
+#endif
+};
+
+static void wasm_aio_free(wasm_aio_t *waio)
+{
+    if (waio->aio) {
+        wm_ext_wasm_native_aio_destroy(waio->aio);
+    }
+
+    wasm_runtime_free(waio);
+}
+
+static wasm_aio_t *wasm_aio_get(wasm_exec_env_t exec_env, int id)
+{
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+
+    if (!ctx || id < 0 || id >= WM_EXT_WASM_NATIVE_AIO_MAX_RINGS) {
+        return NULL;
+    }
+
+    return (wasm_aio_t *)ctx->aio[id];
+}
+
+static int wasm_aio_setup_wrapper(wasm_exec_env_t exec_env, uint32_t ring)
+{
+    int id = -1;
+    esp_err_t err;
+    wasm_aio_t *waio;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(module_inst);
+
+    if (!ctx) {
+        return -ENOMEM;
+    }
+
+    waio = wasm_runtime_malloc(sizeof(wasm_aio_t));
+    if (!waio) {
+        return -ENOMEM;
+    }
+
+    memset(waio, 0, sizeof(wasm_aio_t));
+    waio->module_inst = module_inst;
+
+    pthread_mutex_lock(&s_aio_lock);
+
+    for (int i = 0; i < WM_EXT_WASM_NATIVE_AIO_MAX_RINGS; i++) {
+        if (!ctx->aio[i]) {
+            id = i;
+            break;
+        }
+    }
+
+    if (id < 0) {
+        pthread_mutex_unlock(&s_aio_lock);
+        wasm_aio_free(waio);
+        return -EMFILE;
+    }
+
+    err = wm_ext_wasm_native_aio_create(ring, &s_wasm_aio_ops, waio, &waio->aio);
+    if (err != ESP_OK) {
+        pthread_mutex_unlock(&s_aio_lock);
+        wasm_aio_free(waio);
+        return err == ESP_ERR_INVALID_ARG ? -EINVAL : -ENOMEM;
+    }
+
+    ctx->aio[id] = waio;
+
+    pthread_mutex_unlock(&s_aio_lock);
+
+    ESP_LOGD(TAG, "setup ring=%"PRIx32" id=%d", ring, id);
+
+    return id;
+}
+
+static int wasm_aio_submit_wrapper(wasm_exec_env_t exec_env, int id)
+{
+    int ret;
+    wasm_aio_t *waio = wasm_aio_get(exec_env, id);
+
+    if (!waio) {
+        return -EBADF;
+    }
+
+    waio->exec_env = exec_env;
+
+    ret = wm_ext_wasm_native_aio_submit(waio->aio);
+    if (ret < 0) {
+        ret = -errno;
+    }
+
+    return ret;
+}
+
+static int wasm_aio_wait_wrapper(wasm_exec_env_t exec_env, int id, uint32_t min_complete, int32_t timeout_ms)
+{
+    int ret;
+    wasm_aio_t *waio = wasm_aio_get(exec_env, id);
+
+    if (!waio) {
+        return -EBADF;
+    }
+
+    waio->exec_env = exec_env;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_aio_wait", 0, id, min_complete, timeout_ms);
+
+    ret = wm_ext_wasm_native_aio_wait(waio->aio, min_complete, timeout_ms);
+    if (ret < 0) {
+        ret = -errno;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static int wasm_aio_destroy_wrapper(wasm_exec_env_t exec_env, int id)
+{
+    wasm_aio_t *waio;
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+
+    if (!ctx || id < 0 || id >= WM_EXT_WASM_NATIVE_AIO_MAX_RINGS) {
+        return -EBADF;
+    }
+
+    pthread_mutex_lock(&s_aio_lock);
+    waio = ctx->aio[id];
+    ctx->aio[id] = NULL;
+    pthread_mutex_unlock(&s_aio_lock);
+
+    if (!waio) {
+        return -EBADF;
+    }
+
+    wasm_aio_free(waio);
+
+    return 0;
+}
+
+void wm_ext_wasm_native_aio_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx)
+{
+    for (int i = 0; i < WM_EXT_WASM_NATIVE_AIO_MAX_RINGS; i++) {
+        if (ctx->aio[i]) {
+            wasm_aio_free(ctx->aio[i]);
+            ctx->aio[i] = NULL;
+        }
+    }
+}
+
+static NativeSymbol wm_aio_wrapper_native_symbol[] = {
+    REG_NATIVE_FUNC(wasm_aio_setup,     "(i)i"),
+    REG_NATIVE_FUNC(wasm_aio_submit,    "(i)i"),
+    REG_NATIVE_FUNC(wasm_aio_wait,      "(iii)i"),
+    REG_NATIVE_FUNC(wasm_aio_destroy,   "(i)i"),
+};
+
+int wm_ext_wasm_native_aio_export(void)
+{
+    NativeSymbol *sym = (NativeSymbol *)wm_aio_wrapper_native_symbol;
+    int num = sizeof(wm_aio_wrapper_native_symbol) / sizeof(wm_aio_wrapper_native_symbol[0]);
+
+    if (!wasm_native_register_natives("env", sym,  num)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+WM_EXT_WASM_NATIVE_EXPORT_FN(wm_ext_wasm_native_aio_export)
+{
+    return wm_ext_wasm_native_aio_export();
+}
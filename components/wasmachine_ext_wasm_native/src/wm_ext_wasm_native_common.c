@@ -1,18 +1,102 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <inttypes.h>
+#include <string.h>
+#include <pthread.h>
 
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "esp_log.h"
 
 #include "wm_ext_wasm_native_macro.h"
 #include "wm_ext_wasm_native_common.h"
 
+#ifdef CONFIG_WASMACHINE_EXT_VFS
+#include "wm_ext_wasm_vfs_ioctl.h"
+#endif
+
+#define EXEC_ENV_POOL_SIZE  CONFIG_WASMACHINE_WASM_EXT_NATIVE_EXEC_ENV_POOL_SIZE
+
+#if defined(CONFIG_WASMACHINE_EXT_VFS) && (defined(CONFIG_EXTENDED_VFS_I2C) || defined(CONFIG_EXTENDED_VFS_SPI))
+#define CTX_VFS_XFER        1
+#endif
+
 static const char *TAG = "wm_common";
 
+static const char *const s_func_name[WM_EXT_WASM_NATIVE_FUNC_MAX] = {
+    [WM_EXT_WASM_NATIVE_FUNC_SET_ERRNO]         = "libc_builtin_set_errno",
+    [WM_EXT_WASM_NATIVE_FUNC_MQTT_DISPATCH]     = "on_mqtt_dispatch_event",
+    [WM_EXT_WASM_NATIVE_FUNC_HRTIMER_DISPATCH]  = "on_hrtimer_dispatch",
+    [WM_EXT_WASM_NATIVE_FUNC_GPIO_DISPATCH]     = "on_gpio_events",
+};
+
+static void *s_ctx_key;
+static pthread_mutex_t s_ctx_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void ctx_destroy(wasm_module_inst_t module_inst, void *p)
+{
+    wm_ext_wasm_native_ctx_t *ctx = (wm_ext_wasm_native_ctx_t *)p;
+
+#if EXEC_ENV_POOL_SIZE > 0
+    for (int i = 0; i < EXEC_ENV_POOL_SIZE; i++) {
+        if (ctx->exec_env[i].exec_env) {
+            wasm_runtime_destroy_exec_env(ctx->exec_env[i].exec_env);
+        }
+    }
+
+    pthread_mutex_destroy(&ctx->lock);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_AIO
+    wm_ext_wasm_native_aio_ctx_destroy(ctx);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP
+    wm_ext_wasm_native_mmap_ctx_destroy(ctx);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_CRYPTO
+    wm_ext_wasm_native_crypto_ctx_destroy(ctx);
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_COMPRESS
+    wm_ext_wasm_native_compress_ctx_destroy(ctx);
+#endif
+
+#if defined(CONFIG_WASMACHINE_WASM_EXT_NATIVE_TIMER) && defined(CONFIG_WASMACHINE_APP_MGR)
+    wm_ext_wasm_native_timer_ctx_destroy(ctx);
+#endif
+
+#if defined(CONFIG_WASMACHINE_EXT_VFS) && defined(CONFIG_EXTENDED_VFS)
+    wm_ext_wasm_vfs_ctx_destroy(ctx);
+#endif
+
+#ifdef CTX_VFS_XFER
+    pthread_mutex_destroy(&ctx->vfs_xfer_lock);
+#endif
+
+    wasm_runtime_free(ctx);
+}
+
+bool wm_ext_wasm_native_mem_resolve(wm_ext_wasm_native_mem_t *mem)
+{
+    wasm_module_inst_t module_inst = get_module_inst(mem->exec_env);
+    wasm_memory_inst_t memory = wasm_runtime_get_default_memory(module_inst);
+
+    if (!memory) {
+        return false;
+    }
+
+    mem->base = wasm_memory_get_base_address(memory);
+    mem->size = wasm_memory_get_cur_page_count(memory) * wasm_memory_get_bytes_per_page(memory);
+
+    return mem->base != NULL;
+}
+
 int wm_ext_data_seq_addr_wasm2c(wasm_exec_env_t exec_env, data_seq_t *ds)
 {
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
@@ -69,3 +153,166 @@ data_seq_t *wm_ext_wasm_native_get_data_seq(wasm_exec_env_t exec_env, char *va_a
 
     return ds;
 }
+
+esp_err_t wm_ext_wasm_native_ctx_init(void)
+{
+    if (s_ctx_key) {
+        return ESP_OK;
+    }
+
+    s_ctx_key = wasm_runtime_create_context_key(ctx_destroy);
+    if (!s_ctx_key) {
+        ESP_LOGE(TAG, "failed to create context key");
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+wm_ext_wasm_native_ctx_t *wm_ext_wasm_native_get_ctx(wasm_module_inst_t module_inst)
+{
+    wm_ext_wasm_native_ctx_t *ctx;
+
+    ctx = wasm_runtime_get_context(module_inst, s_ctx_key);
+    if (ctx) {
+        return ctx;
+    }
+
+    /* Threads of one module instance may get the context at the same time */
+    pthread_mutex_lock(&s_ctx_lock);
+
+    ctx = wasm_runtime_get_context(module_inst, s_ctx_key);
+    if (ctx) {
+        goto out;
+    }
+
+    ctx = wasm_runtime_malloc(sizeof(wm_ext_wasm_native_ctx_t));
+    if (!ctx) {
+        ESP_LOGE(TAG, "failed to malloc context");
+        goto out;
+    }
+
+    memset(ctx, 0, sizeof(wm_ext_wasm_native_ctx_t));
+#if EXEC_ENV_POOL_SIZE > 0
+    if (pthread_mutex_init(&ctx->lock, NULL)) {
+        ESP_LOGE(TAG, "failed to init context lock");
+        wasm_runtime_free(ctx);
+        ctx = NULL;
+        goto out;
+    }
+#endif
+
+#ifdef CTX_VFS_XFER
+    if (pthread_mutex_init(&ctx->vfs_xfer_lock, NULL)) {
+        ESP_LOGE(TAG, "failed to init context lock of prepared transfers");
+#if EXEC_ENV_POOL_SIZE > 0
+        pthread_mutex_destroy(&ctx->lock);
+#endif
+        wasm_runtime_free(ctx);
+        ctx = NULL;
+        goto out;
+    }
+#endif
+
+    for (int i = 0; i < WM_EXT_WASM_NATIVE_FUNC_MAX; i++) {
+        ctx->func[i] = wasm_runtime_lookup_function(module_inst, s_func_name[i]);
+    }
+
+    wasm_runtime_set_context(module_inst, s_ctx_key, ctx);
+
+out:
+    pthread_mutex_unlock(&s_ctx_lock);
+    return ctx;
+}
+
+wasm_function_inst_t wm_ext_wasm_native_get_func(wasm_module_inst_t module_inst, wm_ext_wasm_native_func_t func)
+{
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(module_inst);
+
+    if (!ctx) {
+        return NULL;
+    }
+
+    if (!ctx->func[func]) {
+        ESP_LOGW(TAG, "failed to find function %s", s_func_name[func]);
+    }
+
+    return ctx->func[func];
+}
+
+wasm_exec_env_t wm_ext_wasm_native_get_exec_env(wasm_module_inst_t module_inst, uint32_t stack_size)
+{
+#if EXEC_ENV_POOL_SIZE > 0
+    wasm_exec_env_t exec_env = NULL;
+    wm_ext_wasm_native_exec_env_t *slot = NULL;
+    void *self = xTaskGetCurrentTaskHandle();
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(module_inst);
+
+    if (!ctx) {
+        return wasm_runtime_create_exec_env(module_inst, stack_size);
+    }
+
+    pthread_mutex_lock(&ctx->lock);
+
+    for (int i = 0; i < EXEC_ENV_POOL_SIZE; i++) {
+        wm_ext_wasm_native_exec_env_t *p = &ctx->exec_env[i];
+
+        if (p->exec_env && p->owner == self && !p->busy && p->stack_size >= stack_size) {
+            p->busy = true;
+            exec_env = p->exec_env;
+            goto out;
+        } else if (!p->exec_env && !slot) {
+            slot = p;
+        }
+    }
+
+    /* Evict an idle execution environment of other tasks when the pool is full */
+    for (int i = 0; !slot && i < EXEC_ENV_POOL_SIZE; i++) {
+        wm_ext_wasm_native_exec_env_t *p = &ctx->exec_env[ctx->exec_env_next++ % EXEC_ENV_POOL_SIZE];
+
+        if (!p->busy) {
+            wasm_runtime_destroy_exec_env(p->exec_env);
+            p->exec_env = NULL;
+            slot = p;
+        }
+    }
+
+    /* If all slots are busy by nested callbacks, the execution environment is not pooled */
+    exec_env = wasm_runtime_create_exec_env(module_inst, stack_size);
+    if (exec_env && slot) {
+        slot->exec_env = exec_env;
+        slot->owner = self;
+        slot->stack_size = stack_size;
+        slot->busy = true;
+    }
+
+out:
+    pthread_mutex_unlock(&ctx->lock);
+    return exec_env;
+#else
+    return wasm_runtime_create_exec_env(module_inst, stack_size);
+#endif
+}
+
+void wm_ext_wasm_native_put_exec_env(wasm_module_inst_t module_inst, wasm_exec_env_t exec_env)
+{
+#if EXEC_ENV_POOL_SIZE > 0
+    wm_ext_wasm_native_ctx_t *ctx = wasm_runtime_get_context(module_inst, s_ctx_key);
+
+    if (ctx) {
+        pthread_mutex_lock(&ctx->lock);
+
+        for (int i = 0; i < EXEC_ENV_POOL_SIZE; i++) {
+            if (ctx->exec_env[i].exec_env == exec_env) {
+                ctx->exec_env[i].busy = false;
+                pthread_mutex_unlock(&ctx->lock);
+                return;
+            }
+        }
+
+        pthread_mutex_unlock(&ctx->lock);
+    }
+#endif
+
+    wasm_runtime_destroy_exec_env(exec_env);
+}
@@ -0,0 +1,390 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/param.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+
+#include "zlib.h"
+
+#include "wasm_export.h"
+#include "wasm_native.h"
+
+#include "wm_ext_wasm_native_macro.h"
+#include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
+#include "wm_ext_wasm_native_compress.h"
+#include "wm_ext_wasm_native_lz4.h"
+
+/*
+ * Streaming compression of buffers in linear memory. Applications feed input and drain
+ * output in pieces of any size, like zlib streams, so neither the whole data nor a
+ * whole compressed block has to be in the application heap.
+ */
+
+#define COMPRESS_MAX_CTX            CONFIG_WASMACHINE_WASM_EXT_NATIVE_COMPRESS_MAX_CTX
+#define DEFLATE_WINDOW_BITS_MIN     9
+#define DEFLATE_WINDOW_BITS_MAX     15
+#define DEFLATE_MEM_LEVEL_MAX       8
+#define DEFLATE_GZIP_WINDOW_BITS    16      /*!< Added to window bits to select gzip header */
+
+struct wm_ext_wasm_native_compress {
+    wm_ext_wasm_native_compress_format_t format;
+    bool compress;
+    bool busy;                              /*!< A native call of the application is using the stream */
+
+    union {
+        z_stream zs;
+        wm_ext_wasm_native_lz4_t *lz4;
+    };
+};
+
+/* Stream buffers of an application, layout is shared with wasm32 applications */
+typedef struct wasm_compress_buf {
+    uint32_t in;                            /*!< Input address, it is advanced by consumed bytes */
+    uint32_t in_len;                        /*!< Available input bytes */
+    uint32_t out;                           /*!< Output address, it is advanced by produced bytes */
+    uint32_t out_len;                       /*!< Output space */
+} wasm_compress_buf_t;
+
+static const char *TAG = "wm_compress";
+
+static pthread_mutex_t s_compress_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static esp_err_t deflate_create(wm_ext_wasm_native_compress_t *stream, int level, uint32_t window_bits)
+{
+    int ret;
+    int bits = window_bits;
+
+    if (window_bits < DEFLATE_WINDOW_BITS_MIN || window_bits > DEFLATE_WINDOW_BITS_MAX ||
+            level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (stream->format == WM_EXT_WASM_NATIVE_COMPRESS_DEFLATE) {
+        bits = -bits;
+    } else if (stream->format == WM_EXT_WASM_NATIVE_COMPRESS_GZIP) {
+        bits += DEFLATE_GZIP_WINDOW_BITS;
+    }
+
+    if (stream->compress) {
+        /* Hash chains are half the size of the window, which keeps memory at 6 windows */
+        int mem_level = MIN(MAX((int)window_bits - 8, 1), DEFLATE_MEM_LEVEL_MAX);
+
+        ret = deflateInit2(&stream->zs, level, Z_DEFLATED, bits, mem_level, Z_DEFAULT_STRATEGY);
+    } else {
+        ret = inflateInit2(&stream->zs, bits);
+    }
+
+    if (ret != Z_OK) {
+        ESP_LOGD(TAG, "failed to init zlib ret=%d", ret);
+        return ret == Z_MEM_ERROR ? ESP_ERR_NO_MEM : ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t deflate_update(wm_ext_wasm_native_compress_t *stream, const uint8_t *in, uint32_t *in_len,
+                                uint8_t *out, uint32_t *out_len, bool finish, bool *end)
+{
+    int ret;
+    z_stream *zs = &stream->zs;
+
+    zs->next_in = (Bytef *)in;
+    zs->avail_in = *in_len;
+    zs->next_out = out;
+    zs->avail_out = *out_len;
+
+    if (stream->compress) {
+        ret = deflate(zs, finish ? Z_FINISH : Z_NO_FLUSH);
+    } else {
+        ret = inflate(zs, Z_NO_FLUSH);
+    }
+
+    *in_len -= zs->avail_in;
+    *out_len -= zs->avail_out;
+
+    switch (ret) {
+    case Z_STREAM_END:
+        *end = true;
+        return ESP_OK;
+    case Z_OK:
+    case Z_BUF_ERROR:
+        /* No progress is possible until more input or output space is given */
+        return ESP_OK;
+    case Z_NEED_DICT:
+        return ESP_ERR_NOT_SUPPORTED;
+    case Z_DATA_ERROR:
+        return ESP_ERR_INVALID_RESPONSE;
+    case Z_MEM_ERROR:
+        return ESP_ERR_NO_MEM;
+    default:
+        return ESP_FAIL;
+    }
+}
+
+esp_err_t wm_ext_wasm_native_compress_create(wm_ext_wasm_native_compress_format_t format, bool compress,
+                                             int level, uint32_t window_bits,
+                                             wm_ext_wasm_native_compress_t **stream)
+{
+    esp_err_t ret;
+    wm_ext_wasm_native_compress_t *s;
+
+    if (format >= WM_EXT_WASM_NATIVE_COMPRESS_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* Not from the runtime heap, the streams can be used without the runtime */
+    s = calloc(1, sizeof(wm_ext_wasm_native_compress_t));
+    if (!s) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    s->format = format;
+    s->compress = compress;
+
+    if (format == WM_EXT_WASM_NATIVE_COMPRESS_LZ4) {
+        ret = wm_ext_wasm_native_lz4_create(compress, window_bits, &s->lz4);
+    } else {
+        ret = deflate_create(s, level, window_bits);
+    }
+
+    if (ret != ESP_OK) {
+        free(s);
+        return ret;
+    }
+
+    *stream = s;
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_compress_update(wm_ext_wasm_native_compress_t *stream,
+                                             const uint8_t *in, uint32_t *in_len,
+                                             uint8_t *out, uint32_t *out_len,
+                                             bool finish, bool *end)
+{
+    *end = false;
+
+    if (stream->format == WM_EXT_WASM_NATIVE_COMPRESS_LZ4) {
+        return wm_ext_wasm_native_lz4_update(stream->lz4, in, in_len, out, out_len, finish, end);
+    }
+
+    return deflate_update(stream, in, in_len, out, out_len, finish, end);
+}
+
+void wm_ext_wasm_native_compress_destroy(wm_ext_wasm_native_compress_t *stream)
+{
+    if (!stream) {
+        return;
+    }
+
+    if (stream->format == WM_EXT_WASM_NATIVE_COMPRESS_LZ4) {
+        wm_ext_wasm_native_lz4_destroy(stream->lz4);
+    } else if (stream->compress) {
+        deflateEnd(&stream->zs);
+    } else {
+        inflateEnd(&stream->zs);
+    }
+
+    free(stream);
+}
+
+static int wasm_compress_errno(esp_err_t err)
+{
+    switch (err) {
+    case ESP_ERR_NO_MEM:
+        return -ENOMEM;
+    case ESP_ERR_INVALID_ARG:
+        return -EINVAL;
+    case ESP_ERR_INVALID_RESPONSE:
+        return -EBADMSG;
+    case ESP_ERR_NOT_SUPPORTED:
+        return -ENOTSUP;
+    default:
+        return -EIO;
+    }
+}
+
+/*
+ * Mark a stream busy, or take it out of its slot when remove is true, so threads of an
+ * application can't feed or free a stream while another thread is using it.
+ */
+static wm_ext_wasm_native_compress_t *wasm_compress_get(wasm_exec_env_t exec_env, int id, bool remove, int *err)
+{
+    wm_ext_wasm_native_compress_t *stream = NULL;
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+
+    if (!ctx || id < 0 || id >= COMPRESS_MAX_CTX) {
+        *err = -EBADF;
+        return NULL;
+    }
+
+    pthread_mutex_lock(&s_compress_lock);
+
+    stream = ctx->compress[id];
+    if (!stream) {
+        *err = -EBADF;
+    } else if (stream->busy) {
+        stream = NULL;
+        *err = -EBUSY;
+    } else if (remove) {
+        ctx->compress[id] = NULL;
+    } else {
+        stream->busy = true;
+    }
+
+    pthread_mutex_unlock(&s_compress_lock);
+
+    return stream;
+}
+
+static void wasm_compress_put(wm_ext_wasm_native_compress_t *stream)
+{
+    pthread_mutex_lock(&s_compress_lock);
+    stream->busy = false;
+    pthread_mutex_unlock(&s_compress_lock);
+}
+
+static int wasm_compress_create_wrapper(wasm_exec_env_t exec_env, int format, int compress, int level,
+                                        uint32_t window_bits)
+{
+    int id = -EMFILE;
+    esp_err_t ret;
+    wm_ext_wasm_native_compress_t *stream;
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+
+    if (!ctx) {
+        return -ENOMEM;
+    }
+
+    ret = wm_ext_wasm_native_compress_create(format, compress != 0, level, window_bits, &stream);
+    if (ret != ESP_OK) {
+        return wasm_compress_errno(ret);
+    }
+
+    pthread_mutex_lock(&s_compress_lock);
+
+    for (int i = 0; i < COMPRESS_MAX_CTX; i++) {
+        if (!ctx->compress[i]) {
+            ctx->compress[i] = stream;
+            id = i;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&s_compress_lock);
+
+    if (id < 0) {
+        wm_ext_wasm_native_compress_destroy(stream);
+    }
+
+    return id;
+}
+
+static int wasm_compress_update_wrapper(wasm_exec_env_t exec_env, int id, uint32_t buf, int finish)
+{
+    int err = 0;
+    esp_err_t ret;
+    bool end = false;
+    uint32_t in_len;
+    uint32_t out_len;
+    wasm_compress_buf_t b;
+    wm_ext_wasm_native_compress_t *stream;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!validate_app_addr(buf, sizeof(wasm_compress_buf_t))) {
+        return -EFAULT;
+    }
+
+    /* The structure may be unaligned in linear memory */
+    memcpy(&b, addr_app_to_native(buf), sizeof(wasm_compress_buf_t));
+    in_len = b.in_len;
+    out_len = b.out_len;
+    if ((in_len && !validate_app_addr(b.in, in_len)) || (out_len && !validate_app_addr(b.out, out_len))) {
+        return -EFAULT;
+    }
+
+    stream = wasm_compress_get(exec_env, id, false, &err);
+    if (!stream) {
+        return err;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_compress_update", 0, id, b.in, in_len, out_len);
+
+    ret = wm_ext_wasm_native_compress_update(stream,
+                                             in_len ? addr_app_to_native(b.in) : NULL, &in_len,
+                                             out_len ? addr_app_to_native(b.out) : NULL, &out_len,
+                                             finish != 0, &end);
+
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    wasm_compress_put(stream);
+
+    b.in += in_len;
+    b.in_len -= in_len;
+    b.out += out_len;
+    b.out_len -= out_len;
+    memcpy(addr_app_to_native(buf), &b, sizeof(wasm_compress_buf_t));
+
+    if (ret != ESP_OK) {
+        return wasm_compress_errno(ret);
+    }
+
+    return end;
+}
+
+static int wasm_compress_destroy_wrapper(wasm_exec_env_t exec_env, int id)
+{
+    int err = 0;
+    wm_ext_wasm_native_compress_t *stream = wasm_compress_get(exec_env, id, true, &err);
+
+    if (!stream) {
+        return err;
+    }
+
+    wm_ext_wasm_native_compress_destroy(stream);
+
+    return 0;
+}
+
+void wm_ext_wasm_native_compress_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx)
+{
+    for (int i = 0; i < COMPRESS_MAX_CTX; i++) {
+        if (ctx->compress[i]) {
+            wm_ext_wasm_native_compress_destroy(ctx->compress[i]);
+            ctx->compress[i] = NULL;
+        }
+    }
+}
+
+static NativeSymbol wm_compress_wrapper_native_symbol[] = {
+    REG_NATIVE_FUNC(wasm_compress_create,   "(iiii)i"),
+    REG_NATIVE_FUNC(wasm_compress_update,   "(iii)i"),
+    REG_NATIVE_FUNC(wasm_compress_destroy,  "(i)i"),
+};
+
+int wm_ext_wasm_native_compress_export(void)
+{
+    NativeSymbol *sym = (NativeSymbol *)wm_compress_wrapper_native_symbol;
+    int num = sizeof(wm_compress_wrapper_native_symbol) / sizeof(wm_compress_wrapper_native_symbol[0]);
+
+    if (!wasm_native_register_natives("env", sym,  num)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+WM_EXT_WASM_NATIVE_EXPORT_FN(wm_ext_wasm_native_compress_export)
+{
+    return wm_ext_wasm_native_compress_export();
+}
@@ -0,0 +1,695 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/param.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+
+#include "mbedtls/md.h"
+#include "mbedtls/aes.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/ecp.h"
+#include "mbedtls/ecdsa.h"
+
+#include "wasm_export.h"
+#include "wasm_native.h"
+
+#include "wm_ext_wasm_native_macro.h"
+#include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
+#include "wm_ext_wasm_native_crypto.h"
+
+/*
+ * Hashes and ciphers run by mbedTLS, which uses SHA, AES and ECC accelerators of the
+ * chip when they are enabled in its configuration and software implementations on
+ * linux target. Applications keep streaming operations as handles of their module
+ * instance and pass buffers of linear memory, so data is not copied into a WASM
+ * implementation of the algorithm.
+ */
+
+#define CRYPTO_MAX_CTX          CONFIG_WASMACHINE_WASM_EXT_NATIVE_CRYPTO_MAX_CTX
+#define CRYPTO_GCM_TAG_MIN      4
+
+typedef enum crypto_type {
+    CRYPTO_TYPE_HASH = 0,
+    CRYPTO_TYPE_AES_CTR,
+    CRYPTO_TYPE_AES_GCM,
+} crypto_type_t;
+
+struct wm_ext_wasm_native_crypto {
+    crypto_type_t type;
+    bool hmac;
+    bool decrypt;
+    bool busy;                      /*!< A native call of the application is using the operation */
+    uint8_t digest_len;
+
+    union {
+        mbedtls_md_context_t md;
+
+        struct {
+            mbedtls_aes_context aes;
+            size_t nc_off;
+            uint8_t nonce[WM_EXT_WASM_NATIVE_CRYPTO_AES_BLOCK_SIZE];
+            uint8_t stream[WM_EXT_WASM_NATIVE_CRYPTO_AES_BLOCK_SIZE];
+        } ctr;
+
+        mbedtls_gcm_context gcm;
+    };
+};
+
+static const char *TAG = "wm_crypto";
+
+static pthread_mutex_t s_crypto_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static bool crypto_aes_key_len_is_valid(uint32_t key_len)
+{
+    return key_len == 16 || key_len == 24 || key_len == 32;
+}
+
+static wm_ext_wasm_native_crypto_t *crypto_alloc(crypto_type_t type)
+{
+    /* Not from the runtime heap, the operations can be used without the runtime */
+    wm_ext_wasm_native_crypto_t *crypto = calloc(1, sizeof(wm_ext_wasm_native_crypto_t));
+
+    if (crypto) {
+        crypto->type = type;
+    }
+
+    return crypto;
+}
+
+esp_err_t wm_ext_wasm_native_crypto_hash_start(wm_ext_wasm_native_crypto_hash_t alg, const uint8_t *key,
+                                               uint32_t key_len, wm_ext_wasm_native_crypto_t **crypto)
+{
+    int ret;
+    const mbedtls_md_info_t *info;
+    wm_ext_wasm_native_crypto_t *c;
+
+    if (alg == WM_EXT_WASM_NATIVE_CRYPTO_HASH_SHA256) {
+        info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA256);
+    } else if (alg == WM_EXT_WASM_NATIVE_CRYPTO_HASH_SHA512) {
+        info = mbedtls_md_info_from_type(MBEDTLS_MD_SHA512);
+    } else {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!info) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    c = crypto_alloc(CRYPTO_TYPE_HASH);
+    if (!c) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    c->hmac = key != NULL;
+    c->digest_len = mbedtls_md_get_size(info);
+    mbedtls_md_init(&c->md);
+
+    ret = mbedtls_md_setup(&c->md, info, c->hmac);
+    if (!ret) {
+        ret = c->hmac ? mbedtls_md_hmac_starts(&c->md, key, key_len) : mbedtls_md_starts(&c->md);
+    }
+
+    if (ret) {
+        ESP_LOGD(TAG, "failed to start hash ret=-0x%x", -ret);
+        wm_ext_wasm_native_crypto_free(c);
+        return ret == MBEDTLS_ERR_MD_ALLOC_FAILED ? ESP_ERR_NO_MEM : ESP_FAIL;
+    }
+
+    *crypto = c;
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_crypto_aes_ctr_start(const uint8_t *key, uint32_t key_len, const uint8_t *iv,
+                                                  wm_ext_wasm_native_crypto_t **crypto)
+{
+    wm_ext_wasm_native_crypto_t *c;
+
+    if (!crypto_aes_key_len_is_valid(key_len)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    c = crypto_alloc(CRYPTO_TYPE_AES_CTR);
+    if (!c) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    mbedtls_aes_init(&c->ctr.aes);
+    memcpy(c->ctr.nonce, iv, WM_EXT_WASM_NATIVE_CRYPTO_AES_BLOCK_SIZE);
+
+    /* CTR mode always runs the block cipher forward */
+    if (mbedtls_aes_setkey_enc(&c->ctr.aes, key, key_len * 8)) {
+        wm_ext_wasm_native_crypto_free(c);
+        return ESP_FAIL;
+    }
+
+    *crypto = c;
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_crypto_aes_gcm_start(const uint8_t *key, uint32_t key_len,
+                                                  const uint8_t *iv, uint32_t iv_len,
+                                                  const uint8_t *aad, uint32_t aad_len,
+                                                  bool decrypt, wm_ext_wasm_native_crypto_t **crypto)
+{
+    int ret;
+    wm_ext_wasm_native_crypto_t *c;
+
+    if (!crypto_aes_key_len_is_valid(key_len) || !iv_len) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    c = crypto_alloc(CRYPTO_TYPE_AES_GCM);
+    if (!c) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    c->decrypt = decrypt;
+    mbedtls_gcm_init(&c->gcm);
+
+    ret = mbedtls_gcm_setkey(&c->gcm, MBEDTLS_CIPHER_ID_AES, key, key_len * 8);
+    if (!ret) {
+        ret = mbedtls_gcm_starts(&c->gcm, decrypt ? MBEDTLS_GCM_DECRYPT : MBEDTLS_GCM_ENCRYPT, iv, iv_len);
+    }
+    if (!ret && aad_len) {
+        ret = mbedtls_gcm_update_ad(&c->gcm, aad, aad_len);
+    }
+
+    if (ret) {
+        ESP_LOGD(TAG, "failed to start AES-GCM ret=-0x%x", -ret);
+        wm_ext_wasm_native_crypto_free(c);
+        return ESP_FAIL;
+    }
+
+    *crypto = c;
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_crypto_update(wm_ext_wasm_native_crypto_t *crypto, const uint8_t *in,
+                                           uint8_t *out, uint32_t len)
+{
+    int ret;
+    size_t olen = 0;
+
+    if (!len) {
+        return ESP_OK;
+    }
+
+    switch (crypto->type) {
+    case CRYPTO_TYPE_HASH:
+        ret = crypto->hmac ? mbedtls_md_hmac_update(&crypto->md, in, len) :
+              mbedtls_md_update(&crypto->md, in, len);
+        break;
+    case CRYPTO_TYPE_AES_CTR:
+        ret = mbedtls_aes_crypt_ctr(&crypto->ctr.aes, len, &crypto->ctr.nc_off, crypto->ctr.nonce,
+                                    crypto->ctr.stream, in, out);
+        break;
+    case CRYPTO_TYPE_AES_GCM:
+        /* GCM is a stream mode, each update outputs as many bytes as it takes */
+        ret = mbedtls_gcm_update(&crypto->gcm, in, len, out, len, &olen);
+        if (!ret && olen != len) {
+            ret = MBEDTLS_ERR_GCM_BAD_INPUT;
+        }
+        break;
+    default:
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    return ret ? ESP_FAIL : ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_crypto_finish(wm_ext_wasm_native_crypto_t *crypto, uint8_t *out, uint32_t *out_len)
+{
+    int ret = 0;
+    esp_err_t err = ESP_OK;
+    uint8_t tag[WM_EXT_WASM_NATIVE_CRYPTO_GCM_TAG_MAX];
+    uint32_t len;
+    uint8_t diff = 0;
+    size_t olen;
+
+    switch (crypto->type) {
+    case CRYPTO_TYPE_HASH:
+        len = crypto->digest_len;
+        if (*out_len < len) {
+            err = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+
+        ret = crypto->hmac ? mbedtls_md_hmac_finish(&crypto->md, out) : mbedtls_md_finish(&crypto->md, out);
+        *out_len = len;
+        break;
+    case CRYPTO_TYPE_AES_CTR:
+        *out_len = 0;
+        break;
+    case CRYPTO_TYPE_AES_GCM:
+        len = MIN(*out_len, WM_EXT_WASM_NATIVE_CRYPTO_GCM_TAG_MAX);
+        if (len < CRYPTO_GCM_TAG_MIN) {
+            err = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+
+        ret = mbedtls_gcm_finish(&crypto->gcm, NULL, 0, &olen, tag, len);
+        if (ret) {
+            break;
+        }
+
+        if (crypto->decrypt) {
+            /* Compare in constant time, so timing does not tell how many bytes match */
+            for (uint32_t i = 0; i < len; i++) {
+                diff |= tag[i] ^ out[i];
+            }
+            if (diff) {
+                err = ESP_ERR_INVALID_CRC;
+            }
+        } else {
+            memcpy(out, tag, len);
+        }
+
+        *out_len = len;
+        break;
+    default:
+        err = ESP_ERR_INVALID_STATE;
+        break;
+    }
+
+    if (ret) {
+        ESP_LOGD(TAG, "failed to finish ret=-0x%x", -ret);
+        err = ESP_FAIL;
+    }
+
+    wm_ext_wasm_native_crypto_free(crypto);
+
+    return err;
+}
+
+void wm_ext_wasm_native_crypto_free(wm_ext_wasm_native_crypto_t *crypto)
+{
+    if (!crypto) {
+        return;
+    }
+
+    switch (crypto->type) {
+    case CRYPTO_TYPE_HASH:
+        mbedtls_md_free(&crypto->md);
+        break;
+    case CRYPTO_TYPE_AES_CTR:
+        mbedtls_aes_free(&crypto->ctr.aes);
+        break;
+    case CRYPTO_TYPE_AES_GCM:
+        mbedtls_gcm_free(&crypto->gcm);
+        break;
+    default:
+        break;
+    }
+
+    /* Key schedules and stream blocks are secrets */
+    memset(crypto, 0, sizeof(wm_ext_wasm_native_crypto_t));
+    free(crypto);
+}
+
+esp_err_t wm_ext_wasm_native_crypto_ecdsa_verify(wm_ext_wasm_native_crypto_curve_t curve,
+                                                 const uint8_t *pubkey, uint32_t pubkey_len,
+                                                 const uint8_t *hash, uint32_t hash_len,
+                                                 const uint8_t *sig, uint32_t sig_len)
+{
+    int ret;
+    size_t n;
+    mbedtls_ecp_group_id id;
+    mbedtls_ecp_group grp;
+    mbedtls_ecp_point q;
+    mbedtls_mpi r, s;
+    esp_err_t err = ESP_FAIL;
+
+    if (curve == WM_EXT_WASM_NATIVE_CRYPTO_CURVE_P256) {
+        id = MBEDTLS_ECP_DP_SECP256R1;
+    } else if (curve == WM_EXT_WASM_NATIVE_CRYPTO_CURVE_P384) {
+        id = MBEDTLS_ECP_DP_SECP384R1;
+    } else {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    mbedtls_ecp_group_init(&grp);
+    mbedtls_ecp_point_init(&q);
+    mbedtls_mpi_init(&r);
+    mbedtls_mpi_init(&s);
+
+    if (mbedtls_ecp_group_load(&grp, id)) {
+        err = ESP_ERR_NOT_SUPPORTED;
+        goto exit;
+    }
+
+    n = mbedtls_mpi_size(&grp.N);
+    if (sig_len != n * 2 || !hash_len) {
+        err = ESP_ERR_INVALID_ARG;
+        goto exit;
+    }
+
+    if (mbedtls_ecp_point_read_binary(&grp, &q, pubkey, pubkey_len) ||
+            mbedtls_ecp_check_pubkey(&grp, &q)) {
+        err = ESP_ERR_INVALID_ARG;
+        goto exit;
+    }
+
+    if (mbedtls_mpi_read_binary(&r, sig, n) || mbedtls_mpi_read_binary(&s, sig + n, n)) {
+        err = ESP_ERR_NO_MEM;
+        goto exit;
+    }
+
+    ret = mbedtls_ecdsa_verify(&grp, hash, hash_len, &q, &r, &s);
+    if (!ret) {
+        err = ESP_OK;
+    } else if (ret == MBEDTLS_ERR_ECP_VERIFY_FAILED) {
+        err = ESP_ERR_INVALID_CRC;
+    } else {
+        ESP_LOGD(TAG, "failed to verify ret=-0x%x", -ret);
+    }
+
+exit:
+    mbedtls_mpi_free(&s);
+    mbedtls_mpi_free(&r);
+    mbedtls_ecp_point_free(&q);
+    mbedtls_ecp_group_free(&grp);
+
+    return err;
+}
+
+static int wasm_crypto_errno(esp_err_t err)
+{
+    switch (err) {
+    case ESP_ERR_NO_MEM:
+        return ENOMEM;
+    case ESP_ERR_INVALID_ARG:
+    case ESP_ERR_INVALID_SIZE:
+        return EINVAL;
+    case ESP_ERR_NOT_SUPPORTED:
+        return ENOTSUP;
+    case ESP_ERR_INVALID_CRC:
+        return EBADMSG;
+    default:
+        return EIO;
+    }
+}
+
+/* Ranges of zero length map to NULL, other ranges must be inside linear memory */
+static bool wasm_crypto_map(wasm_module_inst_t module_inst, uint32_t addr, uint32_t len, uint8_t **ptr)
+{
+    if (!len) {
+        *ptr = NULL;
+        return true;
+    }
+
+    if (!validate_app_addr(addr, len)) {
+        return false;
+    }
+
+    *ptr = addr_app_to_native(addr);
+
+    return true;
+}
+
+static int wasm_crypto_add(wasm_exec_env_t exec_env, wm_ext_wasm_native_crypto_t *crypto, esp_err_t err)
+{
+    int id = -EMFILE;
+    wm_ext_wasm_native_ctx_t *ctx;
+
+    if (err != ESP_OK) {
+        return -wasm_crypto_errno(err);
+    }
+
+    ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+    if (!ctx) {
+        wm_ext_wasm_native_crypto_free(crypto);
+        return -ENOMEM;
+    }
+
+    pthread_mutex_lock(&s_crypto_lock);
+
+    for (int i = 0; i < CRYPTO_MAX_CTX; i++) {
+        if (!ctx->crypto[i]) {
+            ctx->crypto[i] = crypto;
+            id = i;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&s_crypto_lock);
+
+    if (id < 0) {
+        wm_ext_wasm_native_crypto_free(crypto);
+    }
+
+    return id;
+}
+
+/*
+ * Mark an operation busy, or take it out of its slot when remove is true, so threads of an
+ * application can't feed or free an operation while another thread is using it.
+ */
+static int wasm_crypto_get(wasm_exec_env_t exec_env, int id, bool remove, wm_ext_wasm_native_crypto_t **crypto)
+{
+    int ret = 0;
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+
+    if (!ctx || id < 0 || id >= CRYPTO_MAX_CTX) {
+        return -EBADF;
+    }
+
+    pthread_mutex_lock(&s_crypto_lock);
+
+    *crypto = ctx->crypto[id];
+    if (!*crypto) {
+        ret = -EBADF;
+    } else if ((*crypto)->busy) {
+        *crypto = NULL;
+        ret = -EBUSY;
+    } else if (remove) {
+        ctx->crypto[id] = NULL;
+    } else {
+        (*crypto)->busy = true;
+    }
+
+    pthread_mutex_unlock(&s_crypto_lock);
+
+    return ret;
+}
+
+static void wasm_crypto_put(wm_ext_wasm_native_crypto_t *crypto)
+{
+    pthread_mutex_lock(&s_crypto_lock);
+    crypto->busy = false;
+    pthread_mutex_unlock(&s_crypto_lock);
+}
+
+static int wasm_crypto_hash_start_wrapper(wasm_exec_env_t exec_env, int alg)
+{
+    wm_ext_wasm_native_crypto_t *crypto = NULL;
+    esp_err_t err = wm_ext_wasm_native_crypto_hash_start(alg, NULL, 0, &crypto);
+
+    return wasm_crypto_add(exec_env, crypto, err);
+}
+
+static int wasm_crypto_hmac_start_wrapper(wasm_exec_env_t exec_env, int alg, uint32_t key, uint32_t key_len)
+{
+    uint8_t *key_ptr;
+    wm_ext_wasm_native_crypto_t *crypto = NULL;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    esp_err_t err;
+
+    if (!wasm_crypto_map(module_inst, key, key_len, &key_ptr)) {
+        return -EFAULT;
+    }
+
+    /* An empty HMAC key is valid, it is not a plain hash */
+    err = wm_ext_wasm_native_crypto_hash_start(alg, key_ptr ? key_ptr : (const uint8_t *)"", key_len, &crypto);
+
+    return wasm_crypto_add(exec_env, crypto, err);
+}
+
+static int wasm_crypto_aes_ctr_start_wrapper(wasm_exec_env_t exec_env, uint32_t key, uint32_t key_len, uint32_t iv)
+{
+    uint8_t *key_ptr;
+    uint8_t *iv_ptr;
+    wm_ext_wasm_native_crypto_t *crypto = NULL;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    esp_err_t err;
+
+    if (!wasm_crypto_map(module_inst, key, key_len, &key_ptr) ||
+            !wasm_crypto_map(module_inst, iv, WM_EXT_WASM_NATIVE_CRYPTO_AES_BLOCK_SIZE, &iv_ptr)) {
+        return -EFAULT;
+    }
+
+    err = wm_ext_wasm_native_crypto_aes_ctr_start(key_ptr, key_len, iv_ptr, &crypto);
+
+    return wasm_crypto_add(exec_env, crypto, err);
+}
+
+static int wasm_crypto_aes_gcm_start_wrapper(wasm_exec_env_t exec_env, uint32_t key, uint32_t key_len,
+                                             uint32_t iv, uint32_t iv_len, uint32_t aad, uint32_t aad_len,
+                                             int decrypt)
+{
+    uint8_t *key_ptr;
+    uint8_t *iv_ptr;
+    uint8_t *aad_ptr;
+    wm_ext_wasm_native_crypto_t *crypto = NULL;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    esp_err_t err;
+
+    if (!wasm_crypto_map(module_inst, key, key_len, &key_ptr) ||
+            !wasm_crypto_map(module_inst, iv, iv_len, &iv_ptr) ||
+            !wasm_crypto_map(module_inst, aad, aad_len, &aad_ptr)) {
+        return -EFAULT;
+    }
+
+    err = wm_ext_wasm_native_crypto_aes_gcm_start(key_ptr, key_len, iv_ptr, iv_len, aad_ptr, aad_len,
+                                                  decrypt != 0, &crypto);
+
+    return wasm_crypto_add(exec_env, crypto, err);
+}
+
+static int wasm_crypto_update_wrapper(wasm_exec_env_t exec_env, int id, uint32_t in, uint32_t out, uint32_t len)
+{
+    int ret;
+    esp_err_t err;
+    uint8_t *in_ptr;
+    uint8_t *out_ptr = NULL;
+    wm_ext_wasm_native_crypto_t *crypto;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    ret = wasm_crypto_get(exec_env, id, false, &crypto);
+    if (ret < 0) {
+        return ret;
+    }
+
+    if (!wasm_crypto_map(module_inst, in, len, &in_ptr) ||
+            (crypto->type != CRYPTO_TYPE_HASH && !wasm_crypto_map(module_inst, out, len, &out_ptr))) {
+        wasm_crypto_put(crypto);
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_crypto_update", 0, id, in, out, len);
+
+    err = wm_ext_wasm_native_crypto_update(crypto, in_ptr, out_ptr, len);
+
+    WM_EXT_WASM_NATIVE_TRACE_END(err);
+
+    wasm_crypto_put(crypto);
+
+    return err == ESP_OK ? 0 : -wasm_crypto_errno(err);
+}
+
+static int wasm_crypto_finish_wrapper(wasm_exec_env_t exec_env, int id, uint32_t out, uint32_t out_len)
+{
+    int ret;
+    esp_err_t err;
+    uint8_t *out_ptr;
+    wm_ext_wasm_native_crypto_t *crypto;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!wasm_crypto_map(module_inst, out, out_len, &out_ptr)) {
+        return -EFAULT;
+    }
+
+    ret = wasm_crypto_get(exec_env, id, true, &crypto);
+    if (ret < 0) {
+        return ret;
+    }
+
+    err = wm_ext_wasm_native_crypto_finish(crypto, out_ptr, &out_len);
+
+    return err == ESP_OK ? out_len : -wasm_crypto_errno(err);
+}
+
+static int wasm_crypto_free_wrapper(wasm_exec_env_t exec_env, int id)
+{
+    wm_ext_wasm_native_crypto_t *crypto;
+    int ret = wasm_crypto_get(exec_env, id, true, &crypto);
+
+    if (ret < 0) {
+        return ret;
+    }
+
+    wm_ext_wasm_native_crypto_free(crypto);
+
+    return 0;
+}
+
+static int wasm_crypto_ecdsa_verify_wrapper(wasm_exec_env_t exec_env, int curve,
+                                            uint32_t pubkey, uint32_t pubkey_len,
+                                            uint32_t hash, uint32_t hash_len,
+                                            uint32_t sig, uint32_t sig_len)
+{
+    esp_err_t err;
+    uint8_t *pubkey_ptr;
+    uint8_t *hash_ptr;
+    uint8_t *sig_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!pubkey_len || !hash_len || !sig_len) {
+        return -EINVAL;
+    }
+
+    if (!wasm_crypto_map(module_inst, pubkey, pubkey_len, &pubkey_ptr) ||
+            !wasm_crypto_map(module_inst, hash, hash_len, &hash_ptr) ||
+            !wasm_crypto_map(module_inst, sig, sig_len, &sig_ptr)) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_crypto_ecdsa_verify", 0, curve, pubkey_len, hash_len, sig_len);
+
+    err = wm_ext_wasm_native_crypto_ecdsa_verify(curve, pubkey_ptr, pubkey_len, hash_ptr, hash_len,
+                                                 sig_ptr, sig_len);
+
+    WM_EXT_WASM_NATIVE_TRACE_END(err);
+
+    return err == ESP_OK ? 0 : -wasm_crypto_errno(err);
+}
+
+void wm_ext_wasm_native_crypto_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx)
+{
+    for (int i = 0; i < CRYPTO_MAX_CTX; i++) {
+        if (ctx->crypto[i]) {
+            wm_ext_wasm_native_crypto_free(ctx->crypto[i]);
+            ctx->crypto[i] = NULL;
+        }
+    }
+}
+
+static NativeSymbol wm_crypto_wrapper_native_symbol[] = {
+    REG_NATIVE_FUNC(wasm_crypto_hash_start,     "(i)i"),
+    REG_NATIVE_FUNC(wasm_crypto_hmac_start,     "(iii)i"),
+    REG_NATIVE_FUNC(wasm_crypto_aes_ctr_start,  "(iii)i"),
+    REG_NATIVE_FUNC(wasm_crypto_aes_gcm_start,  "(iiiiiii)i"),
+    REG_NATIVE_FUNC(wasm_crypto_update,         "(iiii)i"),
+    REG_NATIVE_FUNC(wasm_crypto_finish,         "(iii)i"),
+    REG_NATIVE_FUNC(wasm_crypto_free,           "(i)i"),
+    REG_NATIVE_FUNC(wasm_crypto_ecdsa_verify,   "(iiiiiii)i"),
+};
+
+int wm_ext_wasm_native_crypto_export(void)
+{
+    NativeSymbol *sym = (NativeSymbol *)wm_crypto_wrapper_native_symbol;
+    int num = sizeof(wm_crypto_wrapper_native_symbol) / sizeof(wm_crypto_wrapper_native_symbol[0]);
+
+    if (!wasm_native_register_natives("env", sym,  num)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+WM_EXT_WASM_NATIVE_EXPORT_FN(wm_ext_wasm_native_crypto_export)
+{
+    return wm_ext_wasm_native_crypto_export();
+}
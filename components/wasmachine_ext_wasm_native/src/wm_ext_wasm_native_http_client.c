@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -21,11 +21,12 @@
 
 #include "wm_ext_wasm_native_macro.h"
 #include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/event_groups.h>
-#include "esp_memory_utils.h"
 #include <esp_log.h>
 #include <esp_event.h>
 #include <esp_http_client.h>
@@ -102,15 +103,17 @@ static const char *TAG = "http_client_wrapper";
 #define http_client_native_get_arg(type, name)     type name = *((type *)(args++))
 #define http_client_native_set_return(val)         *args_ret = (uint32_t)(val)
 
-#define DEFINE_HTTP_CLIENT_NATIVE_WRAPPER(func_name)                   \
-    static int func_name ## _wrapper(wasm_exec_env_t exec_env, \
-                                      uint32_t *args,           \
-                                      uint32_t *args_ret)
+#define DEFINE_HTTP_CLIENT_NATIVE_WRAPPER(func_name)                \
+    static int func_name ## _wrapper(wasm_exec_env_t exec_env,      \
+                                     wm_ext_wasm_native_mem_t *mem, \
+                                     uint32_t *args,                \
+                                     uint32_t *args_ret)
 
 #define HTTP_CLIENT_NATIVE_WRAPPER(id, func_name, argc)                \
     [id] = { func_name ## _wrapper, argc }
 
-typedef int (*http_client_func_t)(wasm_exec_env_t exec_env, uint32_t *args, uint32_t *args_ret);
+typedef int (*http_client_func_t)(wasm_exec_env_t exec_env, wm_ext_wasm_native_mem_t *mem,
+                                  uint32_t *args, uint32_t *args_ret);
 
 typedef struct http_client_func_desc {
     http_client_func_t  func;
@@ -118,7 +121,7 @@ typedef struct http_client_func_desc {
 } http_client_func_desc_t;
 
 typedef struct __http_client_wrapper_ctx_t {
-    wasm_exec_env_t             exec_env;
+    wasm_module_inst_t          module_inst;
     esp_http_client_handle_t    client;
     uint32_t                    event_handler;
     void                        *user_data;
@@ -127,62 +130,52 @@ typedef struct __http_client_wrapper_ctx_t {
 
 #define CONFIG_HTTP_CLIENT_HEAP_SIZE 16384
 
-static bool ptr_is_in_ram_or_rom(const void *ptr)
+static bool http_client_run_wasm(wasm_module_inst_t module_inst, uint32_t cb, int argc, uint32_t *argv)
 {
-    bool ret = false;
-
-    if (esp_ptr_in_dram(ptr)) {
-        ret = true;
-    } else if (esp_ptr_in_drom(ptr)) {
-        ret = true;
-    } else if (esp_ptr_external_ram(ptr)) {
-        ret = true;
+    wasm_exec_env_t exec_env = wm_ext_wasm_native_get_exec_env(module_inst, CONFIG_HTTP_CLIENT_HEAP_SIZE);
+    if (!exec_env) {
+        ESP_LOGE(TAG, "failed to create execution environment");
+        return false;
     }
 
+    bool ret = wasm_runtime_call_indirect(exec_env, cb, argc, argv);
+    if (!ret) {
+        ESP_LOGE(TAG, "failed to run WASM callback as %s", wasm_runtime_get_exception(get_module_inst(exec_env)));
+    }
+
+    wm_ext_wasm_native_put_exec_env(module_inst, exec_env);
+
     return ret;
 }
 
-static char *map_string(wasm_exec_env_t exec_env, const char *str)
+/* Map a string passed by WASM App, NULL is kept as it is */
+static bool http_client_map_str(wm_ext_wasm_native_mem_t *mem, const char **str)
 {
-    void *ptr;
-    wasm_module_inst_t module_inst = get_module_inst(exec_env);
-
-    if (ptr_is_in_ram_or_rom(str)) {
-        return (void *)str;
+    if (!*str) {
+        return true;
     }
 
-    ptr = str ? (char *)addr_app_to_native((uint32_t)str) : NULL;
-    if (str && !ptr) {
-        ESP_LOGE(TAG, "failed to map str=%p", str);
-    } else {
-        str = ptr;
-    }
+    *str = wm_ext_wasm_native_map_string(mem, *str);
 
-    return (char *)str;
+    return *str != NULL;
 }
 
-static bool http_client_run_wasm(wasm_exec_env_t env, uint32_t cb, int argc, uint32_t *argv)
+/* Map a buffer of len bytes passed by WASM App, or a string if len is 0 */
+static bool http_client_map_buf(wm_ext_wasm_native_mem_t *mem, const char **buf, size_t len)
 {
-    wasm_exec_env_t exec_env = wasm_runtime_create_exec_env(get_module_inst(env), CONFIG_HTTP_CLIENT_HEAP_SIZE);
-    if (!exec_env) {
-        ESP_LOGE(TAG, "failed to create execution environment");
-        return false;
+    if (!len || !*buf) {
+        return http_client_map_str(mem, buf);
     }
 
-    bool ret = wasm_runtime_call_indirect(exec_env, cb, argc, argv);
-    if (!ret) {
-        ESP_LOGE(TAG, "failed to run WASM callback as %s", wasm_runtime_get_exception(get_module_inst(exec_env)));
-    }
-
-    wasm_runtime_destroy_exec_env(exec_env);
+    *buf = wm_ext_wasm_native_map_range(mem, (uint32_t)(uintptr_t)*buf, len);
 
-    return ret;
+    return *buf != NULL;
 }
 
 static esp_err_t wasm_http_client_event_handler(esp_http_client_event_t *evt)
 {
     http_client_wrapper_ctx_t *http_client_wrapper = evt->user_data;
-    wasm_module_inst_t module_inst = get_module_inst(http_client_wrapper->exec_env);
+    wasm_module_inst_t module_inst = http_client_wrapper->module_inst;
     uint32_t key = 0, value = 0;
 
     uint32_t argv[4] = { 0 };
@@ -222,7 +215,7 @@ static esp_err_t wasm_http_client_event_handler(esp_http_client_event_t *evt)
         break;
     }
 
-    http_client_run_wasm(http_client_wrapper->exec_env, http_client_wrapper->event_handler, sizeof(argv) / sizeof(argv[0]), argv);
+    http_client_run_wasm(http_client_wrapper->module_inst, http_client_wrapper->event_handler, sizeof(argv) / sizeof(argv[0]), argv);
 
     if (key) {
         wasm_runtime_module_free(module_inst, key);
@@ -282,22 +275,29 @@ DEFINE_HTTP_CLIENT_NATIVE_WRAPPER(http_client_init)
         .if_name                        = (struct ifreq *)args[35],
     };
 
-    http_client_wrapper->exec_env = exec_env;
+    /**
+     * The execution environment may belong to a thread spawned by the WASM App,
+     * which can exit before the client is cleaned up, so keep the module instance.
+     */
+    http_client_wrapper->module_inst = module_inst;
     http_client_wrapper->event_handler = args[22];
     http_client_wrapper->user_data = (void *)args[26];
     http_client_wrapper->crt_bundle_attach = args[30];
 
-    config.url = map_string(exec_env, config.url);
-    config.host = map_string(exec_env, config.host);
-    config.username = map_string(exec_env, config.username);
-    config.password = map_string(exec_env, config.password);
-    config.path = map_string(exec_env, config.path);
-    config.query = map_string(exec_env, config.query);
-    config.cert_pem = map_string(exec_env, config.cert_pem);
-    config.client_cert_pem = map_string(exec_env, config.client_cert_pem);
-    config.client_key_pem = map_string(exec_env, config.client_key_pem);
-    config.client_key_password = map_string(exec_env, config.client_key_password);
-    config.user_agent = map_string(exec_env, config.user_agent);
+    if (!http_client_map_str(mem, &config.url) ||
+            !http_client_map_str(mem, &config.host) ||
+            !http_client_map_str(mem, &config.username) ||
+            !http_client_map_str(mem, &config.password) ||
+            !http_client_map_str(mem, &config.path) ||
+            !http_client_map_str(mem, &config.query) ||
+            !http_client_map_buf(mem, &config.cert_pem, config.cert_len) ||
+            !http_client_map_buf(mem, &config.client_cert_pem, config.client_cert_len) ||
+            !http_client_map_buf(mem, &config.client_key_pem, config.client_key_len) ||
+            !http_client_map_buf(mem, &config.client_key_password, config.client_key_password_len) ||
+            !http_client_map_str(mem, &config.user_agent)) {
+        ESP_LOGE(TAG, "Failed to map strings out of linear memory");
+        goto fail;
+    }
 
     if (!validate_app_addr((uint32_t)config.if_name, sizeof(struct ifreq))) {
         ESP_LOGE(TAG, "Failed to check args by runtime");
@@ -329,7 +329,12 @@ DEFINE_HTTP_CLIENT_NATIVE_WRAPPER(http_client_set_str)
     http_client_native_get_arg(const http_client_wrapper_ctx_t *, http_client_wrapper);
     http_client_native_get_arg(const char *, buffer);
 
-    buffer = map_string(exec_env, buffer);
+    /* Post field and written data are buffers of len bytes, others are strings */
+    if (mode != HTTP_CLIENT_SET_POST_FILED && mode != HTTP_CLIENT_WRITE_DATA) {
+        if (!http_client_map_str(mem, &buffer)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
 
     switch (mode) {
     case HTTP_CLIENT_SET_URL:
@@ -337,12 +342,17 @@ DEFINE_HTTP_CLIENT_NATIVE_WRAPPER(http_client_set_str)
         break;
     case HTTP_CLIENT_SET_POST_FILED: {
         http_client_native_get_arg(const int, len);
+        if (len < 0 || !http_client_map_buf(mem, &buffer, len)) {
+            return ESP_ERR_INVALID_ARG;
+        }
         ret = esp_http_client_set_post_field(http_client_wrapper->client, buffer, len);
     }
     break;
     case HTTP_CLIENT_SET_HEADER: {
         http_client_native_get_arg(const char *, value);
-        value = map_string(exec_env, value);
+        if (!http_client_map_str(mem, &value)) {
+            return ESP_ERR_INVALID_ARG;
+        }
         ret = esp_http_client_set_header(http_client_wrapper->client, buffer, value);
     }
     break;
@@ -357,6 +367,9 @@ DEFINE_HTTP_CLIENT_NATIVE_WRAPPER(http_client_set_str)
         break;
     case HTTP_CLIENT_WRITE_DATA: {
         http_client_native_get_arg(const int, len);
+        if (len < 0 || !http_client_map_buf(mem, &buffer, len)) {
+            return ESP_ERR_INVALID_ARG;
+        }
         ret = esp_http_client_write(http_client_wrapper->client, buffer, len);
     }
     break;
@@ -377,7 +390,17 @@ DEFINE_HTTP_CLIENT_NATIVE_WRAPPER(http_client_get_str)
     http_client_native_get_arg(char *, buffer);
     http_client_native_get_arg(const int, len);
 
-    buffer = map_string(exec_env, buffer);
+    /*
+     * The header key is a string, others are output buffers of len bytes, which can be
+     * NULL to get the length.
+     */
+    if (mode == HTTP_CLIENT_GET_HEADER) {
+        if (!http_client_map_str(mem, (const char **)&buffer)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    } else if (len < 0 || !http_client_map_buf(mem, (const char **)&buffer, len)) {
+        return ESP_ERR_INVALID_ARG;
+    }
 
     switch (mode) {
     case HTTP_CLIENT_GET_POST_FILED:
@@ -395,7 +418,9 @@ DEFINE_HTTP_CLIENT_NATIVE_WRAPPER(http_client_get_str)
         break;
     case HTTP_CLIENT_GET_HEADER: {
         http_client_native_get_arg(char *, value);
-        value = map_string(exec_env, value);
+        if (len < 0 || !http_client_map_buf(mem, (const char **)&value, len)) {
+            return ESP_ERR_INVALID_ARG;
+        }
         ret = esp_http_client_get_header(http_client_wrapper->client, buffer, &data);
         if (data) {
             if (value && len == strlen(data)) {
@@ -577,6 +602,7 @@ static int wasm_http_client_call_native_func_wrapper(wasm_exec_env_t exec_env, i
         uint32_t size;
         uint32_t argv_copy_buf[HTTP_CLIENT_ARG_BUF_NUM];
         uint32_t *argv_copy = argv_copy_buf;
+        wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
 
         if (argc > HTTP_CLIENT_ARG_BUF_NUM) {
             if (argc > HTTP_CLIENT_ARG_NUM_MAX) {
@@ -600,7 +626,11 @@ static int wasm_http_client_call_native_func_wrapper(wasm_exec_env_t exec_env, i
 
         ESP_LOGD(TAG, "func_id=%"PRIx32" is to do", func_id);
 
-        int ret = func_desc->func(exec_env, argv_copy, argv);
+        WM_EXT_WASM_NATIVE_TRACE_BEGIN_ARGV("http_client", func_id, argv_copy, argc);
+
+        int ret = func_desc->func(exec_env, &mem, argv_copy, argv);
+
+        WM_EXT_WASM_NATIVE_TRACE_END(ret);
 
         if (argv_copy != argv_copy_buf) {
             wasm_runtime_free(argv_copy);
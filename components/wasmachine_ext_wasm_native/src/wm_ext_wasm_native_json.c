@@ -0,0 +1,1252 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <inttypes.h>
+#include <math.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+
+#include "wasm_export.h"
+#include "wasm_native.h"
+
+#include "wm_ext_wasm_native_macro.h"
+#include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_trace.h"
+#include "wm_ext_wasm_native_json.h"
+
+/*
+ * JSON parsing and writing on buffers of linear memory. Parsing doesn't copy or
+ * allocate, it fills a token array of the application with offsets into the text,
+ * and the writer keeps its state in a structure of the application, so no native
+ * memory is held between calls.
+ */
+
+#define JSON_NONE                   UINT32_MAX
+#define JSON_NUMBER_TEXT_MAX        64
+
+typedef enum json_state {
+    JSON_STATE_VALUE = 0,                   /*!< A value must follow */
+    JSON_STATE_FIRST_VALUE,                 /*!< A value or end of array must follow */
+    JSON_STATE_KEY,                         /*!< A key must follow */
+    JSON_STATE_FIRST_KEY,                   /*!< A key or end of object must follow */
+    JSON_STATE_AFTER,                       /*!< A comma, end of container or end of text must follow */
+} json_state_t;
+
+/* Document of an application, layout is shared with wasm32 applications */
+typedef struct wasm_json {
+    uint32_t json;
+    uint32_t len;
+    uint32_t tokens;
+    uint32_t max_tokens;
+    uint32_t count;
+} wasm_json_t;
+
+/* Writer of an application, layout is shared with wasm32 applications */
+typedef struct wasm_json_writer {
+    uint32_t buf;
+    uint32_t size;
+    uint32_t len;
+    uint32_t depth;
+    uint32_t comma;
+    uint32_t object;
+} wasm_json_writer_t;
+
+static const char *TAG = "wm_json";
+
+static inline bool json_is_digit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static int json_hex(char c)
+{
+    if (json_is_digit(c)) {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+
+    return -1;
+}
+
+/* Scan a string from after its opening quote, p is left after its closing quote */
+static esp_err_t json_scan_string(const char **p, const char *end, uint8_t *flags)
+{
+    const char *s = *p;
+
+    while (s < end) {
+        uint8_t c = (uint8_t)*s++;
+
+        if (c == '"') {
+            *p = s;
+            return ESP_OK;
+        } else if (c < 0x20) {
+            return ESP_ERR_INVALID_RESPONSE;
+        } else if (c == '\\') {
+            if (s >= end) {
+                return ESP_ERR_INVALID_RESPONSE;
+            }
+
+            c = (uint8_t)*s++;
+            if (c == 'u') {
+                if (end - s < 4) {
+                    return ESP_ERR_INVALID_RESPONSE;
+                }
+                for (int i = 0; i < 4; i++) {
+                    if (json_hex(*s++) < 0) {
+                        return ESP_ERR_INVALID_RESPONSE;
+                    }
+                }
+            } else if (!c || !strchr("\"\\/bfnrt", c)) {
+                return ESP_ERR_INVALID_RESPONSE;
+            }
+
+            *flags |= WM_EXT_WASM_NATIVE_JSON_ESCAPED;
+        }
+    }
+
+    return ESP_ERR_INVALID_RESPONSE;
+}
+
+static esp_err_t json_scan_number(const char **p, const char *end)
+{
+    const char *s = *p;
+
+    if (s < end && *s == '-') {
+        s++;
+    }
+
+    if (s < end && *s == '0') {
+        s++;
+    } else if (s < end && json_is_digit(*s)) {
+        while (s < end && json_is_digit(*s)) {
+            s++;
+        }
+    } else {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    if (s < end && *s == '.') {
+        if (++s >= end || !json_is_digit(*s)) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        while (s < end && json_is_digit(*s)) {
+            s++;
+        }
+    }
+
+    if (s < end && (*s == 'e' || *s == 'E')) {
+        if (++s < end && (*s == '+' || *s == '-')) {
+            s++;
+        }
+        if (s >= end || !json_is_digit(*s)) {
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        while (s < end && json_is_digit(*s)) {
+            s++;
+        }
+    }
+
+    *p = s;
+
+    return ESP_OK;
+}
+
+static esp_err_t json_scan_literal(const char **p, const char *end, const char *literal, uint32_t len)
+{
+    if ((uint32_t)(end - *p) < len || memcmp(*p, literal, len)) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    *p += len;
+
+    return ESP_OK;
+}
+
+static esp_err_t json_scan_scalar(const char **p, const char *end, wm_ext_wasm_native_json_token_t *token)
+{
+    switch (**p) {
+    case '"':
+        token->type = WM_EXT_WASM_NATIVE_JSON_STRING;
+        token->start++;
+        (*p)++;
+        return json_scan_string(p, end, &token->flags);
+    case 't':
+        token->type = WM_EXT_WASM_NATIVE_JSON_TRUE;
+        return json_scan_literal(p, end, "true", 4);
+    case 'f':
+        token->type = WM_EXT_WASM_NATIVE_JSON_FALSE;
+        return json_scan_literal(p, end, "false", 5);
+    case 'n':
+        token->type = WM_EXT_WASM_NATIVE_JSON_NULL;
+        return json_scan_literal(p, end, "null", 4);
+    default:
+        token->type = WM_EXT_WASM_NATIVE_JSON_NUMBER;
+        return json_scan_number(p, end);
+    }
+}
+
+/*
+ * Parse without recursion, "next" of an open container holds the index of its parent
+ * until the container ends, so nesting depth is only limited by the token array.
+ */
+esp_err_t wm_ext_wasm_native_json_parse(wm_ext_wasm_native_json_t *doc)
+{
+    esp_err_t ret;
+    const char *p;
+    const char *end;
+    uint32_t n = 0;
+    uint32_t parent = JSON_NONE;
+    json_state_t state = JSON_STATE_VALUE;
+    wm_ext_wasm_native_json_token_t *tokens;
+
+    if (!doc || (!doc->json && doc->len) || (!doc->tokens && doc->max_tokens)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    doc->count = 0;
+    tokens = doc->tokens;
+    p = doc->json;
+    end = doc->json + doc->len;
+
+    for (;;) {
+        wm_ext_wasm_native_json_token_t *token;
+        bool in_object;
+
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+            p++;
+        }
+
+        if (p >= end) {
+            if (state == JSON_STATE_AFTER && parent == JSON_NONE) {
+                break;
+            }
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+
+        in_object = parent != JSON_NONE && tokens[parent].type == WM_EXT_WASM_NATIVE_JSON_OBJECT;
+
+        if ((state == JSON_STATE_FIRST_KEY && *p == '}') ||
+                (state == JSON_STATE_FIRST_VALUE && *p == ']') ||
+                (state == JSON_STATE_AFTER && parent != JSON_NONE && *p == (in_object ? '}' : ']'))) {
+            token = &tokens[parent];
+            p++;
+            token->len = (uint32_t)(p - doc->json) - token->start;
+            parent = token->next;
+            token->next = n;
+            state = JSON_STATE_AFTER;
+            continue;
+        }
+
+        if (state == JSON_STATE_AFTER) {
+            if (parent == JSON_NONE || *p != ',') {
+                return ESP_ERR_INVALID_RESPONSE;
+            }
+            p++;
+            state = in_object ? JSON_STATE_KEY : JSON_STATE_VALUE;
+            continue;
+        }
+
+        if (n >= doc->max_tokens) {
+            return ESP_ERR_NO_MEM;
+        }
+
+        token = &tokens[n];
+        memset(token, 0, sizeof(wm_ext_wasm_native_json_token_t));
+        token->start = (uint32_t)(p - doc->json);
+
+        if (state == JSON_STATE_KEY || state == JSON_STATE_FIRST_KEY) {
+            if (*p != '"') {
+                return ESP_ERR_INVALID_RESPONSE;
+            }
+
+            ret = json_scan_scalar(&p, end, token);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+            token->len = (uint32_t)(p - doc->json) - token->start - 1;
+            token->next = ++n;
+            tokens[parent].size++;
+
+            while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) {
+                p++;
+            }
+            if (p >= end || *p++ != ':') {
+                return ESP_ERR_INVALID_RESPONSE;
+            }
+            state = JSON_STATE_VALUE;
+            continue;
+        }
+
+        if (parent != JSON_NONE && !in_object) {
+            tokens[parent].size++;
+        }
+
+        if (*p == '{' || *p == '[') {
+            token->type = *p == '{' ? WM_EXT_WASM_NATIVE_JSON_OBJECT : WM_EXT_WASM_NATIVE_JSON_ARRAY;
+            token->next = parent;
+            parent = n++;
+            state = *p == '{' ? JSON_STATE_FIRST_KEY : JSON_STATE_FIRST_VALUE;
+            p++;
+            continue;
+        }
+
+        ret = json_scan_scalar(&p, end, token);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        token->len = (uint32_t)(p - doc->json) - token->start;
+        if (token->type == WM_EXT_WASM_NATIVE_JSON_STRING) {
+            token->len--;
+        }
+        token->next = ++n;
+        state = JSON_STATE_AFTER;
+    }
+
+    doc->count = n;
+
+    return ESP_OK;
+}
+
+/*
+ * Tokens may be written by an application after parsing, so indexes and offsets are
+ * checked before they are used, and "next" must move forward to end every loop.
+ */
+static const wm_ext_wasm_native_json_token_t *json_token(const wm_ext_wasm_native_json_t *doc, uint32_t index)
+{
+    const wm_ext_wasm_native_json_token_t *token;
+
+    if (index >= doc->count || index >= doc->max_tokens) {
+        return NULL;
+    }
+
+    token = &doc->tokens[index];
+    if (token->start > doc->len || token->len > doc->len - token->start || token->next <= index) {
+        return NULL;
+    }
+
+    return token;
+}
+
+static esp_err_t json_child(const wm_ext_wasm_native_json_t *doc, uint32_t parent, const char *key, uint32_t key_len,
+                            uint32_t array_index, uint32_t *index)
+{
+    const wm_ext_wasm_native_json_token_t *token = json_token(doc, parent);
+    uint32_t i = parent + 1;
+
+    if (!token) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (key ? token->type != WM_EXT_WASM_NATIVE_JSON_OBJECT : token->type != WM_EXT_WASM_NATIVE_JSON_ARRAY) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    for (uint32_t m = 0; m < token->size; m++) {
+        const wm_ext_wasm_native_json_token_t *child = json_token(doc, i);
+
+        if (!child) {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        if (key) {
+            const wm_ext_wasm_native_json_token_t *value = json_token(doc, i + 1);
+
+            if (!value) {
+                return ESP_ERR_INVALID_ARG;
+            }
+
+            if (child->len == key_len && !memcmp(doc->json + child->start, key, key_len)) {
+                *index = i + 1;
+                return ESP_OK;
+            }
+
+            i = value->next;
+        } else {
+            if (m == array_index) {
+                *index = i;
+                return ESP_OK;
+            }
+
+            i = child->next;
+        }
+    }
+
+    return ESP_ERR_NOT_FOUND;
+}
+
+esp_err_t wm_ext_wasm_native_json_find(const wm_ext_wasm_native_json_t *doc, uint32_t parent, const char *path,
+                                       uint32_t *index)
+{
+    esp_err_t ret;
+    const char *p = path;
+    uint32_t i = parent;
+
+    if (!doc || !path || !index || !json_token(doc, parent)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    while (*p) {
+        if (*p == '[') {
+            const char *e = p + 1;
+            uint32_t n = 0;
+
+            for (; json_is_digit(*e); e++) {
+                n = n > (UINT32_MAX - 9) / 10 ? UINT32_MAX : n * 10 + (uint32_t)(*e - '0');
+            }
+            if (e == p + 1 || *e != ']') {
+                return ESP_ERR_INVALID_ARG;
+            }
+
+            ret = json_child(doc, i, NULL, 0, n, &i);
+            p = e + 1;
+        } else {
+            const char *key;
+
+            if (*p == '.' && p != path) {
+                p++;
+            }
+
+            key = p;
+            while (*p && *p != '.' && *p != '[') {
+                p++;
+            }
+            if (p == key) {
+                return ESP_ERR_INVALID_ARG;
+            }
+
+            ret = json_child(doc, i, key, (uint32_t)(p - key), 0, &i);
+        }
+
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    *index = i;
+
+    return ESP_OK;
+}
+
+/* Copy number text to be NUL-terminated, strtod() can't be limited by length */
+static esp_err_t json_number_text(const wm_ext_wasm_native_json_t *doc, uint32_t index, char *text)
+{
+    const wm_ext_wasm_native_json_token_t *token = doc ? json_token(doc, index) : NULL;
+
+    if (!token || token->type != WM_EXT_WASM_NATIVE_JSON_NUMBER) {
+        return ESP_ERR_INVALID_ARG;
+    } else if (token->len >= JSON_NUMBER_TEXT_MAX) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    memcpy(text, doc->json + token->start, token->len);
+    text[token->len] = '\0';
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_json_get_number(const wm_ext_wasm_native_json_t *doc, uint32_t index, double *value)
+{
+    esp_err_t ret;
+    char text[JSON_NUMBER_TEXT_MAX];
+
+    if (!value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ret = json_number_text(doc, index, text);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    *value = strtod(text, NULL);
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_json_get_int(const wm_ext_wasm_native_json_t *doc, uint32_t index, int64_t *value)
+{
+    esp_err_t ret;
+    char *e;
+    long long v;
+    char text[JSON_NUMBER_TEXT_MAX];
+
+    if (!value) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ret = json_number_text(doc, index, text);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    errno = 0;
+    v = strtoll(text, &e, 10);
+    if (*e) {
+        return ESP_ERR_INVALID_ARG;
+    } else if (errno == ERANGE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    *value = v;
+
+    return ESP_OK;
+}
+
+static uint32_t json_utf8(uint32_t cp, char *out)
+{
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        return 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xc0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3f));
+        return 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xe0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3f));
+        out[2] = (char)(0x80 | (cp & 0x3f));
+        return 3;
+    }
+
+    out[0] = (char)(0xf0 | (cp >> 18));
+    out[1] = (char)(0x80 | ((cp >> 12) & 0x3f));
+    out[2] = (char)(0x80 | ((cp >> 6) & 0x3f));
+    out[3] = (char)(0x80 | (cp & 0x3f));
+    return 4;
+}
+
+/* Read 4 hex digits, escapes of parsed tokens are valid, but tokens may be changed since */
+static int32_t json_hex4(const char *s, const char *end)
+{
+    int32_t cp = 0;
+
+    if (end - s < 4) {
+        return -1;
+    }
+
+    for (int i = 0; i < 4; i++) {
+        int h = json_hex(s[i]);
+
+        if (h < 0) {
+            return -1;
+        }
+        cp = (cp << 4) | h;
+    }
+
+    return cp;
+}
+
+esp_err_t wm_ext_wasm_native_json_get_string(const wm_ext_wasm_native_json_t *doc, uint32_t index,
+                                             char *out, uint32_t out_size, uint32_t *out_len)
+{
+    const char *s;
+    const char *end;
+    uint32_t len = 0;
+    const wm_ext_wasm_native_json_token_t *token = doc ? json_token(doc, index) : NULL;
+
+    if (!token || token->type != WM_EXT_WASM_NATIVE_JSON_STRING || (!out && out_size) || !out_len) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    s = doc->json + token->start;
+    end = s + token->len;
+
+    if (!(token->flags & WM_EXT_WASM_NATIVE_JSON_ESCAPED)) {
+        len = token->len;
+        if (out_size) {
+            uint32_t n = len < out_size - 1 ? len : out_size - 1;
+
+            memcpy(out, s, n);
+            out[n] = '\0';
+        }
+
+        *out_len = len;
+        return ESP_OK;
+    }
+
+    while (s < end) {
+        char buf[4];
+        uint32_t n = 1;
+
+        if (*s != '\\') {
+            buf[0] = *s++;
+        } else if (end - s < 2) {
+            return ESP_ERR_INVALID_RESPONSE;
+        } else if (s[1] != 'u') {
+            switch (s[1]) {
+            case 'b':
+                buf[0] = '\b';
+                break;
+            case 'f':
+                buf[0] = '\f';
+                break;
+            case 'n':
+                buf[0] = '\n';
+                break;
+            case 'r':
+                buf[0] = '\r';
+                break;
+            case 't':
+                buf[0] = '\t';
+                break;
+            default:
+                buf[0] = s[1];
+                break;
+            }
+            s += 2;
+        } else {
+            int32_t cp = json_hex4(s + 2, end);
+
+            if (cp < 0) {
+                return ESP_ERR_INVALID_RESPONSE;
+            }
+            s += 6;
+
+            /* A high surrogate is followed by a low surrogate, an unpaired one isn't a character */
+            if (cp >= 0xd800 && cp < 0xdc00) {
+                int32_t lo = end - s >= 6 && s[0] == '\\' && s[1] == 'u' ? json_hex4(s + 2, end) : -1;
+
+                if (lo >= 0xdc00 && lo < 0xe000) {
+                    cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+                    s += 6;
+                } else {
+                    cp = 0xfffd;
+                }
+            } else if (cp >= 0xdc00 && cp < 0xe000) {
+                cp = 0xfffd;
+            }
+
+            n = json_utf8((uint32_t)cp, buf);
+        }
+
+        for (uint32_t i = 0; i < n; i++, len++) {
+            if (len + 1 < out_size) {
+                out[len] = buf[i];
+            }
+        }
+    }
+
+    if (out_size) {
+        out[len < out_size ? len : out_size - 1] = '\0';
+    }
+
+    *out_len = len;
+
+    return ESP_OK;
+}
+
+void wm_ext_wasm_native_json_writer_init(wm_ext_wasm_native_json_writer_t *writer, char *buf, uint32_t size)
+{
+    memset(writer, 0, sizeof(wm_ext_wasm_native_json_writer_t));
+    writer->buf = buf;
+    writer->size = buf ? size : 0;
+}
+
+static void json_put(wm_ext_wasm_native_json_writer_t *writer, const char *s, uint32_t n)
+{
+    if (writer->len < writer->size) {
+        uint32_t space = writer->size - writer->len;
+
+        memcpy(writer->buf + writer->len, s, n < space ? n : space);
+    }
+
+    writer->len = n > UINT32_MAX - writer->len ? UINT32_MAX : writer->len + n;
+}
+
+static void json_put_string(wm_ext_wasm_native_json_writer_t *writer, const char *str, uint32_t len)
+{
+    static const char s_hex[] = "0123456789abcdef";
+    const char *run = str;
+    const char *end = str + len;
+
+    json_put(writer, "\"", 1);
+
+    /* Copy runs of characters which need no escape at once */
+    for (const char *s = str; s < end; s++) {
+        uint8_t c = (uint8_t)*s;
+        char esc[6] = { '\\', 0, '0', '0', 0, 0 };
+        uint32_t n = 2;
+
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        json_put(writer, run, (uint32_t)(s - run));
+        run = s + 1;
+
+        switch (c) {
+        case '"':
+        case '\\':
+            esc[1] = (char)c;
+            break;
+        case '\b':
+            esc[1] = 'b';
+            break;
+        case '\f':
+            esc[1] = 'f';
+            break;
+        case '\n':
+            esc[1] = 'n';
+            break;
+        case '\r':
+            esc[1] = 'r';
+            break;
+        case '\t':
+            esc[1] = 't';
+            break;
+        default:
+            esc[1] = 'u';
+            esc[4] = s_hex[c >> 4];
+            esc[5] = s_hex[c & 0xf];
+            n = 6;
+            break;
+        }
+
+        json_put(writer, esc, n);
+    }
+
+    json_put(writer, run, (uint32_t)(end - run));
+    json_put(writer, "\"", 1);
+}
+
+/* Check that a key is given exactly when the value is in an object, and write separators and key */
+static esp_err_t json_value_begin(wm_ext_wasm_native_json_writer_t *writer, const char *key)
+{
+    uint32_t bit;
+
+    /* State of an application writer may be anything */
+    if (writer->depth > WM_EXT_WASM_NATIVE_JSON_MAX_DEPTH) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    bit = 1u << writer->depth;
+    if (!key != !(writer->object & bit) || (!writer->depth && (writer->comma & bit))) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (writer->comma & bit) {
+        json_put(writer, ",", 1);
+    }
+    writer->comma |= bit;
+
+    if (key) {
+        json_put_string(writer, key, strlen(key));
+        json_put(writer, ":", 1);
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t json_value_end(wm_ext_wasm_native_json_writer_t *writer)
+{
+    return writer->len > writer->size ? ESP_ERR_INVALID_SIZE : ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_json_write_begin(wm_ext_wasm_native_json_writer_t *writer, const char *key, bool array)
+{
+    esp_err_t ret;
+    uint32_t bit;
+
+    if (!writer) {
+        return ESP_ERR_INVALID_ARG;
+    } else if (writer->depth >= WM_EXT_WASM_NATIVE_JSON_MAX_DEPTH) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    ret = json_value_begin(writer, key);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    json_put(writer, array ? "[" : "{", 1);
+
+    bit = 1u << ++writer->depth;
+    writer->comma &= ~bit;
+    if (array) {
+        writer->object &= ~bit;
+    } else {
+        writer->object |= bit;
+    }
+
+    return json_value_end(writer);
+}
+
+esp_err_t wm_ext_wasm_native_json_write_end(wm_ext_wasm_native_json_writer_t *writer)
+{
+    if (!writer) {
+        return ESP_ERR_INVALID_ARG;
+    } else if (!writer->depth || writer->depth > WM_EXT_WASM_NATIVE_JSON_MAX_DEPTH) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    json_put(writer, (writer->object & (1u << writer->depth)) ? "}" : "]", 1);
+    writer->depth--;
+
+    return json_value_end(writer);
+}
+
+esp_err_t wm_ext_wasm_native_json_write_string(wm_ext_wasm_native_json_writer_t *writer, const char *key,
+                                               const char *str, uint32_t len)
+{
+    esp_err_t ret;
+
+    if (!writer || (!str && len)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ret = json_value_begin(writer, key);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    json_put_string(writer, str, len);
+
+    return json_value_end(writer);
+}
+
+esp_err_t wm_ext_wasm_native_json_write_number(wm_ext_wasm_native_json_writer_t *writer, const char *key,
+                                               double value)
+{
+    esp_err_t ret;
+    int n;
+    char text[32];
+
+    if (!writer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ret = json_value_begin(writer, key);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    if (!isfinite(value)) {
+        json_put(writer, "null", 4);
+    } else {
+        n = snprintf(text, sizeof(text), "%.15g", value);
+        if (strtod(text, NULL) != value) {
+            n = snprintf(text, sizeof(text), "%.17g", value);
+        }
+        json_put(writer, text, (uint32_t)n);
+    }
+
+    return json_value_end(writer);
+}
+
+esp_err_t wm_ext_wasm_native_json_write_int(wm_ext_wasm_native_json_writer_t *writer, const char *key,
+                                            int64_t value)
+{
+    esp_err_t ret;
+    int n;
+    char text[24];
+
+    if (!writer) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ret = json_value_begin(writer, key);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    n = snprintf(text, sizeof(text), "%" PRId64, value);
+    json_put(writer, text, (uint32_t)n);
+
+    return json_value_end(writer);
+}
+
+esp_err_t wm_ext_wasm_native_json_write_bool(wm_ext_wasm_native_json_writer_t *writer, const char *key, bool value)
+{
+    return wm_ext_wasm_native_json_write_raw(writer, key, value ? "true" : "false", value ? 4 : 5);
+}
+
+esp_err_t wm_ext_wasm_native_json_write_null(wm_ext_wasm_native_json_writer_t *writer, const char *key)
+{
+    return wm_ext_wasm_native_json_write_raw(writer, key, "null", 4);
+}
+
+esp_err_t wm_ext_wasm_native_json_write_raw(wm_ext_wasm_native_json_writer_t *writer, const char *key,
+                                            const char *json, uint32_t len)
+{
+    esp_err_t ret;
+
+    if (!writer || !json || !len) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ret = json_value_begin(writer, key);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    json_put(writer, json, len);
+
+    return json_value_end(writer);
+}
+
+static int wasm_json_errno(esp_err_t err)
+{
+    switch (err) {
+    case ESP_ERR_NO_MEM:
+        return -ENOMEM;
+    case ESP_ERR_INVALID_RESPONSE:
+        return -EBADMSG;
+    case ESP_ERR_NOT_FOUND:
+        return -ENOENT;
+    case ESP_ERR_INVALID_SIZE:
+        return -ERANGE;
+    case ESP_ERR_INVALID_STATE:
+        return -EPERM;
+    default:
+        return -EINVAL;
+    }
+}
+
+/*
+ * Load a document of an application, its text and tokens are validated as whole ranges
+ * once, token offsets are checked against the text by the functions using them.
+ */
+static int wasm_json_load(wasm_module_inst_t module_inst, uint32_t addr, wm_ext_wasm_native_json_t *doc)
+{
+    wasm_json_t d;
+
+    if (!validate_app_addr(addr, sizeof(wasm_json_t))) {
+        return -EFAULT;
+    }
+
+    /* The structure may be unaligned in linear memory */
+    memcpy(&d, addr_app_to_native(addr), sizeof(wasm_json_t));
+
+    /* Tokens are accessed in place by words */
+    if ((d.tokens & 3) || d.max_tokens > UINT32_MAX / sizeof(wm_ext_wasm_native_json_token_t)) {
+        return -EINVAL;
+    }
+
+    if ((d.len && !validate_app_addr(d.json, d.len)) ||
+            (d.max_tokens && !validate_app_addr(d.tokens, d.max_tokens * sizeof(wm_ext_wasm_native_json_token_t)))) {
+        return -EFAULT;
+    }
+
+    doc->json = d.len ? addr_app_to_native(d.json) : NULL;
+    doc->len = d.len;
+    doc->tokens = d.max_tokens ? addr_app_to_native(d.tokens) : NULL;
+    doc->max_tokens = d.max_tokens;
+    doc->count = d.count < d.max_tokens ? d.count : d.max_tokens;
+
+    return 0;
+}
+
+static int wasm_json_parse_wrapper(wasm_exec_env_t exec_env, uint32_t addr)
+{
+    int err;
+    esp_err_t ret;
+    wm_ext_wasm_native_json_t doc;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    err = wasm_json_load(module_inst, addr, &doc);
+    if (err) {
+        return err;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_json_parse", 0, doc.len, doc.max_tokens, 0, 0);
+
+    ret = wm_ext_wasm_native_json_parse(&doc);
+
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    memcpy((uint8_t *)addr_app_to_native(addr) + offsetof(wasm_json_t, count), &doc.count, sizeof(uint32_t));
+
+    if (ret != ESP_OK) {
+        ESP_LOGD(TAG, "failed to parse %" PRIu32 " bytes: %s", doc.len, esp_err_to_name(ret));
+        return wasm_json_errno(ret);
+    }
+
+    return (int)doc.count;
+}
+
+static int wasm_json_find_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t parent, uint32_t path)
+{
+    int err;
+    esp_err_t ret;
+    uint32_t index;
+    wm_ext_wasm_native_json_t doc;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!validate_app_str_addr(path)) {
+        return -EFAULT;
+    }
+
+    err = wasm_json_load(module_inst, addr, &doc);
+    if (err) {
+        return err;
+    }
+
+    ret = wm_ext_wasm_native_json_find(&doc, parent, addr_app_to_native(path), &index);
+    if (ret != ESP_OK) {
+        return wasm_json_errno(ret);
+    }
+
+    return (int)index;
+}
+
+static int wasm_json_get_number_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t index, uint32_t value)
+{
+    int err;
+    esp_err_t ret;
+    double v;
+    wm_ext_wasm_native_json_t doc;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!validate_app_addr(value, sizeof(double))) {
+        return -EFAULT;
+    }
+
+    err = wasm_json_load(module_inst, addr, &doc);
+    if (err) {
+        return err;
+    }
+
+    ret = wm_ext_wasm_native_json_get_number(&doc, index, &v);
+    if (ret != ESP_OK) {
+        return wasm_json_errno(ret);
+    }
+
+    memcpy(addr_app_to_native(value), &v, sizeof(double));
+
+    return 0;
+}
+
+static int wasm_json_get_int_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t index, uint32_t value)
+{
+    int err;
+    esp_err_t ret;
+    int64_t v;
+    wm_ext_wasm_native_json_t doc;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!validate_app_addr(value, sizeof(int64_t))) {
+        return -EFAULT;
+    }
+
+    err = wasm_json_load(module_inst, addr, &doc);
+    if (err) {
+        return err;
+    }
+
+    ret = wm_ext_wasm_native_json_get_int(&doc, index, &v);
+    if (ret != ESP_OK) {
+        return wasm_json_errno(ret);
+    }
+
+    memcpy(addr_app_to_native(value), &v, sizeof(int64_t));
+
+    return 0;
+}
+
+static int wasm_json_get_string_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t index, uint32_t out,
+                                        uint32_t out_size)
+{
+    int err;
+    esp_err_t ret;
+    uint32_t len;
+    wm_ext_wasm_native_json_t doc;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (out_size && !validate_app_addr(out, out_size)) {
+        return -EFAULT;
+    }
+
+    err = wasm_json_load(module_inst, addr, &doc);
+    if (err) {
+        return err;
+    }
+
+    ret = wm_ext_wasm_native_json_get_string(&doc, index, out_size ? addr_app_to_native(out) : NULL, out_size, &len);
+    if (ret != ESP_OK) {
+        return wasm_json_errno(ret);
+    } else if (len > INT32_MAX) {
+        return -ERANGE;
+    }
+
+    return (int)len;
+}
+
+/*
+ * Writer natives load the writer of an application, write a value and store the state
+ * back, a key address of 0 means no key.
+ */
+typedef esp_err_t (*wasm_json_write_fn_t)(wm_ext_wasm_native_json_writer_t *writer, const char *key,
+                                          const void *arg, uint32_t len);
+
+static int wasm_json_write(wasm_exec_env_t exec_env, uint32_t addr, uint32_t key, wasm_json_write_fn_t fn,
+                           const void *arg, uint32_t len)
+{
+    esp_err_t ret;
+    wasm_json_writer_t w;
+    wm_ext_wasm_native_json_writer_t writer;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!validate_app_addr(addr, sizeof(wasm_json_writer_t)) || (key && !validate_app_str_addr(key))) {
+        return -EFAULT;
+    }
+
+    memcpy(&w, addr_app_to_native(addr), sizeof(wasm_json_writer_t));
+    if (w.size && !validate_app_addr(w.buf, w.size)) {
+        return -EFAULT;
+    }
+
+    writer.buf = w.size ? addr_app_to_native(w.buf) : NULL;
+    writer.size = w.size;
+    writer.len = w.len;
+    writer.depth = w.depth;
+    writer.comma = w.comma;
+    writer.object = w.object;
+
+    ret = fn(&writer, key ? addr_app_to_native(key) : NULL, arg, len);
+
+    w.len = writer.len;
+    w.depth = writer.depth;
+    w.comma = writer.comma;
+    w.object = writer.object;
+    memcpy(addr_app_to_native(addr), &w, sizeof(wasm_json_writer_t));
+
+    if (ret == ESP_ERR_INVALID_SIZE) {
+        return -ENOSPC;
+    }
+
+    return ret == ESP_OK ? 0 : wasm_json_errno(ret);
+}
+
+static esp_err_t json_write_begin(wm_ext_wasm_native_json_writer_t *writer, const char *key, const void *arg,
+                                  uint32_t len)
+{
+    return wm_ext_wasm_native_json_write_begin(writer, key, len != 0);
+}
+
+static esp_err_t json_write_end(wm_ext_wasm_native_json_writer_t *writer, const char *key, const void *arg,
+                                uint32_t len)
+{
+    return wm_ext_wasm_native_json_write_end(writer);
+}
+
+static esp_err_t json_write_string(wm_ext_wasm_native_json_writer_t *writer, const char *key, const void *arg,
+                                   uint32_t len)
+{
+    return wm_ext_wasm_native_json_write_string(writer, key, arg, len);
+}
+
+static esp_err_t json_write_number(wm_ext_wasm_native_json_writer_t *writer, const char *key, const void *arg,
+                                   uint32_t len)
+{
+    return wm_ext_wasm_native_json_write_number(writer, key, *(const double *)arg);
+}
+
+static esp_err_t json_write_int(wm_ext_wasm_native_json_writer_t *writer, const char *key, const void *arg,
+                                uint32_t len)
+{
+    return wm_ext_wasm_native_json_write_int(writer, key, *(const int64_t *)arg);
+}
+
+static esp_err_t json_write_raw(wm_ext_wasm_native_json_writer_t *writer, const char *key, const void *arg,
+                                uint32_t len)
+{
+    return wm_ext_wasm_native_json_write_raw(writer, key, arg, len);
+}
+
+static int wasm_json_write_begin_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t key, int array)
+{
+    return wasm_json_write(exec_env, addr, key, json_write_begin, NULL, array != 0);
+}
+
+static int wasm_json_write_end_wrapper(wasm_exec_env_t exec_env, uint32_t addr)
+{
+    return wasm_json_write(exec_env, addr, 0, json_write_end, NULL, 0);
+}
+
+static int wasm_json_write_string_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t key, uint32_t str,
+                                          uint32_t len)
+{
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (len && !validate_app_addr(str, len)) {
+        return -EFAULT;
+    }
+
+    return wasm_json_write(exec_env, addr, key, json_write_string, len ? addr_app_to_native(str) : NULL, len);
+}
+
+static int wasm_json_write_number_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t key, double value)
+{
+    return wasm_json_write(exec_env, addr, key, json_write_number, &value, 0);
+}
+
+static int wasm_json_write_int_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t key, int64_t value)
+{
+    return wasm_json_write(exec_env, addr, key, json_write_int, &value, 0);
+}
+
+static int wasm_json_write_bool_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t key, int value)
+{
+    return wasm_json_write(exec_env, addr, key, json_write_raw, value ? "true" : "false", value ? 4 : 5);
+}
+
+static int wasm_json_write_null_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t key)
+{
+    return wasm_json_write(exec_env, addr, key, json_write_raw, "null", 4);
+}
+
+static int wasm_json_write_raw_wrapper(wasm_exec_env_t exec_env, uint32_t addr, uint32_t key, uint32_t json,
+                                       uint32_t len)
+{
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!len || !validate_app_addr(json, len)) {
+        return -EFAULT;
+    }
+
+    return wasm_json_write(exec_env, addr, key, json_write_raw, addr_app_to_native(json), len);
+}
+
+static NativeSymbol wm_json_wrapper_native_symbol[] = {
+    REG_NATIVE_FUNC(wasm_json_parse,        "(i)i"),
+    REG_NATIVE_FUNC(wasm_json_find,         "(iii)i"),
+    REG_NATIVE_FUNC(wasm_json_get_number,   "(iii)i"),
+    REG_NATIVE_FUNC(wasm_json_get_int,      "(iii)i"),
+    REG_NATIVE_FUNC(wasm_json_get_string,   "(iiii)i"),
+    REG_NATIVE_FUNC(wasm_json_write_begin,  "(iii)i"),
+    REG_NATIVE_FUNC(wasm_json_write_end,    "(i)i"),
+    REG_NATIVE_FUNC(wasm_json_write_string, "(iiii)i"),
+    REG_NATIVE_FUNC(wasm_json_write_number, "(iiF)i"),
+    REG_NATIVE_FUNC(wasm_json_write_int,    "(iiI)i"),
+    REG_NATIVE_FUNC(wasm_json_write_bool,   "(iii)i"),
+    REG_NATIVE_FUNC(wasm_json_write_null,   "(ii)i"),
+    REG_NATIVE_FUNC(wasm_json_write_raw,    "(iiii)i"),
+};
+
+int wm_ext_wasm_native_json_export(void)
+{
+    NativeSymbol *sym = (NativeSymbol *)wm_json_wrapper_native_symbol;
+    int num = sizeof(wm_json_wrapper_native_symbol) / sizeof(wm_json_wrapper_native_symbol[0]);
+
+    if (!wasm_native_register_natives("env", sym,  num)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+WM_EXT_WASM_NATIVE_EXPORT_FN(wm_ext_wasm_native_json_export)
+{
+    return wm_ext_wasm_native_json_export();
+}
@@ -4,13 +4,20 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
+#include <limits.h>
 #include <unistd.h>
 #include <fcntl.h>
 #include <sys/errno.h>
 #include <time.h>
+#if CONFIG_IDF_TARGET_LINUX
+#include <sys/random.h>
+#endif
 
 #include "esp_log.h"
-#include "esp_memory_utils.h"
+#if !CONFIG_IDF_TARGET_LINUX
+#include "esp_random.h"
+#endif
 
 #include "bh_platform.h"
 #include "wasm_export.h"
@@ -19,8 +26,14 @@
 
 #include "wm_ext_wasm_native_macro.h"
 #include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
 #ifdef CONFIG_WASMACHINE_EXT_VFS
 #include "wm_ext_wasm_vfs_ioctl.h"
+#include "wm_ext_wasm_vfs_batch.h"
+#include "wm_ext_wasm_vfs_dma.h"
+#include "wm_ext_wasm_vfs_gpio.h"
+#include "wm_ext_wasm_vfs_stream.h"
 #endif
 
 #define WASM_O_APPEND       (1 << 0)
@@ -36,6 +49,9 @@
 
 #define WASM_O_RDWR         (WASM_O_RDONLY | WASM_O_WRONLY)
 
+#define WASM_GRND_NONBLOCK  (1 << 0)
+#define WASM_GRND_RANDOM    (1 << 1)
+
 #define WASI_ESUCCESS        (0)
 #define WASI_E2BIG           (1)
 #define WASI_EACCES          (2)
@@ -116,6 +132,20 @@
 
 #define FLAGS_CHECK(v, f)   (((v) & (f)) == (f))
 
+#define WASM_IOV_MAX        1024
+#define IOV_BOUNCE_MAX      4096
+
+/* struct iovec of wasm32 applications */
+typedef struct wasm_iovec {
+    uint32_t base;
+    uint32_t len;
+} wasm_iovec_t;
+
+typedef struct native_iovec {
+    void *base;
+    size_t len;
+} native_iovec_t;
+
 #define X(v) [v] = WASI_##v
 
 static const char *TAG = "wm_libc_wrapper";
@@ -168,7 +198,7 @@ static int flags_wasm2c(int wasm_flags)
 }
 
 
-static uint32_t errno_c2wasm(int error)
+uint32_t wm_ext_wasm_native_errno_c2wasm(int error)
 {
     static const uint8_t errors[] = {
         X(E2BIG),
@@ -265,68 +295,20 @@ static uint32_t errno_c2wasm(int error)
     return errors[error];
 }
 
-#if CONFIG_IDF_TARGET_ESP32P4
-static bool ptr_is_in_external_ram(const void *ptr)
-{
-    return ((intptr_t)ptr >= SOC_EXTRAM_LOW) &&
-           ((intptr_t)ptr < SOC_EXTRAM_HIGH);
-}
-#endif
-
-static bool ptr_is_in_ram_or_rom(const void *ptr)
-{
-    bool ret = false;
-
-    if (esp_ptr_in_dram(ptr)) {
-        ret = true;
-    } else if (esp_ptr_in_drom(ptr)) {
-        ret = true;
-#if CONFIG_IDF_TARGET_ESP32P4
-    } else {
-        ret = ptr_is_in_external_ram(ptr);
-#else
-    } else if (esp_ptr_external_ram(ptr)) {
-        ret = true;
-#endif
-    }
-
-    return ret;
-}
-
-static void *map_ptr(wasm_exec_env_t exec_env, const void *app_addr)
-{
-    void *ptr;
-    wasm_module_inst_t module_inst = get_module_inst(exec_env);
-
-    if (ptr_is_in_ram_or_rom(app_addr)) {
-        return (void *)app_addr;
-    }
-
-    ptr = (char *)addr_app_to_native((uint32_t)app_addr);
-    if (!ptr) {
-        ESP_LOGE(TAG, "failed to map app_addr=%p", app_addr);
-        return NULL;
-    }
-
-    return ptr;
-}
-
-static void set_wasm_errno(wasm_exec_env_t exec_env, int c_errno)
+void wm_ext_wasm_native_set_errno(wasm_exec_env_t exec_env, int c_errno)
 {
     uint32_t argv[1];
     WASMFunctionInstanceCommon *func;
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
-    const char *func_name = "libc_builtin_set_errno";
 
-    func = wasm_runtime_lookup_function(module_inst, func_name);
+    func = wm_ext_wasm_native_get_func(module_inst, WM_EXT_WASM_NATIVE_FUNC_SET_ERRNO);
     if (!func) {
-        ESP_LOGW(TAG, "failed to find function %s", func_name);
         return;
     }
 
-    argv[0] = (uint32_t)errno_c2wasm(c_errno);
+    argv[0] = wm_ext_wasm_native_errno_c2wasm(c_errno);
     if (!wasm_runtime_call_wasm(exec_env, func, 1, argv)) {
-        ESP_LOGE(TAG, "failed to call function %s", func_name);
+        ESP_LOGE(TAG, "failed to call function libc_builtin_set_errno");
         return;
     }
 }
@@ -339,15 +321,19 @@ static int open_wrapper(wasm_exec_env_t exec_env,
     int ret;
     int gcc_flags = flags_wasm2c(flags);
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("open", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(pathname), flags, mode);
+
     ESP_LOGV(TAG, "open(%s, %x(%x), %x)", pathname, flags, gcc_flags, mode);
 
     ret = open(pathname, gcc_flags, mode);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
     ESP_LOGV(TAG, "open(%s, %x(%x), %x)=%d", pathname, flags, gcc_flags, mode, ret);
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return ret;
 }
 
@@ -355,15 +341,19 @@ static ssize_t read_wrapper(wasm_exec_env_t exec_env, int fd, void *buffer, size
 {
     int ret;
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("read", 0, fd, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(buffer), n);
+
     ESP_LOGV(TAG, "read(%d, %p, %d)", fd, buffer, n);
 
     ret = read(fd, buffer, n);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
     ESP_LOGV(TAG, "read(%d, %p, %d)=%d", fd, buffer, n, ret);
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return ret;
 }
 
@@ -371,15 +361,19 @@ static ssize_t write_wrapper(wasm_exec_env_t exec_env, int fd, const void *buffe
 {
     int ret;
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("write", 0, fd, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(buffer), n);
+
     ESP_LOGV(TAG, "write(%d, %p, %d)", fd, buffer, n);
 
     ret = write(fd, buffer, n);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
     ESP_LOGV(TAG, "write(%d, %p, %d)=%d", fd, buffer, n, ret);
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return ret;
 }
 
@@ -387,15 +381,19 @@ static ssize_t pread_wrapper(wasm_exec_env_t exec_env, int fd, void *dst, size_t
 {
     int ret;
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("pread", 0, fd, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(dst), size, offset);
+
     ESP_LOGV(TAG, "pread(%d, %p, %u, %lu)", fd, dst, size, offset);
 
     ret = pread(fd, dst, size, offset);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
     ESP_LOGV(TAG, "pread(%d, %p, %u, %lu)=%d", fd, dst, size, offset, ret);
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return ret;
 }
 
@@ -403,15 +401,228 @@ static ssize_t pwrite_wrapper(wasm_exec_env_t exec_env, int fd, const void *dst,
 {
     int ret;
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("pwrite", 0, fd, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(dst), size, offset);
+
     ESP_LOGV(TAG, "pwrite(%d, %p, %u, %lu)", fd, dst, size, offset);
 
     ret = pwrite(fd, dst, size, offset);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
     ESP_LOGV(TAG, "pwrite(%d, %p, %u, %lu)=%d", fd, dst, size, offset, ret);
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+/**
+ * Validate iovec array and all buffers of it in one pass, and transform
+ * buffer addresses to native. Return total length or -1 with errno set.
+ */
+static ssize_t iov_wasm2c(wasm_exec_env_t exec_env, const wasm_iovec_t *iov, int iovcnt, native_iovec_t **piov)
+{
+    size_t total = 0;
+    native_iovec_t *niov;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (iovcnt <= 0 || iovcnt > WASM_IOV_MAX) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (!wasm_runtime_validate_native_addr(module_inst, (void *)iov, iovcnt * sizeof(wasm_iovec_t))) {
+        errno = EFAULT;
+        return -1;
+    }
+
+    niov = wasm_runtime_malloc(iovcnt * sizeof(native_iovec_t));
+    if (!niov) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    for (int i = 0; i < iovcnt; i++) {
+        uint32_t base = iov[i].base;
+        uint32_t len = iov[i].len;
+
+        if (len > SSIZE_MAX - total ||
+                !wasm_runtime_validate_app_addr(module_inst, base, len)) {
+            wasm_runtime_free(niov);
+            errno = len > SSIZE_MAX - total ? EINVAL : EFAULT;
+            return -1;
+        }
+
+        niov[i].base = len ? wasm_runtime_addr_app_to_native(module_inst, base) : NULL;
+        niov[i].len = len;
+        total += len;
+    }
+
+    *piov = niov;
+
+    return total;
+}
+
+/**
+ * Do scatter/gather I/O with a single read/write/pread/pwrite call if there is
+ * only one buffer or total length fits the bounce buffer, otherwise fall back to
+ * one call per buffer and stop at the first short transfer.
+ */
+static ssize_t iov_rw(wasm_exec_env_t exec_env, int fd, const wasm_iovec_t *iov, int iovcnt,
+                      int64_t offset, bool is_write, bool positional)
+{
+    ssize_t ret;
+    ssize_t total;
+    native_iovec_t *niov;
+    uint8_t *bounce = NULL;
+
+    total = iov_wasm2c(exec_env, iov, iovcnt, &niov);
+    if (total < 0) {
+        return -1;
+    }
+
+    if (iovcnt > 1 && total <= IOV_BOUNCE_MAX) {
+        bounce = wasm_runtime_malloc(total ? total : 1);
+    }
+
+    if (bounce || iovcnt == 1) {
+        void *buf = bounce ? bounce : niov[0].base;
+
+        if (is_write) {
+            if (bounce) {
+                for (int i = 0, n = 0; i < iovcnt; n += niov[i].len, i++) {
+                    if (niov[i].len) {
+                        memcpy(bounce + n, niov[i].base, niov[i].len);
+                    }
+                }
+            }
+
+            ret = positional ? pwrite(fd, buf, total, (off_t)offset) : write(fd, buf, total);
+        } else {
+            ret = positional ? pread(fd, buf, total, (off_t)offset) : read(fd, buf, total);
+            if (bounce && ret > 0) {
+                for (int i = 0, n = 0; i < iovcnt && n < ret; n += niov[i].len, i++) {
+                    if (niov[i].len) {
+                        memcpy(niov[i].base, bounce + n, niov[i].len < ret - n ? niov[i].len : ret - n);
+                    }
+                }
+            }
+        }
+    } else {
+        ret = 0;
+        for (int i = 0; i < iovcnt; i++) {
+            ssize_t n;
+
+            if (!niov[i].len) {
+                continue;
+            }
+
+            if (is_write) {
+                n = positional ? pwrite(fd, niov[i].base, niov[i].len, (off_t)(offset + ret)) :
+                    write(fd, niov[i].base, niov[i].len);
+            } else {
+                n = positional ? pread(fd, niov[i].base, niov[i].len, (off_t)(offset + ret)) :
+                    read(fd, niov[i].base, niov[i].len);
+            }
+
+            if (n < 0) {
+                ret = ret ? ret : -1;
+                break;
+            }
+
+            ret += n;
+            if ((size_t)n < niov[i].len) {
+                break;
+            }
+        }
+    }
+
+    if (bounce) {
+        wasm_runtime_free(bounce);
+    }
+    wasm_runtime_free(niov);
+
+    return ret;
+}
+
+static ssize_t readv_wrapper(wasm_exec_env_t exec_env, int fd, const wasm_iovec_t *iov, int iovcnt)
+{
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("readv", 0, fd, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(iov), iovcnt);
+
+    ESP_LOGV(TAG, "readv(%d, %p, %d)", fd, iov, iovcnt);
+
+    ret = iov_rw(exec_env, fd, iov, iovcnt, 0, false, false);
+    if (ret < 0) {
+        wm_ext_wasm_native_set_errno(exec_env, errno);
+    }
+
+    ESP_LOGV(TAG, "readv(%d, %p, %d)=%d", fd, iov, iovcnt, ret);
+
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static ssize_t writev_wrapper(wasm_exec_env_t exec_env, int fd, const wasm_iovec_t *iov, int iovcnt)
+{
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("writev", 0, fd, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(iov), iovcnt);
+
+    ESP_LOGV(TAG, "writev(%d, %p, %d)", fd, iov, iovcnt);
+
+    ret = iov_rw(exec_env, fd, iov, iovcnt, 0, true, false);
+    if (ret < 0) {
+        wm_ext_wasm_native_set_errno(exec_env, errno);
+    }
+
+    ESP_LOGV(TAG, "writev(%d, %p, %d)=%d", fd, iov, iovcnt, ret);
+
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static ssize_t preadv_wrapper(wasm_exec_env_t exec_env, int fd, const wasm_iovec_t *iov, int iovcnt, int64_t offset)
+{
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("preadv", 0, fd, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(iov), iovcnt, (uint32_t)offset);
+
+    ESP_LOGV(TAG, "preadv(%d, %p, %d, %llx)", fd, iov, iovcnt, offset);
+
+    ret = iov_rw(exec_env, fd, iov, iovcnt, offset, false, true);
+    if (ret < 0) {
+        wm_ext_wasm_native_set_errno(exec_env, errno);
+    }
+
+    ESP_LOGV(TAG, "preadv(%d, %p, %d, %llx)=%d", fd, iov, iovcnt, offset, ret);
+
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static ssize_t pwritev_wrapper(wasm_exec_env_t exec_env, int fd, const wasm_iovec_t *iov, int iovcnt, int64_t offset)
+{
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("pwritev", 0, fd, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(iov), iovcnt, (uint32_t)offset);
+
+    ESP_LOGV(TAG, "pwritev(%d, %p, %d, %llx)", fd, iov, iovcnt, offset);
+
+    ret = iov_rw(exec_env, fd, iov, iovcnt, offset, true, true);
+    if (ret < 0) {
+        wm_ext_wasm_native_set_errno(exec_env, errno);
+    }
+
+    ESP_LOGV(TAG, "pwritev(%d, %p, %d, %llx)=%d", fd, iov, iovcnt, offset, ret);
+
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return ret;
 }
 
@@ -419,15 +630,19 @@ static off_t lseek_wrapper(wasm_exec_env_t exec_env, int fd, int64_t offset, int
 {
     int ret;
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("lseek", 0, fd, (uint32_t)offset, whence);
+
     ESP_LOGV(TAG, "lseek(%d, %llx, %x)", fd, offset, whence);
 
     ret = lseek(fd, (off_t)offset, whence);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
     ESP_LOGV(TAG, "lseek(%d, %llx, %x)=%d", fd, offset, whence, ret);
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return (int64_t)ret;
 }
 
@@ -435,15 +650,19 @@ static int fcntl_wrapper(wasm_exec_env_t exec_env, int fd, int cmd, int arg)
 {
     int ret;
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("fcntl", 0, fd, cmd, arg);
+
     ESP_LOGV(TAG, "fcntl(%d, %x, %x)", fd, cmd, arg);
 
     ret = fcntl(fd, cmd, arg);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
     ESP_LOGV(TAG, "fcntl(%d, %x, %x)=%d", fd, cmd, arg, ret);
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return ret;
 }
 
@@ -451,15 +670,19 @@ static int fsync_wrapper(wasm_exec_env_t exec_env, int fd)
 {
     int ret;
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("fsync", 0, fd);
+
     ESP_LOGV(TAG, "fsync(%d)", fd);
 
     ret = fsync(fd);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
     ESP_LOGV(TAG, "fsync(%d)=%d", fd, ret);
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return ret;
 }
 
@@ -467,26 +690,35 @@ static int close_wrapper(wasm_exec_env_t exec_env, int fd)
 {
     int ret;
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("close", 0, fd);
+
     ESP_LOGV(TAG, "close(%d)", fd);
 
     ret = close(fd);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
     ESP_LOGV(TAG, "close(%d)=%d", fd, ret);
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return ret;
 }
 
 #ifdef CONFIG_WASMACHINE_EXT_VFS
-static int ioctl_wrapper(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
+int wm_ext_wasm_native_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
 {
     int ret;
 
     switch (cmd) {
 #ifdef CONFIG_EXTENDED_VFS_GPIO
     case GPIOCSCFG:
+    case WM_EXT_WASM_VFS_GPIOCREAD:
+    case WM_EXT_WASM_VFS_GPIOCWRITE:
+#ifdef CONFIG_WASMACHINE_EXT_VFS_GPIO_EVENT
+    case WM_EXT_WASM_VFS_GPIOCSEVENT:
+#endif
         ret = wm_ext_wasm_gpio_ioctl(exec_env, fd, cmd, va_args);
         break;
 #endif
@@ -494,15 +726,38 @@ static int ioctl_wrapper(wasm_exec_env_t exec_env, int fd, int cmd, char *va_arg
     case I2CIOCSCFG:
     case I2CIOCRDWR:
     case I2CIOCEXCHANGE:
+    case WM_EXT_WASM_VFS_I2CIOCBATCH:
+    case WM_EXT_WASM_VFS_I2CIOCPREPARE:
         ret = wm_ext_wasm_i2c_ioctl(exec_env, fd, cmd, va_args);
         break;
 #endif
 #ifdef CONFIG_EXTENDED_VFS_SPI
     case SPIIOCSCFG:
     case SPIIOCEXCHANGE:
+    case WM_EXT_WASM_VFS_SPIIOCBATCH:
+    case WM_EXT_WASM_VFS_SPIIOCPREPARE:
         ret = wm_ext_wasm_native_spi_ioctl(exec_env, fd, cmd, va_args);
         break;
 #endif
+#if defined(CONFIG_EXTENDED_VFS_I2C) || defined(CONFIG_EXTENDED_VFS_SPI)
+    case WM_EXT_WASM_VFS_IOCXFER:
+    case WM_EXT_WASM_VFS_IOCUNPREPARE:
+        ret = wm_ext_wasm_vfs_xfer_ioctl(exec_env, fd, cmd, va_args);
+        break;
+#endif
+#ifdef CONFIG_WASMACHINE_EXT_VFS_DMA_POOL
+    case WM_EXT_WASM_VFS_IOCDMASTATS:
+        ret = wm_ext_wasm_vfs_dma_ioctl(exec_env, fd, cmd, va_args);
+        break;
+#endif
+#ifdef CONFIG_WASMACHINE_EXT_VFS_STREAM
+    case WM_EXT_WASM_VFS_STREAMIOCSTART:
+    case WM_EXT_WASM_VFS_STREAMIOCSTOP:
+    case WM_EXT_WASM_VFS_STREAMIOCNEXT:
+    case WM_EXT_WASM_VFS_STREAMIOCSTATS:
+        ret = wm_ext_wasm_vfs_stream_ioctl(exec_env, fd, cmd, va_args);
+        break;
+#endif
 #ifdef CONFIG_EXTENDED_VFS_LEDC
     case LEDCIOCSCFG:
     case LEDCIOCSSETFREQ:
@@ -518,10 +773,22 @@ static int ioctl_wrapper(wasm_exec_env_t exec_env, int fd, int cmd, char *va_arg
         ret = -1;
     }
 
+    return ret;
+}
+
+static int ioctl_wrapper(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
+{
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("ioctl", 0, fd, cmd, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(va_args));
+
+    ret = wm_ext_wasm_native_ioctl(exec_env, fd, cmd, va_args);
     if (ret < 0) {
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
     }
 
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
     return ret;
 }
 #endif
@@ -550,11 +817,12 @@ static int usleep_wrapper(wasm_exec_env_t exec_env, unsigned long us)
 static time_t time_wrapper(wasm_exec_env_t exec_env, time_t *timer)
 {
     time_t *mapped_timer = NULL;
+    wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
 
     if (timer) {
-        mapped_timer = map_ptr(exec_env, timer);
+        mapped_timer = wm_ext_wasm_native_map_ptr(&mem, timer);
         if (!mapped_timer) {
-            set_wasm_errno(exec_env, EFAULT);
+            wm_ext_wasm_native_set_errno(exec_env, EFAULT);
             return (time_t) -1;
         }
     }
@@ -572,27 +840,89 @@ static int rand_wrapper(wasm_exec_env_t exec_env)
     return rand();
 }
 
+/*
+ * Fill a buffer from the hardware RNG, its output is true random when Wi-Fi or Bluetooth
+ * is enabled or bootloader_random_enable() was called, or from getrandom(2) on linux target.
+ */
+static int libc_fill_random(void *buf, uint32_t len)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    uint8_t *p = buf;
+
+    while (len > 0) {
+        ssize_t n = getrandom(p, len, 0);
+
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+
+        p += n;
+        len -= n;
+    }
+#else
+    esp_fill_random(buf, len);
+#endif
+
+    return 0;
+}
+
+static int getrandom_wrapper(wasm_exec_env_t exec_env, void *buf, uint32_t len, uint32_t flags)
+{
+    int ret = len;
+
+    if (flags & ~(WASM_GRND_NONBLOCK | WASM_GRND_RANDOM)) {
+        wm_ext_wasm_native_set_errno(exec_env, EINVAL);
+        return -1;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("getrandom", 0, len, flags);
+
+    if (libc_fill_random(buf, len) < 0) {
+        wm_ext_wasm_native_set_errno(exec_env, errno);
+        ret = -1;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+#if CONFIG_WAMR_ENABLE_LIBC_WASI != 0
+static uint32_t random_get_wrapper(wasm_exec_env_t exec_env, void *buf, uint32_t len)
+{
+    if (libc_fill_random(buf, len) < 0) {
+        return wm_ext_wasm_native_errno_c2wasm(errno);
+    }
+
+    return WASI_ESUCCESS;
+}
+#endif
+
 static struct tm *localtime_r_wrapper(wasm_exec_env_t exec_env, int32_t timer, int32_t tp)
 {
     const time_t *native_timer;
     struct tm *native_tp;
+    wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
 
     if (timer == 0 || tp == 0) {
-        set_wasm_errno(exec_env, EFAULT);
+        wm_ext_wasm_native_set_errno(exec_env, EFAULT);
         return NULL;
     }
 
-    native_timer = map_ptr(exec_env, (const void *)timer);
+    native_timer = wm_ext_wasm_native_map_ptr(&mem, (const void *)timer);
     if (!native_timer) {
         ESP_LOGE(TAG, "localtime_r: failed to map timer pointer");
-        set_wasm_errno(exec_env, EFAULT);
+        wm_ext_wasm_native_set_errno(exec_env, EFAULT);
         return NULL;
     }
 
-    native_tp = map_ptr(exec_env, (const void *)tp);
+    native_tp = wm_ext_wasm_native_map_ptr(&mem, (const void *)tp);
     if (!native_tp) {
         ESP_LOGE(TAG, "localtime_r: failed to map tp pointer");
-        set_wasm_errno(exec_env, EFAULT);
+        wm_ext_wasm_native_set_errno(exec_env, EFAULT);
         return NULL;
     }
 
@@ -600,7 +930,7 @@ static struct tm *localtime_r_wrapper(wasm_exec_env_t exec_env, int32_t timer, i
     struct tm *native_tm = localtime_r(native_timer, native_tp);
     if (!native_tm) {
         ESP_LOGE(TAG, "localtime_r failed");
-        set_wasm_errno(exec_env, errno);
+        wm_ext_wasm_native_set_errno(exec_env, errno);
         return NULL;
     }
 
@@ -616,6 +946,10 @@ static NativeSymbol wm_libc_wrapper_native_symbol[] = {
     REG_NATIVE_FUNC(write,  "(i*~)i"),
     REG_NATIVE_FUNC(pread,  "(i*~i)i"),
     REG_NATIVE_FUNC(pwrite, "(i*~i)i"),
+    REG_NATIVE_FUNC(readv,  "(i*i)i"),
+    REG_NATIVE_FUNC(writev, "(i*i)i"),
+    REG_NATIVE_FUNC(preadv, "(i*iI)i"),
+    REG_NATIVE_FUNC(pwritev, "(i*iI)i"),
     REG_NATIVE_FUNC(lseek,  "(iIi)I"),
     REG_NATIVE_FUNC(fcntl,  "(iii)i"),
     REG_NATIVE_FUNC(fsync,  "(i)i"),
@@ -629,9 +963,20 @@ static NativeSymbol wm_libc_wrapper_native_symbol[] = {
     REG_NATIVE_FUNC(time,   "(*)I"),
     REG_NATIVE_FUNC(srand,  "(i)"),
     REG_NATIVE_FUNC(rand,   "()i"),
+    REG_NATIVE_FUNC(getrandom, "(*~i)i"),
     REG_NATIVE_FUNC(localtime_r, NULL)
 };
 
+#if CONFIG_WAMR_ENABLE_LIBC_WASI != 0
+/*
+ * Natives registered later are looked up first, so this replaces random_get of WAMR
+ * libc-wasi, which getentropy() and arc4random() of wasi-libc are built on.
+ */
+static NativeSymbol wm_wasi_wrapper_native_symbol[] = {
+    REG_NATIVE_FUNC(random_get, "(*~)i"),
+};
+#endif
+
 int wm_ext_wasm_native_libc_export(void)
 {
     NativeSymbol *sym = (NativeSymbol *)wm_libc_wrapper_native_symbol;
@@ -641,6 +986,15 @@ int wm_ext_wasm_native_libc_export(void)
         return -1;
     }
 
+#if CONFIG_WAMR_ENABLE_LIBC_WASI != 0
+    sym = (NativeSymbol *)wm_wasi_wrapper_native_symbol;
+    num = sizeof(wm_wasi_wrapper_native_symbol) / sizeof(wm_wasi_wrapper_native_symbol[0]);
+
+    if (!wasm_native_register_natives("wasi_snapshot_preview1", sym,  num)) {
+        return -1;
+    }
+#endif
+
     return 0;
 }
 
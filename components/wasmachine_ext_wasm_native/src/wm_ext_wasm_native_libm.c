@@ -4,12 +4,16 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include <unistd.h>
 #include <math.h>
 #include <fcntl.h>
 #include <sys/errno.h>
 
 #include "esp_log.h"
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_LIBMATH_ESP_DSP
+#include "esp_dsp.h"
+#endif
 
 #include "bh_platform.h"
 #include "wasm_export.h"
@@ -18,26 +22,354 @@
 
 #include "wm_ext_wasm_native_macro.h"
 #include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_libm.h"
+#include "wm_ext_wasm_native_trace.h"
+
+esp_err_t wm_ext_wasm_native_libm_vmathf(wm_ext_wasm_native_libm_op_t op, float *dst, const float *src, uint32_t n)
+{
+    switch (op) {
+    case WM_EXT_WASM_NATIVE_LIBM_OP_SIN:
+        for (uint32_t i = 0; i < n; i++) {
+            dst[i] = sinf(src[i]);
+        }
+        break;
+    case WM_EXT_WASM_NATIVE_LIBM_OP_COS:
+        for (uint32_t i = 0; i < n; i++) {
+            dst[i] = cosf(src[i]);
+        }
+        break;
+    case WM_EXT_WASM_NATIVE_LIBM_OP_EXP:
+        for (uint32_t i = 0; i < n; i++) {
+            dst[i] = expf(src[i]);
+        }
+        break;
+    case WM_EXT_WASM_NATIVE_LIBM_OP_LOG:
+        for (uint32_t i = 0; i < n; i++) {
+            dst[i] = logf(src[i]);
+        }
+        break;
+    case WM_EXT_WASM_NATIVE_LIBM_OP_SQRT:
+        for (uint32_t i = 0; i < n; i++) {
+            dst[i] = sqrtf(src[i]);
+        }
+        break;
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return ESP_OK;
+}
+
+void wm_ext_wasm_native_libm_vatan2f(float *dst, const float *y, const float *x, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = atan2f(y[i], x[i]);
+    }
+}
+
+void wm_ext_wasm_native_libm_vscalef(float *dst, const float *src, uint32_t n, float scale, float offset)
+{
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_LIBMATH_ESP_DSP
+    dsps_mulc_f32(src, dst, n, scale, 1, 1);
+    dsps_addc_f32(dst, dst, n, offset, 1, 1);
+#else
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = src[i] * scale + offset;
+    }
+#endif
+}
+
+void wm_ext_wasm_native_libm_vscale_s16(int16_t *dst, const int16_t *src, uint32_t n, float scale, float offset)
+{
+    for (uint32_t i = 0; i < n; i++) {
+        float v = rintf(src[i] * scale + offset);
+
+        if (v >= INT16_MAX) {
+            dst[i] = INT16_MAX;
+        } else if (v <= INT16_MIN) {
+            dst[i] = INT16_MIN;
+        } else {
+            dst[i] = (int16_t)v;
+        }
+    }
+}
+
+float wm_ext_wasm_native_libm_vdotf(const float *a, const float *b, uint32_t n)
+{
+    float sum = 0;
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_LIBMATH_ESP_DSP
+    dsps_dotprod_f32(a, b, &sum, n);
+#else
+    for (uint32_t i = 0; i < n; i++) {
+        sum += a[i] * b[i];
+    }
+#endif
+
+    return sum;
+}
+
+int64_t wm_ext_wasm_native_libm_vdot_s16(const int16_t *a, const int16_t *b, uint32_t n)
+{
+    int64_t sum = 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        sum += (int32_t)a[i] * b[i];
+    }
+
+    return sum;
+}
+
+void wm_ext_wasm_native_libm_vstatf(const float *src, uint32_t n, wm_ext_wasm_native_libm_stat_t *stat)
+{
+    float sum = 0;
+
+    stat->min = n ? src[0] : 0;
+    stat->max = n ? src[0] : 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        stat->min = fminf(stat->min, src[i]);
+        stat->max = fmaxf(stat->max, src[i]);
+        sum += src[i];
+    }
+
+    stat->mean = n ? sum / n : 0;
+}
+
+void wm_ext_wasm_native_libm_vstat_s16(const int16_t *src, uint32_t n, wm_ext_wasm_native_libm_stat_t *stat)
+{
+    int64_t sum = 0;
+    int16_t min = n ? src[0] : 0;
+    int16_t max = n ? src[0] : 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        min = src[i] < min ? src[i] : min;
+        max = src[i] > max ? src[i] : max;
+        sum += src[i];
+    }
+
+    stat->min = min;
+    stat->max = max;
+    stat->mean = n ? (float)sum / n : 0;
+}
+
+/*
+ * Arrays are passed by address and number of elements, so check the whole array is in linear memory.
+ * Batch natives return 0 or negative errno, because libm does not depend on libc natives.
+ */
+static void *wasm_libm_map(wasm_module_inst_t module_inst, uint32_t addr, uint32_t n, uint32_t size)
+{
+    uint64_t bytes = (uint64_t)n * size;
+
+    if (bytes > UINT32_MAX || !validate_app_addr(addr, bytes)) {
+        return NULL;
+    }
+
+    return addr_app_to_native(addr);
+}
 
 static float sinf_wrapper(wasm_exec_env_t exec_env, float value)
 {
-    return sinf(value);
+    float ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("sinf", 0);
+    ret = sinf(value);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return ret;
 }
 
 static float cosf_wrapper(wasm_exec_env_t exec_env, float value)
 {
-    return cosf(value);
+    float ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("cosf", 0);
+    ret = cosf(value);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return ret;
 }
 
 static double pow_wrapper(wasm_exec_env_t exec_env, double x, double y)
 {
-    return pow(x, y);
+    double ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("pow", 0);
+    ret = pow(x, y);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return ret;
+}
+
+static int wasm_vmathf_wrapper(wasm_exec_env_t exec_env, int op, uint32_t dst, uint32_t src, uint32_t n)
+{
+    int ret;
+    float *dst_ptr, *src_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    dst_ptr = wasm_libm_map(module_inst, dst, n, sizeof(float));
+    src_ptr = wasm_libm_map(module_inst, src, n, sizeof(float));
+    if (!dst_ptr || !src_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_vmathf", op, dst, src, n);
+    ret = wm_ext_wasm_native_libm_vmathf(op, dst_ptr, src_ptr, n) == ESP_OK ? 0 : -EINVAL;
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static int wasm_vatan2f_wrapper(wasm_exec_env_t exec_env, uint32_t dst, uint32_t y, uint32_t x, uint32_t n)
+{
+    float *dst_ptr, *y_ptr, *x_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    dst_ptr = wasm_libm_map(module_inst, dst, n, sizeof(float));
+    y_ptr = wasm_libm_map(module_inst, y, n, sizeof(float));
+    x_ptr = wasm_libm_map(module_inst, x, n, sizeof(float));
+    if (!dst_ptr || !y_ptr || !x_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_vatan2f", 0, dst, y, x, n);
+    wm_ext_wasm_native_libm_vatan2f(dst_ptr, y_ptr, x_ptr, n);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
+}
+
+static int wasm_vscalef_wrapper(wasm_exec_env_t exec_env, uint32_t dst, uint32_t src, uint32_t n,
+                                float scale, float offset)
+{
+    float *dst_ptr, *src_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    dst_ptr = wasm_libm_map(module_inst, dst, n, sizeof(float));
+    src_ptr = wasm_libm_map(module_inst, src, n, sizeof(float));
+    if (!dst_ptr || !src_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_vscalef", 0, dst, src, n);
+    wm_ext_wasm_native_libm_vscalef(dst_ptr, src_ptr, n, scale, offset);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
+}
+
+static int wasm_vscale_s16_wrapper(wasm_exec_env_t exec_env, uint32_t dst, uint32_t src, uint32_t n,
+                                   float scale, float offset)
+{
+    int16_t *dst_ptr, *src_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    dst_ptr = wasm_libm_map(module_inst, dst, n, sizeof(int16_t));
+    src_ptr = wasm_libm_map(module_inst, src, n, sizeof(int16_t));
+    if (!dst_ptr || !src_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_vscale_s16", 0, dst, src, n);
+    wm_ext_wasm_native_libm_vscale_s16(dst_ptr, src_ptr, n, scale, offset);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
+}
+
+static int wasm_vdotf_wrapper(wasm_exec_env_t exec_env, uint32_t a, uint32_t b, uint32_t n, uint32_t result)
+{
+    float *a_ptr, *b_ptr, *result_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    a_ptr = wasm_libm_map(module_inst, a, n, sizeof(float));
+    b_ptr = wasm_libm_map(module_inst, b, n, sizeof(float));
+    result_ptr = wasm_libm_map(module_inst, result, 1, sizeof(float));
+    if (!a_ptr || !b_ptr || !result_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_vdotf", 0, a, b, n);
+    *result_ptr = wm_ext_wasm_native_libm_vdotf(a_ptr, b_ptr, n);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
+}
+
+static int wasm_vdot_s16_wrapper(wasm_exec_env_t exec_env, uint32_t a, uint32_t b, uint32_t n, uint32_t result)
+{
+    int64_t dot;
+    int16_t *a_ptr, *b_ptr;
+    void *result_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    a_ptr = wasm_libm_map(module_inst, a, n, sizeof(int16_t));
+    b_ptr = wasm_libm_map(module_inst, b, n, sizeof(int16_t));
+    result_ptr = wasm_libm_map(module_inst, result, 1, sizeof(int64_t));
+    if (!a_ptr || !b_ptr || !result_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_vdot_s16", 0, a, b, n);
+    dot = wm_ext_wasm_native_libm_vdot_s16(a_ptr, b_ptr, n);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    /* int64_t of the application may be aligned to 4 bytes only */
+    memcpy(result_ptr, &dot, sizeof(dot));
+
+    return 0;
+}
+
+static int wasm_vstatf_wrapper(wasm_exec_env_t exec_env, uint32_t src, uint32_t n, uint32_t stat)
+{
+    float *src_ptr;
+    wm_ext_wasm_native_libm_stat_t *stat_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    src_ptr = wasm_libm_map(module_inst, src, n, sizeof(float));
+    stat_ptr = wasm_libm_map(module_inst, stat, 1, sizeof(wm_ext_wasm_native_libm_stat_t));
+    if (!src_ptr || !stat_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_vstatf", 0, src, n, stat);
+    wm_ext_wasm_native_libm_vstatf(src_ptr, n, stat_ptr);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
+}
+
+static int wasm_vstat_s16_wrapper(wasm_exec_env_t exec_env, uint32_t src, uint32_t n, uint32_t stat)
+{
+    int16_t *src_ptr;
+    wm_ext_wasm_native_libm_stat_t *stat_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    src_ptr = wasm_libm_map(module_inst, src, n, sizeof(int16_t));
+    stat_ptr = wasm_libm_map(module_inst, stat, 1, sizeof(wm_ext_wasm_native_libm_stat_t));
+    if (!src_ptr || !stat_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_vstat_s16", 0, src, n, stat);
+    wm_ext_wasm_native_libm_vstat_s16(src_ptr, n, stat_ptr);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
 }
 
 static NativeSymbol wm_math_wrapper_native_symbol[] = {
-    REG_NATIVE_FUNC(sinf,   "(f)f"),
-    REG_NATIVE_FUNC(cosf,   "(f)f"),
-    REG_NATIVE_FUNC(pow,    "(FF)F")
+    REG_NATIVE_FUNC(sinf,               "(f)f"),
+    REG_NATIVE_FUNC(cosf,               "(f)f"),
+    REG_NATIVE_FUNC(pow,                "(FF)F"),
+    REG_NATIVE_FUNC(wasm_vmathf,        "(iiii)i"),
+    REG_NATIVE_FUNC(wasm_vatan2f,       "(iiii)i"),
+    REG_NATIVE_FUNC(wasm_vscalef,       "(iiiff)i"),
+    REG_NATIVE_FUNC(wasm_vscale_s16,    "(iiiff)i"),
+    REG_NATIVE_FUNC(wasm_vdotf,         "(iiii)i"),
+    REG_NATIVE_FUNC(wasm_vdot_s16,      "(iiii)i"),
+    REG_NATIVE_FUNC(wasm_vstatf,        "(iii)i"),
+    REG_NATIVE_FUNC(wasm_vstat_s16,     "(iii)i"),
 };
 
 int wm_ext_wasm_native_libm_export(void)
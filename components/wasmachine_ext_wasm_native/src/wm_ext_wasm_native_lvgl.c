@@ -20,7 +20,9 @@
 #include "wm_ext_wasm_native.h"
 #include "wm_ext_wasm_native_macro.h"
 #include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
 #include "wm_ext_wasm_native_lvgl.h"
+#include "wm_ext_wasm_native_trace.h"
 
 #include "lvgl.h"
 #include "src/core/lv_obj_private.h"
@@ -54,9 +56,10 @@
 #define lvgl_native_get_arg(type, name)     type name = *((type *)(args++))
 #define lvgl_native_set_return(val)         *lvgl_ret = (val)
 
-#define DEFINE_LVGL_NATIVE_WRAPPER(func_name)                   \
-    static void func_name ## _wrapper(wasm_exec_env_t exec_env, \
-                                      uint32_t *args,           \
+#define DEFINE_LVGL_NATIVE_WRAPPER(func_name)                        \
+    static void func_name ## _wrapper(wasm_exec_env_t exec_env,      \
+                                      wm_ext_wasm_native_mem_t *mem, \
+                                      uint32_t *args,                \
                                       uint32_t *args_ret)
 
 #define LVGL_NATIVE_WRAPPER(id, func_name, argc)                \
@@ -78,7 +81,8 @@
                                     WM_LV_VERSION_PATCH)
 #define ESP_BROOKESIA_SELECTOR_TRANS_VALUE             0xFFFFFFFF
 
-typedef void (*lvgl_func_t)(wasm_exec_env_t exec_env, uint32_t *args, uint32_t *args_ret);
+typedef void (*lvgl_func_t)(wasm_exec_env_t exec_env, wm_ext_wasm_native_mem_t *mem,
+                            uint32_t *args, uint32_t *args_ret);
 typedef void (*lv_async_cb_t)(void *);
 
 typedef struct lvgl_func_desc {
@@ -167,58 +171,17 @@ static void lvgl_unlock_wrapper(void)
     s_lvgl_ops.unlock();
 }
 
-#if CONFIG_IDF_TARGET_ESP32P4
-static bool ptr_is_in_external_ram(const void *ptr)
-{
-    return ((intptr_t)ptr >= SOC_EXTRAM_LOW) &&
-           ((intptr_t)ptr < SOC_EXTRAM_HIGH);
-}
-#endif
-
-static bool ptr_is_in_ram_or_rom(const void *ptr)
-{
-    bool ret = false;
-
-    if (esp_ptr_in_dram(ptr)) {
-        ret = true;
-    } else if (esp_ptr_in_drom(ptr)) {
-        ret = true;
-#if CONFIG_IDF_TARGET_ESP32P4
-    } else {
-        ret = ptr_is_in_external_ram(ptr);
-#else
-    } else if (esp_ptr_external_ram(ptr)) {
-        ret = true;
-#endif
-    }
-
-    return ret;
-}
-
-static void *map_ptr(wasm_exec_env_t exec_env, const void *app_addr)
-{
-    void *ptr;
-    wasm_module_inst_t module_inst = get_module_inst(exec_env);
-
-    if (ptr_is_in_ram_or_rom(app_addr)) {
-        return (void *)app_addr;
-    }
-
-    ptr = (void *)addr_app_to_native((uint32_t)app_addr);
-    if (!ptr) {
-        ESP_LOGE(TAG, "failed to map app_addr=%p", app_addr);
-        return NULL;
-    }
-
-    return ptr;
-}
-
 static bool lvgl_run_wasm(void *_module_inst, uint32_t cb, int argc, uint32_t *argv)
 {
     bool ret;
     const char *exception;
     wasm_module_inst_t module_inst = (wasm_module_inst_t)_module_inst;
-    wasm_exec_env_t exec_env = wasm_runtime_create_exec_env(module_inst, LVGL_WASM_CALLBACK_STACK_SIZE);
+    wasm_exec_env_t exec_env = wm_ext_wasm_native_get_exec_env(module_inst, LVGL_WASM_CALLBACK_STACK_SIZE);
+
+    if (!exec_env) {
+        ESP_LOGE(TAG, "failed to create execution environment");
+        return false;
+    }
 
     ret = wasm_runtime_call_indirect(exec_env, cb, argc, argv);
     if (!ret) {
@@ -229,7 +192,7 @@ static bool lvgl_run_wasm(void *_module_inst, uint32_t cb, int argc, uint32_t *a
         }
     }
 
-    wasm_runtime_destroy_exec_env(exec_env);
+    wm_ext_wasm_native_put_exec_env(module_inst, exec_env);
 
     return ret;
 }
@@ -256,7 +219,7 @@ static bool esp_addr_executable(uint32_t addr)
 {
     bool is_psram = false;
 #if CONFIG_IDF_TARGET_ESP32P4
-    is_psram = ptr_is_in_external_ram((const void *)addr);
+    is_psram = (addr >= SOC_EXTRAM_LOW) && (addr < SOC_EXTRAM_HIGH);
 #endif
     return (esp_ptr_executable((const void *)addr) || is_psram);
 }
@@ -473,7 +436,7 @@ static lv_image_dsc_t *lvgl_clone_img_desc(wasm_exec_env_t exec_env, const void
     lv_image_dsc_t *dsc;
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
 
-    if (ptr_is_in_ram_or_rom(_dsc)) {
+    if (wm_ext_wasm_native_ptr_is_native(_dsc)) {
         return (lv_image_dsc_t *)_dsc;
     }
 
@@ -849,7 +812,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_add_style)
     lvgl_native_get_arg(lv_style_selector_t, selector);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_obj_add_style: map_ptr failed for style=%p", orig_style);
         return;
@@ -920,9 +883,9 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_label_set_text)
     lvgl_native_get_arg(const char *, txt);
 
     const void *orig_txt = txt;
-    txt = (const char *)map_ptr(exec_env, (const void *)txt);
+    txt = wm_ext_wasm_native_map_string(mem, txt);
     if (!txt) {
-        ESP_LOGE(TAG, "lv_label_set_text: map_ptr failed for txt=%p", orig_txt);
+        ESP_LOGE(TAG, "lv_label_set_text: map_string failed for txt=%p", orig_txt);
         return;
     }
 
@@ -975,9 +938,9 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_table_set_cell_value)
     lvgl_native_get_arg(const char *, txt);
 
     const void *orig_txt = txt;
-    txt = (const char *)map_ptr(exec_env, (const void *)txt);
+    txt = wm_ext_wasm_native_map_string(mem, txt);
     if (!txt) {
-        ESP_LOGE(TAG, "lv_table_set_cell_value: map_ptr failed for txt=%p", orig_txt);
+        ESP_LOGE(TAG, "lv_table_set_cell_value: map_string failed for txt=%p", orig_txt);
         return;
     }
 
@@ -1030,7 +993,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_init)
     lvgl_native_get_arg(lv_style_t *, style);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_init: map_ptr failed for style=%p", orig_style);
         return;
@@ -1044,7 +1007,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_reset)
     lvgl_native_get_arg(lv_style_t *, style);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_reset: map_ptr failed for style=%p", orig_style);
         return;
@@ -1059,7 +1022,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_bg_opa)
     lvgl_native_get_arg(lv_opa_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_bg_opa: map_ptr failed for style=%p", orig_style);
         return;
@@ -1074,7 +1037,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_radius)
     lvgl_native_get_arg(int32_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_radius: map_ptr failed for style=%p", orig_style);
         return;
@@ -1089,7 +1052,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_border_width)
     lvgl_native_get_arg(int32_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_border_width: map_ptr failed for style=%p", orig_style);
         return;
@@ -1104,7 +1067,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_border_opa)
     lvgl_native_get_arg(lv_opa_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_border_opa: map_ptr failed for style=%p", orig_style);
         return;
@@ -1119,7 +1082,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_border_side)
     lvgl_native_get_arg(lv_border_side_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_border_side: map_ptr failed for style=%p", orig_style);
         return;
@@ -1134,7 +1097,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_shadow_opa)
     lvgl_native_get_arg(lv_opa_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_shadow_opa: map_ptr failed for style=%p", orig_style);
         return;
@@ -1149,7 +1112,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_shadow_width)
     lvgl_native_get_arg(int32_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_shadow_width: map_ptr failed for style=%p", orig_style);
         return;
@@ -1164,7 +1127,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_shadow_offset_x)
     lvgl_native_get_arg(int32_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_shadow_offset_x: map_ptr failed for style=%p", orig_style);
         return;
@@ -1179,7 +1142,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_shadow_offset_y)
     lvgl_native_get_arg(int32_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_shadow_offset_y: map_ptr failed for style=%p", orig_style);
         return;
@@ -1194,7 +1157,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_shadow_spread)
     lvgl_native_get_arg(int32_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_shadow_spread: map_ptr failed for style=%p", orig_style);
         return;
@@ -1209,7 +1172,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_image_opa)
     lvgl_native_get_arg(lv_opa_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_image_opa: map_ptr failed for style=%p", orig_style);
         return;
@@ -1224,7 +1187,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_image_recolor_opa)
     lvgl_native_get_arg(lv_opa_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_image_recolor_opa: map_ptr failed for style=%p", orig_style);
         return;
@@ -1238,9 +1201,9 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_text_font)
     lvgl_native_get_arg(lv_style_t *, style);
     lvgl_native_get_arg(const lv_font_t *, font);
 
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
 
-    if (!ptr_is_in_ram_or_rom(font)) {
+    if (!wm_ext_wasm_native_ptr_is_native(font)) {
         ESP_LOGE(TAG, "Wrong font addr %p", font);
         LVGL_TRACE_ABORT();
     }
@@ -1254,7 +1217,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_text_opa)
     lvgl_native_get_arg(lv_opa_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_text_opa: map_ptr failed for style=%p", orig_style);
         return;
@@ -1269,7 +1232,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_line_width)
     lvgl_native_get_arg(int32_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_line_width: map_ptr failed for style=%p", orig_style);
         return;
@@ -1284,7 +1247,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_line_opa)
     lvgl_native_get_arg(lv_opa_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_line_opa: map_ptr failed for style=%p", orig_style);
         return;
@@ -1299,7 +1262,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_arc_width)
     lvgl_native_get_arg(int32_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_arc_width: map_ptr failed for style=%p", orig_style);
         return;
@@ -1314,7 +1277,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_arc_opa)
     lvgl_native_get_arg(lv_opa_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_arc_opa: map_ptr failed for style=%p", orig_style);
         return;
@@ -1329,7 +1292,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_blend_mode)
     lvgl_native_get_arg(lv_blend_mode_t, value);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_blend_mode: map_ptr failed for style=%p", orig_style);
         return;
@@ -1344,7 +1307,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_text_color)
     lvgl_native_get_arg(uint32_t, color_packed);
 
     void *orig_style = style;
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_text_color: map_ptr failed for style=%p", orig_style);
         return;
@@ -1376,7 +1339,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_line_set_points)
     lvgl_native_get_arg(const lv_point_precise_t *, points);
     lvgl_native_get_arg(uint32_t, point_num);
 
-    points = (const lv_point_precise_t *)map_ptr(exec_env, (const void *)points);
+    points = (const lv_point_precise_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)points);
 
     lv_line_set_points(obj, (const lv_point_precise_t *)points, point_num);
 }
@@ -1414,7 +1377,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_image_create)
     lvgl_native_return_type(lv_obj_t *);
     lvgl_native_get_arg(lv_obj_t *, parent);
 
-    parent = map_ptr(exec_env, parent);
+    parent = wm_ext_wasm_native_map_ptr(mem, parent);
     res = lv_image_create(parent);
 
     lvgl_native_set_return(res);
@@ -1461,7 +1424,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_init)
 {
     lvgl_native_get_arg(lv_anim_t *, a);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
 
     lv_anim_init(a);
 
@@ -1475,7 +1438,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_start)
     lvgl_native_get_arg(lv_anim_t *, a);
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
 
 #if CONFIG_WASMACHINE_WASM_EXT_NATIVE_LVGL_USE_WASM_HEAP
     vTaskSetThreadLocalStoragePointer(NULL, LVGL_WASM_TASK_LOCAL_STORAGE_INDEX, module_inst);
@@ -1584,7 +1547,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_theme_default_init)
     lvgl_native_get_arg(bool, dark);
     lvgl_native_get_arg(const lv_font_t *, font);
 
-    if (!ptr_is_in_ram_or_rom(font)) {
+    if (!wm_ext_wasm_native_ptr_is_native(font)) {
         ESP_LOGE(TAG, "Wrong font addr %p", font);
         LVGL_TRACE_ABORT();
     }
@@ -1624,8 +1587,8 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_font_get_bitmap_fmt_txt)
     lvgl_native_get_arg(lv_font_glyph_dsc_t *, g_dsc);
     lvgl_native_get_arg(lv_draw_buf_t *, draw_buf);
 
-    g_dsc = (lv_font_glyph_dsc_t *)map_ptr(exec_env, (const void *)g_dsc);
-    draw_buf = (lv_draw_buf_t *)map_ptr(exec_env, (const void *)draw_buf);
+    g_dsc = (lv_font_glyph_dsc_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)g_dsc);
+    draw_buf = (lv_draw_buf_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)draw_buf);
 
     res = lv_font_get_bitmap_fmt_txt(g_dsc, draw_buf);
 
@@ -1641,8 +1604,8 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_font_get_glyph_dsc_fmt_txt)
     lvgl_native_get_arg(uint32_t, unicode_letter);
     lvgl_native_get_arg(uint32_t, unicode_letter_next);
 
-    dsc_out = (lv_font_glyph_dsc_t *)map_ptr(exec_env, (const void *)dsc_out);
-    if (!ptr_is_in_ram_or_rom(font)) {
+    dsc_out = (lv_font_glyph_dsc_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)dsc_out);
+    if (!wm_ext_wasm_native_ptr_is_native(font)) {
         ESP_LOGE(TAG, "Wrong font addr %p", font);
         LVGL_TRACE_ABORT();
     }
@@ -1680,7 +1643,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_set_style_text_font)
     lvgl_native_get_arg(const lv_font_t *, value);
     lvgl_native_get_arg(lv_style_selector_t, selector);
 
-    value = (const lv_font_t *)map_ptr(exec_env, (const void *)value);
+    value = (const lv_font_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)value);
 
     lv_obj_set_style_text_font(obj, value, selector);
 }
@@ -1712,7 +1675,13 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_tabview_add_tab)
     lvgl_native_get_arg(lv_obj_t *, tv);
     lvgl_native_get_arg(const char *, name);
 
-    name = (const char *)map_ptr(exec_env, (const void *)name);
+    const void *orig_name = name;
+    name = wm_ext_wasm_native_map_string(mem, name);
+    if (orig_name && !name) {
+        ESP_LOGE(TAG, "lv_tabview_add_tab: map_string failed for name=%p", orig_name);
+        lvgl_native_set_return(NULL);
+        return;
+    }
 
     res = lv_tabview_add_tab(tv, name);
 
@@ -1797,7 +1766,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_textarea_set_placeholder_text)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, value);
 
-    value = (const char *)map_ptr(exec_env, (const void *)value);
+    const void *orig_value = value;
+    value = wm_ext_wasm_native_map_string(mem, value);
+    if (orig_value && !value) {
+        ESP_LOGE(TAG, "lv_textarea_set_placeholder_text: map_string failed for value=%p", orig_value);
+        return;
+    }
 
     lv_textarea_set_placeholder_text(obj, value);
 }
@@ -1852,7 +1826,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_dropdown_set_options_static)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, value);
 
-    value = (const char *)map_ptr(exec_env, (const void *)value);
+    const void *orig_value = value;
+    value = wm_ext_wasm_native_map_string(mem, value);
+    if (orig_value && !value) {
+        ESP_LOGE(TAG, "lv_dropdown_set_options_static: map_string failed for value=%p", orig_value);
+        return;
+    }
 
     lv_dropdown_set_options_static(obj, value);
 }
@@ -1892,8 +1871,8 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_set_grid_dsc_array)
     lvgl_native_get_arg(const int32_t *, col_dsc);
     lvgl_native_get_arg(const int32_t *, row_dsc);
 
-    col_dsc = map_ptr(exec_env, col_dsc);
-    row_dsc = map_ptr(exec_env, row_dsc);
+    col_dsc = wm_ext_wasm_native_map_ptr(mem, col_dsc);
+    row_dsc = wm_ext_wasm_native_map_ptr(mem, row_dsc);
 
     lv_obj_set_grid_dsc_array(obj, col_dsc, row_dsc);
 }
@@ -2189,7 +2168,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_checkbox_set_text)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, value);
 
-    value = (const char *)map_ptr(exec_env, (const void *)value);
+    const void *orig_value = value;
+    value = wm_ext_wasm_native_map_string(mem, value);
+    if (orig_value && !value) {
+        ESP_LOGE(TAG, "lv_checkbox_set_text: map_string failed for value=%p", orig_value);
+        return;
+    }
 
     lv_checkbox_set_text(obj, value);
 }
@@ -2254,7 +2238,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_set_style_bg_image_src)
             lv_obj_set_style_bg_image_src(obj, res, selector);
         }
     } else {
-        res = (lv_image_dsc_t *)map_ptr(exec_env, (const void *)value);
+        res = (lv_image_dsc_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)value);
         lv_obj_set_style_bg_image_src(obj, res, selector);
     }
 }
@@ -2276,7 +2260,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_event_get_target)
     lvgl_native_return_type(void *);
     lvgl_native_get_arg(lv_event_t *, e);
 
-    e = map_ptr(exec_env, e);
+    e = wm_ext_wasm_native_map_ptr(mem, e);
 
     res = lv_event_get_target(e);
 
@@ -2289,7 +2273,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_event_get_user_data)
     lvgl_native_return_type(void *);
     lvgl_native_get_arg(lv_event_t *, e);
 
-    e = map_ptr(exec_env, e);
+    e = wm_ext_wasm_native_map_ptr(mem, e);
 
     res = lv_event_get_user_data(e);
 
@@ -2434,15 +2418,15 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_text_get_size)
     lvgl_native_get_arg(int32_t, max_width);
     lvgl_native_get_arg(lv_text_flag_t, flag);
 
-    size_res = map_ptr(exec_env, size_res);
+    size_res = wm_ext_wasm_native_map_ptr(mem, size_res);
     const void *orig_text = text;
-    text = (const char *)map_ptr(exec_env, (const void *)text);
+    text = wm_ext_wasm_native_map_string(mem, text);
     if (!text) {
-        ESP_LOGE(TAG, "lv_text_get_size: map_ptr failed for text=%p", orig_text);
+        ESP_LOGE(TAG, "lv_text_get_size: map_string failed for text=%p", orig_text);
         return;
     }
 
-    if (!ptr_is_in_ram_or_rom(font)) {
+    if (!wm_ext_wasm_native_ptr_is_native(font)) {
         ESP_LOGE(TAG, "Wrong font addr %p", font);
         LVGL_TRACE_ABORT();
     }
@@ -2454,7 +2438,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_rect_dsc_init)
 {
     lvgl_native_get_arg(lv_draw_rect_dsc_t *, dsc);
 
-    dsc = map_ptr(exec_env, dsc);
+    dsc = wm_ext_wasm_native_map_ptr(mem, dsc);
 
     lv_draw_rect_dsc_init(dsc);
 }
@@ -2465,9 +2449,9 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_rect)
     lvgl_native_get_arg(const lv_draw_rect_dsc_t *, dsc);
     lvgl_native_get_arg(const lv_area_t *, coords);
 
-    layer = map_ptr(exec_env, layer);
-    dsc = map_ptr(exec_env, dsc);
-    coords = map_ptr(exec_env, coords);
+    layer = wm_ext_wasm_native_map_ptr(mem, layer);
+    dsc = wm_ext_wasm_native_map_ptr(mem, dsc);
+    coords = wm_ext_wasm_native_map_ptr(mem, coords);
 
     lv_draw_rect(layer, dsc, coords);
 }
@@ -2476,7 +2460,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_label_dsc_init)
 {
     lvgl_native_get_arg(lv_draw_label_dsc_t *, dsc);
 
-    dsc = map_ptr(exec_env, dsc);
+    dsc = wm_ext_wasm_native_map_ptr(mem, dsc);
 
     lv_draw_label_dsc_init(dsc);
 }
@@ -2487,10 +2471,10 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_label)
     lvgl_native_get_arg(lv_draw_label_dsc_t *, dsc);
     lvgl_native_get_arg(const lv_area_t *, coords);
 
-    layer = map_ptr(exec_env, layer);
-    dsc = map_ptr(exec_env, dsc);
-    coords = map_ptr(exec_env, coords);
-    dsc->text = map_ptr(exec_env, dsc->text);
+    layer = wm_ext_wasm_native_map_ptr(mem, layer);
+    dsc = wm_ext_wasm_native_map_ptr(mem, dsc);
+    coords = wm_ext_wasm_native_map_ptr(mem, coords);
+    dsc->text = wm_ext_wasm_native_map_ptr(mem, dsc->text);
     if (!dsc->font) {
         dsc->font = &lv_font_montserrat_14;
     }
@@ -2516,7 +2500,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_calendar_get_pressed_date)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(lv_calendar_date_t *, data);
 
-    data = map_ptr(exec_env, data);
+    data = wm_ext_wasm_native_map_ptr(mem, data);
 
     res = lv_calendar_get_pressed_date(obj, data);
 
@@ -2528,7 +2512,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_textarea_set_text)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, value);
 
-    value = (const char *)map_ptr(exec_env, (const void *)value);
+    const void *orig_value = value;
+    value = wm_ext_wasm_native_map_string(mem, value);
+    if (orig_value && !value) {
+        ESP_LOGE(TAG, "lv_textarea_set_text: map_string failed for value=%p", orig_value);
+        return;
+    }
 
     lv_textarea_set_text(obj, value);
 }
@@ -2566,9 +2555,9 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_area_intersect)
     lvgl_native_get_arg(lv_area_t *, a1_p);
     lvgl_native_get_arg(lv_area_t *, a2_p);
 
-    res_p = map_ptr(exec_env, res_p);
-    a1_p = map_ptr(exec_env, a1_p);
-    a2_p = map_ptr(exec_env, a2_p);
+    res_p = wm_ext_wasm_native_map_ptr(mem, res_p);
+    a1_p = wm_ext_wasm_native_map_ptr(mem, a1_p);
+    a2_p = wm_ext_wasm_native_map_ptr(mem, a2_p);
 
     res = lv_area_intersect(res_p, a1_p, a2_p);
 
@@ -2665,7 +2654,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_mem_monitor)
 {
     lvgl_native_get_arg(lv_mem_monitor_t *, mon_p);
 
-    mon_p = map_ptr(exec_env, mon_p);
+    mon_p = wm_ext_wasm_native_map_ptr(mem, mon_p);
 
     lv_mem_monitor(mon_p);
 }
@@ -2751,7 +2740,13 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_win_add_title)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, txt);
 
-    txt = (const char *)map_ptr(exec_env, (const void *)txt);
+    const void *orig_txt = txt;
+    txt = wm_ext_wasm_native_map_string(mem, txt);
+    if (orig_txt && !txt) {
+        ESP_LOGE(TAG, "lv_win_add_title: map_string failed for txt=%p", orig_txt);
+        lvgl_native_set_return(NULL);
+        return;
+    }
 
     res = lv_win_add_title(obj, txt);
 
@@ -2766,7 +2761,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_win_add_button)
     lvgl_native_get_arg(const void *, icon);
     lvgl_native_get_arg(int32_t, btn_w);
 
-    icon = map_ptr(exec_env, icon);
+    icon = wm_ext_wasm_native_map_ptr(mem, icon);
 
     res = lv_win_add_button(obj, icon, btn_w);
 
@@ -2797,7 +2792,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_dropdown_set_options)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, options);
 
-    options = (const char *)map_ptr(exec_env, (const void *)options);
+    const void *orig_options = options;
+    options = wm_ext_wasm_native_map_string(mem, options);
+    if (orig_options && !options) {
+        ESP_LOGE(TAG, "lv_dropdown_set_options: map_string failed for options=%p", orig_options);
+        return;
+    }
 
     lv_dropdown_set_options(obj, options);
 }
@@ -2834,7 +2834,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_roller_set_options)
     lvgl_native_get_arg(const char *, options);
     lvgl_native_get_arg(lv_roller_mode_t, mode);
 
-    options = (const char *)map_ptr(exec_env, (const void *)options);
+    const void *orig_options = options;
+    options = wm_ext_wasm_native_map_string(mem, options);
+    if (orig_options && !options) {
+        ESP_LOGE(TAG, "lv_roller_set_options: map_string failed for options=%p", orig_options);
+        return;
+    }
 
     lv_roller_set_options(obj, options, mode);
 }
@@ -2913,8 +2918,14 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_list_add_button)
     lvgl_native_get_arg(const void *, icon);
     lvgl_native_get_arg(const char *, txt);
 
-    icon = map_ptr(exec_env, icon);
-    txt = (const char *)map_ptr(exec_env, (const void *)txt);
+    icon = wm_ext_wasm_native_map_ptr(mem, icon);
+    const void *orig_txt = txt;
+    txt = wm_ext_wasm_native_map_string(mem, txt);
+    if (orig_txt && !txt) {
+        ESP_LOGE(TAG, "lv_list_add_button: map_string failed for txt=%p", orig_txt);
+        lvgl_native_set_return(NULL);
+        return;
+    }
 
     res = lv_list_add_button(obj, icon, txt);
 
@@ -2950,7 +2961,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_textarea_add_text)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, txt);
 
-    txt = (const char *)map_ptr(exec_env, (const void *)txt);
+    const void *orig_txt = txt;
+    txt = wm_ext_wasm_native_map_string(mem, txt);
+    if (orig_txt && !txt) {
+        ESP_LOGE(TAG, "lv_textarea_add_text: map_string failed for txt=%p", orig_txt);
+        return;
+    }
 
     lv_textarea_add_text(obj, txt);
 }
@@ -3019,7 +3035,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_width)
     lvgl_native_get_arg(lv_style_t *, style);
     lvgl_native_get_arg(int32_t, value);
 
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
 
     lv_style_set_width(style, value);
 }
@@ -3030,7 +3046,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_bg_color)
     lvgl_native_get_arg(uint32_t, color_packed);
 
     void *orig_style = style;
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_bg_color: map_ptr failed for style=%p", orig_style);
         return;
@@ -3050,7 +3066,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_pad_right)
     lvgl_native_get_arg(lv_style_t *, style);
     lvgl_native_get_arg(int32_t, value);
 
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
 
     lv_style_set_pad_right(style, value);
 }
@@ -3060,8 +3076,8 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_grid_column_dsc_array)
     lvgl_native_get_arg(lv_style_t *, style);
     lvgl_native_get_arg(const int32_t *, value);
 
-    style = map_ptr(exec_env, style);
-    value = map_ptr(exec_env, value);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
+    value = wm_ext_wasm_native_map_ptr(mem, value);
 
     lv_style_set_grid_column_dsc_array(style, value);
 }
@@ -3071,8 +3087,8 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_grid_row_dsc_array)
     lvgl_native_get_arg(lv_style_t *, style);
     lvgl_native_get_arg(const int32_t *, value);
 
-    style = map_ptr(exec_env, style);
-    value = map_ptr(exec_env, value);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
+    value = wm_ext_wasm_native_map_ptr(mem, value);
 
     lv_style_set_grid_row_dsc_array(style, value);
 }
@@ -3082,7 +3098,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_grid_row_align)
     lvgl_native_get_arg(lv_style_t *, style);
     lvgl_native_get_arg(lv_grid_align_t, value);
 
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
 
     lv_style_set_grid_row_align(style, value);
 }
@@ -3092,7 +3108,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_layout)
     lvgl_native_get_arg(lv_style_t *, style);
     lvgl_native_get_arg(uint16_t, value);
 
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
 
     if (!value) {
         value = LV_LAYOUT_GRID;
@@ -3285,7 +3301,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_path_bounce)
     lvgl_native_return_type(int32_t);
     lvgl_native_get_arg(const lv_anim_t *, a);
 
-    a = map_ptr(exec_env, a);
+    a = wm_ext_wasm_native_map_ptr(mem, a);
 
     res = lv_anim_path_bounce(a);
 
@@ -3307,7 +3323,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_path_ease_out)
     lvgl_native_return_type(int32_t);
     lvgl_native_get_arg(const lv_anim_t *, a);
 
-    a = map_ptr(exec_env, a);
+    a = wm_ext_wasm_native_map_ptr(mem, a);
 
     res = lv_anim_path_ease_out(a);
 
@@ -3353,7 +3369,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_path_linear)
     lvgl_native_return_type(int32_t);
     lvgl_native_get_arg(const lv_anim_t *, a);
 
-    a = map_ptr(exec_env, a);
+    a = wm_ext_wasm_native_map_ptr(mem, a);
 
     res = lv_anim_path_linear(a);
 
@@ -3366,7 +3382,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_path_overshoot)
     lvgl_native_return_type(int32_t);
     lvgl_native_get_arg(lv_anim_t *, a);
 
-    a = map_ptr(exec_env, a);
+    a = wm_ext_wasm_native_map_ptr(mem, a);
 
     res = lv_anim_path_overshoot(a);
 
@@ -3453,7 +3469,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_path_ease_in)
     lvgl_native_return_type(int32_t);
     lvgl_native_get_arg(const lv_anim_t *, a);
 
-    a = map_ptr(exec_env, a);
+    a = wm_ext_wasm_native_map_ptr(mem, a);
 
     res = lv_anim_path_ease_in(a);
 
@@ -3480,7 +3496,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_get_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_OBJ_COORDS && n == sizeof(obj->coords)) {
         memcpy(pdata, &obj->coords, sizeof(obj->coords));
@@ -3499,7 +3515,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_rect_dsc_get_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_RECT_DSC_BASE && n == sizeof(dsc->base)) {
         memcpy(pdata, &dsc->base, sizeof(dsc->base));
@@ -3542,7 +3558,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_rect_dsc_set_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_RECT_DSC_BASE && n == sizeof(dsc->base)) {
         memcpy(&dsc->base, pdata, sizeof(dsc->base));
@@ -3779,12 +3795,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_font_get_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    if (!ptr_is_in_ram_or_rom(font)) {
+    if (!wm_ext_wasm_native_ptr_is_native(font)) {
         ESP_LOGE(TAG, "Wrong font addr %p", font);
         LVGL_TRACE_ABORT();
     }
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_FONT_LINE_HEIGHT && n == sizeof(font->line_height)) {
         memcpy(pdata, &font->line_height, sizeof(font->line_height));
@@ -3799,7 +3815,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_label_set_text_static)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, text);
 
-    text = (const char *)map_ptr(exec_env, (const void *)text);
+    const void *orig_text = text;
+    text = wm_ext_wasm_native_map_string(mem, text);
+    if (orig_text && !text) {
+        ESP_LOGE(TAG, "lv_label_set_text_static: map_string failed for text=%p", orig_text);
+        return;
+    }
 
     lv_label_set_text_static(obj, text);
 }
@@ -3810,7 +3831,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_border_color)
     lvgl_native_get_arg(uint32_t, color_packed);
 
     void *orig_style = style;
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_border_color: map_ptr failed for style=%p", orig_style);
         return;
@@ -3831,7 +3852,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_shadow_color)
     lvgl_native_get_arg(uint32_t, color_packed);
 
     void *orig_style = style;
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_shadow_color: map_ptr failed for style=%p", orig_style);
         return;
@@ -3852,7 +3873,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_outline_color)
     lvgl_native_get_arg(uint32_t, color_packed);
 
     void *orig_style = style;
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_outline_color: map_ptr failed for style=%p", orig_style);
         return;
@@ -3872,7 +3893,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_outline_width)
     lvgl_native_get_arg(lv_style_t *, style);
     lvgl_native_get_arg(int32_t, value);
 
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
 
     lv_style_set_outline_width(style, value);
 }
@@ -4088,7 +4109,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_get_click_area)
     lvgl_native_get_arg(const lv_obj_t *, obj);
     lvgl_native_get_arg(lv_area_t *, area);
 
-    area = map_ptr(exec_env, area);
+    area = wm_ext_wasm_native_map_ptr(mem, area);
 
     lv_obj_get_click_area(obj, area);
 }
@@ -4099,7 +4120,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_indev_set_button_points)
     lvgl_native_get_arg(const lv_point_t *, points);
 
     if (points) {
-        points = map_ptr(exec_env, points);
+        points = wm_ext_wasm_native_map_ptr(mem, points);
     }
 
     lv_indev_set_button_points(indev, points);
@@ -4124,7 +4145,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_qrcode_update)
     lvgl_native_get_arg(const void *, data);
     lvgl_native_get_arg(uint32_t, data_len);
 
-    data = map_ptr(exec_env, data);
+    data = wm_ext_wasm_native_map_ptr(mem, data);
 
     res = lv_qrcode_update(obj, data, data_len);
 
@@ -4162,7 +4183,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_timer_set_period)
     lvgl_native_get_arg(lv_timer_t *, timer);
     lvgl_native_get_arg(uint32_t, period);
 
-    timer = map_ptr(exec_env, timer);
+    timer = wm_ext_wasm_native_map_ptr(mem, timer);
 
     lv_timer_set_period(timer, period);
 }
@@ -4185,7 +4206,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_timer_get_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
     if (n == sizeof(anim_timer->period)) {
         memcpy(pdata, &anim_timer->period, sizeof(anim_timer->period));
         res = 0;
@@ -4215,8 +4236,8 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_timer_ctx_get_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    timer_ctx = map_ptr(exec_env, timer_ctx);
-    pdata = map_ptr(exec_env, pdata);
+    timer_ctx = wm_ext_wasm_native_map_ptr(mem, timer_ctx);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_TIMER_CTX_COUNT_VAL && n == sizeof(timer_ctx->count_val)) {
         memcpy(pdata, &timer_ctx->count_val, sizeof(timer_ctx->count_val));
@@ -4235,8 +4256,8 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_timer_ctx_set_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    timer_ctx = map_ptr(exec_env, timer_ctx);
-    pdata = map_ptr(exec_env, pdata);
+    timer_ctx = wm_ext_wasm_native_map_ptr(mem, timer_ctx);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_TIMER_CTX_COUNT_VAL && n == sizeof(timer_ctx->count_val)) {
         memcpy(&timer_ctx->count_val, pdata, sizeof(timer_ctx->count_val));
@@ -4250,7 +4271,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_timer_ready)
 {
     lvgl_native_get_arg(lv_timer_t *, timer);
 
-    timer = map_ptr(exec_env, timer);
+    timer = wm_ext_wasm_native_map_ptr(mem, timer);
 
     lv_timer_ready(timer);
 }
@@ -4278,7 +4299,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_var)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(void *, var);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_var(a, var);
 }
 
@@ -4287,7 +4308,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_duration)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(uint32_t, duration);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_duration(a, duration);
 }
 
@@ -4297,7 +4318,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_delay)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(uint32_t, delay);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_delay(a, delay);
 }
 
@@ -4305,7 +4326,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_delete_anim_completed_cb)
 {
     lvgl_native_get_arg(lv_anim_t *, a);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_obj_delete_anim_completed_cb(a);
 }
 
@@ -4314,7 +4335,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_completed_cb)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(lv_anim_completed_cb_t, completed_cb);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_completed_cb(a, completed_cb);
 }
 
@@ -4323,7 +4344,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_exec_cb)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(lv_anim_exec_xcb_t, exec_cb);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_exec_cb(a, exec_cb);
 }
 
@@ -4332,7 +4353,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_path_cb)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(lv_anim_path_cb_t, path_cb);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_path_cb(a, path_cb);
 }
 
@@ -4342,7 +4363,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_values)
     lvgl_native_get_arg(int32_t, start);
     lvgl_native_get_arg(int32_t, end);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_values(a, start, end);
 }
 
@@ -4351,7 +4372,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_reverse_duration)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(uint32_t, duration);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_reverse_duration(a, duration);
 }
 
@@ -4360,7 +4381,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_repeat_count)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(uint32_t, cnt);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_repeat_count(a, cnt);
 }
 
@@ -4390,7 +4411,13 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_msgbox_add_title)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, title);
 
-    title = (const char *)map_ptr(exec_env, (const void *)title);
+    const void *orig_title = title;
+    title = wm_ext_wasm_native_map_string(mem, title);
+    if (orig_title && !title) {
+        ESP_LOGE(TAG, "lv_msgbox_add_title: map_string failed for title=%p", orig_title);
+        lvgl_native_set_return(NULL);
+        return;
+    }
 
     res = lv_msgbox_add_title(obj, title);
 
@@ -4404,7 +4431,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_msgbox_add_header_button)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const void *, icon);
 
-    icon = map_ptr(exec_env, icon);
+    icon = wm_ext_wasm_native_map_ptr(mem, icon);
 
     res = lv_msgbox_add_header_button(obj, icon);
 
@@ -4418,7 +4445,13 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_msgbox_add_text)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, text);
 
-    text = (const char *)map_ptr(exec_env, (const void *)text);
+    const void *orig_text = text;
+    text = wm_ext_wasm_native_map_string(mem, text);
+    if (orig_text && !text) {
+        ESP_LOGE(TAG, "lv_msgbox_add_text: map_string failed for text=%p", orig_text);
+        lvgl_native_set_return(NULL);
+        return;
+    }
 
     res = lv_msgbox_add_text(obj, text);
 
@@ -4432,7 +4465,13 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_msgbox_add_footer_button)
     lvgl_native_get_arg(lv_obj_t *, obj);
     lvgl_native_get_arg(const char *, text);
 
-    text = (const char *)map_ptr(exec_env, (const void *)text);
+    const void *orig_text = text;
+    text = wm_ext_wasm_native_map_string(mem, text);
+    if (orig_text && !text) {
+        ESP_LOGE(TAG, "lv_msgbox_add_footer_button: map_string failed for text=%p", orig_text);
+        lvgl_native_set_return(NULL);
+        return;
+    }
 
     res = lv_msgbox_add_footer_button(obj, text);
 
@@ -4483,7 +4522,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_dsc_base_get_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_DSC_BASE_OBJ && n == sizeof(*dsc->obj)) {
         memcpy(pdata, dsc->obj, sizeof(*dsc->obj));
@@ -4523,7 +4562,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_dsc_base_set_data)
         return;
     }
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_DSC_BASE_OBJ && n == sizeof(*dsc->obj)) {
         // Check if dsc->obj is NULL before memcpy
@@ -4563,7 +4602,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_line_dsc_get_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_LINE_DSC_BASE && n == sizeof(dsc->base)) {
         memcpy(pdata, &dsc->base, sizeof(dsc->base));
@@ -4597,7 +4636,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_line_dsc_set_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_LINE_DSC_BASE && n == sizeof(dsc->base)) {
         memcpy(&dsc->base, pdata, sizeof(dsc->base));
@@ -4631,7 +4670,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_fill_dsc_get_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_FILL_DSC_RADIUS && n == sizeof(dsc->radius)) {
         memcpy(pdata, &dsc->radius, sizeof(dsc->radius));
@@ -4785,7 +4824,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_scale_set_section_style_main)
     lvgl_native_get_arg(lv_scale_section_t *, section);
     lvgl_native_get_arg(lv_style_t *, style);
 
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
 
     lv_scale_set_section_style_main(scale, section, (const lv_style_t *)style);
 }
@@ -4796,7 +4835,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_scale_set_section_style_indicator)
     lvgl_native_get_arg(lv_scale_section_t *, section);
     lvgl_native_get_arg(lv_style_t *, style);
 
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
 
     lv_scale_set_section_style_indicator(scale, section, (const lv_style_t *)style);
 }
@@ -4807,7 +4846,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_scale_set_section_style_items)
     lvgl_native_get_arg(lv_scale_section_t *, section);
     lvgl_native_get_arg(lv_style_t *, style);
 
-    style = (lv_style_t *)map_ptr(exec_env, (const void *)style);
+    style = (lv_style_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)style);
 
     lv_scale_set_section_style_items(scale, section, (const lv_style_t *)style);
 }
@@ -4845,7 +4884,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_task_get_area)
     lvgl_native_get_arg(const lv_draw_task_t *, t);
     lvgl_native_get_arg(lv_area_t *, area);
 
-    area = map_ptr(exec_env, area);
+    area = wm_ext_wasm_native_map_ptr(mem, area);
 
     lv_draw_task_get_area(t, area);
 }
@@ -4898,7 +4937,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_triangle_dsc_init)
 {
     lvgl_native_get_arg(lv_draw_triangle_dsc_t *, dsc);
 
-    dsc = map_ptr(exec_env, dsc);
+    dsc = wm_ext_wasm_native_map_ptr(mem, dsc);
 
     lv_draw_triangle_dsc_init(dsc);
 }
@@ -4908,7 +4947,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_triangle)
     lvgl_native_get_arg(lv_layer_t *, layer);
     lvgl_native_get_arg(const lv_draw_triangle_dsc_t *, draw_dsc);
 
-    draw_dsc = map_ptr(exec_env, draw_dsc);
+    draw_dsc = wm_ext_wasm_native_map_ptr(mem, draw_dsc);
 
     lv_draw_triangle(layer, draw_dsc);
 }
@@ -5039,7 +5078,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_get_coords)
     lvgl_native_get_arg(const lv_obj_t *, obj);
     lvgl_native_get_arg(lv_area_t *, coords);
 
-    coords = map_ptr(exec_env, coords);
+    coords = wm_ext_wasm_native_map_ptr(mem, coords);
 
     lv_obj_get_coords(obj, coords);
 }
@@ -5115,7 +5154,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_arc_color)
     lvgl_native_get_arg(uint32_t, color_packed);
 
     void *orig_style = style;
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_arc_color: map_ptr failed for style=%p", orig_style);
         return;
@@ -5136,7 +5175,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_style_set_line_color)
     lvgl_native_get_arg(uint32_t, color_packed);
 
     void *orig_style = style;
-    style = map_ptr(exec_env, style);
+    style = wm_ext_wasm_native_map_ptr(mem, style);
     if (!style) {
         ESP_LOGE(TAG, "lv_style_set_line_color: map_ptr failed for style=%p", orig_style);
         return;
@@ -5241,7 +5280,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_area_get_width)
     lvgl_native_return_type(int32_t);
     lvgl_native_get_arg(const lv_area_t *, area_p);
 
-    area_p = map_ptr(exec_env, area_p);
+    area_p = wm_ext_wasm_native_map_ptr(mem, area_p);
     res = lv_area_get_width(area_p);
 
     lvgl_native_set_return(res);
@@ -5253,7 +5292,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_area_get_height)
     lvgl_native_return_type(int32_t);
     lvgl_native_get_arg(const lv_area_t *, area_p);
 
-    area_p = map_ptr(exec_env, area_p);
+    area_p = wm_ext_wasm_native_map_ptr(mem, area_p);
     res = lv_area_get_height(area_p);
 
     lvgl_native_set_return(res);
@@ -5321,7 +5360,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_get_obs_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_SYSMON_BACKEND_DATA && n == sizeof(disp->perf_sysmon_backend)) {
         memcpy(pdata, &disp->perf_sysmon_backend, sizeof(disp->perf_sysmon_backend));
@@ -5340,7 +5379,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_task_get_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_TASK_DSC_BASE && n == sizeof(lv_draw_dsc_base_t)) {
         memcpy(pdata, t->draw_dsc, sizeof(lv_draw_dsc_base_t));
@@ -5359,7 +5398,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_fill_dsc_set_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_FILL_DSC_COLOR && n == sizeof(dsc->color)) {
         memcpy(&dsc->color, pdata, sizeof(dsc->color));
@@ -5378,7 +5417,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_label_dsc_set_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_LABEL_DSC_COLOR && n == sizeof(dsc->color)) {
         memcpy(&dsc->color, pdata, sizeof(dsc->color));
@@ -5397,7 +5436,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_draw_border_dsc_set_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_DRAW_BORDER_DSC_COLOR && n == sizeof(dsc->color)) {
         memcpy(&dsc->color, pdata, sizeof(dsc->color));
@@ -5419,7 +5458,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_font_get_line_height)
     lvgl_native_return_type(int32_t);
     lvgl_native_get_arg(const lv_font_t *, font);
 
-    if (!ptr_is_in_ram_or_rom(font)) {
+    if (!wm_ext_wasm_native_ptr_is_native(font)) {
         ESP_LOGE(TAG, "Wrong font addr %p", font);
         LVGL_TRACE_ABORT();
     }
@@ -5449,7 +5488,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_get_sys_perf_data)
     lvgl_native_get_arg(void *, pdata);
     lvgl_native_get_arg(int, n);
 
-    pdata = map_ptr(exec_env, pdata);
+    pdata = wm_ext_wasm_native_map_ptr(mem, pdata);
 
     if (type == LV_SYS_PERF_INFO_CALC && n == sizeof(info->calculated)) {
         memcpy(pdata, &info->calculated, sizeof(info->calculated));
@@ -5593,7 +5632,12 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_label_ins_text)
     lvgl_native_get_arg(uint32_t, pos);
     lvgl_native_get_arg(const char *, txt);
 
-    txt = (const char *)map_ptr(exec_env, (const void *)txt);
+    const void *orig_txt = txt;
+    txt = wm_ext_wasm_native_map_string(mem, txt);
+    if (!txt) {
+        ESP_LOGE(TAG, "lv_label_ins_text: map_string failed for txt=%p", orig_txt);
+        return;
+    }
 
     lv_label_ins_text(obj, pos, txt);
 }
@@ -5662,7 +5706,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_subject_get_pointer)
     lvgl_native_return_type(const void *);
     lvgl_native_get_arg(lv_subject_t *, subject);
 
-    subject = (lv_subject_t *)map_ptr(exec_env, (const void *)subject);
+    subject = (lv_subject_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)subject);
     res = lv_subject_get_pointer(subject);
 
     lvgl_native_set_return(res);
@@ -5707,7 +5751,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_set_style_grid_column_dsc_array)
     lvgl_native_get_arg(const int32_t *, value);
     lvgl_native_get_arg(lv_style_selector_t, selector);
 
-    value = map_ptr(exec_env, value);
+    value = wm_ext_wasm_native_map_ptr(mem, value);
 
     lv_obj_set_style_grid_column_dsc_array(obj, value, selector);
 }
@@ -5718,7 +5762,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_obj_set_style_grid_row_dsc_array)
     lvgl_native_get_arg(const int32_t *, value);
     lvgl_native_get_arg(lv_style_selector_t, selector);
 
-    value = map_ptr(exec_env, value);
+    value = wm_ext_wasm_native_map_ptr(mem, value);
 
     lv_obj_set_style_grid_row_dsc_array(obj, value, selector);
 }
@@ -5766,7 +5810,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_display_set_theme)
     lvgl_native_get_arg(lv_display_t *, disp);
     lvgl_native_get_arg(lv_theme_t *, th);
 
-    th = (lv_theme_t *)map_ptr(exec_env, (const void *)th);
+    th = (lv_theme_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)th);
 
     lv_display_set_theme(disp, th);
 }
@@ -5853,7 +5897,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_user_data)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(void *, user_data);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_user_data(a, user_data);
 }
 
@@ -5862,7 +5906,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_custom_exec_cb)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(lv_anim_custom_exec_cb_t, exec_cb);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_custom_exec_cb(a, exec_cb);
 }
 
@@ -5871,7 +5915,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_deleted_cb)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(lv_anim_deleted_cb_t, deleted_cb);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_deleted_cb(a, deleted_cb);
 }
 
@@ -5880,7 +5924,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_reverse_delay)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(uint32_t, delay);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_reverse_delay(a, delay);
 }
 
@@ -5889,7 +5933,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_repeat_delay)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(uint32_t, delay);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_repeat_delay(a, delay);
 }
 
@@ -5898,7 +5942,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_early_apply)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(bool, en);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_early_apply(a, en);
 }
 
@@ -5907,7 +5951,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_set_get_value_cb)
     lvgl_native_get_arg(lv_anim_t *, a);
     lvgl_native_get_arg(lv_anim_get_value_cb_t, get_value_cb);
 
-    a = (lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     lv_anim_set_get_value_cb(a, get_value_cb);
 }
 
@@ -6096,7 +6140,7 @@ DEFINE_LVGL_NATIVE_WRAPPER(lv_anim_get_user_data)
     lvgl_native_return_type(void *);
     lvgl_native_get_arg(const lv_anim_t *, a);
 
-    a = (const lv_anim_t *)map_ptr(exec_env, (const void *)a);
+    a = (const lv_anim_t *)wm_ext_wasm_native_map_ptr(mem, (const void *)a);
     res = lv_anim_get_user_data(a);
 
     lvgl_native_set_return(res);
@@ -6565,6 +6609,7 @@ static void esp_lvgl_call_native_func_wrapper(wasm_exec_env_t exec_env,
         uint32_t size;
         uint32_t argv_copy_buf[LVGL_ARG_BUF_NUM];
         uint32_t *argv_copy = argv_copy_buf;
+        wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
 
         if (argc > LVGL_ARG_BUF_NUM) {
             if (argc > LVGL_ARG_NUM_MAX) {
@@ -6588,7 +6633,11 @@ static void esp_lvgl_call_native_func_wrapper(wasm_exec_env_t exec_env,
 
         ESP_LOGD(TAG, "func_id=%"PRIi32" start", func_id);
 
-        func_desc->func(exec_env, argv_copy, argv);
+        WM_EXT_WASM_NATIVE_TRACE_BEGIN_ARGV("lvgl", func_id, argv_copy, argc);
+
+        func_desc->func(exec_env, &mem, argv_copy, argv);
+
+        WM_EXT_WASM_NATIVE_TRACE_END(0);
 
         if (argv_copy != argv_copy_buf) {
             wasm_runtime_free(argv_copy);
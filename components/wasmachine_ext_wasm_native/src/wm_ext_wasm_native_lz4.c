@@ -0,0 +1,634 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+
+#include "wm_ext_wasm_native_lz4.h"
+
+/*
+ * LZ4 frame format codec which runs on caller buffers of any size, so memory is bound
+ * by the window instead of by frame or block sizes. Block and content checksums of
+ * input frames are skipped, frames written by the compressor have none.
+ */
+
+#define LZ4_MAGIC               0x184d2204
+#define LZ4_MIN_MATCH           4
+#define LZ4_LAST_LITERALS       5           /*!< Last bytes of a block are always literals */
+#define LZ4_MF_LIMIT            12          /*!< Last match starts at least 12 bytes before block end */
+#define LZ4_MAX_OFFSET          65535
+#define LZ4_HASH_BITS_MAX       12
+#define LZ4_SKIP_TRIGGER        6           /*!< Search step grows every 64 failed positions */
+#define LZ4_RUN_MASK            15
+
+#define LZ4_FLG_VERSION         0x40
+#define LZ4_FLG_VERSION_MASK    0xc0
+#define LZ4_FLG_BLOCK_INDEP     0x20
+#define LZ4_FLG_BLOCK_CSUM      0x10
+#define LZ4_FLG_CONTENT_SIZE    0x08
+#define LZ4_FLG_CONTENT_CSUM    0x04
+#define LZ4_FLG_RESERVED        0x02
+#define LZ4_FLG_DICT_ID         0x01
+#define LZ4_BD_64KB             0x40
+#define LZ4_BD_SIZE_SHIFT       4
+#define LZ4_BD_SIZE_MASK        0x70
+#define LZ4_BLOCK_RAW           0x80000000
+
+#define LZ4_HEADER_MIN          7           /*!< Magic, FLG, BD and HC */
+#define LZ4_HEADER_MAX          19          /*!< With content size and dictionary ID */
+#define LZ4_BLOCK_HEADER        4
+
+#define XXH_PRIME32_1           0x9e3779b1U
+#define XXH_PRIME32_2           0x85ebca77U
+#define XXH_PRIME32_3           0xc2b2ae3dU
+#define XXH_PRIME32_4           0x27d4eb2fU
+#define XXH_PRIME32_5           0x165667b1U
+
+typedef enum lz4_state {
+    LZ4_STATE_HEADER = 0,
+    LZ4_STATE_BLOCK_SIZE,
+    LZ4_STATE_TOKEN,
+    LZ4_STATE_LITERAL_LEN,
+    LZ4_STATE_LITERALS,
+    LZ4_STATE_OFFSET,
+    LZ4_STATE_MATCH_LEN,
+    LZ4_STATE_MATCH,
+    LZ4_STATE_RAW,
+    LZ4_STATE_BLOCK_CSUM,
+    LZ4_STATE_CONTENT_CSUM,
+    LZ4_STATE_END,
+} lz4_state_t;
+
+struct wm_ext_wasm_native_lz4 {
+    bool compress;
+    uint32_t window;                /*!< Window size, it is a power of 2 */
+    uint8_t *buf;                   /*!< History and block input of compressor, output ring of decompressor */
+
+    /* Compressor */
+    uint32_t base;                  /*!< Stream position of buf[0] */
+    uint32_t hist_len;              /*!< History bytes before block input */
+    uint32_t block_len;             /*!< Block input bytes */
+    uint32_t hash_bits;
+    uint32_t *table;                /*!< Stream positions of 4-byte sequences */
+    uint8_t *obuf;                  /*!< Encoded data which is not output yet */
+    uint32_t obuf_len;
+    uint32_t obuf_pos;
+    bool header_done;
+    bool end_done;
+
+    /* Decompressor */
+    lz4_state_t state;
+    uint8_t header[LZ4_HEADER_MAX];
+    uint32_t header_len;
+    uint32_t header_need;
+    uint32_t field;                 /*!< Little-endian field which is being collected */
+    uint32_t field_len;
+    uint32_t block_max;
+    uint32_t block_left;            /*!< Bytes left in current block */
+    uint32_t literal_left;
+    uint32_t match_left;
+    uint32_t offset;
+    uint32_t pos;                   /*!< Output position, the ring index is pos & (window - 1) */
+    uint32_t filled;                /*!< Valid history bytes in ring */
+};
+
+static inline uint32_t lz4_read32(const uint8_t *p)
+{
+    uint32_t v;
+
+    memcpy(&v, p, sizeof(v));
+
+    return v;
+}
+
+static inline uint32_t lz4_read_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline void lz4_write_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint32_t xxh_rotl32(uint32_t x, int r)
+{
+    return (x << r) | (x >> (32 - r));
+}
+
+/* xxHash32 of inputs shorter than 16 bytes, which is all a frame descriptor needs */
+static uint32_t lz4_xxh32_short(const uint8_t *p, uint32_t len)
+{
+    uint32_t h = XXH_PRIME32_5 + len;
+
+    for (; len >= 4; p += 4, len -= 4) {
+        h += lz4_read_le32(p) * XXH_PRIME32_3;
+        h = xxh_rotl32(h, 17) * XXH_PRIME32_4;
+    }
+    for (; len; p++, len--) {
+        h += *p * XXH_PRIME32_5;
+        h = xxh_rotl32(h, 11) * XXH_PRIME32_1;
+    }
+
+    h ^= h >> 15;
+    h *= XXH_PRIME32_2;
+    h ^= h >> 13;
+    h *= XXH_PRIME32_3;
+    h ^= h >> 16;
+
+    return h;
+}
+
+static inline uint8_t lz4_header_checksum(const uint8_t *desc, uint32_t len)
+{
+    return (uint8_t)(lz4_xxh32_short(desc, len) >> 8);
+}
+
+static uint8_t *lz4_write_len(uint8_t *op, uint32_t len)
+{
+    for (; len >= 255; len -= 255) {
+        *op++ = 255;
+    }
+    *op++ = (uint8_t)len;
+
+    return op;
+}
+
+static inline uint32_t lz4_hash(uint32_t seq, uint32_t bits)
+{
+    return (seq * 2654435761U) >> (32 - bits);
+}
+
+/* Worst case size of a sequence, the caller gives up when it doesn't fit */
+static inline uint32_t lz4_seq_bound(uint32_t literals, uint32_t match)
+{
+    return 1 + literals / 255 + 1 + literals + 2 + match / 255 + 1;
+}
+
+/*
+ * Compress block input into dst, matches may reference history before the block.
+ * Return compressed size, or 0 if it is not smaller than the block.
+ */
+static uint32_t lz4_compress_block(wm_ext_wasm_native_lz4_t *lz4, uint8_t *dst)
+{
+    const uint8_t *src = lz4->buf + lz4->hist_len;
+    const uint8_t *ip = src;
+    const uint8_t *anchor = src;
+    const uint8_t *iend = src + lz4->block_len;
+    const uint8_t *mlimit = iend - LZ4_LAST_LITERALS;
+    uint8_t *op = dst;
+    uint8_t *oend = dst + lz4->block_len;
+    uint32_t max_offset = MIN(lz4->window, LZ4_MAX_OFFSET);
+    uint32_t searched = 1 << LZ4_SKIP_TRIGGER;
+    uint32_t literals;
+
+    while (lz4->block_len > LZ4_MF_LIMIT && ip <= iend - LZ4_MF_LIMIT) {
+        uint32_t seq = lz4_read32(ip);
+        uint32_t h = lz4_hash(seq, lz4->hash_bits);
+        uint32_t cur = lz4->base + (uint32_t)(ip - lz4->buf);
+        uint32_t ref = lz4->table[h];
+        const uint8_t *match;
+        const uint8_t *p;
+        uint32_t match_len;
+
+        lz4->table[h] = cur;
+
+        if (ref < lz4->base || ref >= cur || cur - ref > max_offset ||
+                lz4_read32(lz4->buf + (ref - lz4->base)) != seq) {
+            ip += searched++ >> LZ4_SKIP_TRIGGER;
+            continue;
+        }
+
+        match = lz4->buf + (ref - lz4->base) + LZ4_MIN_MATCH;
+        for (p = ip + LZ4_MIN_MATCH; p < mlimit && *p == *match; p++, match++) {
+        }
+
+        literals = (uint32_t)(ip - anchor);
+        match_len = (uint32_t)(p - ip) - LZ4_MIN_MATCH;
+        if (op + lz4_seq_bound(literals, match_len) > oend) {
+            return 0;
+        }
+
+        *op = (uint8_t)(MIN(literals, LZ4_RUN_MASK) << 4) | (uint8_t)MIN(match_len, LZ4_RUN_MASK);
+        op++;
+        if (literals >= LZ4_RUN_MASK) {
+            op = lz4_write_len(op, literals - LZ4_RUN_MASK);
+        }
+        memcpy(op, anchor, literals);
+        op += literals;
+
+        *op++ = (uint8_t)(cur - ref);
+        *op++ = (uint8_t)((cur - ref) >> 8);
+        if (match_len >= LZ4_RUN_MASK) {
+            op = lz4_write_len(op, match_len - LZ4_RUN_MASK);
+        }
+
+        anchor = ip = p;
+        searched = 1 << LZ4_SKIP_TRIGGER;
+    }
+
+    literals = (uint32_t)(iend - anchor);
+    if (op + 1 + literals / 255 + 1 + literals >= oend) {
+        return 0;
+    }
+
+    *op++ = (uint8_t)(MIN(literals, LZ4_RUN_MASK) << 4);
+    if (literals >= LZ4_RUN_MASK) {
+        op = lz4_write_len(op, literals - LZ4_RUN_MASK);
+    }
+    memcpy(op, anchor, literals);
+    op += literals;
+
+    return (uint32_t)(op - dst);
+}
+
+static void lz4_flush_block(wm_ext_wasm_native_lz4_t *lz4)
+{
+    uint32_t total = lz4->hist_len + lz4->block_len;
+    uint32_t keep = MIN(total, lz4->window);
+    uint32_t len = lz4_compress_block(lz4, lz4->obuf + LZ4_BLOCK_HEADER);
+
+    if (len) {
+        lz4_write_le32(lz4->obuf, len);
+    } else {
+        len = lz4->block_len;
+        lz4_write_le32(lz4->obuf, len | LZ4_BLOCK_RAW);
+        memcpy(lz4->obuf + LZ4_BLOCK_HEADER, lz4->buf + lz4->hist_len, len);
+    }
+
+    lz4->obuf_len = LZ4_BLOCK_HEADER + len;
+    lz4->obuf_pos = 0;
+
+    /* Keep the last window of input as history of the next block */
+    memmove(lz4->buf, lz4->buf + total - keep, keep);
+    lz4->base += total - keep;
+    lz4->hist_len = keep;
+    lz4->block_len = 0;
+}
+
+static esp_err_t lz4_compress(wm_ext_wasm_native_lz4_t *lz4, const uint8_t *in, uint32_t *in_len,
+                              uint8_t *out, uint32_t *out_len, bool finish, bool *end)
+{
+    uint32_t in_done = 0;
+    uint32_t out_done = 0;
+    uint32_t n;
+
+    while (1) {
+        n = MIN(lz4->obuf_len - lz4->obuf_pos, *out_len - out_done);
+        if (n) {
+            memcpy(out + out_done, lz4->obuf + lz4->obuf_pos, n);
+            lz4->obuf_pos += n;
+            out_done += n;
+        }
+        if (lz4->obuf_pos < lz4->obuf_len) {
+            break;
+        }
+
+        if (!lz4->header_done) {
+            lz4_write_le32(lz4->obuf, LZ4_MAGIC);
+            lz4->obuf[4] = LZ4_FLG_VERSION;
+            lz4->obuf[5] = LZ4_BD_64KB;
+            lz4->obuf[6] = lz4_header_checksum(lz4->obuf + 4, 2);
+            lz4->obuf_len = LZ4_HEADER_MIN;
+            lz4->obuf_pos = 0;
+            lz4->header_done = true;
+            continue;
+        }
+
+        if (lz4->end_done) {
+            *end = true;
+            break;
+        }
+
+        n = MIN(lz4->window - lz4->block_len, *in_len - in_done);
+        if (n) {
+            memcpy(lz4->buf + lz4->hist_len + lz4->block_len, in + in_done, n);
+            lz4->block_len += n;
+            in_done += n;
+        }
+
+        if (lz4->block_len == lz4->window || (finish && in_done == *in_len && lz4->block_len)) {
+            lz4_flush_block(lz4);
+        } else if (finish && in_done == *in_len) {
+            /* End mark */
+            lz4_write_le32(lz4->obuf, 0);
+            lz4->obuf_len = LZ4_BLOCK_HEADER;
+            lz4->obuf_pos = 0;
+            lz4->end_done = true;
+        } else {
+            break;
+        }
+    }
+
+    *in_len = in_done;
+    *out_len = out_done;
+
+    return ESP_OK;
+}
+
+/* Output decoded bytes and append them to the history ring */
+static void lz4_emit(wm_ext_wasm_native_lz4_t *lz4, const uint8_t *src, uint8_t *out, uint32_t n)
+{
+    uint32_t idx = lz4->pos & (lz4->window - 1);
+    uint32_t first = MIN(n, lz4->window - idx);
+
+    memcpy(out, src, n);
+    memcpy(lz4->buf + idx, src, first);
+    memcpy(lz4->buf, src + first, n - first);
+
+    lz4->pos += n;
+    lz4->filled = MIN(lz4->filled + n, lz4->window);
+}
+
+static esp_err_t lz4_parse_header(wm_ext_wasm_native_lz4_t *lz4)
+{
+    uint8_t flg = lz4->header[4];
+    uint8_t bd = lz4->header[5];
+    uint32_t bd_size = (bd & LZ4_BD_SIZE_MASK) >> LZ4_BD_SIZE_SHIFT;
+
+    if (lz4_read_le32(lz4->header) != LZ4_MAGIC || (flg & LZ4_FLG_VERSION_MASK) != LZ4_FLG_VERSION ||
+            (flg & LZ4_FLG_RESERVED) || (bd & ~LZ4_BD_SIZE_MASK) || bd_size < 4 ||
+            lz4_header_checksum(lz4->header + 4, lz4->header_len - 5) != lz4->header[lz4->header_len - 1]) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    if (flg & LZ4_FLG_DICT_ID) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    /* 64 KiB, 256 KiB, 1 MiB or 4 MiB */
+    lz4->block_max = 1 << (bd_size * 2 + 8);
+
+    return ESP_OK;
+}
+
+static esp_err_t lz4_decompress(wm_ext_wasm_native_lz4_t *lz4, const uint8_t *in, uint32_t *in_len,
+                                uint8_t *out, uint32_t *out_len, bool *end)
+{
+    esp_err_t ret = ESP_OK;
+    const uint8_t *ip = in;
+    const uint8_t *iend = in + *in_len;
+    uint8_t *op = out;
+    uint8_t *oend = out + *out_len;
+    uint32_t n;
+    uint32_t mask = lz4->window - 1;
+    bool block_done;
+
+    while (ret == ESP_OK) {
+        block_done = false;
+
+        switch (lz4->state) {
+        case LZ4_STATE_HEADER:
+            if (ip == iend) {
+                goto exit;
+            }
+
+            lz4->header[lz4->header_len++] = *ip++;
+            if (lz4->header_len == 5) {
+                /* FLG tells whether optional fields follow BD */
+                lz4->header_need = LZ4_HEADER_MIN;
+                lz4->header_need += lz4->header[4] & LZ4_FLG_CONTENT_SIZE ? 8 : 0;
+                lz4->header_need += lz4->header[4] & LZ4_FLG_DICT_ID ? 4 : 0;
+            }
+            if (lz4->header_len < MAX(lz4->header_need, LZ4_HEADER_MIN)) {
+                break;
+            }
+
+            ret = lz4_parse_header(lz4);
+            lz4->state = LZ4_STATE_BLOCK_SIZE;
+            break;
+        case LZ4_STATE_BLOCK_SIZE:
+        case LZ4_STATE_BLOCK_CSUM:
+        case LZ4_STATE_CONTENT_CSUM:
+            if (ip == iend) {
+                goto exit;
+            }
+
+            lz4->field |= (uint32_t)*ip++ << (lz4->field_len * 8);
+            if (++lz4->field_len < 4) {
+                break;
+            }
+
+            if (lz4->state == LZ4_STATE_BLOCK_CSUM) {
+                lz4->state = LZ4_STATE_BLOCK_SIZE;
+            } else if (lz4->state == LZ4_STATE_CONTENT_CSUM) {
+                lz4->state = LZ4_STATE_END;
+            } else if (!lz4->field) {
+                lz4->state = lz4->header[4] & LZ4_FLG_CONTENT_CSUM ? LZ4_STATE_CONTENT_CSUM : LZ4_STATE_END;
+            } else {
+                lz4->block_left = lz4->field & ~LZ4_BLOCK_RAW;
+                if (!lz4->block_left || lz4->block_left > lz4->block_max) {
+                    ret = ESP_ERR_INVALID_RESPONSE;
+                }
+                lz4->state = lz4->field & LZ4_BLOCK_RAW ? LZ4_STATE_RAW : LZ4_STATE_TOKEN;
+            }
+
+            lz4->field = 0;
+            lz4->field_len = 0;
+            break;
+        case LZ4_STATE_TOKEN:
+            if (ip == iend) {
+                goto exit;
+            }
+
+            lz4->literal_left = *ip >> 4;
+            lz4->match_left = *ip & LZ4_RUN_MASK;
+            ip++;
+            lz4->block_left--;
+            lz4->state = lz4->literal_left == LZ4_RUN_MASK ? LZ4_STATE_LITERAL_LEN : LZ4_STATE_LITERALS;
+            break;
+        case LZ4_STATE_LITERAL_LEN:
+        case LZ4_STATE_MATCH_LEN:
+            if (ip == iend) {
+                goto exit;
+            }
+            if (!lz4->block_left) {
+                ret = ESP_ERR_INVALID_RESPONSE;
+                break;
+            }
+
+            n = *ip++;
+            lz4->block_left--;
+            if (lz4->state == LZ4_STATE_LITERAL_LEN) {
+                lz4->literal_left += n;
+                lz4->state = n == 255 ? LZ4_STATE_LITERAL_LEN : LZ4_STATE_LITERALS;
+            } else {
+                lz4->match_left += n;
+                lz4->state = n == 255 ? LZ4_STATE_MATCH_LEN : LZ4_STATE_MATCH;
+            }
+            break;
+        case LZ4_STATE_LITERALS:
+            if (lz4->literal_left > lz4->block_left) {
+                ret = ESP_ERR_INVALID_RESPONSE;
+                break;
+            }
+
+            n = MIN(lz4->literal_left, MIN((uint32_t)(iend - ip), (uint32_t)(oend - op)));
+            if (n) {
+                lz4_emit(lz4, ip, op, n);
+                ip += n;
+                op += n;
+                lz4->literal_left -= n;
+                lz4->block_left -= n;
+            }
+
+            if (lz4->literal_left) {
+                goto exit;
+            }
+
+            /* Last sequence of a block has no match */
+            if (!lz4->block_left) {
+                block_done = true;
+            } else {
+                lz4->state = LZ4_STATE_OFFSET;
+            }
+            break;
+        case LZ4_STATE_OFFSET:
+            if (ip == iend) {
+                goto exit;
+            }
+            if (!lz4->block_left) {
+                ret = ESP_ERR_INVALID_RESPONSE;
+                break;
+            }
+
+            lz4->field |= (uint32_t)*ip++ << (lz4->field_len * 8);
+            lz4->block_left--;
+            if (++lz4->field_len < 2) {
+                break;
+            }
+
+            lz4->offset = lz4->field;
+            lz4->field = 0;
+            lz4->field_len = 0;
+
+            /* Offsets beyond a full ring are valid, but need a larger window */
+            if (!lz4->offset || lz4->offset > lz4->filled) {
+                ret = lz4->offset && lz4->filled == lz4->window ? ESP_ERR_NOT_SUPPORTED : ESP_ERR_INVALID_RESPONSE;
+                break;
+            }
+
+            lz4->state = lz4->match_left == LZ4_RUN_MASK ? LZ4_STATE_MATCH_LEN : LZ4_STATE_MATCH;
+            lz4->match_left += LZ4_MIN_MATCH;
+            break;
+        case LZ4_STATE_MATCH:
+            while (lz4->match_left && op < oend) {
+                uint32_t src = (lz4->pos - lz4->offset) & mask;
+                uint32_t dst = lz4->pos & mask;
+
+                /* Chunks not longer than offset don't overlap the bytes they copy */
+                n = MIN(lz4->match_left, (uint32_t)(oend - op));
+                n = MIN(n, lz4->offset);
+                n = MIN(n, lz4->window - MAX(src, dst));
+
+                memmove(lz4->buf + dst, lz4->buf + src, n);
+                memcpy(op, lz4->buf + dst, n);
+                op += n;
+                lz4->pos += n;
+                lz4->filled = MIN(lz4->filled + n, lz4->window);
+                lz4->match_left -= n;
+            }
+
+            if (lz4->match_left) {
+                goto exit;
+            }
+
+            if (!lz4->block_left) {
+                ret = ESP_ERR_INVALID_RESPONSE;
+                break;
+            }
+            lz4->state = LZ4_STATE_TOKEN;
+            break;
+        case LZ4_STATE_RAW:
+            n = MIN(lz4->block_left, MIN((uint32_t)(iend - ip), (uint32_t)(oend - op)));
+            if (n) {
+                lz4_emit(lz4, ip, op, n);
+                ip += n;
+                op += n;
+                lz4->block_left -= n;
+            }
+
+            if (lz4->block_left) {
+                goto exit;
+            }
+
+            block_done = true;
+            break;
+        case LZ4_STATE_END:
+            *end = true;
+            goto exit;
+        }
+
+        if (block_done) {
+            lz4->state = lz4->header[4] & LZ4_FLG_BLOCK_CSUM ? LZ4_STATE_BLOCK_CSUM : LZ4_STATE_BLOCK_SIZE;
+        }
+    }
+
+exit:
+    *in_len = (uint32_t)(ip - in);
+    *out_len = (uint32_t)(op - out);
+
+    return ret;
+}
+
+esp_err_t wm_ext_wasm_native_lz4_create(bool compress, uint32_t window_bits, wm_ext_wasm_native_lz4_t **lz4)
+{
+    wm_ext_wasm_native_lz4_t *z;
+
+    if (window_bits < WM_EXT_WASM_NATIVE_LZ4_WINDOW_BITS_MIN || window_bits > WM_EXT_WASM_NATIVE_LZ4_WINDOW_BITS_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    z = calloc(1, sizeof(wm_ext_wasm_native_lz4_t));
+    if (!z) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    z->compress = compress;
+    z->window = 1 << window_bits;
+
+    if (compress) {
+        z->hash_bits = MIN(window_bits, LZ4_HASH_BITS_MAX);
+        z->buf = malloc(z->window * 2);
+        z->table = calloc(1 << z->hash_bits, sizeof(uint32_t));
+        z->obuf = malloc(LZ4_BLOCK_HEADER + z->window);
+    } else {
+        z->buf = malloc(z->window);
+    }
+
+    if (!z->buf || (compress && (!z->table || !z->obuf))) {
+        wm_ext_wasm_native_lz4_destroy(z);
+        return ESP_ERR_NO_MEM;
+    }
+
+    *lz4 = z;
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_lz4_update(wm_ext_wasm_native_lz4_t *lz4, const uint8_t *in, uint32_t *in_len,
+                                        uint8_t *out, uint32_t *out_len, bool finish, bool *end)
+{
+    *end = false;
+
+    if (lz4->compress) {
+        return lz4_compress(lz4, in, in_len, out, out_len, finish, end);
+    }
+
+    return lz4_decompress(lz4, in, in_len, out, out_len, end);
+}
+
+void wm_ext_wasm_native_lz4_destroy(wm_ext_wasm_native_lz4_t *lz4)
+{
+    free(lz4->obuf);
+    free(lz4->table);
+    free(lz4->buf);
+    free(lz4);
+}
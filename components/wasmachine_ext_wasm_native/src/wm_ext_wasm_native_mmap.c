@@ -0,0 +1,474 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+#include "esp_partition.h"
+
+#include "wasm_export.h"
+#include "wasm_native.h"
+
+#include "wm_ext_wasm_native_macro.h"
+#include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
+#include "wm_ext_wasm_native_mmap.h"
+
+#define MMAP_PARTITION_PREFIX   "partition:"
+#define MMAP_PAGE_SIZE          CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PAGE_SIZE
+#define MMAP_PAGE_NUM           CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PAGE_NUM
+
+typedef struct mmap_page {
+    uint8_t *data;
+    uint32_t index;                 /*!< Page index in the window */
+    uint32_t len;                   /*!< Valid bytes, 0 if the page is empty */
+    uint32_t stamp;                 /*!< Last access time, for LRU eviction */
+} mmap_page_t;
+
+/* Read-only window of a file or a data partition */
+struct wm_ext_wasm_native_mmap {
+    pthread_mutex_t lock;
+    uint32_t size;                  /*!< Window size */
+
+    /* Data partition which is mapped into data address space */
+    const uint8_t *ptr;
+    esp_partition_mmap_handle_t mmap_handle;
+
+    /* File which is read through page cache */
+    int fd;
+    off_t offset;                   /*!< Window offset in the file */
+    uint32_t stamp;
+    mmap_page_t pages[MMAP_PAGE_NUM];
+    wm_ext_wasm_native_mmap_stats_t stats;
+};
+
+static const char *TAG = "wm_mmap";
+
+static pthread_mutex_t s_mmap_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static void wasm_mmap_free(wm_ext_wasm_native_mmap_t *m)
+{
+    if (m->ptr) {
+        esp_partition_munmap(m->mmap_handle);
+    }
+
+    if (m->fd >= 0) {
+        close(m->fd);
+    }
+
+    for (int i = 0; i < MMAP_PAGE_NUM; i++) {
+        free(m->pages[i].data);
+    }
+
+    pthread_mutex_destroy(&m->lock);
+    free(m);
+}
+
+/* Check if a partition label is in CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PARTITIONS */
+static bool wasm_mmap_partition_is_listed(const char *label)
+{
+    size_t len = strlen(label);
+    const char *list = CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PARTITIONS;
+
+    while (len && *list) {
+        const char *end = strchr(list, ',');
+        size_t n = end ? end - list : strlen(list);
+
+        if (n == len && !strncmp(list, label, n)) {
+            return true;
+        }
+
+        list += end ? n + 1 : n;
+    }
+
+    return false;
+}
+
+/* Partitions which keep credentials, calibration or boot state are never mapped */
+static bool wasm_mmap_partition_is_sensitive(const esp_partition_t *part)
+{
+    switch (part->subtype) {
+    case ESP_PARTITION_SUBTYPE_DATA_OTA:
+    case ESP_PARTITION_SUBTYPE_DATA_PHY:
+    case ESP_PARTITION_SUBTYPE_DATA_NVS:
+    case ESP_PARTITION_SUBTYPE_DATA_COREDUMP:
+    case ESP_PARTITION_SUBTYPE_DATA_NVS_KEYS:
+    case ESP_PARTITION_SUBTYPE_DATA_EFUSE_EM:
+        return true;
+    default:
+        return false;
+    }
+}
+
+static int wasm_mmap_open_partition(wm_ext_wasm_native_mmap_t *m, const char *label, uint32_t offset, uint32_t length)
+{
+    esp_err_t ret;
+    const void *ptr;
+    const esp_partition_t *part;
+
+    if (!wasm_mmap_partition_is_listed(label)) {
+        ESP_LOGE(TAG, "partition %s is not allowed to be mapped", label);
+        return EACCES;
+    }
+
+    part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (!part) {
+        return ENOENT;
+    }
+
+    if (wasm_mmap_partition_is_sensitive(part)) {
+        ESP_LOGE(TAG, "partition %s is sensitive and can't be mapped", label);
+        return EACCES;
+    }
+
+    if (offset > part->size) {
+        return EINVAL;
+    }
+
+    m->size = length ? length : part->size - offset;
+    if (m->size > part->size - offset) {
+        return EINVAL;
+    }
+
+    ret = esp_partition_mmap(part, offset, m->size, ESP_PARTITION_MMAP_DATA, &ptr, &m->mmap_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "failed to map partition %s ret=%d", label, ret);
+        return ENOMEM;
+    }
+
+    m->ptr = ptr;
+
+    return 0;
+}
+
+static int wasm_mmap_open_file(wm_ext_wasm_native_mmap_t *m, const char *path, uint32_t offset, uint32_t length)
+{
+    struct stat st;
+
+    m->fd = open(path, O_RDONLY);
+    if (m->fd < 0) {
+        return errno;
+    }
+
+    if (fstat(m->fd, &st) < 0) {
+        return errno;
+    }
+
+    if (offset > st.st_size) {
+        return EINVAL;
+    }
+
+    m->size = length ? length : st.st_size - offset;
+    if (m->size > st.st_size - offset) {
+        return EINVAL;
+    }
+
+    m->offset = offset;
+
+    for (int i = 0; i < MMAP_PAGE_NUM; i++) {
+        m->pages[i].data = malloc(MMAP_PAGE_SIZE);
+        if (!m->pages[i].data) {
+            return ENOMEM;
+        }
+    }
+
+    return 0;
+}
+
+static mmap_page_t *wasm_mmap_get_page(wm_ext_wasm_native_mmap_t *m, uint32_t index)
+{
+    ssize_t n;
+    mmap_page_t *page = &m->pages[0];
+    uint32_t len = MMAP_PAGE_SIZE;
+
+    for (int i = 0; i < MMAP_PAGE_NUM; i++) {
+        if (m->pages[i].len && m->pages[i].index == index) {
+            page = &m->pages[i];
+            page->stamp = ++m->stamp;
+            m->stats.hits++;
+            return page;
+        } else if (!m->pages[i].len || (page->len && m->pages[i].stamp < page->stamp)) {
+            page = &m->pages[i];
+        }
+    }
+
+    if ((uint64_t)index * MMAP_PAGE_SIZE + len > m->size) {
+        len = m->size - index * MMAP_PAGE_SIZE;
+    }
+
+    if (page->len) {
+        m->stats.evictions++;
+    }
+
+    page->len = 0;
+    m->stats.misses++;
+    n = pread(m->fd, page->data, len, m->offset + (off_t)index * MMAP_PAGE_SIZE);
+    if (n != (ssize_t)len) {
+        if (n >= 0) {
+            errno = EIO;
+        }
+        return NULL;
+    }
+
+    page->index = index;
+    page->len = len;
+    page->stamp = ++m->stamp;
+
+    return page;
+}
+
+static int wasm_mmap_read(wm_ext_wasm_native_mmap_t *m, uint32_t offset, uint8_t *buf, uint32_t len)
+{
+    uint32_t done = 0;
+
+    if (offset >= m->size) {
+        return 0;
+    } else if (len > m->size - offset) {
+        len = m->size - offset;
+    }
+
+    if (m->ptr) {
+        memcpy(buf, m->ptr + offset, len);
+        return len;
+    }
+
+    while (done < len) {
+        uint32_t pos = offset + done;
+        uint32_t in_page = pos % MMAP_PAGE_SIZE;
+        uint32_t n = len - done;
+        mmap_page_t *page;
+
+        /* Stream whole pages into the caller's buffer without polluting page cache */
+        if (!in_page && n >= MMAP_PAGE_SIZE) {
+            ssize_t ret;
+
+            n -= n % MMAP_PAGE_SIZE;
+            ret = pread(m->fd, buf + done, n, m->offset + pos);
+            if (ret <= 0) {
+                return done ? (int)done : -1;
+            }
+
+            done += ret;
+            continue;
+        }
+
+        page = wasm_mmap_get_page(m, pos / MMAP_PAGE_SIZE);
+        if (!page) {
+            return done ? (int)done : -1;
+        }
+
+        if (n > page->len - in_page) {
+            n = page->len - in_page;
+        }
+
+        memcpy(buf + done, page->data + in_page, n);
+        done += n;
+    }
+
+    return done;
+}
+
+wm_ext_wasm_native_mmap_t *wm_ext_wasm_native_mmap_open(const char *path, uint32_t offset, uint32_t length)
+{
+    int ret;
+    wm_ext_wasm_native_mmap_t *m;
+
+    m = calloc(1, sizeof(wm_ext_wasm_native_mmap_t));
+    if (!m) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    m->fd = -1;
+    pthread_mutex_init(&m->lock, NULL);
+
+    if (!strncmp(path, MMAP_PARTITION_PREFIX, strlen(MMAP_PARTITION_PREFIX))) {
+        ret = wasm_mmap_open_partition(m, path + strlen(MMAP_PARTITION_PREFIX), offset, length);
+    } else {
+        ret = wasm_mmap_open_file(m, path, offset, length);
+    }
+
+    if (ret) {
+        wasm_mmap_free(m);
+        errno = ret;
+        return NULL;
+    }
+
+    return m;
+}
+
+int wm_ext_wasm_native_mmap_read(wm_ext_wasm_native_mmap_t *m, uint32_t offset, void *buf, uint32_t len)
+{
+    int ret;
+
+    pthread_mutex_lock(&m->lock);
+    ret = wasm_mmap_read(m, offset, buf, len);
+    pthread_mutex_unlock(&m->lock);
+
+    return ret;
+}
+
+uint32_t wm_ext_wasm_native_mmap_size(wm_ext_wasm_native_mmap_t *m)
+{
+    return m->size;
+}
+
+void wm_ext_wasm_native_mmap_get_stats(wm_ext_wasm_native_mmap_t *m, wm_ext_wasm_native_mmap_stats_t *stats)
+{
+    pthread_mutex_lock(&m->lock);
+    *stats = m->stats;
+    pthread_mutex_unlock(&m->lock);
+}
+
+void wm_ext_wasm_native_mmap_close(wm_ext_wasm_native_mmap_t *m)
+{
+    wasm_mmap_free(m);
+}
+
+static wm_ext_wasm_native_mmap_t *wasm_mmap_get(wasm_exec_env_t exec_env, int id)
+{
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+
+    if (!ctx || id < 0 || id >= WM_EXT_WASM_NATIVE_MMAP_MAX_FILES) {
+        return NULL;
+    }
+
+    return (wm_ext_wasm_native_mmap_t *)ctx->mmap[id];
+}
+
+static int wasm_mmap_open_wrapper(wasm_exec_env_t exec_env, const char *path, uint32_t offset, uint32_t length)
+{
+    int id = -1;
+    wm_ext_wasm_native_mmap_t *m;
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+
+    if (!ctx) {
+        return -ENOMEM;
+    }
+
+    m = wm_ext_wasm_native_mmap_open(path, offset, length);
+    if (!m) {
+        return -errno;
+    }
+
+    pthread_mutex_lock(&s_mmap_lock);
+
+    for (int i = 0; i < WM_EXT_WASM_NATIVE_MMAP_MAX_FILES; i++) {
+        if (!ctx->mmap[i]) {
+            ctx->mmap[i] = m;
+            id = i;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&s_mmap_lock);
+
+    if (id < 0) {
+        wasm_mmap_free(m);
+        return -EMFILE;
+    }
+
+    ESP_LOGD(TAG, "open %s offset=%"PRIu32" size=%"PRIu32" id=%d", path, offset, m->size, id);
+
+    return id;
+}
+
+static int wasm_mmap_read_wrapper(wasm_exec_env_t exec_env, int id, uint32_t offset, void *buf, uint32_t len)
+{
+    int ret;
+    wm_ext_wasm_native_mmap_t *m = wasm_mmap_get(exec_env, id);
+
+    if (!m) {
+        return -EBADF;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mmap_read", 0, id, offset, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(buf), len);
+
+    ret = wm_ext_wasm_native_mmap_read(m, offset, buf, len);
+    if (ret < 0) {
+        ret = -errno;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static int wasm_mmap_size_wrapper(wasm_exec_env_t exec_env, int id)
+{
+    wm_ext_wasm_native_mmap_t *m = wasm_mmap_get(exec_env, id);
+
+    if (!m) {
+        return -EBADF;
+    }
+
+    return m->size;
+}
+
+static int wasm_mmap_close_wrapper(wasm_exec_env_t exec_env, int id)
+{
+    wm_ext_wasm_native_mmap_t *m;
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+
+    if (!ctx || id < 0 || id >= WM_EXT_WASM_NATIVE_MMAP_MAX_FILES) {
+        return -EBADF;
+    }
+
+    pthread_mutex_lock(&s_mmap_lock);
+    m = ctx->mmap[id];
+    ctx->mmap[id] = NULL;
+    pthread_mutex_unlock(&s_mmap_lock);
+
+    if (!m) {
+        return -EBADF;
+    }
+
+    wasm_mmap_free(m);
+
+    return 0;
+}
+
+void wm_ext_wasm_native_mmap_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx)
+{
+    for (int i = 0; i < WM_EXT_WASM_NATIVE_MMAP_MAX_FILES; i++) {
+        if (ctx->mmap[i]) {
+            wasm_mmap_free(ctx->mmap[i]);
+            ctx->mmap[i] = NULL;
+        }
+    }
+}
+
+static NativeSymbol wm_mmap_wrapper_native_symbol[] = {
+    REG_NATIVE_FUNC(wasm_mmap_open,     "($ii)i"),
+    REG_NATIVE_FUNC(wasm_mmap_read,     "(ii*~)i"),
+    REG_NATIVE_FUNC(wasm_mmap_size,     "(i)i"),
+    REG_NATIVE_FUNC(wasm_mmap_close,    "(i)i"),
+};
+
+int wm_ext_wasm_native_mmap_export(void)
+{
+    NativeSymbol *sym = (NativeSymbol *)wm_mmap_wrapper_native_symbol;
+    int num = sizeof(wm_mmap_wrapper_native_symbol) / sizeof(wm_mmap_wrapper_native_symbol[0]);
+
+    if (!wasm_native_register_natives("env", sym,  num)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+WM_EXT_WASM_NATIVE_EXPORT_FN(wm_ext_wasm_native_mmap_export)
+{
+    return wm_ext_wasm_native_mmap_export();
+}
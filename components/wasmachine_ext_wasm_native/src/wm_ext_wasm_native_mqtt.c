@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -21,6 +21,8 @@
 
 #include "wm_ext_wasm_native_macro.h"
 #include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -152,9 +154,8 @@ static void mqtt_wrapper_event_callback(module_data *m_data, bh_message_t msg)
         return;
     }
 
-    func_on_conn_data = wasm_runtime_lookup_function(inst, "on_mqtt_dispatch_event");
+    func_on_conn_data = wm_ext_wasm_native_get_func(inst, WM_EXT_WASM_NATIVE_FUNC_MQTT_DISPATCH);
     if (!func_on_conn_data) {
-        ESP_LOGE(TAG, "Cannot find function on_mqtt_dispatch_event");
         return;
     }
 
@@ -348,7 +349,9 @@ static int wasm_mqtt_init_wrapper(wasm_exec_env_t exec_env, uint32_t *mqtt_handl
         goto fail;
     }
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_init", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(args));
     wrapper_mqtt_ctx->client = esp_mqtt_client_init(&wrapper_mqtt_ctx->config);
+    WM_EXT_WASM_NATIVE_TRACE_END(wrapper_mqtt_ctx->client ? ESP_OK : ESP_FAIL);
     if (!wrapper_mqtt_ctx->client) {
         ESP_LOGE(TAG, "Failed to allocate memory for mqtt client");
         goto fail;
@@ -383,7 +386,9 @@ static int wasm_mqtt_destory_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_han
         return ESP_FAIL;
     }
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_destory", 0, mqtt_handle);
     esp_mqtt_client_destroy(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_END(ESP_OK);
 
     wasm_runtime_free(wrapper_mqtt_ctx);
 
@@ -392,47 +397,73 @@ static int wasm_mqtt_destory_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_han
 
 static int wasm_mqtt_start_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_start(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_start", 0, mqtt_handle);
+    ret = esp_mqtt_client_start(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_stop_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_stop(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_stop", 0, mqtt_handle);
+    ret = esp_mqtt_client_stop(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_reconnect_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_reconnect(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_reconnect", 0, mqtt_handle);
+    ret = esp_mqtt_client_reconnect(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_disconnect_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_disconnect(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_disconnect", 0, mqtt_handle);
+    ret = esp_mqtt_client_disconnect(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_publish_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle, const char *topic, void *data, size_t data_len, uint8_t qos)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
@@ -444,32 +475,50 @@ static int wasm_mqtt_publish_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_han
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_publish(wrapper_mqtt_ctx->client, topic, data, data_len, qos, 0);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_publish", 0, mqtt_handle, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(topic), WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(data), data_len, qos);
+    ret = esp_mqtt_client_publish(wrapper_mqtt_ctx->client, topic, data, data_len, qos, 0);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_subscribe_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle, char *topic, uint8_t qos)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_subscribe(wrapper_mqtt_ctx->client, topic, qos);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_subscribe", 0, mqtt_handle, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(topic), qos);
+    ret = esp_mqtt_client_subscribe(wrapper_mqtt_ctx->client, topic, qos);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_unsubscribe_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle, const char *topic)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_unsubscribe(wrapper_mqtt_ctx->client, topic);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_unsubscribe", 0, mqtt_handle, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(topic));
+    ret = esp_mqtt_client_unsubscribe(wrapper_mqtt_ctx->client, topic);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_enqueue_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle, const char *topic, const void *data, int len, int qos, int retain, bool store)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
@@ -481,22 +530,34 @@ static int wasm_mqtt_enqueue_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_han
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_enqueue(wrapper_mqtt_ctx->client, topic, data, len, qos, retain, store);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_enqueue", 0, mqtt_handle, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(topic), WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(data), len, qos, retain, store);
+    ret = esp_mqtt_client_enqueue(wrapper_mqtt_ctx->client, topic, data, len, qos, retain, store);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_set_uri_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle, const char *uri)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_set_uri(wrapper_mqtt_ctx->client, uri);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_set_uri", 0, mqtt_handle, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(uri));
+    ret = esp_mqtt_client_set_uri(wrapper_mqtt_ctx->client, uri);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_config_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle, attr_container_t *args)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx || !args) {
         return ESP_FAIL;
     }
@@ -512,17 +573,27 @@ static int wasm_mqtt_config_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_hand
         return ESP_FAIL;
     }
 
-    return esp_mqtt_set_config(wrapper_mqtt_ctx->client, &wrapper_mqtt_ctx->config);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_config", 0, mqtt_handle, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(args));
+    ret = esp_mqtt_set_config(wrapper_mqtt_ctx->client, &wrapper_mqtt_ctx->config);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_mqtt_get_outbox_size_wrapper(wasm_exec_env_t exec_env, uint32_t mqtt_handle)
 {
+    int ret;
     mqtt_wrapper_ctx_t *wrapper_mqtt_ctx = (mqtt_wrapper_ctx_t *)mqtt_handle;
+
     if (!wrapper_mqtt_ctx) {
         return ESP_FAIL;
     }
 
-    return esp_mqtt_client_get_outbox_size(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_mqtt_get_outbox_size", 0, mqtt_handle);
+    ret = esp_mqtt_client_get_outbox_size(wrapper_mqtt_ctx->client);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static NativeSymbol wm_mqtt_wrapper_native_symbol[] = {
@@ -0,0 +1,144 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "bh_platform.h"
+#include "wasm_export.h"
+#include "wasm_native.h"
+#include "wasm_runtime_common.h"
+
+#include "wm_ext_wasm_native_macro.h"
+#include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
+
+/*
+ * Memory and string functions on ranges of linear memory, they are imported by
+ * applications through wasm_include/wm_native_string.h instead of running wasi-libc
+ * versions in the interpreter. Ranges are validated as a whole, then the optimized
+ * libc of the firmware copies, fills and compares them a word at a time.
+ *
+ * An invalid range raises an out of bounds exception, like a WASM access would.
+ */
+
+static uint32_t wasm_memcpy_wrapper(wasm_exec_env_t exec_env, uint32_t dst, uint32_t src, uint32_t n)
+{
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!validate_app_addr(dst, n) || !validate_app_addr(src, n)) {
+        return 0;
+    }
+
+    /* Overlapping ranges are undefined for memcpy, but they must not corrupt native memory */
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("memcpy", 0, dst, src, n);
+    memmove(addr_app_to_native(dst), addr_app_to_native(src), n);
+    WM_EXT_WASM_NATIVE_TRACE_END(dst);
+
+    return dst;
+}
+
+static uint32_t wasm_memmove_wrapper(wasm_exec_env_t exec_env, uint32_t dst, uint32_t src, uint32_t n)
+{
+    return wasm_memcpy_wrapper(exec_env, dst, src, n);
+}
+
+static uint32_t wasm_memset_wrapper(wasm_exec_env_t exec_env, uint32_t dst, int c, uint32_t n)
+{
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!validate_app_addr(dst, n)) {
+        return 0;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("memset", 0, dst, c, n);
+    memset(addr_app_to_native(dst), c, n);
+    WM_EXT_WASM_NATIVE_TRACE_END(dst);
+
+    return dst;
+}
+
+static int wasm_memcmp_wrapper(wasm_exec_env_t exec_env, uint32_t s1, uint32_t s2, uint32_t n)
+{
+    int ret;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!validate_app_addr(s1, n) || !validate_app_addr(s2, n)) {
+        return 0;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("memcmp", 0, s1, s2, n);
+    ret = memcmp(addr_app_to_native(s1), addr_app_to_native(s2), n);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static uint32_t wasm_memchr_wrapper(wasm_exec_env_t exec_env, uint32_t s, int c, uint32_t n)
+{
+    uint8_t *ptr;
+    uint8_t *found;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!validate_app_addr(s, n)) {
+        return 0;
+    }
+
+    ptr = addr_app_to_native(s);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("memchr", 0, s, c, n);
+    found = memchr(ptr, c, n);
+    WM_EXT_WASM_NATIVE_TRACE_END(found ? 0 : -1);
+
+    return found ? s + (uint32_t)(found - ptr) : 0;
+}
+
+static uint32_t wasm_strlen_wrapper(wasm_exec_env_t exec_env, uint32_t s)
+{
+    size_t len;
+    wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
+
+    /* One scan bounded by the end of linear memory both validates and measures the string */
+    if (wm_ext_wasm_native_mem_resolve(&mem) && s < mem.size) {
+        WM_EXT_WASM_NATIVE_TRACE_BEGIN("strlen", 0, s);
+        len = strnlen((const char *)mem.base + s, mem.size - s);
+        WM_EXT_WASM_NATIVE_TRACE_END(len);
+        if (len < mem.size - s) {
+            return len;
+        }
+    }
+
+    wasm_runtime_set_exception(get_module_inst(exec_env), "out of bounds memory access");
+
+    return 0;
+}
+
+static NativeSymbol wm_string_wrapper_native_symbol[] = {
+    REG_NATIVE_FUNC(wasm_memcpy,    "(iii)i"),
+    REG_NATIVE_FUNC(wasm_memmove,   "(iii)i"),
+    REG_NATIVE_FUNC(wasm_memset,    "(iii)i"),
+    REG_NATIVE_FUNC(wasm_memcmp,    "(iii)i"),
+    REG_NATIVE_FUNC(wasm_memchr,    "(iii)i"),
+    REG_NATIVE_FUNC(wasm_strlen,    "(i)i"),
+};
+
+int wm_ext_wasm_native_string_export(void)
+{
+    NativeSymbol *sym = (NativeSymbol *)wm_string_wrapper_native_symbol;
+    int num = sizeof(wm_string_wrapper_native_symbol) / sizeof(wm_string_wrapper_native_symbol[0]);
+
+    if (!wasm_native_register_natives("env", sym,  num)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+WM_EXT_WASM_NATIVE_EXPORT_FN(wm_ext_wasm_native_string_export)
+{
+    return wm_ext_wasm_native_string_export();
+}
@@ -0,0 +1,443 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/param.h>
+#include <sys/errno.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "wasm_export.h"
+#include "wasm_native.h"
+#ifdef CONFIG_WASMACHINE_APP_MGR
+#include "bh_common.h"
+#include "bh_platform.h"
+#include "app_manager_export.h"
+#include "module_wasm_app.h"
+#endif
+
+#include "wm_ext_wasm_native_macro.h"
+#include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_timer.h"
+#include "wm_ext_wasm_native_trace.h"
+
+/*
+ * Microsecond monotonic clock, and one-shot and periodic timers of esp_timer which
+ * deliver expirations to the message queue of the module, so the application handles
+ * them in its own thread like WAMR timers, but with microsecond periods.
+ */
+
+#define TIMER_MAX_NUM           CONFIG_WASMACHINE_WASM_EXT_NATIVE_TIMER_MAX_NUM
+#define TIMER_TICK_US           ((int64_t)portTICK_PERIOD_MS * 1000)
+/* Creating and arming an esp_timer takes longer than spinning for this time */
+#define TIMER_DELAY_SPIN_US     50
+
+#ifdef CONFIG_WASMACHINE_APP_MGR
+#define HRTIMER_EVENT_WASM      WASM_Msg_Start + 6
+
+/* Slot index in low 8 bits and generation of the slot above them */
+#define HRTIMER_HANDLE(_id, _gen)   ((uint32_t)(_id) | ((_gen) << 8))
+#define HRTIMER_HANDLE_ID(_handle)  ((_handle) & 0xff)
+#define HRTIMER_HANDLE_GEN(_handle) ((_handle) >> 8)
+#define HRTIMER_GEN_MASK            0xffffff
+
+/*
+ * Timers are in one pool of all module instances, and esp_timer callbacks get a handle
+ * instead of a pointer, so a callback which runs while its timer is deleted only finds
+ * that the generation of the slot has changed.
+ */
+typedef struct hrtimer {
+    esp_timer_handle_t timer;               /*!< esp_timer, NULL if the slot is free */
+    wm_ext_wasm_native_ctx_t *owner;        /*!< Native context of the owner, NULL while the slot is freed */
+    uint32_t module_id;                     /*!< Module which expirations are posted to */
+    uint32_t gen;                           /*!< Generation, changed whenever the slot is taken */
+    uint32_t pending;                       /*!< Expirations which the module hasn't handled yet */
+} hrtimer_t;
+
+static const char *TAG = "wm_timer";
+
+static pthread_mutex_t s_timer_lock = PTHREAD_MUTEX_INITIALIZER;
+static hrtimer_t s_timer[TIMER_MAX_NUM];
+#endif
+
+int64_t wm_ext_wasm_native_timer_now_us(void)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+#if !CONFIG_IDF_TARGET_LINUX
+static void timer_delay_callback(void *arg)
+{
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+}
+#endif
+
+/* Block on a timer which expires at the deadline, false if the timer can't be used */
+static bool timer_sleep_until(int64_t deadline_us)
+{
+#if CONFIG_IDF_TARGET_LINUX
+    struct timespec ts = {
+        .tv_sec = deadline_us / 1000000,
+        .tv_nsec = deadline_us % 1000000 * 1000,
+    };
+
+    return clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == 0;
+#else
+    StaticSemaphore_t sem_buf;
+    SemaphoreHandle_t sem = xSemaphoreCreateBinaryStatic(&sem_buf);
+    esp_timer_handle_t timer;
+    esp_timer_create_args_t args = {
+        .callback = timer_delay_callback,
+        .arg = sem,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "wasm_delay",
+    };
+    bool ret = false;
+
+    if (esp_timer_create(&args, &timer) != ESP_OK) {
+        goto exit;
+    }
+
+    if (esp_timer_start_once(timer, MAX(deadline_us - esp_timer_get_time(), 0)) == ESP_OK) {
+        xSemaphoreTake(sem, portMAX_DELAY);
+        ret = true;
+    }
+
+    esp_timer_delete(timer);
+exit:
+    vSemaphoreDelete(sem);
+
+    return ret;
+#endif
+}
+
+int64_t wm_ext_wasm_native_timer_delay_until(int64_t deadline_us)
+{
+    int64_t now;
+
+    /* vTaskDelay(n) returns after n - 1 to n ticks, so it never passes the deadline */
+    while (deadline_us - (now = wm_ext_wasm_native_timer_now_us()) > 2 * TIMER_TICK_US) {
+        vTaskDelay((TickType_t)MIN((deadline_us - now) / TIMER_TICK_US - 1, (int64_t)portMAX_DELAY - 1));
+    }
+
+    /* Less than 2 ticks are left, a tick can't be slept without passing the deadline */
+    if (deadline_us - now > TIMER_DELAY_SPIN_US) {
+        timer_sleep_until(deadline_us);
+    }
+
+    while ((now = wm_ext_wasm_native_timer_now_us()) < deadline_us) {
+        ;
+    }
+
+    return now - deadline_us;
+}
+
+static int64_t wasm_clock_monotonic_us_wrapper(wasm_exec_env_t exec_env)
+{
+    return wm_ext_wasm_native_timer_now_us();
+}
+
+static int64_t wasm_clock_delay_until_wrapper(wasm_exec_env_t exec_env, int64_t deadline_us)
+{
+    int64_t late;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_clock_delay_until", 0, (uint32_t)deadline_us, (uint32_t)(deadline_us >> 32));
+    late = wm_ext_wasm_native_timer_delay_until(deadline_us);
+    WM_EXT_WASM_NATIVE_TRACE_END(late);
+
+    return late;
+}
+
+#ifdef CONFIG_WASMACHINE_APP_MGR
+static void hrtimer_event_callback(module_data *m_data, bh_message_t msg)
+{
+    uint32_t argv[2];
+    uint32_t handle = (uint32_t)(uintptr_t)bh_message_payload(msg);
+    hrtimer_t *t = &s_timer[HRTIMER_HANDLE_ID(handle)];
+    wasm_data *wasm_app_data = (wasm_data *)m_data->internal_data;
+    wasm_module_inst_t inst = wasm_app_data->wasm_module_inst;
+    wasm_function_inst_t func;
+
+    bh_assert(HRTIMER_EVENT_WASM == bh_message_type(msg));
+
+    pthread_mutex_lock(&s_timer_lock);
+    argv[0] = HRTIMER_HANDLE_ID(handle);
+    argv[1] = 0;
+    if (t->owner && t->gen == HRTIMER_HANDLE_GEN(handle)) {
+        argv[1] = t->pending;
+        t->pending = 0;
+    }
+    pthread_mutex_unlock(&s_timer_lock);
+
+    if (!argv[1]) {
+        return;
+    }
+
+    func = wm_ext_wasm_native_get_func(inst, WM_EXT_WASM_NATIVE_FUNC_HRTIMER_DISPATCH);
+    if (!func) {
+        return;
+    }
+
+    if (!wasm_runtime_call_wasm(wasm_app_data->exec_env, func, 2, argv)) {
+        ESP_LOGE(TAG, "failed to run timer callback: %s", wasm_runtime_get_exception(inst));
+        wasm_runtime_clear_exception(inst);
+    }
+}
+
+/*
+ * Expirations are counted, and only the first one which the module hasn't handled yet
+ * posts a message, so a fast periodic timer can't fill the queue of a busy module.
+ */
+static void hrtimer_esp_timer_callback(void *arg)
+{
+    uint32_t handle = (uint32_t)(uintptr_t)arg;
+    hrtimer_t *t = &s_timer[HRTIMER_HANDLE_ID(handle)];
+    uint32_t module_id = ID_NONE;
+    module_data *module;
+
+    pthread_mutex_lock(&s_timer_lock);
+    if (t->owner && t->gen == HRTIMER_HANDLE_GEN(handle) && !t->pending++) {
+        module_id = t->module_id;
+    }
+    pthread_mutex_unlock(&s_timer_lock);
+
+    if (module_id == ID_NONE) {
+        return;
+    }
+
+    /* The handle is the payload itself, length 0 keeps the receiver from freeing it */
+    module = module_data_list_lookup_id(module_id);
+    if (module && bh_post_msg(module->queue, HRTIMER_EVENT_WASM, arg, 0)) {
+        return;
+    }
+
+    /* Let the next expiration post again */
+    pthread_mutex_lock(&s_timer_lock);
+    if (t->gen == HRTIMER_HANDLE_GEN(handle)) {
+        t->pending = 0;
+    }
+    pthread_mutex_unlock(&s_timer_lock);
+}
+
+static hrtimer_t *hrtimer_get(wasm_exec_env_t exec_env, int id)
+{
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(get_module_inst(exec_env));
+
+    if (!ctx || id < 0 || id >= TIMER_MAX_NUM || s_timer[id].owner != ctx) {
+        return NULL;
+    }
+
+    return &s_timer[id];
+}
+
+static void hrtimer_free(hrtimer_t *t)
+{
+    esp_timer_handle_t timer = t->timer;
+
+    /* Stop callbacks which start from now, and fail those which are running */
+    t->owner = NULL;
+    t->pending = 0;
+    pthread_mutex_unlock(&s_timer_lock);
+
+    esp_timer_stop(timer);
+    esp_timer_delete(timer);
+
+    pthread_mutex_lock(&s_timer_lock);
+    t->timer = NULL;
+}
+
+static int wasm_hrtimer_create_wrapper(wasm_exec_env_t exec_env)
+{
+    int id = -EMFILE;
+    hrtimer_t *t = NULL;
+    esp_err_t ret;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    uint32_t module_id = app_manager_get_module_id(Module_WASM_App, module_inst);
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(module_inst);
+    esp_timer_create_args_t args = {
+        .callback = hrtimer_esp_timer_callback,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "wasm_hrtimer",
+        .skip_unhandled_events = true,
+    };
+
+    if (!ctx) {
+        return -ENOMEM;
+    } else if (module_id == ID_NONE) {
+        return -ENOTSUP;
+    }
+
+    if (!wasm_register_msg_callback(HRTIMER_EVENT_WASM, hrtimer_event_callback)) {
+        return -ENOMEM;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_hrtimer_create", 0);
+    pthread_mutex_lock(&s_timer_lock);
+
+    for (int i = 0; i < TIMER_MAX_NUM; i++) {
+        if (!s_timer[i].timer) {
+            t = &s_timer[i];
+            id = i;
+            break;
+        }
+    }
+
+    if (t) {
+        t->gen = (t->gen + 1) & HRTIMER_GEN_MASK;
+        args.arg = (void *)(uintptr_t)HRTIMER_HANDLE(id, t->gen);
+        ret = esp_timer_create(&args, &t->timer);
+        if (ret == ESP_OK) {
+            t->owner = ctx;
+            t->module_id = module_id;
+            t->pending = 0;
+        } else {
+            ESP_LOGE(TAG, "failed to create esp_timer: %s", esp_err_to_name(ret));
+            t->timer = NULL;
+            id = -ENOMEM;
+        }
+    }
+
+    pthread_mutex_unlock(&s_timer_lock);
+    WM_EXT_WASM_NATIVE_TRACE_END(id);
+
+    return id;
+}
+
+static int wasm_hrtimer_start_wrapper(wasm_exec_env_t exec_env, int id, int64_t period_us, int periodic)
+{
+    int ret = 0;
+    hrtimer_t *t;
+
+    if (period_us <= 0) {
+        return -EINVAL;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_hrtimer_start", 0, id, (uint32_t)period_us, periodic);
+    pthread_mutex_lock(&s_timer_lock);
+
+    t = hrtimer_get(exec_env, id);
+    if (!t) {
+        ret = -EBADF;
+        goto out;
+    }
+
+    /* Restart an armed timer with the new period, and drop expirations of the old one */
+    esp_timer_stop(t->timer);
+    t->pending = 0;
+    if (periodic) {
+        ret = esp_timer_start_periodic(t->timer, (uint64_t)period_us);
+    } else {
+        ret = esp_timer_start_once(t->timer, (uint64_t)period_us);
+    }
+    ret = ret == ESP_OK ? 0 : -EINVAL;
+
+out:
+    pthread_mutex_unlock(&s_timer_lock);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+    return ret;
+}
+
+static int wasm_hrtimer_stop_wrapper(wasm_exec_env_t exec_env, int id)
+{
+    int ret = 0;
+    hrtimer_t *t;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_hrtimer_stop", 0, id);
+    pthread_mutex_lock(&s_timer_lock);
+
+    t = hrtimer_get(exec_env, id);
+    if (t) {
+        esp_timer_stop(t->timer);
+        t->pending = 0;
+    } else {
+        ret = -EBADF;
+    }
+
+    pthread_mutex_unlock(&s_timer_lock);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static int wasm_hrtimer_destroy_wrapper(wasm_exec_env_t exec_env, int id)
+{
+    int ret = 0;
+    hrtimer_t *t;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_hrtimer_destroy", 0, id);
+    pthread_mutex_lock(&s_timer_lock);
+
+    t = hrtimer_get(exec_env, id);
+    if (t) {
+        hrtimer_free(t);
+    } else {
+        ret = -EBADF;
+    }
+
+    pthread_mutex_unlock(&s_timer_lock);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+void wm_ext_wasm_native_timer_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx)
+{
+    pthread_mutex_lock(&s_timer_lock);
+
+    for (int i = 0; i < TIMER_MAX_NUM; i++) {
+        if (s_timer[i].owner == ctx) {
+            hrtimer_free(&s_timer[i]);
+        }
+    }
+
+    pthread_mutex_unlock(&s_timer_lock);
+}
+#endif
+
+static NativeSymbol wm_timer_wrapper_native_symbol[] = {
+    REG_NATIVE_FUNC(wasm_clock_monotonic_us,    "()I"),
+    REG_NATIVE_FUNC(wasm_clock_delay_until,     "(I)I"),
+#ifdef CONFIG_WASMACHINE_APP_MGR
+    REG_NATIVE_FUNC(wasm_hrtimer_create,        "()i"),
+    REG_NATIVE_FUNC(wasm_hrtimer_start,         "(iIi)i"),
+    REG_NATIVE_FUNC(wasm_hrtimer_stop,          "(i)i"),
+    REG_NATIVE_FUNC(wasm_hrtimer_destroy,       "(i)i"),
+#endif
+};
+
+int wm_ext_wasm_native_timer_export(void)
+{
+    NativeSymbol *sym = (NativeSymbol *)wm_timer_wrapper_native_symbol;
+    int num = sizeof(wm_timer_wrapper_native_symbol) / sizeof(wm_timer_wrapper_native_symbol[0]);
+
+    if (!wasm_native_register_natives("env", sym,  num)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+WM_EXT_WASM_NATIVE_EXPORT_FN(wm_ext_wasm_native_timer_export)
+{
+    return wm_ext_wasm_native_timer_export();
+}
@@ -0,0 +1,299 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "wasm_export.h"
+
+#include "wm_ext_wasm_native_trace.h"
+
+#define TRACE_ENTRIES       CONFIG_WASMACHINE_WASM_EXT_NATIVE_TRACE_ENTRIES
+#define TRACE_CORES         portNUM_PROCESSORS
+
+#define FNV_OFFSET_BASIS    2166136261u
+#define FNV_PRIME           16777619u
+
+typedef struct trace_slot {
+    uint32_t seq;                   /*!< Index of the entry plus 1, written last */
+    wm_ext_wasm_native_trace_entry_t entry;
+} trace_slot_t;
+
+/* Each core writes its own ring, so recording a call never contends with other cores */
+struct wm_ext_wasm_native_trace_ring {
+    uint32_t mask;                  /*!< Number of slots minus 1 */
+    uint32_t head;                  /*!< Free running index of next entry to write */
+    uint32_t writers;               /*!< Number of tasks which are writing entries */
+    bool running;
+    trace_slot_t slots[];
+};
+
+static const char *TAG = "wm_trace";
+
+bool wm_ext_wasm_native_trace_running;
+
+static wm_ext_wasm_native_trace_ring_t *s_trace_rings[TRACE_CORES];
+
+wm_ext_wasm_native_trace_ring_t *wm_ext_wasm_native_trace_ring_create(uint32_t size)
+{
+    uint32_t num = 1;
+    wm_ext_wasm_native_trace_ring_t *ring;
+
+    while (num < size) {
+        num <<= 1;
+    }
+
+    ring = calloc(1, sizeof(wm_ext_wasm_native_trace_ring_t) + num * sizeof(trace_slot_t));
+    if (!ring) {
+        return NULL;
+    }
+
+    ring->mask = num - 1;
+
+    return ring;
+}
+
+void wm_ext_wasm_native_trace_ring_destroy(wm_ext_wasm_native_trace_ring_t *ring)
+{
+    free(ring);
+}
+
+void wm_ext_wasm_native_trace_ring_clear(wm_ext_wasm_native_trace_ring_t *ring)
+{
+    /* Clear seq too, or entries of the last run could look committed */
+    for (uint32_t i = 0; i <= ring->mask; i++) {
+        ring->slots[i].seq = 0;
+    }
+
+    ring->head = 0;
+}
+
+void wm_ext_wasm_native_trace_ring_start(wm_ext_wasm_native_trace_ring_t *ring)
+{
+    wm_ext_wasm_native_trace_ring_clear(ring);
+
+    __atomic_store_n(&ring->running, true, __ATOMIC_SEQ_CST);
+}
+
+void wm_ext_wasm_native_trace_ring_stop(wm_ext_wasm_native_trace_ring_t *ring)
+{
+    __atomic_store_n(&ring->running, false, __ATOMIC_SEQ_CST);
+
+    while (__atomic_load_n(&ring->writers, __ATOMIC_ACQUIRE)) {
+        vTaskDelay(1);
+    }
+}
+
+bool wm_ext_wasm_native_trace_ring_reserve(wm_ext_wasm_native_trace_ring_t *ring, uint32_t *index)
+{
+    /* Count writers before checking the running flag, so stopping waits for entries being written */
+    __atomic_add_fetch(&ring->writers, 1, __ATOMIC_SEQ_CST);
+
+    if (!__atomic_load_n(&ring->running, __ATOMIC_SEQ_CST)) {
+        __atomic_sub_fetch(&ring->writers, 1, __ATOMIC_RELEASE);
+        return false;
+    }
+
+    *index = __atomic_fetch_add(&ring->head, 1, __ATOMIC_RELAXED);
+
+    return true;
+}
+
+void wm_ext_wasm_native_trace_ring_commit(wm_ext_wasm_native_trace_ring_t *ring, uint32_t index,
+                                          const wm_ext_wasm_native_trace_entry_t *entry)
+{
+    trace_slot_t *slot = &ring->slots[index & ring->mask];
+
+    slot->entry = *entry;
+
+    /* A writer which is preempted and lapped by others leaves a stale seq, the entry is skipped */
+    __atomic_store_n(&slot->seq, index + 1, __ATOMIC_RELEASE);
+    __atomic_sub_fetch(&ring->writers, 1, __ATOMIC_RELEASE);
+}
+
+uint32_t wm_ext_wasm_native_trace_ring_foreach(const wm_ext_wasm_native_trace_ring_t *ring,
+                                               wm_ext_wasm_native_trace_visit_t visit, void *arg)
+{
+    uint32_t count = 0;
+    uint32_t head = ring->head;
+    uint32_t num = head <= ring->mask ? head : ring->mask + 1;
+
+    /* Oldest entries first, entries which are overwritten are lost */
+    for (uint32_t i = head - num; i != head; i++) {
+        const trace_slot_t *slot = &ring->slots[i & ring->mask];
+
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != i + 1) {
+            continue;
+        }
+
+        visit(&slot->entry, arg);
+        count++;
+    }
+
+    return count;
+}
+
+static uint32_t trace_hash(const uint32_t *args, uint32_t num)
+{
+    uint32_t hash = FNV_OFFSET_BASIS;
+
+    for (uint32_t i = 0; i < num; i++) {
+        uint32_t v = args[i];
+
+        for (int j = 0; j < 4; j++) {
+            hash = (hash ^ (v & 0xff)) * FNV_PRIME;
+            v >>= 8;
+        }
+    }
+
+    return hash;
+}
+
+void wm_ext_wasm_native_trace_begin(wm_ext_wasm_native_trace_t *trace, wasm_exec_env_t exec_env,
+                                    const char *name, uint32_t id, const uint32_t *args, uint32_t num)
+{
+    if (!wm_ext_wasm_native_trace_is_running()) {
+        trace->name = NULL;
+        return;
+    }
+
+    trace->name = name;
+    trace->id = id;
+    trace->module = (uint32_t)(uintptr_t)wasm_runtime_get_module_inst(exec_env);
+    trace->args_hash = trace_hash(args, num);
+    trace->start_us = esp_timer_get_time();
+}
+
+void wm_ext_wasm_native_trace_end(wm_ext_wasm_native_trace_t *trace, int32_t result)
+{
+    uint32_t index;
+    int64_t end_us;
+    wm_ext_wasm_native_trace_ring_t *ring;
+
+    if (!trace->name) {
+        return;
+    }
+
+    end_us = esp_timer_get_time();
+    ring = s_trace_rings[xPortGetCoreID()];
+    if (wm_ext_wasm_native_trace_ring_reserve(ring, &index)) {
+        wm_ext_wasm_native_trace_entry_t entry = {
+            .name = trace->name,
+            .id = trace->id,
+            .module = trace->module,
+            .args_hash = trace->args_hash,
+            .dur_us = (uint32_t)(end_us - trace->start_us),
+            .start_us = trace->start_us,
+            .result = result
+        };
+
+        wm_ext_wasm_native_trace_ring_commit(ring, index, &entry);
+    }
+}
+
+esp_err_t wm_ext_wasm_native_trace_start(void)
+{
+    if (wm_ext_wasm_native_trace_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int i = 0; i < TRACE_CORES; i++) {
+        if (!s_trace_rings[i]) {
+            s_trace_rings[i] = wm_ext_wasm_native_trace_ring_create(TRACE_ENTRIES);
+            if (!s_trace_rings[i]) {
+                ESP_LOGE(TAG, "failed to malloc %d trace entries", TRACE_ENTRIES);
+                return ESP_ERR_NO_MEM;
+            }
+        }
+    }
+
+    for (int i = 0; i < TRACE_CORES; i++) {
+        wm_ext_wasm_native_trace_ring_start(s_trace_rings[i]);
+    }
+
+    __atomic_store_n(&wm_ext_wasm_native_trace_running, true, __ATOMIC_SEQ_CST);
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_trace_stop(void)
+{
+    if (!wm_ext_wasm_native_trace_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    __atomic_store_n(&wm_ext_wasm_native_trace_running, false, __ATOMIC_SEQ_CST);
+
+    for (int i = 0; i < TRACE_CORES; i++) {
+        wm_ext_wasm_native_trace_ring_stop(s_trace_rings[i]);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_trace_clear(void)
+{
+    if (wm_ext_wasm_native_trace_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int i = 0; i < TRACE_CORES; i++) {
+        if (s_trace_rings[i]) {
+            wm_ext_wasm_native_trace_ring_clear(s_trace_rings[i]);
+        }
+    }
+
+    return ESP_OK;
+}
+
+typedef struct trace_dump {
+    FILE *stream;
+    int core;
+    bool first;
+} trace_dump_t;
+
+static void trace_dump_entry(const wm_ext_wasm_native_trace_entry_t *entry, void *arg)
+{
+    trace_dump_t *dump = arg;
+
+    fprintf(dump->stream, "%s\n{\"name\":\"%s\",\"cat\":\"native\",\"ph\":\"X\","
+            "\"ts\":%" PRIi64 ",\"dur\":%" PRIu32 ",\"pid\":%" PRIu32 ",\"tid\":%d,"
+            "\"args\":{\"id\":%" PRIu32 ",\"args_hash\":\"0x%08" PRIx32 "\",\"ret\":%" PRIi32 "}}",
+            dump->first ? "" : ",", entry->name, entry->start_us, entry->dur_us, entry->module, dump->core,
+            entry->id, entry->args_hash, entry->result);
+    dump->first = false;
+}
+
+esp_err_t wm_ext_wasm_native_trace_dump(FILE *stream)
+{
+    trace_dump_t dump = {
+        .stream = stream,
+        .first = true
+    };
+
+    /* Rings are allocated in order, so all are there if the last one is */
+    if (wm_ext_wasm_native_trace_running || !s_trace_rings[TRACE_CORES - 1]) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    fprintf(stream, "{\"traceEvents\":[");
+
+    for (int i = 0; i < TRACE_CORES; i++) {
+        dump.core = i;
+        wm_ext_wasm_native_trace_ring_foreach(s_trace_rings[i], trace_dump_entry, &dump);
+    }
+
+    fprintf(stream, "\n],\"displayTimeUnit\":\"ms\"}\n");
+
+    return ESP_OK;
+}
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -22,6 +22,8 @@
 
 #include "wm_ext_wasm_native_macro.h"
 #include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
 
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
@@ -56,13 +58,37 @@ typedef struct {
 
 typedef struct __wifi_prov_wrapper_ctx_t {
     uint32_t                        func_id;
-    wasm_exec_env_t                 exec_env;
+    wasm_module_inst_t              module_inst;
     network_prov_event_handler_t    app_event_handler;
     wifi_prov_endpoint_handler_t    endpoint_handler;
 } wifi_prov_wrapper_ctx_t;
 
 static wifi_prov_wrapper_ctx_t *s_wifi_prov_wrapper_ctx = NULL;
 
+#define CONFIG_WIFI_PROV_HEAP_SIZE 16384
+
+/**
+ * Callbacks run in event or protocomm tasks, so they must not share the execution
+ * environment of the WASM thread which registers them.
+ */
+static bool wifi_prov_run_wasm(wasm_module_inst_t module_inst, uint32_t cb, int argc, uint32_t *argv)
+{
+    wasm_exec_env_t exec_env = wm_ext_wasm_native_get_exec_env(module_inst, CONFIG_WIFI_PROV_HEAP_SIZE);
+    if (!exec_env) {
+        ESP_LOGE(TAG, "failed to create execution environment");
+        return false;
+    }
+
+    bool ret = wasm_runtime_call_indirect(exec_env, cb, argc, argv);
+    if (!ret) {
+        ESP_LOGE(TAG, "failed to run WASM callback as %s", wasm_runtime_get_exception(module_inst));
+    }
+
+    wm_ext_wasm_native_put_exec_env(module_inst, exec_env);
+
+    return ret;
+}
+
 /* Event handler for catching system events */
 static void wifi_prov_system_event_handler(void *arg, esp_event_base_t event_base,
         int32_t event_id, void *event_data)
@@ -129,7 +155,7 @@ static void wifi_prov_app_event_handler(void *user_data, network_prov_cb_event_t
         argv[1] = (uint32_t)event;
         argv[2] = (uint32_t)event_data;
 
-        wasm_runtime_call_indirect(wifi_prov_wrapper_ctx->exec_env, event_cb_index, 3, argv);
+        wifi_prov_run_wasm(wifi_prov_wrapper_ctx->module_inst, event_cb_index, 3, argv);
     }
 }
 
@@ -149,7 +175,7 @@ static esp_err_t wifi_prov_custom_endpoint(uint32_t session_id, const uint8_t *i
     argv[5] = (uint32_t)wifi_prov_wrapper_ctx->endpoint_handler.user_ctx;
 
     if (event_cb_index) {
-        wasm_runtime_call_indirect(wifi_prov_wrapper_ctx->exec_env, event_cb_index, 6, argv);
+        wifi_prov_run_wasm(wifi_prov_wrapper_ctx->module_inst, event_cb_index, 6, argv);
     }
 
     return ESP_OK;
@@ -173,7 +199,7 @@ static int wasm_wifi_prov_mgr_init_wrapper(wasm_exec_env_t exec_env, uint32_t fu
         return ESP_FAIL;
     }
 
-    wifi_prov_wrapper_ctx->exec_env                       = exec_env;
+    wifi_prov_wrapper_ctx->module_inst                    = module_inst;
     wifi_prov_wrapper_ctx->func_id                        = func_id;
     wifi_prov_wrapper_ctx->app_event_handler.event_cb     = (network_prov_cb_func_t)argv[0];
     wifi_prov_wrapper_ctx->app_event_handler.user_data    = (void *)argv[1];
@@ -217,7 +243,9 @@ static int wasm_wifi_prov_mgr_init_wrapper(wasm_exec_env_t exec_env, uint32_t fu
         break;
     }
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_init", func_id, argc);
     ESP_ERROR_CHECK(network_prov_mgr_init(config));
+    WM_EXT_WASM_NATIVE_TRACE_END(ESP_OK);
 
     s_wifi_prov_wrapper_ctx = wifi_prov_wrapper_ctx;
 
@@ -230,7 +258,9 @@ static int wasm_wifi_prov_mgr_deinit_wrapper(wasm_exec_env_t exec_env)
     esp_event_handler_unregister(WIFI_EVENT, ESP_EVENT_ANY_ID, wifi_prov_system_event_handler);
     esp_event_handler_unregister(IP_EVENT, IP_EVENT_STA_GOT_IP, wifi_prov_system_event_handler);
 
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_deinit", 0);
     network_prov_mgr_deinit();
+    WM_EXT_WASM_NATIVE_TRACE_END(ESP_OK);
 
     if (s_wifi_prov_wrapper_ctx) {
         wasm_runtime_free(s_wifi_prov_wrapper_ctx);
@@ -242,11 +272,18 @@ static int wasm_wifi_prov_mgr_deinit_wrapper(wasm_exec_env_t exec_env)
 
 static int wasm_wifi_prov_mgr_is_provisioned_wrapper(wasm_exec_env_t exec_env, bool *provisioned)
 {
-    return network_prov_mgr_is_wifi_provisioned(provisioned);
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_is_provisioned", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(provisioned));
+    ret = network_prov_mgr_is_wifi_provisioned(provisioned);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_start_provisioning_wrapper(wasm_exec_env_t exec_env, network_prov_security_t security, uint32_t pop_offset, const char *service_name, uint32_t service_key_offset)
 {
+    int ret;
     const char *service_key = NULL, *pop = NULL;
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
 
@@ -268,30 +305,45 @@ static int wasm_wifi_prov_mgr_start_provisioning_wrapper(wasm_exec_env_t exec_en
         pop = (const char *)addr_app_to_native(pop_offset);
     }
 
-    return network_prov_mgr_start_provisioning(security, pop, service_name, service_key);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_start_provisioning", 0, security, pop_offset, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(service_name), service_key_offset);
+    ret = network_prov_mgr_start_provisioning(security, pop, service_name, service_key);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_stop_provisioning_wrapper(wasm_exec_env_t exec_env)
 {
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_stop_provisioning", 0);
     network_prov_mgr_stop_provisioning();
+    WM_EXT_WASM_NATIVE_TRACE_END(ESP_OK);
 
     return ESP_OK;
 }
 
 static int wasm_wifi_prov_mgr_wait_wrapper(wasm_exec_env_t exec_env)
 {
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_wait", 0);
     network_prov_mgr_wait();
+    WM_EXT_WASM_NATIVE_TRACE_END(ESP_OK);
 
     return ESP_OK;
 }
 
 static int wasm_wifi_prov_mgr_disable_auto_stop_wrapper(wasm_exec_env_t exec_env, uint32_t cleanup_delay)
 {
-    return network_prov_mgr_disable_auto_stop(cleanup_delay);
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_disable_auto_stop", 0, cleanup_delay);
+    ret = network_prov_mgr_disable_auto_stop(cleanup_delay);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_set_app_info_wrapper(wasm_exec_env_t exec_env, const char *label, const char *version, int32_t capabilities_offset, size_t total_capabilities)
 {
+    int ret;
     const char **capabilities;
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     if (!validate_app_addr(capabilities_offset, sizeof(int32))) {
@@ -304,16 +356,27 @@ static int wasm_wifi_prov_mgr_set_app_info_wrapper(wasm_exec_env_t exec_env, con
         capabilities[i] = (const char *)addr_app_to_native((uint32_t)capabilities[i]);
     }
 
-    return network_prov_mgr_set_app_info(label, version, capabilities, total_capabilities);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_set_app_info", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(label), WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(version), capabilities_offset, total_capabilities);
+    ret = network_prov_mgr_set_app_info(label, version, capabilities, total_capabilities);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_endpoint_create_wrapper(wasm_exec_env_t exec_env, const char *ep_name)
 {
-    return network_prov_mgr_endpoint_create(ep_name);
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_endpoint_create", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(ep_name));
+    ret = network_prov_mgr_endpoint_create(ep_name);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_endpoint_register_wrapper(wasm_exec_env_t exec_env, const char *ep_name, uint32_t handler, uint32_t user_ctx)
 {
+    int ret;
     wifi_prov_wrapper_ctx_t *wifi_prov_wrapper_ctx = s_wifi_prov_wrapper_ctx;
     if (!wifi_prov_wrapper_ctx) {
         return ESP_ERR_INVALID_ARG;
@@ -323,79 +386,122 @@ static int wasm_wifi_prov_mgr_endpoint_register_wrapper(wasm_exec_env_t exec_env
     wifi_prov_wrapper_ctx->endpoint_handler.handler  = (protocomm_req_handler_t)handler;
     wifi_prov_wrapper_ctx->endpoint_handler.user_ctx = (void *)user_ctx;
 
-    return network_prov_mgr_endpoint_register(ep_name, wifi_prov_custom_endpoint, wifi_prov_wrapper_ctx);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_endpoint_register", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(ep_name), handler, user_ctx);
+    ret = network_prov_mgr_endpoint_register(ep_name, wifi_prov_custom_endpoint, wifi_prov_wrapper_ctx);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_endpoint_unregister_wrapper(wasm_exec_env_t exec_env, const char *ep_name)
 {
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_endpoint_unregister", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(ep_name));
     network_prov_mgr_endpoint_unregister(ep_name);
+    WM_EXT_WASM_NATIVE_TRACE_END(ESP_OK);
 
     return ESP_OK;
 }
 
 static int wasm_wifi_prov_mgr_get_wifi_state_wrapper(wasm_exec_env_t exec_env, network_prov_wifi_sta_state_t *state)
 {
+    int ret;
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     if (!validate_native_addr((void *)state, sizeof(network_prov_wifi_sta_state_t))) {
         ESP_LOGE(TAG, "Failed to check for state by runtime");
         return ESP_FAIL;
     }
 
-    return network_prov_mgr_get_wifi_state(state);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_get_wifi_state", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(state));
+    ret = network_prov_mgr_get_wifi_state(state);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_get_wifi_disconnect_reason_wrapper(wasm_exec_env_t exec_env, network_prov_wifi_sta_fail_reason_t *reason)
 {
+    int ret;
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     if (!validate_native_addr((void *)reason, sizeof(network_prov_wifi_sta_fail_reason_t))) {
         ESP_LOGE(TAG, "Failed to check for disconnect reason by runtime");
         return ESP_FAIL;
     }
 
-    return network_prov_mgr_get_wifi_disconnect_reason(reason);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_get_wifi_disconnect_reason", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(reason));
+    ret = network_prov_mgr_get_wifi_disconnect_reason(reason);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_configure_sta_wrapper(wasm_exec_env_t exec_env, wifi_config_t *wifi_cfg)
 {
+    int ret;
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     if (!validate_native_addr((void *)wifi_cfg, sizeof(wifi_config_t))) {
         ESP_LOGE(TAG, "Failed to check for station configure by runtime");
         return ESP_FAIL;
     }
 
-    return network_prov_mgr_configure_wifi_sta(wifi_cfg);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_configure_sta", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(wifi_cfg));
+    ret = network_prov_mgr_configure_wifi_sta(wifi_cfg);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_reset_provisioning_wrapper(wasm_exec_env_t exec_env)
 {
-    return network_prov_mgr_reset_wifi_provisioning();
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_reset_provisioning", 0);
+    ret = network_prov_mgr_reset_wifi_provisioning();
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_mgr_reset_sm_state_on_failure_wrapper(wasm_exec_env_t exec_env)
 {
-    return network_prov_mgr_reset_wifi_sm_state_on_failure();
+    int ret;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_mgr_reset_sm_state_on_failure", 0);
+    ret = network_prov_mgr_reset_wifi_sm_state_on_failure();
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_scheme_ble_set_service_uuid_wrapper(wasm_exec_env_t exec_env, uint8_t *uuid128)
 {
+    int ret;
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     if (!validate_native_addr((uint8_t *)uuid128, 16 * sizeof(uint8_t))) {
         ESP_LOGE(TAG, "Failed to check a custom 128 bit UUID by runtime");
         return ESP_FAIL;
     }
 
-    return network_prov_scheme_ble_set_service_uuid(uuid128);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_scheme_ble_set_service_uuid", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(uuid128));
+    ret = network_prov_scheme_ble_set_service_uuid(uuid128);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_wifi_prov_scheme_ble_set_mfg_data_wrapper(wasm_exec_env_t exec_env, uint8_t *mfg_data, ssize_t mfg_data_len)
 {
+    int ret;
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     if (!validate_native_addr((uint8_t *)mfg_data, mfg_data_len)) {
         ESP_LOGE(TAG, "Failed to check manufacturer specific data by runtime");
         return ESP_FAIL;
     }
 
-    return network_prov_scheme_ble_set_mfg_data(mfg_data, mfg_data_len);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_wifi_prov_scheme_ble_set_mfg_data", 0, WM_EXT_WASM_NATIVE_TRACE_APP_ADDR(mfg_data), mfg_data_len);
+    ret = network_prov_scheme_ble_set_mfg_data(mfg_data, mfg_data_len);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static NativeSymbol wm_wifi_prov_mgr_native_symbol[] = {
@@ -0,0 +1,302 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/errno.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_AIO && CONFIG_IDF_TARGET_LINUX
+
+#include "wm_ext_wasm_native_aio.h"
+
+/* Host tmpfs stands for the VFS on linux target */
+#define TEST_FILE       "/tmp/wm_aio_test.bin"
+#define TEST_ENTRIES    8
+#define TEST_BLOCK      512
+#define TEST_BLOCKS     12
+
+#define TEST_RING       0
+#define TEST_SQES       64
+#define TEST_CQES       (TEST_SQES + TEST_ENTRIES * sizeof(wm_ext_wasm_native_aio_sqe_t))
+#define TEST_DATA       1024
+#define TEST_MEM_SIZE   (TEST_DATA + TEST_BLOCK * TEST_BLOCKS * 2)
+#define TEST_IOCTL_CMD  0x5a
+
+/* Application linear memory, addresses are offsets in it, and it moves when it grows */
+static uint8_t *s_mem;
+static uint32_t s_mem_size;
+
+static void *test_map(void *arg, uint32_t addr, uint32_t size)
+{
+    if (addr > s_mem_size || size > s_mem_size - addr) {
+        return NULL;
+    }
+
+    return s_mem + addr;
+}
+
+static int test_ioctl(void *arg, int fd, int cmd, void *va_args)
+{
+    if (cmd != TEST_IOCTL_CMD) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    *(uint32_t *)va_args = fd;
+
+    return 0;
+}
+
+static const wm_ext_wasm_native_aio_ops_t s_test_ops = {
+    .map = test_map,
+};
+
+static const wm_ext_wasm_native_aio_ops_t s_test_ioctl_ops = {
+    .map = test_map,
+    .ioctl = test_ioctl,
+};
+
+static void test_mem_init(void)
+{
+    s_mem_size = TEST_MEM_SIZE;
+    s_mem = calloc(1, s_mem_size);
+    TEST_ASSERT_NOT_NULL(s_mem);
+}
+
+/* Move linear memory as memory.grow may do, the old memory is freed */
+static void test_mem_grow(void)
+{
+    uint8_t *mem = calloc(1, s_mem_size * 2);
+
+    TEST_ASSERT_NOT_NULL(mem);
+    memcpy(mem, s_mem, s_mem_size);
+    free(s_mem);
+    s_mem = mem;
+    s_mem_size *= 2;
+}
+
+static wm_ext_wasm_native_aio_ring_t *test_ring(void)
+{
+    return (wm_ext_wasm_native_aio_ring_t *)(s_mem + TEST_RING);
+}
+
+static void test_submit(wm_ext_wasm_native_aio_t *aio, uint8_t opcode, int fd, uint32_t addr,
+                        uint32_t len, int64_t offset, uint64_t user_data)
+{
+    wm_ext_wasm_native_aio_ring_t *ring = test_ring();
+    wm_ext_wasm_native_aio_sqe_t *sqes = (wm_ext_wasm_native_aio_sqe_t *)(s_mem + TEST_SQES);
+    wm_ext_wasm_native_aio_sqe_t *sqe = &sqes[ring->sq_tail & (TEST_ENTRIES - 1)];
+
+    /* Wait for a free submission queue entry, entries are taken when completions are posted */
+    while (ring->sq_tail - __atomic_load_n(&ring->sq_head, __ATOMIC_ACQUIRE) >= TEST_ENTRIES) {
+        wm_ext_wasm_native_aio_wait(aio, 0, 0);
+        usleep(1000);
+    }
+
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->fd = fd;
+    sqe->addr = addr;
+    sqe->len = len;
+    sqe->offset = offset;
+    sqe->user_data = user_data;
+    __atomic_store_n(&ring->sq_tail, ring->sq_tail + 1, __ATOMIC_RELEASE);
+
+    TEST_ASSERT_EQUAL_INT(0, wm_ext_wasm_native_aio_submit(aio));
+}
+
+static wm_ext_wasm_native_aio_cqe_t test_reap(wm_ext_wasm_native_aio_t *aio)
+{
+    wm_ext_wasm_native_aio_ring_t *ring = test_ring();
+    wm_ext_wasm_native_aio_cqe_t *cqes = (wm_ext_wasm_native_aio_cqe_t *)(s_mem + TEST_CQES);
+    wm_ext_wasm_native_aio_cqe_t cqe;
+
+    TEST_ASSERT_GREATER_OR_EQUAL(1, wm_ext_wasm_native_aio_wait(aio, 1, 1000));
+
+    cqe = cqes[ring->cq_head & (TEST_ENTRIES - 1)];
+    __atomic_store_n(&ring->cq_head, ring->cq_head + 1, __ATOMIC_RELEASE);
+
+    return cqe;
+}
+
+TEST_CASE("Asynchronous I/O ring", "[aio]")
+{
+    int fd;
+    wm_ext_wasm_native_aio_t *aio;
+    wm_ext_wasm_native_aio_ring_t *ring;
+    uint8_t *wbuf;
+    uint8_t *rbuf;
+
+    test_mem_init();
+    ring = test_ring();
+    wbuf = s_mem + TEST_DATA;
+    rbuf = wbuf + TEST_BLOCK * TEST_BLOCKS;
+    for (int i = 0; i < TEST_BLOCK * TEST_BLOCKS; i++) {
+        wbuf[i] = (uint8_t)random();
+    }
+
+    fd = open(TEST_FILE, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+
+    /* Invalid ring is rejected */
+    ring->entries = 6;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_aio_create(TEST_RING, &s_test_ops, NULL, &aio));
+
+    ring->entries = TEST_ENTRIES;
+    ring->sqes = TEST_SQES;
+    ring->cqes = TEST_CQES;
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_aio_create(TEST_RING, &s_test_ops, NULL, &aio));
+
+    /* More writes than entries, completion queue must not be overrun */
+    for (int i = 0; i < TEST_BLOCKS; i++) {
+        test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_WRITE, fd, TEST_DATA + i * TEST_BLOCK, TEST_BLOCK,
+                    i * TEST_BLOCK, i);
+        if (ring->sq_tail - ring->cq_head >= TEST_ENTRIES) {
+            wm_ext_wasm_native_aio_cqe_t cqe = test_reap(aio);
+
+            TEST_ASSERT_EQUAL_INT32(TEST_BLOCK, cqe.res);
+        }
+    }
+
+    while (ring->cq_head != ring->sq_tail) {
+        wm_ext_wasm_native_aio_cqe_t cqe = test_reap(aio);
+
+        TEST_ASSERT_EQUAL_INT32(TEST_BLOCK, cqe.res);
+    }
+
+    test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_FSYNC, fd, 0, 0, 0, 100);
+    TEST_ASSERT_EQUAL_INT32(0, test_reap(aio).res);
+
+    /* Read back in reverse order and check completions keep submission order */
+    for (int i = TEST_BLOCKS - 1; i >= TEST_BLOCKS - TEST_ENTRIES; i--) {
+        test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_READ, fd, TEST_DATA + (TEST_BLOCKS + i) * TEST_BLOCK,
+                    TEST_BLOCK, i * TEST_BLOCK, 200 + i);
+    }
+
+    TEST_ASSERT_EQUAL_INT(TEST_ENTRIES, wm_ext_wasm_native_aio_wait(aio, TEST_ENTRIES, 1000));
+    for (int i = TEST_BLOCKS - 1; i >= TEST_BLOCKS - TEST_ENTRIES; i--) {
+        wm_ext_wasm_native_aio_cqe_t cqe = test_reap(aio);
+
+        TEST_ASSERT_EQUAL_UINT32(200 + i, (uint32_t)cqe.user_data);
+        TEST_ASSERT_EQUAL_INT32(TEST_BLOCK, cqe.res);
+        TEST_ASSERT_EQUAL_MEMORY(wbuf + i * TEST_BLOCK, rbuf + i * TEST_BLOCK, TEST_BLOCK);
+    }
+
+    /* Errors are reported by completion queue entries */
+    test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_READ, fd, TEST_MEM_SIZE - 4, 8, 0, 300);
+    TEST_ASSERT_EQUAL_INT32(-EFAULT, test_reap(aio).res);
+
+    test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_WRITE, -1, TEST_DATA, 4, -1, 301);
+    TEST_ASSERT_EQUAL_INT32(-EBADF, test_reap(aio).res);
+
+    test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_IOCTL, fd, TEST_DATA, 0, 0, 302);
+    TEST_ASSERT_EQUAL_INT32(-ENOTSUP, test_reap(aio).res);
+
+    /* Nothing to complete */
+    TEST_ASSERT_EQUAL_INT(-1, wm_ext_wasm_native_aio_wait(aio, 1, 10));
+    TEST_ASSERT_EQUAL_INT(ETIMEDOUT, errno);
+
+    wm_ext_wasm_native_aio_destroy(aio);
+
+    close(fd);
+    unlink(TEST_FILE);
+    free(s_mem);
+}
+
+TEST_CASE("Grow memory while an asynchronous read is pending", "[aio]")
+{
+    int fds[2];
+    uint8_t *old;
+    uint32_t *arg;
+    wm_ext_wasm_native_aio_t *aio;
+    wm_ext_wasm_native_aio_ring_t *ring;
+    wm_ext_wasm_native_aio_cqe_t cqe;
+    const char data[] = "0123456789abcdef";
+
+    test_mem_init();
+    TEST_ASSERT_EQUAL_INT(0, pipe(fds));
+
+    ring = test_ring();
+    ring->entries = TEST_ENTRIES;
+    ring->sqes = TEST_SQES;
+    ring->cqes = TEST_CQES;
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_aio_create(TEST_RING, &s_test_ioctl_ops, NULL, &aio));
+
+    /* Worker task blocks in read, and the ioctl behind it waits for it */
+    test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_READ, fds[0], TEST_DATA, sizeof(data), -1, 400);
+    test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_IOCTL, fds[0], TEST_DATA + 64, TEST_IOCTL_CMD, 0, 401);
+    usleep(20000);
+    TEST_ASSERT_EQUAL_INT(-1, wm_ext_wasm_native_aio_wait(aio, 1, 0));
+    TEST_ASSERT_EQUAL_INT(ETIMEDOUT, errno);
+
+    /* Old memory is freed, so AddressSanitizer catches any access to it */
+    old = s_mem;
+    test_mem_grow();
+    TEST_ASSERT_TRUE(s_mem != old);
+
+    TEST_ASSERT_EQUAL_INT(sizeof(data), write(fds[1], data, sizeof(data)));
+    TEST_ASSERT_EQUAL_INT(2, wm_ext_wasm_native_aio_wait(aio, 2, 1000));
+
+    cqe = test_reap(aio);
+    TEST_ASSERT_EQUAL_UINT32(400, (uint32_t)cqe.user_data);
+    TEST_ASSERT_EQUAL_INT32(sizeof(data), cqe.res);
+    TEST_ASSERT_EQUAL_MEMORY(data, s_mem + TEST_DATA, sizeof(data));
+
+    cqe = test_reap(aio);
+    arg = (uint32_t *)(s_mem + TEST_DATA + 64);
+    TEST_ASSERT_EQUAL_UINT32(401, (uint32_t)cqe.user_data);
+    TEST_ASSERT_EQUAL_INT32(0, cqe.res);
+    TEST_ASSERT_EQUAL_UINT32(fds[0], *arg);
+
+    /* Writes longer than the bounce buffer complete with a short count */
+    test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_WRITE, fds[1], TEST_DATA, s_mem_size - TEST_DATA, -1, 402);
+    cqe = test_reap(aio);
+    TEST_ASSERT_TRUE(cqe.res > 0 && cqe.res <= CONFIG_WASMACHINE_WASM_EXT_NATIVE_AIO_BUF_SIZE);
+
+    wm_ext_wasm_native_aio_destroy(aio);
+
+    close(fds[0]);
+    close(fds[1]);
+    free(s_mem);
+}
+
+TEST_CASE("Destroy asynchronous I/O while a read blocks", "[aio]")
+{
+    int fds[2];
+    wm_ext_wasm_native_aio_t *aio;
+    wm_ext_wasm_native_aio_ring_t *ring;
+
+    test_mem_init();
+    TEST_ASSERT_EQUAL_INT(0, pipe(fds));
+
+    ring = test_ring();
+    ring->entries = TEST_ENTRIES;
+    ring->sqes = TEST_SQES;
+    ring->cqes = TEST_CQES;
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_aio_create(TEST_RING, &s_test_ops, NULL, &aio));
+
+    /* Nothing is written to the pipe, so the read blocks until the handle is destroyed */
+    test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_READ, fds[0], TEST_DATA, TEST_BLOCK, -1, 500);
+    test_submit(aio, WM_EXT_WASM_NATIVE_AIO_OP_READ, fds[0], TEST_DATA, TEST_BLOCK, -1, 501);
+    usleep(20000);
+
+    /* It returns at once, and linear memory can go as the worker task never touches it */
+    wm_ext_wasm_native_aio_destroy(aio);
+    free(s_mem);
+
+    /* The read returns and the worker task frees the handle, LeakSanitizer checks it */
+    TEST_ASSERT_EQUAL_INT(4, write(fds[1], "data", 4));
+    usleep(20000);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_COMPRESS
+
+#include "wm_ext_wasm_native_compress.h"
+
+#define TEST_DATA_SIZE  20000
+#define TEST_CHUNK      37
+
+/* Telemetry-like text, followed by bytes which don't compress */
+static void test_data(uint8_t *data, uint32_t len)
+{
+    uint32_t n = 0;
+    uint32_t seed = 1;
+
+    for (int i = 0; n < len * 3 / 4; i++) {
+        n += snprintf((char *)data + n, len - n, "{\"id\":%d,\"temp\":%d.%d,\"hum\":%d}\n",
+                      i, 20 + i % 7, i % 10, 40 + i % 13);
+    }
+    for (; n < len; n++) {
+        seed = seed * 1103515245 + 12345;
+        data[n] = (uint8_t)(seed >> 16);
+    }
+}
+
+/* Run a stream on input and output pieces of TEST_CHUNK bytes */
+static esp_err_t test_run(wm_ext_wasm_native_compress_t *stream, const uint8_t *in, uint32_t in_len,
+                          uint8_t *out, uint32_t *out_len)
+{
+    esp_err_t ret;
+    uint32_t in_done = 0;
+    uint32_t out_done = 0;
+    bool end = false;
+
+    while (!end) {
+        uint32_t i = in_len - in_done < TEST_CHUNK ? in_len - in_done : TEST_CHUNK;
+        uint32_t o = *out_len - out_done < TEST_CHUNK ? *out_len - out_done : TEST_CHUNK;
+
+        ret = wm_ext_wasm_native_compress_update(stream, in + in_done, &i, out + out_done, &o,
+                                                 in_done + i == in_len, &end);
+        if (ret != ESP_OK) {
+            break;
+        }
+        if (!i && !o && !end) {
+            ret = ESP_ERR_INVALID_SIZE;
+            break;
+        }
+
+        in_done += i;
+        out_done += o;
+    }
+
+    wm_ext_wasm_native_compress_destroy(stream);
+    *out_len = out_done;
+
+    return ret;
+}
+
+TEST_CASE("Compress and decompress streams", "[compress]")
+{
+    const uint32_t window_bits[WM_EXT_WASM_NATIVE_COMPRESS_MAX] = { 10, 12, 15, 11 };
+    uint8_t *data = malloc(TEST_DATA_SIZE);
+    uint8_t *packed = malloc(TEST_DATA_SIZE * 2);
+    uint8_t *unpacked = malloc(TEST_DATA_SIZE);
+    wm_ext_wasm_native_compress_t *stream;
+    uint32_t packed_len, unpacked_len;
+
+    TEST_ASSERT_NOT_NULL(data);
+    TEST_ASSERT_NOT_NULL(packed);
+    TEST_ASSERT_NOT_NULL(unpacked);
+
+    test_data(data, TEST_DATA_SIZE);
+
+    for (int format = 0; format < WM_EXT_WASM_NATIVE_COMPRESS_MAX; format++) {
+        TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_compress_create(format, true, -1, window_bits[format], &stream));
+        packed_len = TEST_DATA_SIZE * 2;
+        TEST_ASSERT_EQUAL(ESP_OK, test_run(stream, data, TEST_DATA_SIZE, packed, &packed_len));
+        TEST_ASSERT_LESS_THAN(TEST_DATA_SIZE * 3 / 5, packed_len);
+
+        TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_compress_create(format, false, -1, window_bits[format], &stream));
+        unpacked_len = TEST_DATA_SIZE;
+        TEST_ASSERT_EQUAL(ESP_OK, test_run(stream, packed, packed_len, unpacked, &unpacked_len));
+        TEST_ASSERT_EQUAL(TEST_DATA_SIZE, unpacked_len);
+        TEST_ASSERT_EQUAL_MEMORY(data, unpacked, TEST_DATA_SIZE);
+
+        /* zlib header tells the window, a smaller one can't decompress the stream */
+        if (format == WM_EXT_WASM_NATIVE_COMPRESS_ZLIB) {
+            TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_compress_create(format, false, -1, window_bits[format] - 1,
+                                                                         &stream));
+            unpacked_len = TEST_DATA_SIZE;
+            TEST_ASSERT_EQUAL(ESP_ERR_INVALID_RESPONSE, test_run(stream, packed, packed_len, unpacked, &unpacked_len));
+        }
+
+        /* Corrupt data is detected instead of decompressed */
+        packed[packed_len / 3] ^= 0x55;
+        packed[packed_len / 2] ^= 0xaa;
+        TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_compress_create(format, false, -1, window_bits[format], &stream));
+        unpacked_len = TEST_DATA_SIZE;
+        if (test_run(stream, packed, packed_len, unpacked, &unpacked_len) == ESP_OK) {
+            TEST_ASSERT(unpacked_len != TEST_DATA_SIZE || memcmp(data, unpacked, TEST_DATA_SIZE));
+        }
+    }
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_compress_create(WM_EXT_WASM_NATIVE_COMPRESS_ZLIB,
+                                                                              true, -1, 16, &stream));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_compress_create(WM_EXT_WASM_NATIVE_COMPRESS_LZ4,
+                                                                              true, -1, 9, &stream));
+
+    free(unpacked);
+    free(packed);
+    free(data);
+}
+
+#endif
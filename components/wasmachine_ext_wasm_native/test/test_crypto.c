@@ -0,0 +1,161 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_CRYPTO
+
+#include "wm_ext_wasm_native_crypto.h"
+
+/* AES-GCM test case 4 of the GCM specification, 60 bytes are not a multiple of blocks */
+#define GCM_KEY     "feffe9928665731c6d6a8f9467308308"
+#define GCM_IV      "cafebabefacedbaddecaf888"
+#define GCM_AAD     "feedfacedeadbeeffeedfacedeadbeefabaddad2"
+#define GCM_PT      "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a72" \
+                    "1c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b39"
+#define GCM_CT      "42831ec2217774244b7221b784d0d49ce3aa212f2c02a4e035c17e2329aca12e" \
+                    "21d514b25466931c7d8f6a5aac84aa051ba30b396a0aac973d58e091"
+#define GCM_TAG     "5bc94fbc3221a5db94fae95ae7121a47"
+
+/* ECDSA P-256 signature of SHA-256("abc") */
+#define ECDSA_PUBKEY "04bc807ff06c47128d0afc51a7960bd750b6f3c8d8365d64e1819237b8d787d1" \
+                     "c0ab360a27fb09d6f388eac5cc6a5ed12eceb3d04318294a1bf229ee29eb0b3373"
+#define ECDSA_SIG    "fb1f17e4984179e7904deaf9c779ea4fc4444861e5628d1493bf6ff78f8f8344" \
+                     "c7c519fe0ecd73fbd611d7bdaa8a4f64c2c2e809a40304d28b0cb751cea07db0"
+
+#define SHA256_ABC   "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"
+
+static uint32_t test_hex(const char *hex, uint8_t *buf)
+{
+    uint32_t len = strlen(hex) / 2;
+
+    for (uint32_t i = 0; i < len; i++) {
+        char byte[3] = { hex[i * 2], hex[i * 2 + 1], 0 };
+
+        buf[i] = (uint8_t)strtoul(byte, NULL, 16);
+    }
+
+    return len;
+}
+
+static void test_hash(wm_ext_wasm_native_crypto_hash_t alg, const char *key, const char *msg,
+                      uint32_t chunk, const char *digest)
+{
+    uint8_t expect[WM_EXT_WASM_NATIVE_CRYPTO_DIGEST_MAX];
+    uint8_t out[WM_EXT_WASM_NATIVE_CRYPTO_DIGEST_MAX];
+    uint32_t expect_len = test_hex(digest, expect);
+    uint32_t out_len = sizeof(out);
+    uint32_t msg_len = strlen(msg);
+    wm_ext_wasm_native_crypto_t *crypto;
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_hash_start(alg, (const uint8_t *)key,
+                                                                   key ? strlen(key) : 0, &crypto));
+    for (uint32_t i = 0; i < msg_len; i += chunk) {
+        uint32_t n = msg_len - i < chunk ? msg_len - i : chunk;
+
+        TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_update(crypto, (const uint8_t *)msg + i, NULL, n));
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_finish(crypto, out, &out_len));
+    TEST_ASSERT_EQUAL(expect_len, out_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(expect, out, expect_len);
+}
+
+TEST_CASE("Crypto hash and HMAC", "[crypto]")
+{
+    uint8_t out[16];
+    uint32_t out_len = sizeof(out);
+    wm_ext_wasm_native_crypto_t *crypto;
+
+    test_hash(WM_EXT_WASM_NATIVE_CRYPTO_HASH_SHA256, NULL, "abc", 1, SHA256_ABC);
+    test_hash(WM_EXT_WASM_NATIVE_CRYPTO_HASH_SHA512, NULL, "abc", 3,
+              "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+              "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+
+    /* RFC 4231 test case 2 */
+    test_hash(WM_EXT_WASM_NATIVE_CRYPTO_HASH_SHA256, "Jefe", "what do ya want for nothing?", 5,
+              "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_hash_start(WM_EXT_WASM_NATIVE_CRYPTO_HASH_SHA256,
+                                                                   NULL, 0, &crypto));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, wm_ext_wasm_native_crypto_finish(crypto, out, &out_len));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_crypto_hash_start(WM_EXT_WASM_NATIVE_CRYPTO_HASH_MAX,
+                                                                                NULL, 0, &crypto));
+}
+
+TEST_CASE("Crypto AES-CTR and AES-GCM", "[crypto]")
+{
+    uint8_t key[16], iv[16], aad[20], pt[64], ct[64], out[64], tag[16];
+    uint32_t pt_len, aad_len, iv_len, tag_len;
+    wm_ext_wasm_native_crypto_t *crypto;
+
+    /* NIST SP 800-38A F.5.1, split in the middle of a block */
+    test_hex("2b7e151628aed2a6abf7158809cf4f3c", key);
+    test_hex("f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff", iv);
+    pt_len = test_hex("6bc1bee22e409f96e93d7e117393172a", pt);
+    test_hex("874d6191b620e3261bef6864990db6ce", ct);
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_aes_ctr_start(key, 16, iv, &crypto));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_update(crypto, pt, out, 5));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_update(crypto, pt + 5, out + 5, pt_len - 5));
+    tag_len = 0;
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_finish(crypto, NULL, &tag_len));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(ct, out, pt_len);
+
+    test_hex(GCM_KEY, key);
+    iv_len = test_hex(GCM_IV, iv);
+    aad_len = test_hex(GCM_AAD, aad);
+    pt_len = test_hex(GCM_PT, pt);
+    test_hex(GCM_CT, ct);
+
+    /* Encrypt in place */
+    memcpy(out, pt, pt_len);
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_aes_gcm_start(key, 16, iv, iv_len, aad, aad_len,
+                                                                      false, &crypto));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_update(crypto, out, out, 7));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_update(crypto, out + 7, out + 7, pt_len - 7));
+    tag_len = sizeof(tag);
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_finish(crypto, tag, &tag_len));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(ct, out, pt_len);
+    test_hex(GCM_TAG, out);
+    TEST_ASSERT_EQUAL(16, tag_len);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(out, tag, tag_len);
+
+    /* Decrypt and check the tag, then check a modified tag */
+    for (int i = 0; i < 2; i++) {
+        TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_aes_gcm_start(key, 16, iv, iv_len, aad, aad_len,
+                                                                          true, &crypto));
+        TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_update(crypto, ct, out, pt_len));
+        TEST_ASSERT_EQUAL_HEX8_ARRAY(pt, out, pt_len);
+        tag[15] ^= i;
+        TEST_ASSERT_EQUAL(i ? ESP_ERR_INVALID_CRC : ESP_OK, wm_ext_wasm_native_crypto_finish(crypto, tag, &tag_len));
+    }
+}
+
+TEST_CASE("Crypto ECDSA verify", "[crypto]")
+{
+    uint8_t pubkey[65], hash[32], sig[64];
+    uint32_t pubkey_len = test_hex(ECDSA_PUBKEY, pubkey);
+    uint32_t sig_len = test_hex(ECDSA_SIG, sig);
+
+    test_hex(SHA256_ABC, hash);
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_crypto_ecdsa_verify(WM_EXT_WASM_NATIVE_CRYPTO_CURVE_P256,
+                                                                     pubkey, pubkey_len, hash, sizeof(hash),
+                                                                     sig, sig_len));
+
+    hash[0] ^= 1;
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_CRC, wm_ext_wasm_native_crypto_ecdsa_verify(WM_EXT_WASM_NATIVE_CRYPTO_CURVE_P256,
+                                                                                  pubkey, pubkey_len, hash, sizeof(hash),
+                                                                                  sig, sig_len));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_crypto_ecdsa_verify(WM_EXT_WASM_NATIVE_CRYPTO_CURVE_P256,
+                                                                                  pubkey, pubkey_len, hash, sizeof(hash),
+                                                                                  sig, sig_len - 1));
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_JSON
+
+#include "wm_ext_wasm_native_json.h"
+
+#define TEST_MAX_TOKENS     64
+
+static const char s_test_json[] =
+    "{\"device\":{\"name\":\"esp32\",\"heap\":{\"free\":214532}},"
+    " \"sensors\" : [ {\"id\":1,\"value\":23.75,\"ok\":true},{\"id\":2,\"value\":-1.5e2,\"ok\":null} ],"
+    "\"text\":\"a\\\"b\\\\c\\n\\u00e9\\ud83d\\ude00\",\"empty\":{},\"none\":[]}";
+
+static esp_err_t test_parse(wm_ext_wasm_native_json_t *doc, wm_ext_wasm_native_json_token_t *tokens,
+                            const char *json)
+{
+    doc->json = json;
+    doc->len = strlen(json);
+    doc->tokens = tokens;
+    doc->max_tokens = TEST_MAX_TOKENS;
+
+    return wm_ext_wasm_native_json_parse(doc);
+}
+
+TEST_CASE("Parse JSON into tokens and query values", "[json]")
+{
+    static const char *const s_invalid[] = {
+        "", "{", "[1,]", "{\"a\":}", "{\"a\" 1}", "{1:2}", "[1 2]", "01", "1.", "-", "1e",
+        "tru", "nul", "\"a", "\"\\x\"", "\"\\u12g4\"", "\"a\nb\"", "[1]]", "{}{}", "[}", "{]",
+    };
+    wm_ext_wasm_native_json_token_t tokens[TEST_MAX_TOKENS];
+    wm_ext_wasm_native_json_t doc;
+    uint32_t index, len;
+    double number;
+    int64_t integer;
+    char text[32];
+
+    TEST_ASSERT_EQUAL(ESP_OK, test_parse(&doc, tokens, s_test_json));
+    TEST_ASSERT_EQUAL(31, doc.count);
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_NATIVE_JSON_OBJECT, tokens[0].type);
+    TEST_ASSERT_EQUAL(5, tokens[0].size);
+    TEST_ASSERT_EQUAL(doc.count, tokens[0].next);
+    TEST_ASSERT_EQUAL(doc.len, tokens[0].len);
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_find(&doc, 0, "device.name", &index));
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_NATIVE_JSON_STRING, tokens[index].type);
+    TEST_ASSERT_EQUAL(5, tokens[index].len);
+    TEST_ASSERT_EQUAL_MEMORY("esp32", s_test_json + tokens[index].start, 5);
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_find(&doc, 0, "device.heap.free", &index));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_get_int(&doc, index, &integer));
+    TEST_ASSERT_EQUAL(214532, (int)integer);
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_find(&doc, 0, "sensors", &index));
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_NATIVE_JSON_ARRAY, tokens[index].type);
+    TEST_ASSERT_EQUAL(2, tokens[index].size);
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_find(&doc, index, "[1].value", &index));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_get_number(&doc, index, &number));
+    TEST_ASSERT_TRUE(number == -150.0);
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_json_get_int(&doc, index, &integer));
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_find(&doc, 0, "sensors[0].ok", &index));
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_NATIVE_JSON_TRUE, tokens[index].type);
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_find(&doc, 0, "sensors[1].ok", &index));
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_NATIVE_JSON_NULL, tokens[index].type);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, wm_ext_wasm_native_json_find(&doc, 0, "sensors[2]", &index));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, wm_ext_wasm_native_json_find(&doc, 0, "device.id", &index));
+    TEST_ASSERT_EQUAL(ESP_ERR_NOT_FOUND, wm_ext_wasm_native_json_find(&doc, 0, "device[0]", &index));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_json_find(&doc, 0, "device..name", &index));
+
+    /* Escapes and a surrogate pair are decoded to UTF-8 */
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_find(&doc, 0, "text", &index));
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_NATIVE_JSON_ESCAPED, tokens[index].flags);
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_get_string(&doc, index, text, sizeof(text), &len));
+    TEST_ASSERT_EQUAL(12, len);
+    TEST_ASSERT_EQUAL_STRING("a\"b\\c\n\xc3\xa9\xf0\x9f\x98\x80", text);
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_get_string(&doc, index, text, 4, &len));
+    TEST_ASSERT_EQUAL(12, len);
+    TEST_ASSERT_EQUAL_STRING("a\"b", text);
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_find(&doc, 0, "empty", &index));
+    TEST_ASSERT_EQUAL(0, tokens[index].size);
+    TEST_ASSERT_EQUAL(index + 1, tokens[index].next);
+
+    /* Text of n bytes never needs more than n / 2 + 1 tokens */
+    doc.max_tokens = 30;
+    TEST_ASSERT_EQUAL(ESP_ERR_NO_MEM, wm_ext_wasm_native_json_parse(&doc));
+    TEST_ASSERT_EQUAL(ESP_OK, test_parse(&doc, tokens, "[0,0,[],{\"\":0}]"));
+    TEST_ASSERT_EQUAL(7, doc.count);
+    TEST_ASSERT_LESS_THAN(doc.len / 2 + 2, doc.count);
+
+    for (int i = 0; i < sizeof(s_invalid) / sizeof(s_invalid[0]); i++) {
+        TEST_ASSERT_EQUAL(ESP_ERR_INVALID_RESPONSE, test_parse(&doc, tokens, s_invalid[i]));
+    }
+}
+
+TEST_CASE("Write JSON to a buffer", "[json]")
+{
+    static const char s_expect[] =
+        "{\"name\":\"a\\\"b\\n\\u0001\",\"n\":[0.1,-150,1e+300,null,9007199254740993],"
+        "\"ok\":true,\"none\":null,\"raw\":{\"x\":1}}";
+    wm_ext_wasm_native_json_writer_t writer;
+    wm_ext_wasm_native_json_token_t tokens[TEST_MAX_TOKENS];
+    wm_ext_wasm_native_json_t doc;
+    char buf[sizeof(s_expect)];
+
+    wm_ext_wasm_native_json_writer_init(&writer, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, wm_ext_wasm_native_json_write_end(&writer));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_begin(&writer, NULL, false));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, wm_ext_wasm_native_json_write_null(&writer, NULL));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_string(&writer, "name", "a\"b\n\x01", 5));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_begin(&writer, "n", true));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, wm_ext_wasm_native_json_write_int(&writer, "k", 1));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_number(&writer, NULL, 0.1));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_number(&writer, NULL, -150.0));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_number(&writer, NULL, 1e300));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_number(&writer, NULL, 1e300 * 1e300));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_int(&writer, NULL, 9007199254740993LL));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_end(&writer));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_bool(&writer, "ok", true));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_null(&writer, "none"));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_raw(&writer, "raw", "{\"x\":1}", 7));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_end(&writer));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, wm_ext_wasm_native_json_write_null(&writer, NULL));
+
+    TEST_ASSERT_EQUAL(0, writer.depth);
+    TEST_ASSERT_EQUAL(sizeof(s_expect) - 1, writer.len);
+    TEST_ASSERT_EQUAL_MEMORY(s_expect, buf, writer.len);
+
+    /* Output parses back */
+    TEST_ASSERT_EQUAL(ESP_OK, test_parse(&doc, tokens, s_expect));
+
+    /* Output is truncated, but its length is still counted */
+    wm_ext_wasm_native_json_writer_init(&writer, buf, 8);
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_json_write_begin(&writer, NULL, true));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, wm_ext_wasm_native_json_write_string(&writer, NULL, "0123456789", 10));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_SIZE, wm_ext_wasm_native_json_write_end(&writer));
+    TEST_ASSERT_EQUAL(14, writer.len);
+    TEST_ASSERT_EQUAL_MEMORY("[\"012345", buf, 8);
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_LIBMATH
+
+#include "wm_ext_wasm_native_libm.h"
+
+#define TEST_NUM    67
+
+TEST_CASE("Batch math of arrays", "[libm]")
+{
+    float x[TEST_NUM], y[TEST_NUM], out[TEST_NUM];
+    int16_t s[TEST_NUM], s_out[TEST_NUM];
+    float (*const ref[])(float) = { sinf, cosf, expf, logf, sqrtf };
+    wm_ext_wasm_native_libm_stat_t stat;
+    float dot = 0, sum = 0;
+    int64_t s_dot = 0;
+
+    for (int i = 0; i < TEST_NUM; i++) {
+        x[i] = (float)(i + 1) / 8;
+        y[i] = (float)(TEST_NUM / 2 - i) / 4;
+        s[i] = (int16_t)(i * 900 - 30000);
+        dot += x[i] * y[i];
+        sum += y[i];
+        s_dot += (int64_t)s[i] * s[i];
+    }
+
+    for (int op = 0; op < WM_EXT_WASM_NATIVE_LIBM_OP_MAX; op++) {
+        TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_libm_vmathf(op, out, x, TEST_NUM));
+        for (int i = 0; i < TEST_NUM; i++) {
+            TEST_ASSERT_FLOAT_WITHIN(1e-5f * fmaxf(1, fabsf(out[i])), ref[op](x[i]), out[i]);
+        }
+    }
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_libm_vmathf(WM_EXT_WASM_NATIVE_LIBM_OP_MAX, out, x, 1));
+
+    wm_ext_wasm_native_libm_vatan2f(out, y, x, TEST_NUM);
+    for (int i = 0; i < TEST_NUM; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, atan2f(y[i], x[i]), out[i]);
+    }
+
+    /* In place */
+    memcpy(out, x, sizeof(out));
+    wm_ext_wasm_native_libm_vscalef(out, out, TEST_NUM, 2.0f, -1.0f);
+    for (int i = 0; i < TEST_NUM; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(1e-6f, x[i] * 2.0f - 1.0f, out[i]);
+    }
+
+    /* Results are saturated */
+    wm_ext_wasm_native_libm_vscale_s16(s_out, s, TEST_NUM, 1.5f, 0.5f);
+    for (int i = 0; i < TEST_NUM; i++) {
+        float v = rintf(s[i] * 1.5f + 0.5f);
+
+        TEST_ASSERT_EQUAL_INT16(v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (int16_t)v, s_out[i]);
+    }
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-3f, dot, wm_ext_wasm_native_libm_vdotf(x, y, TEST_NUM));
+    TEST_ASSERT_TRUE(s_dot == wm_ext_wasm_native_libm_vdot_s16(s, s, TEST_NUM));
+
+    wm_ext_wasm_native_libm_vstatf(y, TEST_NUM, &stat);
+    TEST_ASSERT_EQUAL_FLOAT(y[TEST_NUM - 1], stat.min);
+    TEST_ASSERT_EQUAL_FLOAT(y[0], stat.max);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5f, sum / TEST_NUM, stat.mean);
+
+    wm_ext_wasm_native_libm_vstat_s16(s, TEST_NUM, &stat);
+    TEST_ASSERT_EQUAL_FLOAT(-30000, stat.min);
+    TEST_ASSERT_EQUAL_FLOAT(29400, stat.max);
+    TEST_ASSERT_EQUAL_FLOAT(-300, stat.mean);
+
+    wm_ext_wasm_native_libm_vstat_s16(s, 0, &stat);
+    TEST_ASSERT_EQUAL_FLOAT(0, stat.min);
+    TEST_ASSERT_EQUAL_FLOAT(0, stat.mean);
+}
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/errno.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP && CONFIG_IDF_TARGET_LINUX
+
+#include "wm_ext_wasm_native_mmap.h"
+
+/* Host tmpfs stands for the VFS on linux target */
+#define TEST_FILE       "/tmp/wm_mmap_test.bin"
+#define TEST_PAGE       CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PAGE_SIZE
+#define TEST_PAGES      CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PAGE_NUM
+#define TEST_FILE_SIZE  (TEST_PAGE * (TEST_PAGES + 2) + 100)
+
+static uint8_t s_data[TEST_FILE_SIZE];
+static uint8_t s_buf[TEST_PAGE * 3];
+
+static void test_create_file(void)
+{
+    int fd;
+
+    for (int i = 0; i < TEST_FILE_SIZE; i++) {
+        s_data[i] = (uint8_t)(i * 7 + i / 251);
+    }
+
+    fd = open(TEST_FILE, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    TEST_ASSERT_GREATER_OR_EQUAL(0, fd);
+    TEST_ASSERT_EQUAL(TEST_FILE_SIZE, write(fd, s_data, TEST_FILE_SIZE));
+    close(fd);
+}
+
+static void test_read(wm_ext_wasm_native_mmap_t *m, uint32_t offset, uint32_t len)
+{
+    memset(s_buf, 0, sizeof(s_buf));
+    TEST_ASSERT_EQUAL_INT(len, wm_ext_wasm_native_mmap_read(m, offset, s_buf, len));
+    TEST_ASSERT_EQUAL_MEMORY(s_data + offset, s_buf, len);
+}
+
+static void test_check_stats(wm_ext_wasm_native_mmap_t *m, uint32_t hits, uint32_t misses, uint32_t evictions)
+{
+    wm_ext_wasm_native_mmap_stats_t stats;
+
+    wm_ext_wasm_native_mmap_get_stats(m, &stats);
+    TEST_ASSERT_EQUAL_UINT32(hits, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(misses, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(evictions, stats.evictions);
+}
+
+TEST_CASE("Read a file mapping through its page cache", "[mmap]")
+{
+    wm_ext_wasm_native_mmap_t *m;
+    wm_ext_wasm_native_mmap_stats_t before;
+    wm_ext_wasm_native_mmap_stats_t after;
+
+    test_create_file();
+
+    m = wm_ext_wasm_native_mmap_open(TEST_FILE, 0, 0);
+    TEST_ASSERT_NOT_NULL(m);
+    TEST_ASSERT_EQUAL_UINT32(TEST_FILE_SIZE, wm_ext_wasm_native_mmap_size(m));
+
+    /* Small reads of one page load it once */
+    test_read(m, 10, 20);
+    test_read(m, 40, 20);
+    test_check_stats(m, 1, 1, 0);
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PAGE_NUM > 1
+    /* A read which crosses pages takes the cached page and loads the next one */
+    test_read(m, TEST_PAGE - 8, 16);
+    test_check_stats(m, 2, 2, 0);
+
+    /* Fill the cache, and touch page 0 so that page 1 is the least recently used */
+    for (int i = 2; i < TEST_PAGES; i++) {
+        test_read(m, i * TEST_PAGE + 1, 4);
+    }
+    test_read(m, 0, 4);
+    test_check_stats(m, 3, TEST_PAGES, 0);
+
+    /* A new page evicts page 1, page 0 is still cached */
+    test_read(m, TEST_PAGES * TEST_PAGE + 1, 4);
+    test_check_stats(m, 3, TEST_PAGES + 1, 1);
+    test_read(m, 2, 4);
+    test_check_stats(m, 4, TEST_PAGES + 1, 1);
+    test_read(m, TEST_PAGE + 2, 4);
+    test_check_stats(m, 4, TEST_PAGES + 2, 2);
+#else
+    /* The only page is replaced by the next one in a read which crosses pages */
+    test_read(m, TEST_PAGE - 8, 16);
+    test_check_stats(m, 2, 2, 1);
+    test_read(m, 2, 4);
+    test_check_stats(m, 2, 3, 2);
+#endif
+
+    /* Whole pages are read into the caller's buffer without the cache */
+    wm_ext_wasm_native_mmap_get_stats(m, &before);
+    test_read(m, TEST_PAGE, TEST_PAGE * 2);
+    wm_ext_wasm_native_mmap_get_stats(m, &after);
+    TEST_ASSERT_EQUAL_MEMORY(&before, &after, sizeof(before));
+
+    /* Unaligned reads of many pages combine cached and whole pages */
+    test_read(m, TEST_PAGE / 2, TEST_PAGE * 2);
+
+    /* Reads past the end are short, and offsets past the end read nothing */
+    test_read(m, TEST_FILE_SIZE - 10, 10);
+    TEST_ASSERT_EQUAL_INT(10, wm_ext_wasm_native_mmap_read(m, TEST_FILE_SIZE - 10, s_buf, 100));
+    TEST_ASSERT_EQUAL_INT(0, wm_ext_wasm_native_mmap_read(m, TEST_FILE_SIZE, s_buf, 100));
+    TEST_ASSERT_EQUAL_INT(0, wm_ext_wasm_native_mmap_read(m, UINT32_MAX, s_buf, 100));
+
+    wm_ext_wasm_native_mmap_close(m);
+    unlink(TEST_FILE);
+}
+
+TEST_CASE("Open windows of a file mapping", "[mmap]")
+{
+    wm_ext_wasm_native_mmap_t *m;
+
+    test_create_file();
+
+    /* Offsets of a window are relative to its start */
+    m = wm_ext_wasm_native_mmap_open(TEST_FILE, 100, TEST_PAGE * 2);
+    TEST_ASSERT_NOT_NULL(m);
+    TEST_ASSERT_EQUAL_UINT32(TEST_PAGE * 2, wm_ext_wasm_native_mmap_size(m));
+    TEST_ASSERT_EQUAL_INT(50, wm_ext_wasm_native_mmap_read(m, 0, s_buf, 50));
+    TEST_ASSERT_EQUAL_MEMORY(s_data + 100, s_buf, 50);
+    TEST_ASSERT_EQUAL_INT(20, wm_ext_wasm_native_mmap_read(m, TEST_PAGE * 2 - 20, s_buf, 50));
+    TEST_ASSERT_EQUAL_MEMORY(s_data + 100 + TEST_PAGE * 2 - 20, s_buf, 20);
+    wm_ext_wasm_native_mmap_close(m);
+
+    /* An empty window at the end of the file */
+    m = wm_ext_wasm_native_mmap_open(TEST_FILE, TEST_FILE_SIZE, 0);
+    TEST_ASSERT_NOT_NULL(m);
+    TEST_ASSERT_EQUAL_UINT32(0, wm_ext_wasm_native_mmap_size(m));
+    TEST_ASSERT_EQUAL_INT(0, wm_ext_wasm_native_mmap_read(m, 0, s_buf, 1));
+    wm_ext_wasm_native_mmap_close(m);
+
+    /* Windows out of the file are rejected */
+    TEST_ASSERT_NULL(wm_ext_wasm_native_mmap_open(TEST_FILE, TEST_FILE_SIZE + 1, 0));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+    TEST_ASSERT_NULL(wm_ext_wasm_native_mmap_open(TEST_FILE, 100, TEST_FILE_SIZE));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+    TEST_ASSERT_NULL(wm_ext_wasm_native_mmap_open("/tmp/wm_mmap_none.bin", 0, 0));
+    TEST_ASSERT_EQUAL(ENOENT, errno);
+
+    /* Pages which the file lost after open fail to load */
+    m = wm_ext_wasm_native_mmap_open(TEST_FILE, 0, 0);
+    TEST_ASSERT_NOT_NULL(m);
+    TEST_ASSERT_EQUAL_INT(0, truncate(TEST_FILE, TEST_PAGE));
+    test_read(m, 5, 10);
+    TEST_ASSERT_EQUAL_INT(-1, wm_ext_wasm_native_mmap_read(m, TEST_PAGE + 5, s_buf, 10));
+    TEST_ASSERT_EQUAL(EIO, errno);
+    wm_ext_wasm_native_mmap_close(m);
+
+    unlink(TEST_FILE);
+}
+
+TEST_CASE("Map only listed data partitions", "[mmap]")
+{
+    /* NVS is rejected even if it is listed, and labels never match part of the list */
+    TEST_ASSERT_NULL(wm_ext_wasm_native_mmap_open("partition:nvs", 0, 0));
+    TEST_ASSERT_EQUAL(EACCES, errno);
+    TEST_ASSERT_NULL(wm_ext_wasm_native_mmap_open("partition:", 0, 0));
+    TEST_ASSERT_EQUAL(EACCES, errno);
+    TEST_ASSERT_NULL(wm_ext_wasm_native_mmap_open("partition:" CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PARTITIONS ",nvs", 0, 0));
+    TEST_ASSERT_EQUAL(EACCES, errno);
+}
+
+#endif
@@ -0,0 +1,62 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <time.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_TIMER
+
+#include "wm_ext_wasm_native_timer.h"
+
+TEST_CASE("Delay until deadlines of the monotonic clock", "[timer]")
+{
+    static const int64_t s_delay_us[] = { 0, 50, 700, 3000, 25000 };
+    int64_t now = wm_ext_wasm_native_timer_now_us();
+
+    TEST_ASSERT_TRUE(now > 0);
+
+    for (int i = 0; i < sizeof(s_delay_us) / sizeof(s_delay_us[0]); i++) {
+        int64_t start = wm_ext_wasm_native_timer_now_us();
+        int64_t late = wm_ext_wasm_native_timer_delay_until(start + s_delay_us[i]);
+        int64_t end = wm_ext_wasm_native_timer_now_us();
+
+        TEST_ASSERT_TRUE(late >= 0);
+        TEST_ASSERT_TRUE(end - start >= s_delay_us[i]);
+        TEST_ASSERT_TRUE(end - start < s_delay_us[i] + 1000);
+    }
+
+    /* A passed deadline returns at once */
+    now = wm_ext_wasm_native_timer_now_us();
+    TEST_ASSERT_TRUE(wm_ext_wasm_native_timer_delay_until(now - 1000) >= 1000);
+}
+
+#if CONFIG_IDF_TARGET_LINUX
+static int64_t test_cpu_time_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+TEST_CASE("Delay until deadlines without spinning", "[timer]")
+{
+    /* Fractions of a tick are slept too, so the task takes little CPU time of the delays */
+    static const int64_t s_delay_us[] = { 1500, 9500, 19500 };
+
+    for (int i = 0; i < sizeof(s_delay_us) / sizeof(s_delay_us[0]); i++) {
+        int64_t cpu = test_cpu_time_us();
+        int64_t start = wm_ext_wasm_native_timer_now_us();
+
+        TEST_ASSERT_TRUE(wm_ext_wasm_native_timer_delay_until(start + s_delay_us[i]) >= 0);
+        TEST_ASSERT_TRUE(test_cpu_time_us() - cpu < s_delay_us[i] / 2);
+    }
+}
+#endif
+
+#endif
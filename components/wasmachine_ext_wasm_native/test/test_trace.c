@@ -0,0 +1,167 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_TRACE
+
+#include "wm_ext_wasm_native_trace.h"
+
+#define TEST_ENTRIES    16
+
+typedef struct test_visit {
+    uint32_t num;
+    uint32_t ids[TEST_ENTRIES];
+} test_visit_t;
+
+static void test_visit(const wm_ext_wasm_native_trace_entry_t *entry, void *arg)
+{
+    test_visit_t *visit = arg;
+
+    visit->ids[visit->num++] = entry->id;
+}
+
+static void test_record(wm_ext_wasm_native_trace_ring_t *ring, uint32_t id)
+{
+    uint32_t index;
+    wm_ext_wasm_native_trace_entry_t entry = {
+        .name = "test",
+        .id = id
+    };
+
+    TEST_ASSERT_TRUE(wm_ext_wasm_native_trace_ring_reserve(ring, &index));
+    wm_ext_wasm_native_trace_ring_commit(ring, index, &entry);
+}
+
+TEST_CASE("Trace ring keeps the newest entries", "[trace]")
+{
+    uint32_t index;
+    test_visit_t visit = { 0 };
+    wm_ext_wasm_native_trace_ring_t *ring = wm_ext_wasm_native_trace_ring_create(TEST_ENTRIES - 3);
+
+    TEST_ASSERT_NOT_NULL(ring);
+
+    /* A stopped ring records nothing */
+    TEST_ASSERT_FALSE(wm_ext_wasm_native_trace_ring_reserve(ring, &index));
+
+    wm_ext_wasm_native_trace_ring_start(ring);
+    for (uint32_t i = 0; i < TEST_ENTRIES + 5; i++) {
+        test_record(ring, i);
+    }
+    wm_ext_wasm_native_trace_ring_stop(ring);
+
+    /* The size is rounded up to TEST_ENTRIES, the oldest 5 entries are overwritten */
+    TEST_ASSERT_EQUAL_UINT32(TEST_ENTRIES, wm_ext_wasm_native_trace_ring_foreach(ring, test_visit, &visit));
+    for (uint32_t i = 0; i < TEST_ENTRIES; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i + 5, visit.ids[i]);
+    }
+
+    /* Starting again drops entries of the last run */
+    wm_ext_wasm_native_trace_ring_start(ring);
+    test_record(ring, 100);
+    wm_ext_wasm_native_trace_ring_stop(ring);
+
+    visit.num = 0;
+    TEST_ASSERT_EQUAL_UINT32(1, wm_ext_wasm_native_trace_ring_foreach(ring, test_visit, &visit));
+    TEST_ASSERT_EQUAL_UINT32(100, visit.ids[0]);
+
+    wm_ext_wasm_native_trace_ring_clear(ring);
+    TEST_ASSERT_EQUAL_UINT32(0, wm_ext_wasm_native_trace_ring_foreach(ring, test_visit, &visit));
+
+    wm_ext_wasm_native_trace_ring_destroy(ring);
+}
+
+TEST_CASE("Trace ring skips entries of lapped writers", "[trace]")
+{
+    uint32_t index;
+    uint32_t lapped;
+    test_visit_t visit = { 0 };
+    wm_ext_wasm_native_trace_entry_t entry = {
+        .name = "lapped",
+        .id = 1000
+    };
+    wm_ext_wasm_native_trace_ring_t *ring = wm_ext_wasm_native_trace_ring_create(TEST_ENTRIES);
+
+    TEST_ASSERT_NOT_NULL(ring);
+    wm_ext_wasm_native_trace_ring_start(ring);
+
+    /* A writer is preempted after reserving, and others wrap around the ring meanwhile */
+    TEST_ASSERT_TRUE(wm_ext_wasm_native_trace_ring_reserve(ring, &lapped));
+    for (uint32_t i = 1; i <= TEST_ENTRIES; i++) {
+        test_record(ring, i);
+    }
+
+    /* Its late commit overwrites the newer entry of the same slot, which must not be dumped */
+    wm_ext_wasm_native_trace_ring_commit(ring, lapped, &entry);
+    wm_ext_wasm_native_trace_ring_stop(ring);
+
+    TEST_ASSERT_EQUAL_UINT32(TEST_ENTRIES - 1, wm_ext_wasm_native_trace_ring_foreach(ring, test_visit, &visit));
+    for (uint32_t i = 0; i < TEST_ENTRIES - 1; i++) {
+        TEST_ASSERT_EQUAL_UINT32(i + 1, visit.ids[i]);
+    }
+
+    /* Nothing is recorded after stopping */
+    TEST_ASSERT_FALSE(wm_ext_wasm_native_trace_ring_reserve(ring, &index));
+
+    wm_ext_wasm_native_trace_ring_destroy(ring);
+}
+
+typedef struct test_stop {
+    wm_ext_wasm_native_trace_ring_t *ring;
+    atomic_bool stopped;
+} test_stop_t;
+
+static void *test_stop_task(void *arg)
+{
+    test_stop_t *stop = arg;
+
+    wm_ext_wasm_native_trace_ring_stop(stop->ring);
+    atomic_store(&stop->stopped, true);
+
+    return NULL;
+}
+
+TEST_CASE("Stop trace ring after writers commit", "[trace]")
+{
+    uint32_t index;
+    uint32_t other;
+    pthread_t thread;
+    test_visit_t visit = { 0 };
+    wm_ext_wasm_native_trace_entry_t entry = {
+        .name = "writer",
+        .id = 7
+    };
+    test_stop_t stop = {
+        .ring = wm_ext_wasm_native_trace_ring_create(TEST_ENTRIES)
+    };
+
+    TEST_ASSERT_NOT_NULL(stop.ring);
+    wm_ext_wasm_native_trace_ring_start(stop.ring);
+
+    TEST_ASSERT_TRUE(wm_ext_wasm_native_trace_ring_reserve(stop.ring, &index));
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, test_stop_task, &stop));
+
+    /* Stopping waits for the writer, and new writers are refused meanwhile */
+    usleep(50000);
+    TEST_ASSERT_FALSE(atomic_load(&stop.stopped));
+    TEST_ASSERT_FALSE(wm_ext_wasm_native_trace_ring_reserve(stop.ring, &other));
+
+    wm_ext_wasm_native_trace_ring_commit(stop.ring, index, &entry);
+    TEST_ASSERT_EQUAL_INT(0, pthread_join(thread, NULL));
+    TEST_ASSERT_TRUE(atomic_load(&stop.stopped));
+
+    /* So the entry is complete when the ring is dumped */
+    TEST_ASSERT_EQUAL_UINT32(1, wm_ext_wasm_native_trace_ring_foreach(stop.ring, test_visit, &visit));
+    TEST_ASSERT_EQUAL_UINT32(7, visit.ids[0]);
+
+    wm_ext_wasm_native_trace_ring_destroy(stop.ring);
+}
+
+#endif
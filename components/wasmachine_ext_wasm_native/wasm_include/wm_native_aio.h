@@ -0,0 +1,98 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Header of WASM applications, not of the firmware. Reads, writes, fsync and ioctl run in
+ * a native worker task through submission and completion rings in linear memory when
+ * CONFIG_WASMACHINE_WASM_EXT_NATIVE_AIO is enabled:
+ *
+ *     static wm_native_aio_sqe_t sqes[8];
+ *     static wm_native_aio_cqe_t cqes[8];
+ *     static wm_native_aio_ring_t ring = { .entries = 8, .sqes = sqes, .cqes = cqes };
+ *     int id = wm_native_aio_setup(&ring);
+ *
+ *     sqes[ring.sq_tail % 8] = (wm_native_aio_sqe_t) {
+ *         .opcode = WM_NATIVE_AIO_READ, .fd = fd, .addr = buf, .len = sizeof(buf), .offset = -1
+ *     };
+ *     ring.sq_tail++;
+ *     wm_native_aio_wait(id, 1, -1);
+ *     // consume cqes[ring.cq_head % 8], then ring.cq_head++
+ *
+ * Indexes are free running and wrap by entries, which must be a power of 2. Functions and
+ * res of failed completions are a negative errno value of the firmware.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define WM_NATIVE_AIO_IMPORT(name) \
+    __attribute__((import_module("env"), import_name(#name)))
+
+#define WM_NATIVE_AIO_MAX_ENTRIES   256     /* Max number of entries of a ring */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    WM_NATIVE_AIO_NOP = 0,          /* Do nothing, complete with 0 */
+    WM_NATIVE_AIO_READ,             /* read, or pread if offset is not -1 */
+    WM_NATIVE_AIO_WRITE,            /* write, or pwrite if offset is not -1 */
+    WM_NATIVE_AIO_FSYNC,            /* fsync */
+    WM_NATIVE_AIO_IOCTL,            /* ioctl, addr is the argument block and len is the command */
+};
+
+typedef struct wm_native_aio_sqe {
+    uint8_t opcode;                 /* Operation */
+    uint8_t flags;                  /* Reserved, must be 0 */
+    uint16_t reserved;              /* Reserved, must be 0 */
+    int32_t fd;                     /* File descriptor */
+    void *addr;                     /* Buffer, or argument block of ioctl */
+    uint32_t len;                   /* Length of buffer, or command of ioctl */
+    int64_t offset;                 /* File offset, -1 to use and update current file position */
+    uint64_t user_data;             /* Copied to completion queue entry */
+} wm_native_aio_sqe_t;
+
+typedef struct wm_native_aio_cqe {
+    uint64_t user_data;             /* user_data of submission queue entry */
+    int32_t res;                    /* Result of operation, or negative errno if failed */
+    uint32_t flags;                 /* Reserved */
+} wm_native_aio_cqe_t;
+
+typedef struct wm_native_aio_ring {
+    uint32_t sq_head;               /* Next submission queue entry to take, written by native */
+    uint32_t sq_tail;               /* Next submission queue entry to fill, written by application */
+    uint32_t cq_head;               /* Next completion queue entry to consume, written by application */
+    uint32_t cq_tail;               /* Next completion queue entry to fill, written by native */
+    uint32_t entries;               /* Number of entries of each queue */
+    wm_native_aio_sqe_t *sqes;      /* Submission queue entries */
+    wm_native_aio_cqe_t *cqes;      /* Completion queue entries */
+    uint32_t reserved;              /* Reserved, must be 0 */
+} wm_native_aio_ring_t;
+
+/* Start a worker task of a ring, which must stay in place until it's destroyed, return its id */
+WM_NATIVE_AIO_IMPORT(wasm_aio_setup)
+int wm_native_aio_setup(wm_native_aio_ring_t *ring);
+
+/* Take submitted entries, and post completed entries while there is room */
+WM_NATIVE_AIO_IMPORT(wasm_aio_submit)
+int wm_native_aio_submit(int id);
+
+/*
+ * Submit and wait until there are at least min_complete unconsumed completions, or
+ * timeout_ms passes if it's not negative, return the number of unconsumed completions
+ */
+WM_NATIVE_AIO_IMPORT(wasm_aio_wait)
+int wm_native_aio_wait(int id, uint32_t min_complete, int32_t timeout_ms);
+
+/* Entries which are not started yet are dropped */
+WM_NATIVE_AIO_IMPORT(wasm_aio_destroy)
+int wm_native_aio_destroy(int id);
+
+#ifdef __cplusplus
+}
+#endif
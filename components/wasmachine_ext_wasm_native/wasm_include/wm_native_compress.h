@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Header of WASM applications, not of the firmware. Streaming compression runs natively
+ * when CONFIG_WASMACHINE_WASM_EXT_NATIVE_COMPRESS is enabled:
+ *
+ *     int ret, s = wm_native_compress_create(WM_NATIVE_COMPRESS_LZ4, 1, -1, 12);
+ *     wm_native_compress_buf_t buf = { .in = data, .in_len = len, .out = out, .out_len = size };
+ *
+ *     while ((ret = wm_native_compress_update(s, &buf, 1)) == 0) {
+ *         // consume output before buf.out, then reset buf.out and buf.out_len
+ *     }
+ *     wm_native_compress_destroy(s);
+ *
+ * Update returns 1 when the stream ends, 0 when it needs more input or output space,
+ * and a negative errno value of the firmware if it fails.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define WM_NATIVE_COMPRESS_IMPORT(name) \
+    __attribute__((import_module("env"), import_name(#name)))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    WM_NATIVE_COMPRESS_ZLIB = 0,    /* Deflate with zlib header, window bits are 9 to 15 */
+    WM_NATIVE_COMPRESS_DEFLATE,     /* Raw deflate, window bits are 9 to 15 */
+    WM_NATIVE_COMPRESS_GZIP,        /* Deflate with gzip header, window bits are 9 to 15 */
+    WM_NATIVE_COMPRESS_LZ4,         /* LZ4 frame, window bits are 10 to 16 */
+};
+
+typedef struct wm_native_compress_buf {
+    const void *in;                 /* Input, it is advanced by consumed bytes */
+    uint32_t in_len;                /* Available input bytes */
+    void *out;                      /* Output, it is advanced by produced bytes */
+    uint32_t out_len;               /* Output space */
+} wm_native_compress_buf_t;
+
+WM_NATIVE_COMPRESS_IMPORT(wasm_compress_create)
+int wm_native_compress_create(int format, int compress, int level, uint32_t window_bits);
+
+WM_NATIVE_COMPRESS_IMPORT(wasm_compress_update)
+int wm_native_compress_update(int stream, wm_native_compress_buf_t *buf, int finish);
+
+WM_NATIVE_COMPRESS_IMPORT(wasm_compress_destroy)
+int wm_native_compress_destroy(int stream);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Header of WASM applications, not of the firmware. Hashes, HMAC, AES ciphers and ECDSA
+ * verification run natively by mbedTLS, on accelerators of the chip, when
+ * CONFIG_WASMACHINE_WASM_EXT_NATIVE_CRYPTO is enabled:
+ *
+ *     uint8_t digest[32];
+ *     int h = wm_native_crypto_hash_start(WM_NATIVE_CRYPTO_SHA256);
+ *
+ *     wm_native_crypto_update(h, data, NULL, len);
+ *     wm_native_crypto_finish(h, digest, sizeof(digest));
+ *
+ * Start functions return a handle, which is freed by finish or free. Functions return
+ * a negative errno value of the firmware if they fail.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define WM_NATIVE_CRYPTO_IMPORT(name) \
+    __attribute__((import_module("env"), import_name(#name)))
+
+#define WM_NATIVE_CRYPTO_AES_BLOCK_SIZE     16  /* AES block size, and size of AES-CTR nonce counter */
+#define WM_NATIVE_CRYPTO_GCM_TAG_MAX        16  /* Max size of AES-GCM authentication tag */
+#define WM_NATIVE_CRYPTO_DIGEST_MAX         64  /* Max size of digest */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    WM_NATIVE_CRYPTO_SHA256 = 0,    /* SHA-256, 32 bytes digest */
+    WM_NATIVE_CRYPTO_SHA512,        /* SHA-512, 64 bytes digest */
+};
+
+enum {
+    WM_NATIVE_CRYPTO_P256 = 0,      /* NIST P-256 */
+    WM_NATIVE_CRYPTO_P384,          /* NIST P-384 */
+};
+
+WM_NATIVE_CRYPTO_IMPORT(wasm_crypto_hash_start)
+int wm_native_crypto_hash_start(int alg);
+
+/* An empty key is valid */
+WM_NATIVE_CRYPTO_IMPORT(wasm_crypto_hmac_start)
+int wm_native_crypto_hmac_start(int alg, const void *key, uint32_t key_len);
+
+/* Encryption and decryption are the same, iv is WM_NATIVE_CRYPTO_AES_BLOCK_SIZE bytes */
+WM_NATIVE_CRYPTO_IMPORT(wasm_crypto_aes_ctr_start)
+int wm_native_crypto_aes_ctr_start(const void *key, uint32_t key_len, const void *iv);
+
+WM_NATIVE_CRYPTO_IMPORT(wasm_crypto_aes_gcm_start)
+int wm_native_crypto_aes_gcm_start(const void *key, uint32_t key_len, const void *iv, uint32_t iv_len,
+                                   const void *aad, uint32_t aad_len, int decrypt);
+
+/* Hashes only read in, ciphers write len bytes to out, which can be the same as in */
+WM_NATIVE_CRYPTO_IMPORT(wasm_crypto_update)
+int wm_native_crypto_update(int handle, const void *in, void *out, uint32_t len);
+
+/*
+ * Finish and free an operation. Hashes write the digest, AES-GCM encryption writes the tag
+ * truncated to out_len, AES-GCM decryption checks the tag in out and AES-CTR writes nothing.
+ * Return the length of digest or tag, a wrong tag fails with EBADMSG.
+ */
+WM_NATIVE_CRYPTO_IMPORT(wasm_crypto_finish)
+int wm_native_crypto_finish(int handle, void *out, uint32_t out_len);
+
+/* Free an operation without finishing it */
+WM_NATIVE_CRYPTO_IMPORT(wasm_crypto_free)
+int wm_native_crypto_free(int handle);
+
+/*
+ * Verify a raw r || s signature of a hash by an uncompressed 0x04 || X || Y public key,
+ * a signature which is not valid fails with EBADMSG
+ */
+WM_NATIVE_CRYPTO_IMPORT(wasm_crypto_ecdsa_verify)
+int wm_native_crypto_ecdsa_verify(int curve, const void *pubkey, uint32_t pubkey_len,
+                                  const void *hash, uint32_t hash_len, const void *sig, uint32_t sig_len);
+
+#ifdef __cplusplus
+}
+#endif
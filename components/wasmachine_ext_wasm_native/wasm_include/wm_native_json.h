@@ -0,0 +1,148 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Header of WASM applications, not of the firmware. JSON is parsed and written natively
+ * when CONFIG_WASMACHINE_WASM_EXT_NATIVE_JSON is enabled:
+ *
+ *     wm_native_json_token_t tokens[64];
+ *     wm_native_json_t doc = { .json = text, .len = len, .tokens = tokens, .max_tokens = 64 };
+ *     double value;
+ *
+ *     if (wm_native_json_parse(&doc) >= 0) {
+ *         int i = wm_native_json_find(&doc, 0, "sensors[0].value");
+ *
+ *         if (i >= 0 && !wm_native_json_get_number(&doc, i, &value)) {
+ *             ...
+ *         }
+ *     }
+ *
+ * Parsing copies no strings, a token refers to its text by offset and length, see
+ * wm_native_json_text(). Tokens must be 4-byte aligned. Functions return a negative
+ * errno value of the firmware if they fail.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define WM_NATIVE_JSON_IMPORT(name) \
+    __attribute__((import_module("env"), import_name(#name)))
+
+#define WM_NATIVE_JSON_ESCAPED  0x01    /* Token flag, string contains escape sequences */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    WM_NATIVE_JSON_OBJECT = 1,
+    WM_NATIVE_JSON_ARRAY,
+    WM_NATIVE_JSON_STRING,
+    WM_NATIVE_JSON_NUMBER,
+    WM_NATIVE_JSON_TRUE,
+    WM_NATIVE_JSON_FALSE,
+    WM_NATIVE_JSON_NULL,
+};
+
+/*
+ * Tokens are in document order, a container is followed by tokens of its children and
+ * a member of an object is a key string token followed by tokens of its value.
+ */
+typedef struct wm_native_json_token {
+    uint8_t type;                       /* Value type */
+    uint8_t flags;                      /* WM_NATIVE_JSON_ESCAPED */
+    uint16_t reserved;
+    uint32_t start;                     /* Offset of value text, strings start after the quote */
+    uint32_t len;                       /* Length of value text, strings exclude quotes */
+    uint32_t next;                      /* Index of the token after this value and its children */
+    uint32_t size;                      /* Number of members of an object or elements of an array */
+} wm_native_json_token_t;
+
+typedef struct wm_native_json {
+    const char *json;                   /* Text, it doesn't need to be NUL-terminated */
+    uint32_t len;                       /* Length of text */
+    wm_native_json_token_t *tokens;     /* Token array, len / 2 + 1 tokens are always enough */
+    uint32_t max_tokens;                /* Number of tokens in token array */
+    uint32_t count;                     /* Number of parsed tokens */
+} wm_native_json_t;
+
+/*
+ * Values need a key when they are in an object and no key otherwise. Output is not
+ * NUL-terminated, and len keeps counting when the buffer is full.
+ */
+typedef struct wm_native_json_writer {
+    char *buf;                          /* Output buffer */
+    uint32_t size;                      /* Output buffer size */
+    uint32_t len;                       /* Output length */
+    uint32_t depth;                     /* Writer state, initialized to 0 */
+    uint32_t comma;
+    uint32_t object;
+} wm_native_json_writer_t;
+
+/* Parse doc->json into doc->tokens, return number of tokens */
+WM_NATIVE_JSON_IMPORT(wasm_json_parse)
+int wm_native_json_parse(wm_native_json_t *doc);
+
+/* Find a value by path like "sensors[2].value" from token parent, return its index */
+WM_NATIVE_JSON_IMPORT(wasm_json_find)
+int wm_native_json_find(const wm_native_json_t *doc, int parent, const char *path);
+
+WM_NATIVE_JSON_IMPORT(wasm_json_get_number)
+int wm_native_json_get_number(const wm_native_json_t *doc, int index, double *value);
+
+WM_NATIVE_JSON_IMPORT(wasm_json_get_int)
+int wm_native_json_get_int(const wm_native_json_t *doc, int index, int64_t *value);
+
+/* Copy a string with escape sequences decoded like snprintf, return its full length */
+WM_NATIVE_JSON_IMPORT(wasm_json_get_string)
+int wm_native_json_get_string(const wm_native_json_t *doc, int index, char *out, uint32_t size);
+
+WM_NATIVE_JSON_IMPORT(wasm_json_write_begin)
+int wm_native_json_write_begin(wm_native_json_writer_t *writer, const char *key, int array);
+
+WM_NATIVE_JSON_IMPORT(wasm_json_write_end)
+int wm_native_json_write_end(wm_native_json_writer_t *writer);
+
+WM_NATIVE_JSON_IMPORT(wasm_json_write_string)
+int wm_native_json_write_string(wm_native_json_writer_t *writer, const char *key, const char *str, uint32_t len);
+
+WM_NATIVE_JSON_IMPORT(wasm_json_write_number)
+int wm_native_json_write_number(wm_native_json_writer_t *writer, const char *key, double value);
+
+WM_NATIVE_JSON_IMPORT(wasm_json_write_int)
+int wm_native_json_write_int(wm_native_json_writer_t *writer, const char *key, int64_t value);
+
+WM_NATIVE_JSON_IMPORT(wasm_json_write_bool)
+int wm_native_json_write_bool(wm_native_json_writer_t *writer, const char *key, int value);
+
+WM_NATIVE_JSON_IMPORT(wasm_json_write_null)
+int wm_native_json_write_null(wm_native_json_writer_t *writer, const char *key);
+
+/* Write text which is already JSON as a value */
+WM_NATIVE_JSON_IMPORT(wasm_json_write_raw)
+int wm_native_json_write_raw(wm_native_json_writer_t *writer, const char *key, const char *json, uint32_t len);
+
+/* Text of a token in the document, it's not NUL-terminated */
+static inline const char *wm_native_json_text(const wm_native_json_t *doc, int index)
+{
+    return doc->json + doc->tokens[index].start;
+}
+
+static inline void wm_native_json_writer_init(wm_native_json_writer_t *writer, char *buf, uint32_t size)
+{
+    writer->buf = buf;
+    writer->size = size;
+    writer->len = 0;
+    writer->depth = 0;
+    writer->comma = 0;
+    writer->object = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
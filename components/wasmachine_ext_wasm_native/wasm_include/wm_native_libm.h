@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Header of WASM applications, not of the firmware. Math of whole float and int16_t
+ * arrays runs natively, by esp-dsp on ESP32-S3 and ESP32-P4, when
+ * CONFIG_WASMACHINE_WASM_EXT_NATIVE_LIBMATH is enabled:
+ *
+ *     float dot;
+ *     wm_native_stat_t stat;
+ *
+ *     wm_native_vmathf(WM_NATIVE_MATH_SIN, out, angles, n);
+ *     wm_native_vdotf(a, b, n, &dot);
+ *     wm_native_vstat_s16(samples, n, &stat);
+ *
+ * Arrays are passed by address and number of elements. Functions return 0, or a negative
+ * errno value of the firmware if they fail.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define WM_NATIVE_LIBM_IMPORT(name) \
+    __attribute__((import_module("env"), import_name(#name)))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    WM_NATIVE_MATH_SIN = 0,         /* sinf */
+    WM_NATIVE_MATH_COS,             /* cosf */
+    WM_NATIVE_MATH_EXP,             /* expf */
+    WM_NATIVE_MATH_LOG,             /* logf */
+    WM_NATIVE_MATH_SQRT,            /* sqrtf */
+};
+
+typedef struct wm_native_stat {
+    float min;                      /* Minimum value, 0 if n is 0 */
+    float max;                      /* Maximum value, 0 if n is 0 */
+    float mean;                     /* Arithmetic mean, 0 if n is 0 */
+} wm_native_stat_t;
+
+/* dst = op(src) of each element, dst can be the same as src */
+WM_NATIVE_LIBM_IMPORT(wasm_vmathf)
+int wm_native_vmathf(int op, float *dst, const float *src, uint32_t n);
+
+/* dst = atan2f(y, x) of each element */
+WM_NATIVE_LIBM_IMPORT(wasm_vatan2f)
+int wm_native_vatan2f(float *dst, const float *y, const float *x, uint32_t n);
+
+/* dst = src * scale + offset of each element */
+WM_NATIVE_LIBM_IMPORT(wasm_vscalef)
+int wm_native_vscalef(float *dst, const float *src, uint32_t n, float scale, float offset);
+
+/* dst = src * scale + offset of each element, rounded to nearest and saturated */
+WM_NATIVE_LIBM_IMPORT(wasm_vscale_s16)
+int wm_native_vscale_s16(int16_t *dst, const int16_t *src, uint32_t n, float scale, float offset);
+
+WM_NATIVE_LIBM_IMPORT(wasm_vdotf)
+int wm_native_vdotf(const float *a, const float *b, uint32_t n, float *result);
+
+/* The result doesn't overflow */
+WM_NATIVE_LIBM_IMPORT(wasm_vdot_s16)
+int wm_native_vdot_s16(const int16_t *a, const int16_t *b, uint32_t n, int64_t *result);
+
+WM_NATIVE_LIBM_IMPORT(wasm_vstatf)
+int wm_native_vstatf(const float *src, uint32_t n, wm_native_stat_t *stat);
+
+WM_NATIVE_LIBM_IMPORT(wasm_vstat_s16)
+int wm_native_vstat_s16(const int16_t *src, uint32_t n, wm_native_stat_t *stat);
+
+#ifdef __cplusplus
+}
+#endif
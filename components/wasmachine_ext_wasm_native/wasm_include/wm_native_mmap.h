@@ -0,0 +1,49 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Header of WASM applications, not of the firmware. Read-only windows of files and data
+ * partitions are read through a native page cache when
+ * CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP is enabled:
+ *
+ *     int m = wm_native_mmap_open("partition:assets", 0, 0);
+ *
+ *     wm_native_mmap_read(m, offset, buf, sizeof(buf));
+ *     wm_native_mmap_close(m);
+ *
+ * Partitions must be listed in CONFIG_WASMACHINE_WASM_EXT_NATIVE_MMAP_PARTITIONS. Functions
+ * return a negative errno value of the firmware if they fail.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define WM_NATIVE_MMAP_IMPORT(name) \
+    __attribute__((import_module("env"), import_name(#name)))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Open a window of a file or of "partition:<label>", length 0 is the rest of it, return its id */
+WM_NATIVE_MMAP_IMPORT(wasm_mmap_open)
+int wm_native_mmap_open(const char *path, uint32_t offset, uint32_t length);
+
+/* Return the number of bytes read, reads at the end of the window are short */
+WM_NATIVE_MMAP_IMPORT(wasm_mmap_read)
+int wm_native_mmap_read(int id, uint32_t offset, void *buf, uint32_t len);
+
+/* Return the window size */
+WM_NATIVE_MMAP_IMPORT(wasm_mmap_size)
+int wm_native_mmap_size(int id);
+
+WM_NATIVE_MMAP_IMPORT(wasm_mmap_close)
+int wm_native_mmap_close(int id);
+
+#ifdef __cplusplus
+}
+#endif
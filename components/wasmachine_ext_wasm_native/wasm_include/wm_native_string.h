@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Header of WASM applications, not of the firmware. Include it after <string.h> in
+ * applications built by wasi-sdk, and memcpy, memmove, memset, memcmp, memchr and
+ * strlen calls of the including file run natively when
+ * CONFIG_WASMACHINE_WASM_EXT_NATIVE_STRING is enabled.
+ *
+ * Calls shorter than WM_NATIVE_STRING_MIN_SIZE bytes stay in wasi-libc, because
+ * crossing the native boundary costs more than copying a few bytes. Copies the
+ * compiler generates for structures also stay in wasi-libc.
+ *
+ * Define WM_NATIVE_STRING_NO_OVERRIDE to keep libc names and call wm_native_* directly.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#ifndef WM_NATIVE_STRING_MIN_SIZE
+#define WM_NATIVE_STRING_MIN_SIZE   32
+#endif
+
+#define WM_NATIVE_STRING_IMPORT(name) \
+    __attribute__((import_module("env"), import_name(#name)))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+WM_NATIVE_STRING_IMPORT(wasm_memcpy) void *wm_native_memcpy_import(void *dst, const void *src, size_t n);
+WM_NATIVE_STRING_IMPORT(wasm_memmove) void *wm_native_memmove_import(void *dst, const void *src, size_t n);
+WM_NATIVE_STRING_IMPORT(wasm_memset) void *wm_native_memset_import(void *dst, int c, size_t n);
+WM_NATIVE_STRING_IMPORT(wasm_memcmp) int wm_native_memcmp_import(const void *s1, const void *s2, size_t n);
+WM_NATIVE_STRING_IMPORT(wasm_memchr) void *wm_native_memchr_import(const void *s, int c, size_t n);
+WM_NATIVE_STRING_IMPORT(wasm_strlen) size_t wm_native_strlen(const char *s);
+
+static inline void *wm_native_memcpy(void *dst, const void *src, size_t n)
+{
+    return n < WM_NATIVE_STRING_MIN_SIZE ? (memcpy)(dst, src, n) : wm_native_memcpy_import(dst, src, n);
+}
+
+static inline void *wm_native_memmove(void *dst, const void *src, size_t n)
+{
+    return n < WM_NATIVE_STRING_MIN_SIZE ? (memmove)(dst, src, n) : wm_native_memmove_import(dst, src, n);
+}
+
+static inline void *wm_native_memset(void *dst, int c, size_t n)
+{
+    return n < WM_NATIVE_STRING_MIN_SIZE ? (memset)(dst, c, n) : wm_native_memset_import(dst, c, n);
+}
+
+static inline int wm_native_memcmp(const void *s1, const void *s2, size_t n)
+{
+    return n < WM_NATIVE_STRING_MIN_SIZE ? (memcmp)(s1, s2, n) : wm_native_memcmp_import(s1, s2, n);
+}
+
+static inline void *wm_native_memchr(const void *s, int c, size_t n)
+{
+    return n < WM_NATIVE_STRING_MIN_SIZE ? (memchr)(s, c, n) : wm_native_memchr_import(s, c, n);
+}
+
+#ifndef WM_NATIVE_STRING_NO_OVERRIDE
+#define memcpy(dst, src, n)     wm_native_memcpy(dst, src, n)
+#define memmove(dst, src, n)    wm_native_memmove(dst, src, n)
+#define memset(dst, c, n)       wm_native_memset(dst, c, n)
+#define memcmp(s1, s2, n)       wm_native_memcmp(s1, s2, n)
+#define memchr(s, c, n)         wm_native_memchr(s, c, n)
+#define strlen(s)               wm_native_strlen(s)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
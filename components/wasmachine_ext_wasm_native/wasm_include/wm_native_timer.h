@@ -0,0 +1,71 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Header of WASM applications, not of the firmware. A microsecond monotonic clock and
+ * high-resolution timers are native when CONFIG_WASMACHINE_WASM_EXT_NATIVE_TIMER is enabled:
+ *
+ *     int64_t start = wm_native_clock_us();
+ *     ...
+ *     printf("took %lld us\n", wm_native_clock_us() - start);
+ *
+ * Timers need the application manager. Their expirations are posted to the message queue
+ * of the module and handled in the thread of the application, by a function which it
+ * exports:
+ *
+ *     WM_NATIVE_TIMER_DISPATCH void on_hrtimer_dispatch(int id, uint32_t expirations)
+ *     {
+ *         ...
+ *     }
+ *
+ * expirations is more than 1 if a periodic timer expired again before the last
+ * expiration was handled. Functions return a negative errno value of the firmware if
+ * they fail.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define WM_NATIVE_TIMER_IMPORT(name) \
+    __attribute__((import_module("env"), import_name(#name)))
+
+#define WM_NATIVE_TIMER_DISPATCH \
+    __attribute__((export_name("on_hrtimer_dispatch")))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Monotonic time in microseconds */
+WM_NATIVE_TIMER_IMPORT(wasm_clock_monotonic_us)
+int64_t wm_native_clock_us(void);
+
+/*
+ * Return when the clock reaches deadline_us, sleeping while it's more than one RTOS tick
+ * away and spinning for the rest, and return by how many microseconds it was passed
+ */
+WM_NATIVE_TIMER_IMPORT(wasm_clock_delay_until)
+int64_t wm_native_clock_delay_until(int64_t deadline_us);
+
+/* Create a stopped timer, return its id */
+WM_NATIVE_TIMER_IMPORT(wasm_hrtimer_create)
+int wm_native_timer_create(void);
+
+/* Start or restart a timer which expires after period_us, and then every period_us if periodic */
+WM_NATIVE_TIMER_IMPORT(wasm_hrtimer_start)
+int wm_native_timer_start(int id, int64_t period_us, int periodic);
+
+/* Stop a timer, expirations which are not handled yet are dropped */
+WM_NATIVE_TIMER_IMPORT(wasm_hrtimer_stop)
+int wm_native_timer_stop(int id);
+
+WM_NATIVE_TIMER_IMPORT(wasm_hrtimer_destroy)
+int wm_native_timer_destroy(int id);
+
+#ifdef __cplusplus
+}
+#endif
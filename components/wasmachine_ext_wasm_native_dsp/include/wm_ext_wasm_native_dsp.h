@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WM_EXT_WASM_NATIVE_DSP_BIQUAD_COEFS     5   /*!< b0, b1, b2, a1 and a2 of a biquad section */
+#define WM_EXT_WASM_NATIVE_DSP_BIQUAD_STATES    2   /*!< Delay elements of a biquad section */
+
+/**
+ * @brief Window functions.
+ */
+typedef enum wm_ext_wasm_native_dsp_window {
+    WM_EXT_WASM_NATIVE_DSP_WINDOW_HANN = 0,     /*!< Hann window */
+    WM_EXT_WASM_NATIVE_DSP_WINDOW_HAMMING,      /*!< Hamming window */
+    WM_EXT_WASM_NATIVE_DSP_WINDOW_BLACKMAN,     /*!< Blackman window */
+    WM_EXT_WASM_NATIVE_DSP_WINDOW_MAX
+} wm_ext_wasm_native_dsp_window_t;
+
+/**
+  * @brief  In-place FFT of complex data, output is in natural order.
+  *
+  * @param  data interleaved real and imaginary parts, 2 * n floats
+  * @param  n number of complex points, it must be a power of 2 and not larger
+  *           than CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP_FFT_MAX
+  *
+  * @return ESP_OK if success or ESP_ERR_INVALID_ARG if n is not supported.
+  */
+esp_err_t wm_ext_wasm_native_dsp_fft(float *data, uint32_t n);
+
+/**
+  * @brief  In-place inverse FFT of complex data, output is scaled by 1 / n.
+  *
+  * @param  data interleaved real and imaginary parts, 2 * n floats
+  * @param  n number of complex points, see wm_ext_wasm_native_dsp_fft
+  *
+  * @return ESP_OK if success or ESP_ERR_INVALID_ARG if n is not supported.
+  */
+esp_err_t wm_ext_wasm_native_dsp_ifft(float *data, uint32_t n);
+
+/**
+  * @brief  Multiply real data by a window in place.
+  *
+  * @param  window window function
+  * @param  data real data
+  * @param  n number of points
+  *
+  * @return ESP_OK if success or ESP_ERR_INVALID_ARG if window is not supported.
+  */
+esp_err_t wm_ext_wasm_native_dsp_window(wm_ext_wasm_native_dsp_window_t window, float *data, uint32_t n);
+
+/**
+  * @brief  FIR filter a block of samples, the delay line keeps the last taps - 1 input
+  *         samples so a stream can be filtered block by block.
+  *
+  * @param  coefs filter coefficients
+  * @param  taps number of coefficients
+  * @param  delay delay line of taps - 1 samples, oldest first, zeroed before the first block
+  * @param  src input samples
+  * @param  dst output samples, it must not overlap src
+  * @param  n number of samples
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_dsp_fir(const float *coefs, uint32_t taps, float *delay,
+                                const float *src, float *dst, uint32_t n);
+
+/**
+  * @brief  Filter a block of samples by cascaded biquad sections in direct form II.
+  *
+  * @param  coefs WM_EXT_WASM_NATIVE_DSP_BIQUAD_COEFS coefficients of each section, a0 is 1
+  * @param  states WM_EXT_WASM_NATIVE_DSP_BIQUAD_STATES delay elements of each section,
+  *                zeroed before the first block
+  * @param  sections number of sections
+  * @param  src input samples
+  * @param  dst output samples, it can be the same as src
+  * @param  n number of samples
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_dsp_biquad(const float *coefs, float *states, uint32_t sections,
+                                   const float *src, float *dst, uint32_t n);
+
+/**
+  * @brief  Full convolution of a signal and a kernel.
+  *
+  * @param  sig signal
+  * @param  sig_len number of signal samples
+  * @param  kernel kernel
+  * @param  kernel_len number of kernel samples
+  * @param  out sig_len + kernel_len - 1 output samples, it must not overlap inputs
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_dsp_conv(const float *sig, uint32_t sig_len, const float *kernel, uint32_t kernel_len,
+                                 float *out);
+
+/**
+  * @brief  Multiply row-major matrices, C[m][k] = A[m][n] * B[n][k].
+  *
+  * @param  a matrix A
+  * @param  b matrix B
+  * @param  c matrix C, it must not overlap A or B
+  * @param  m rows of A
+  * @param  n columns of A and rows of B
+  * @param  k columns of B
+  *
+  * @return None.
+  */
+void wm_ext_wasm_native_dsp_matmul(const float *a, const float *b, float *c, uint32_t m, uint32_t n, uint32_t k);
+
+#ifdef __cplusplus
+}
+#endif
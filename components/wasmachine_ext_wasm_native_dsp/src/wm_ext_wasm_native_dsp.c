@@ -0,0 +1,504 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <inttypes.h>
+#include <math.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP_ESP_DSP
+#include "esp_dsp.h"
+#endif
+
+#include "bh_platform.h"
+#include "wasm_export.h"
+#include "wasm_native.h"
+#include "wasm_runtime_common.h"
+
+#include "wm_ext_wasm_native_macro.h"
+#include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_dsp.h"
+#include "wm_ext_wasm_native_trace.h"
+
+#define DSP_FFT_MAX             CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP_FFT_MAX
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP_ESP_DSP
+/* SIMD kernels of esp-dsp load 16 bytes at a time on ESP32-S3 and ESP32-P4 */
+#define DSP_ESP_DSP_ALIGN       16
+
+static const char *TAG = "wm_dsp";
+
+/* esp-dsp keeps one twiddle table, a table of N points serves all FFTs of N points or less */
+static pthread_rwlock_t s_fft_lock = PTHREAD_RWLOCK_INITIALIZER;
+static uint32_t s_fft_table_size;
+
+static void dsp_fft_table_grow(uint32_t n)
+{
+    esp_err_t ret;
+
+    pthread_rwlock_wrlock(&s_fft_lock);
+    if (n > s_fft_table_size) {
+        dsps_fft2r_deinit_fc32();
+        ret = dsps_fft2r_init_fc32(NULL, n);
+        if (ret == ESP_OK) {
+            s_fft_table_size = n;
+        } else {
+            ESP_LOGW(TAG, "failed to initialize FFT table of %" PRIu32 " points ret=%d", n, ret);
+            s_fft_table_size = 0;
+        }
+    }
+    pthread_rwlock_unlock(&s_fft_lock);
+}
+
+static bool dsp_fft_esp_dsp(float *data, uint32_t n)
+{
+    bool done = false;
+
+    pthread_rwlock_rdlock(&s_fft_lock);
+    if (n > s_fft_table_size) {
+        pthread_rwlock_unlock(&s_fft_lock);
+        dsp_fft_table_grow(n);
+        pthread_rwlock_rdlock(&s_fft_lock);
+    }
+
+    if (n <= s_fft_table_size) {
+        dsps_fft2r_fc32(data, n);
+        dsps_bit_rev_fc32(data, n);
+        done = true;
+    }
+    pthread_rwlock_unlock(&s_fft_lock);
+
+    return done;
+}
+#endif
+
+static void dsp_fft(float *data, uint32_t n)
+{
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP_ESP_DSP
+    /* The twiddle table is allocated by the first FFT which needs it, C loops run if it fails */
+    if (!((uintptr_t)data % DSP_ESP_DSP_ALIGN) && dsp_fft_esp_dsp(data, n)) {
+        return;
+    }
+#endif
+
+    /* Bit reversal permutation, then radix-2 butterflies in place */
+    for (uint32_t i = 1, j = 0; i < n; i++) {
+        uint32_t bit = n >> 1;
+
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+
+        if (i < j) {
+            float re = data[2 * i];
+            float im = data[2 * i + 1];
+
+            data[2 * i] = data[2 * j];
+            data[2 * i + 1] = data[2 * j + 1];
+            data[2 * j] = re;
+            data[2 * j + 1] = im;
+        }
+    }
+
+    for (uint32_t len = 2; len <= n; len <<= 1) {
+        uint32_t half = len / 2;
+        double step_re = cos(-2 * M_PI / len);
+        double step_im = sin(-2 * M_PI / len);
+        double w_re = 1;
+        double w_im = 0;
+
+        for (uint32_t k = 0; k < half; k++) {
+            float wr = (float)w_re;
+            float wi = (float)w_im;
+            double t;
+
+            for (uint32_t i = k; i < n; i += len) {
+                float *a = &data[2 * i];
+                float *b = &data[2 * (i + half)];
+                float tr = b[0] * wr - b[1] * wi;
+                float ti = b[0] * wi + b[1] * wr;
+
+                b[0] = a[0] - tr;
+                b[1] = a[1] - ti;
+                a[0] += tr;
+                a[1] += ti;
+            }
+
+            /* Twiddles are rotated in double, so errors don't build up over large sizes */
+            t = w_re * step_re - w_im * step_im;
+            w_im = w_re * step_im + w_im * step_re;
+            w_re = t;
+        }
+    }
+}
+
+static bool dsp_fft_size_is_valid(uint32_t n)
+{
+    return n >= 2 && n <= DSP_FFT_MAX && !(n & (n - 1));
+}
+
+esp_err_t wm_ext_wasm_native_dsp_fft(float *data, uint32_t n)
+{
+    if (!dsp_fft_size_is_valid(n)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    dsp_fft(data, n);
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_dsp_ifft(float *data, uint32_t n)
+{
+    float scale = 1.0f / n;
+
+    if (!dsp_fft_size_is_valid(n)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* ifft(x) = conj(fft(conj(x))) / n */
+    for (uint32_t i = 0; i < n; i++) {
+        data[2 * i + 1] = -data[2 * i + 1];
+    }
+
+    dsp_fft(data, n);
+
+    for (uint32_t i = 0; i < n; i++) {
+        data[2 * i] *= scale;
+        data[2 * i + 1] *= -scale;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t wm_ext_wasm_native_dsp_window(wm_ext_wasm_native_dsp_window_t window, float *data, uint32_t n)
+{
+    float step = n > 1 ? 2 * (float)M_PI / (n - 1) : 0;
+
+    if (window >= WM_EXT_WASM_NATIVE_DSP_WINDOW_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (uint32_t i = 0; i < n; i++) {
+        float c = cosf(step * i);
+
+        switch (window) {
+        case WM_EXT_WASM_NATIVE_DSP_WINDOW_HANN:
+            data[i] *= 0.5f - 0.5f * c;
+            break;
+        case WM_EXT_WASM_NATIVE_DSP_WINDOW_HAMMING:
+            data[i] *= 0.54f - 0.46f * c;
+            break;
+        default:
+            data[i] *= 0.42f - 0.5f * c + 0.08f * cosf(2 * step * i);
+            break;
+        }
+    }
+
+    return ESP_OK;
+}
+
+void wm_ext_wasm_native_dsp_fir(const float *coefs, uint32_t taps, float *delay,
+                                const float *src, float *dst, uint32_t n)
+{
+    uint32_t hist = taps ? taps - 1 : 0;
+
+    for (uint32_t i = 0; i < n; i++) {
+        float acc = 0;
+
+        for (uint32_t k = 0; k < taps; k++) {
+            acc += coefs[k] * (i >= k ? src[i - k] : delay[hist + i - k]);
+        }
+
+        dst[i] = acc;
+    }
+
+    /* Keep the last taps - 1 input samples for the next block */
+    if (n >= hist) {
+        memcpy(delay, src + n - hist, hist * sizeof(float));
+    } else {
+        memmove(delay, delay + n, (hist - n) * sizeof(float));
+        memcpy(delay + hist - n, src, n * sizeof(float));
+    }
+}
+
+void wm_ext_wasm_native_dsp_biquad(const float *coefs, float *states, uint32_t sections,
+                                   const float *src, float *dst, uint32_t n)
+{
+    for (uint32_t s = 0; s < sections; s++) {
+        const float *c = &coefs[s * WM_EXT_WASM_NATIVE_DSP_BIQUAD_COEFS];
+        float *w = &states[s * WM_EXT_WASM_NATIVE_DSP_BIQUAD_STATES];
+        const float *in = s ? dst : src;
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP_ESP_DSP
+        dsps_biquad_f32(in, dst, n, (float *)c, w);
+#else
+        for (uint32_t i = 0; i < n; i++) {
+            float d = in[i] - c[3] * w[0] - c[4] * w[1];
+
+            dst[i] = c[0] * d + c[1] * w[0] + c[2] * w[1];
+            w[1] = w[0];
+            w[0] = d;
+        }
+#endif
+    }
+
+    if (!sections && dst != src) {
+        memmove(dst, src, n * sizeof(float));
+    }
+}
+
+void wm_ext_wasm_native_dsp_conv(const float *sig, uint32_t sig_len, const float *kernel, uint32_t kernel_len,
+                                 float *out)
+{
+    if (!sig_len || !kernel_len) {
+        return;
+    }
+
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP_ESP_DSP
+    dsps_conv_f32(sig, sig_len, kernel, kernel_len, out);
+#else
+    for (uint32_t i = 0; i < sig_len + kernel_len - 1; i++) {
+        uint32_t k_min = i >= sig_len - 1 ? i - (sig_len - 1) : 0;
+        uint32_t k_max = i < kernel_len - 1 ? i : kernel_len - 1;
+        float acc = 0;
+
+        for (uint32_t k = k_min; k <= k_max; k++) {
+            acc += sig[i - k] * kernel[k];
+        }
+
+        out[i] = acc;
+    }
+#endif
+}
+
+void wm_ext_wasm_native_dsp_matmul(const float *a, const float *b, float *c, uint32_t m, uint32_t n, uint32_t k)
+{
+#ifdef CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP_ESP_DSP
+    dspm_mult_f32(a, b, c, m, n, k);
+#else
+    for (uint32_t i = 0; i < m; i++) {
+        float *row = &c[i * k];
+
+        memset(row, 0, k * sizeof(float));
+
+        /* Walk B row by row, so all accesses are sequential */
+        for (uint32_t p = 0; p < n; p++) {
+            float v = a[i * n + p];
+
+            for (uint32_t j = 0; j < k; j++) {
+                row[j] += v * b[p * k + j];
+            }
+        }
+    }
+#endif
+}
+
+/*
+ * Buffers are passed by address and number of floats, so check the whole buffer is in linear memory.
+ * Natives return 0 or negative errno, because DSP natives don't depend on libc natives.
+ */
+static float *wasm_dsp_map(wasm_module_inst_t module_inst, uint32_t addr, uint64_t n)
+{
+    uint64_t bytes = n * sizeof(float);
+
+    if (bytes > UINT32_MAX || !validate_app_addr(addr, bytes)) {
+        return NULL;
+    }
+
+    return addr_app_to_native(addr);
+}
+
+static bool wasm_dsp_overlap(uint32_t a, uint64_t a_n, uint32_t b, uint64_t b_n)
+{
+    return a_n && b_n && a < b + b_n * sizeof(float) && b < a + a_n * sizeof(float);
+}
+
+static int wasm_dsp_fft_wrapper(wasm_exec_env_t exec_env, uint32_t data, uint32_t n)
+{
+    int ret;
+    float *data_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    data_ptr = wasm_dsp_map(module_inst, data, 2 * (uint64_t)n);
+    if (!data_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_dsp_fft", 0, data, n);
+    ret = wm_ext_wasm_native_dsp_fft(data_ptr, n) == ESP_OK ? 0 : -EINVAL;
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static int wasm_dsp_ifft_wrapper(wasm_exec_env_t exec_env, uint32_t data, uint32_t n)
+{
+    int ret;
+    float *data_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    data_ptr = wasm_dsp_map(module_inst, data, 2 * (uint64_t)n);
+    if (!data_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_dsp_ifft", 0, data, n);
+    ret = wm_ext_wasm_native_dsp_ifft(data_ptr, n) == ESP_OK ? 0 : -EINVAL;
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static int wasm_dsp_window_wrapper(wasm_exec_env_t exec_env, int window, uint32_t data, uint32_t n)
+{
+    int ret;
+    float *data_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    data_ptr = wasm_dsp_map(module_inst, data, n);
+    if (!data_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_dsp_window", 0, window, data, n);
+    ret = wm_ext_wasm_native_dsp_window(window, data_ptr, n) == ESP_OK ? 0 : -EINVAL;
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
+}
+
+static int wasm_dsp_fir_wrapper(wasm_exec_env_t exec_env, uint32_t coefs, uint32_t taps, uint32_t delay,
+                                uint32_t src, uint32_t dst, uint32_t n)
+{
+    float *coefs_ptr, *delay_ptr, *src_ptr, *dst_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!taps || wasm_dsp_overlap(src, n, dst, n)) {
+        return -EINVAL;
+    }
+
+    coefs_ptr = wasm_dsp_map(module_inst, coefs, taps);
+    delay_ptr = wasm_dsp_map(module_inst, delay, taps - 1);
+    src_ptr = wasm_dsp_map(module_inst, src, n);
+    dst_ptr = wasm_dsp_map(module_inst, dst, n);
+    if (!coefs_ptr || !delay_ptr || !src_ptr || !dst_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_dsp_fir", 0, coefs, taps, delay, src, dst, n);
+    wm_ext_wasm_native_dsp_fir(coefs_ptr, taps, delay_ptr, src_ptr, dst_ptr, n);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
+}
+
+static int wasm_dsp_biquad_wrapper(wasm_exec_env_t exec_env, uint32_t coefs, uint32_t states, uint32_t sections,
+                                   uint32_t src, uint32_t dst, uint32_t n)
+{
+    float *coefs_ptr, *states_ptr, *src_ptr, *dst_ptr;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (src != dst && wasm_dsp_overlap(src, n, dst, n)) {
+        return -EINVAL;
+    }
+
+    coefs_ptr = wasm_dsp_map(module_inst, coefs, (uint64_t)sections * WM_EXT_WASM_NATIVE_DSP_BIQUAD_COEFS);
+    states_ptr = wasm_dsp_map(module_inst, states, (uint64_t)sections * WM_EXT_WASM_NATIVE_DSP_BIQUAD_STATES);
+    src_ptr = wasm_dsp_map(module_inst, src, n);
+    dst_ptr = wasm_dsp_map(module_inst, dst, n);
+    if (!coefs_ptr || !states_ptr || !src_ptr || !dst_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_dsp_biquad", 0, coefs, states, sections, src, dst, n);
+    wm_ext_wasm_native_dsp_biquad(coefs_ptr, states_ptr, sections, src_ptr, dst_ptr, n);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
+}
+
+static int wasm_dsp_conv_wrapper(wasm_exec_env_t exec_env, uint32_t sig, uint32_t sig_len,
+                                 uint32_t kernel, uint32_t kernel_len, uint32_t out)
+{
+    float *sig_ptr, *kernel_ptr, *out_ptr;
+    uint64_t out_len = sig_len && kernel_len ? (uint64_t)sig_len + kernel_len - 1 : 0;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (wasm_dsp_overlap(out, out_len, sig, sig_len) || wasm_dsp_overlap(out, out_len, kernel, kernel_len)) {
+        return -EINVAL;
+    }
+
+    sig_ptr = wasm_dsp_map(module_inst, sig, sig_len);
+    kernel_ptr = wasm_dsp_map(module_inst, kernel, kernel_len);
+    out_ptr = wasm_dsp_map(module_inst, out, out_len);
+    if (!sig_ptr || !kernel_ptr || !out_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_dsp_conv", 0, sig, sig_len, kernel, kernel_len, out);
+    wm_ext_wasm_native_dsp_conv(sig_ptr, sig_len, kernel_ptr, kernel_len, out_ptr);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
+}
+
+static int wasm_dsp_matmul_wrapper(wasm_exec_env_t exec_env, uint32_t a, uint32_t b, uint32_t c,
+                                   uint32_t m, uint32_t n, uint32_t k)
+{
+    float *a_ptr, *b_ptr, *c_ptr;
+    uint64_t a_n = (uint64_t)m * n;
+    uint64_t b_n = (uint64_t)n * k;
+    uint64_t c_n = (uint64_t)m * k;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (wasm_dsp_overlap(c, c_n, a, a_n) || wasm_dsp_overlap(c, c_n, b, b_n)) {
+        return -EINVAL;
+    }
+
+    a_ptr = wasm_dsp_map(module_inst, a, a_n);
+    b_ptr = wasm_dsp_map(module_inst, b, b_n);
+    c_ptr = wasm_dsp_map(module_inst, c, c_n);
+    if (!a_ptr || !b_ptr || !c_ptr) {
+        return -EFAULT;
+    }
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_dsp_matmul", 0, a, b, c, m, n, k);
+    wm_ext_wasm_native_dsp_matmul(a_ptr, b_ptr, c_ptr, m, n, k);
+    WM_EXT_WASM_NATIVE_TRACE_END(0);
+
+    return 0;
+}
+
+static NativeSymbol wm_dsp_wrapper_native_symbol[] = {
+    REG_NATIVE_FUNC(wasm_dsp_fft,       "(ii)i"),
+    REG_NATIVE_FUNC(wasm_dsp_ifft,      "(ii)i"),
+    REG_NATIVE_FUNC(wasm_dsp_window,    "(iii)i"),
+    REG_NATIVE_FUNC(wasm_dsp_fir,       "(iiiiii)i"),
+    REG_NATIVE_FUNC(wasm_dsp_biquad,    "(iiiiii)i"),
+    REG_NATIVE_FUNC(wasm_dsp_conv,      "(iiiii)i"),
+    REG_NATIVE_FUNC(wasm_dsp_matmul,    "(iiiiii)i"),
+};
+
+int wm_ext_wasm_native_dsp_export(void)
+{
+    NativeSymbol *sym = (NativeSymbol *)wm_dsp_wrapper_native_symbol;
+    int num = sizeof(wm_dsp_wrapper_native_symbol) / sizeof(wm_dsp_wrapper_native_symbol[0]);
+
+    if (!wasm_native_register_natives("env", sym,  num)) {
+        return -1;
+    }
+
+    return 0;
+}
+
+WM_EXT_WASM_NATIVE_EXPORT_FN(wm_ext_wasm_native_dsp_export)
+{
+    return wm_ext_wasm_native_dsp_export();
+}
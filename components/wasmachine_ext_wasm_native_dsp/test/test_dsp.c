@@ -0,0 +1,125 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <math.h>
+#include <string.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP
+
+#include "wm_ext_wasm_native_dsp.h"
+
+#define TEST_EPSILON    1e-4f
+
+/* Buffers are aligned like WASM applications usually do, so esp-dsp kernels are used if enabled */
+static float s_data[2 * 64] __attribute__((aligned(16)));
+
+static void test_assert_floats(const float *expected, const float *actual, int num)
+{
+    for (int i = 0; i < num; i++) {
+        TEST_ASSERT_FLOAT_WITHIN(TEST_EPSILON * fmaxf(1, fabsf(expected[i])), expected[i], actual[i]);
+    }
+}
+
+TEST_CASE("DSP FFT golden vectors", "[dsp]")
+{
+    const float input[] = { 1, 0, 2, 0, 3, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+    const float golden[] = {
+        10, 0, -0.414214f, -7.242641f, -2, 2, 2.414214f, -1.242641f,
+        -2, 0, 2.414214f, 1.242641f, -2, -2, -0.414214f, 7.242641f,
+    };
+
+    memcpy(s_data, input, sizeof(input));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_dsp_fft(s_data, 8));
+    test_assert_floats(golden, s_data, 16);
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_dsp_ifft(s_data, 8));
+    test_assert_floats(input, s_data, 16);
+
+    /* Single tone of bin 5 */
+    for (int i = 0; i < 64; i++) {
+        s_data[2 * i] = cosf(2 * (float)M_PI * 5 * i / 64);
+        s_data[2 * i + 1] = 0;
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_dsp_fft(s_data, 64));
+    for (int i = 0; i < 64; i++) {
+        float mag = hypotf(s_data[2 * i], s_data[2 * i + 1]);
+
+        TEST_ASSERT_FLOAT_WITHIN(1e-3f, i == 5 || i == 59 ? 32 : 0, mag);
+    }
+
+    /* Smaller FFTs run again after a larger one */
+    memcpy(s_data, input, sizeof(input));
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_dsp_fft(s_data, 8));
+    test_assert_floats(golden, s_data, 16);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_dsp_fft(s_data, 48));
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_dsp_ifft(s_data, 1));
+}
+
+TEST_CASE("DSP window golden vectors", "[dsp]")
+{
+    const float hann[] = { 0, 0.345492f, 0.904508f, 0.904508f, 0.345492f, 0 };
+    const float hamming[] = { 0.08f, 0.397852f, 0.912148f, 0.912148f, 0.397852f, 0.08f };
+
+    for (int i = 0; i < 6; i++) {
+        s_data[i] = 1;
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_dsp_window(WM_EXT_WASM_NATIVE_DSP_WINDOW_HANN, s_data, 6));
+    test_assert_floats(hann, s_data, 6);
+
+    for (int i = 0; i < 6; i++) {
+        s_data[i] = 1;
+    }
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_native_dsp_window(WM_EXT_WASM_NATIVE_DSP_WINDOW_HAMMING, s_data, 6));
+    test_assert_floats(hamming, s_data, 6);
+
+    TEST_ASSERT_EQUAL(ESP_ERR_INVALID_ARG, wm_ext_wasm_native_dsp_window(WM_EXT_WASM_NATIVE_DSP_WINDOW_MAX, s_data, 6));
+}
+
+TEST_CASE("DSP filters golden vectors", "[dsp]")
+{
+    const float fir_coefs[] = { 0.5f, 0.25f, 0.25f };
+    const float fir_input[] = { 4, 8, 0, -4, 12 };
+    const float fir_golden[] = { 2, 5, 3, 0, 5 };
+    const float biquad_coefs[] = { 0.2f, 0.4f, 0.2f, -0.5f, 0.25f };
+    const float biquad_golden[] = { 0.2f, 0.5f, 0.4f, 0.075f, -0.0625f, -0.05f };
+    float delay[2] = { 0 };
+    float states[2] = { 0 };
+    float out[5];
+
+    /* Filter a stream in blocks of 2, 1 and 2 samples */
+    wm_ext_wasm_native_dsp_fir(fir_coefs, 3, delay, fir_input, out, 2);
+    wm_ext_wasm_native_dsp_fir(fir_coefs, 3, delay, fir_input + 2, out + 2, 1);
+    wm_ext_wasm_native_dsp_fir(fir_coefs, 3, delay, fir_input + 3, out + 3, 2);
+    test_assert_floats(fir_golden, out, 5);
+
+    /* Impulse response, filtered in place */
+    memset(s_data, 0, 6 * sizeof(float));
+    s_data[0] = 1;
+    wm_ext_wasm_native_dsp_biquad(biquad_coefs, states, 1, s_data, s_data, 6);
+    test_assert_floats(biquad_golden, s_data, 6);
+}
+
+TEST_CASE("DSP convolution and matrix golden vectors", "[dsp]")
+{
+    const float sig[] = { 1, 2, 3 };
+    const float kernel[] = { 1, -1 };
+    const float conv_golden[] = { 1, 1, 1, -3 };
+    const float a[] = { 1, 2, 3, 4, 5, 6 };
+    const float b[] = { 7, 8, 9, 10, 11, 12 };
+    const float matmul_golden[] = { 58, 64, 139, 154 };
+    float out[4];
+
+    wm_ext_wasm_native_dsp_conv(sig, 3, kernel, 2, out);
+    test_assert_floats(conv_golden, out, 4);
+
+    wm_ext_wasm_native_dsp_matmul(a, b, out, 2, 3, 2);
+    test_assert_floats(matmul_golden, out, 4);
+}
+
+#endif
@@ -0,0 +1,82 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Header of WASM applications, not of the firmware. FFT, windows, filters, convolution
+ * and matrix multiplication of float buffers run natively, by esp-dsp on ESP32-S3 and
+ * ESP32-P4, when CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP is enabled:
+ *
+ *     float data[2 * 256];    // re/im pairs
+ *
+ *     wm_native_dsp_fft(data, 256);
+ *
+ * Buffers are passed by address and number of elements. Functions return 0, or a negative
+ * errno value of the firmware if they fail.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define WM_NATIVE_DSP_IMPORT(name) \
+    __attribute__((import_module("env"), import_name(#name)))
+
+#define WM_NATIVE_DSP_BIQUAD_COEFS      5   /* b0, b1, b2, a1 and a2 of a biquad section */
+#define WM_NATIVE_DSP_BIQUAD_STATES     2   /* Delay elements of a biquad section */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum {
+    WM_NATIVE_DSP_WINDOW_HANN = 0,  /* Hann window */
+    WM_NATIVE_DSP_WINDOW_HAMMING,   /* Hamming window */
+    WM_NATIVE_DSP_WINDOW_BLACKMAN,  /* Blackman window */
+};
+
+/*
+ * In-place FFT of n complex points, output is in natural order, n is a power of 2 and not
+ * larger than CONFIG_WASMACHINE_WASM_EXT_NATIVE_DSP_FFT_MAX
+ */
+WM_NATIVE_DSP_IMPORT(wasm_dsp_fft)
+int wm_native_dsp_fft(float *data, uint32_t n);
+
+/* In-place inverse FFT, output is scaled by 1 / n */
+WM_NATIVE_DSP_IMPORT(wasm_dsp_ifft)
+int wm_native_dsp_ifft(float *data, uint32_t n);
+
+/* Multiply real data by a window in place */
+WM_NATIVE_DSP_IMPORT(wasm_dsp_window)
+int wm_native_dsp_window(int window, float *data, uint32_t n);
+
+/*
+ * FIR filter a block of samples, delay keeps the last taps - 1 input samples and is zeroed
+ * before the first block, dst must not overlap src
+ */
+WM_NATIVE_DSP_IMPORT(wasm_dsp_fir)
+int wm_native_dsp_fir(const float *coefs, uint32_t taps, float *delay,
+                      const float *src, float *dst, uint32_t n);
+
+/*
+ * Filter a block of samples by cascaded biquad sections in direct form II, states are
+ * zeroed before the first block, dst can be the same as src
+ */
+WM_NATIVE_DSP_IMPORT(wasm_dsp_biquad)
+int wm_native_dsp_biquad(const float *coefs, float *states, uint32_t sections,
+                         const float *src, float *dst, uint32_t n);
+
+/* Full convolution into sig_len + kernel_len - 1 samples, out must not overlap inputs */
+WM_NATIVE_DSP_IMPORT(wasm_dsp_conv)
+int wm_native_dsp_conv(const float *sig, uint32_t sig_len,
+                       const float *kernel, uint32_t kernel_len, float *out);
+
+/* Multiply row-major matrices, c[m][k] = a[m][n] * b[n][k], c must not overlap a or b */
+WM_NATIVE_DSP_IMPORT(wasm_dsp_matmul)
+int wm_native_dsp_matmul(const float *a, const float *b, float *c, uint32_t m, uint32_t n, uint32_t k);
+
+#ifdef __cplusplus
+}
+#endif
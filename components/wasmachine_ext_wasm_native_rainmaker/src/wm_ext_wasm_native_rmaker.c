@@ -1,12 +1,11 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <inttypes.h>
 
-#include "esp_memory_utils.h"
 #include "esp_log.h"
 
 #include "bh_platform.h"
@@ -16,6 +15,8 @@
 
 #include "wm_ext_wasm_native_macro.h"
 #include "wm_ext_wasm_native_export.h"
+#include "wm_ext_wasm_native_common.h"
+#include "wm_ext_wasm_native_trace.h"
 
 #include <esp_rmaker_core.h>
 #include <esp_rmaker_standard_params.h>
@@ -112,15 +113,17 @@
 #define rmaker_native_return_type(type)       type *rmaker_ret = (type *)(args_ret)
 #define rmaker_native_get_arg(type, name)     type name = *((type *)(args++))
 
-#define DEFINE_RMAKER_NATIVE_WRAPPER(func_name)                   \
-    static int func_name ## _wrapper(wasm_exec_env_t exec_env, \
-                                      uint32_t *args,           \
-                                      uint32_t *args_ret)
+#define DEFINE_RMAKER_NATIVE_WRAPPER(func_name)                     \
+    static int func_name ## _wrapper(wasm_exec_env_t exec_env,      \
+                                     wm_ext_wasm_native_mem_t *mem, \
+                                     uint32_t *args,                \
+                                     uint32_t *args_ret)
 
 #define RMAKER_NATIVE_WRAPPER(id, func_name, argc)                \
     [id] = { func_name ## _wrapper, argc }
 
-typedef int (*rmaker_func_t)(wasm_exec_env_t exec_env, uint32_t *args, uint32_t *args_ret);
+typedef int (*rmaker_func_t)(wasm_exec_env_t exec_env, wm_ext_wasm_native_mem_t *mem,
+                             uint32_t *args, uint32_t *args_ret);
 
 typedef struct rmaker_func_desc {
     rmaker_func_t   func;
@@ -128,7 +131,7 @@ typedef struct rmaker_func_desc {
 } rmaker_func_desc_t;
 
 typedef struct __rmaker_wrapper_ctx_t {
-    wasm_exec_env_t exec_env;
+    wasm_module_inst_t module_inst;
     uint32_t        scheme_cb;
     uint32_t        write_cb;
     uint32_t        read_cb;
@@ -139,43 +142,9 @@ static const char *TAG = "rmaker_wrapper";
 
 #define CONFIG_RMAKER_HEAP_SIZE 16384
 
-static bool ptr_is_in_ram_or_rom(const void *ptr)
+static bool rmaker_run_wasm(wasm_module_inst_t module_inst, uint32_t cb, int argc, uint32_t *argv)
 {
-    bool ret = false;
-
-    if (esp_ptr_in_dram(ptr)) {
-        ret = true;
-    } else if (esp_ptr_in_drom(ptr)) {
-        ret = true;
-    } else if (esp_ptr_external_ram(ptr)) {
-        ret = true;
-    }
-
-    return ret;
-}
-
-static char *map_string(wasm_exec_env_t exec_env, const char *str)
-{
-    void *ptr;
-    wasm_module_inst_t module_inst = get_module_inst(exec_env);
-
-    if (ptr_is_in_ram_or_rom(str)) {
-        return (void *)str;
-    }
-
-    ptr = (char *)addr_app_to_native((uint32_t)str);
-    if (!ptr) {
-        ESP_LOGE(TAG, "failed to map app_addr=%p", str);
-    } else {
-        str = ptr;
-    }
-
-    return (char *)str;
-}
-
-static bool rmaker_run_wasm(wasm_exec_env_t env, uint32_t cb, int argc, uint32_t *argv)
-{
-    wasm_exec_env_t exec_env = wasm_runtime_create_exec_env(get_module_inst(env), CONFIG_RMAKER_HEAP_SIZE);
+    wasm_exec_env_t exec_env = wm_ext_wasm_native_get_exec_env(module_inst, CONFIG_RMAKER_HEAP_SIZE);
     if (!exec_env) {
         ESP_LOGE(TAG, "failed to create execution environment");
         return false;
@@ -186,7 +155,7 @@ static bool rmaker_run_wasm(wasm_exec_env_t env, uint32_t cb, int argc, uint32_t
         ESP_LOGE(TAG, "failed to run WASM callback as %s", wasm_runtime_get_exception(get_module_inst(exec_env)));
     }
 
-    wasm_runtime_destroy_exec_env(exec_env);
+    wm_ext_wasm_native_put_exec_env(module_inst, exec_env);
 
     return ret;
 }
@@ -205,7 +174,7 @@ static esp_err_t wasm_rmaker_write_cb(const esp_rmaker_device_t *device, const e
     argv[4] = (uint32_t)rmaker_wrapper_ctx->priv_data;
     argv[5] = (uint32_t)ctx ? ctx->src : ESP_RMAKER_REQ_SRC_MAX;
 
-    return rmaker_run_wasm(rmaker_wrapper_ctx->exec_env, rmaker_wrapper_ctx->scheme_cb, 6, argv) ? (esp_err_t)argv[0] : ESP_OK;
+    return rmaker_run_wasm(rmaker_wrapper_ctx->module_inst, rmaker_wrapper_ctx->scheme_cb, 6, argv) ? (esp_err_t)argv[0] : ESP_OK;
 }
 
 esp_err_t wasm_rmaker_read_cb(const esp_rmaker_device_t *device, const esp_rmaker_param_t *param,
@@ -221,7 +190,7 @@ esp_err_t wasm_rmaker_read_cb(const esp_rmaker_device_t *device, const esp_rmake
         argv[2] = (uint32_t)rmaker_wrapper_ctx->priv_data;
         argv[3] = (uint32_t)ctx;
 
-        return rmaker_run_wasm(rmaker_wrapper_ctx->exec_env, rmaker_wrapper_ctx->read_cb, 4, argv) ? (esp_err_t)argv[0] : ESP_OK;
+        return rmaker_run_wasm(rmaker_wrapper_ctx->module_inst, rmaker_wrapper_ctx->read_cb, 4, argv) ? (esp_err_t)argv[0] : ESP_OK;
     }
 
     return ESP_OK;
@@ -280,8 +249,8 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_node_init)
     }
 
     config = (const esp_rmaker_config_t *)addr_app_to_native((uint32_t)config);
-    name = map_string(exec_env, name);
-    type = map_string(exec_env, type);
+    name = wm_ext_wasm_native_map_string(mem, name);
+    type = wm_ext_wasm_native_map_string(mem, type);
 
     return (int)esp_rmaker_node_init(config, name, type);
 }
@@ -302,10 +271,10 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_node_set_string)
     rmaker_native_get_arg(const char *, key);
     rmaker_native_get_arg(const char *, value);
 
-    key = map_string(exec_env, key);
+    key = wm_ext_wasm_native_map_string(mem, key);
     switch (mode) {
     case RMAKER_NODE_ADD_ATTRIBUTE:
-        value = map_string(exec_env, value);
+        value = wm_ext_wasm_native_map_string(mem, value);
         ret = esp_rmaker_node_add_attribute(node, key, value);
         break;
     case RMAKER_NODE_ADD_FW_VERSION:
@@ -338,7 +307,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_node_get_string)
             rmaker_native_get_arg(char *, output);
             rmaker_native_get_arg(uint8_t, len);
 
-            output = map_string(exec_env, (const char *)output);
+            output = wm_ext_wasm_native_map_ptr(mem, output);
 
             memcpy(output, res, len > strlen(output) ? strlen(output) : len);
 
@@ -369,7 +338,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_node_get_device)
     rmaker_native_get_arg(const esp_rmaker_node_t *, node);
     rmaker_native_get_arg(const char *, input);
 
-    input = map_string(exec_env, input);
+    input = wm_ext_wasm_native_map_string(mem, input);
 
     switch (mode) {
     case RMAKER_NODE_GET_DEVICE_BY_NAME:
@@ -399,11 +368,11 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_node_get_info)
         rmaker_native_get_arg(char *, model);
         rmaker_native_get_arg(char *, subtype);
 
-        name = map_string(exec_env, name);
-        type = map_string(exec_env, type);
-        fw_version = map_string(exec_env, fw_version);
-        model = map_string(exec_env, model);
-        name = map_string(exec_env, name);
+        name = wm_ext_wasm_native_map_ptr(mem, name);
+        type = wm_ext_wasm_native_map_ptr(mem, type);
+        fw_version = wm_ext_wasm_native_map_ptr(mem, fw_version);
+        model = wm_ext_wasm_native_map_ptr(mem, model);
+        subtype = wm_ext_wasm_native_map_ptr(mem, subtype);
         memcpy(name, node_info->name, strlen(node_info->name));
         memcpy(type, node_info->type, strlen(node_info->type));
         memcpy(fw_version, node_info->fw_version, strlen(node_info->fw_version));
@@ -425,8 +394,8 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_device_create)
     rmaker_native_get_arg(const char *, type);
     rmaker_native_get_arg(void *, priv_data);
 
-    dev_name = map_string(exec_env, dev_name);
-    type = map_string(exec_env, type);
+    dev_name = wm_ext_wasm_native_map_string(mem, dev_name);
+    type = wm_ext_wasm_native_map_string(mem, type);
 
     rmaker_wrapper->priv_data = priv_data;
 
@@ -464,10 +433,10 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_device_set_string)
     rmaker_native_get_arg(const char *, input);
     rmaker_native_get_arg(const char *, val);
 
-    input = map_string(exec_env, input);
+    input = wm_ext_wasm_native_map_string(mem, input);
     switch (mode) {
     case RMAKER_DEVICE_ADD_ATTRIBUTE:
-        val = map_string(exec_env, val);
+        val = wm_ext_wasm_native_map_string(mem, val);
         ret = esp_rmaker_device_add_attribute(device, input, val);
         break;
     case RMAKER_DEVICE_ADD_SUBTYPE:
@@ -504,7 +473,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_device_get_string)
     }
 
     if (res) {
-        output = map_string(exec_env, output);
+        output = wm_ext_wasm_native_map_ptr(mem, output);
         memcpy(output, res, len > strlen(res) ? strlen(res) : len);
     }
 
@@ -541,7 +510,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_device_get_param)
     rmaker_native_get_arg(const esp_rmaker_device_t *, device);
     rmaker_native_get_arg(const char *, input);
 
-    input = map_string(exec_env, input);
+    input = wm_ext_wasm_native_map_string(mem, input);
 
     switch (mode) {
     case RMAKER_DEVICE_GET_PARAM_BY_NAME:
@@ -567,7 +536,8 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_device_add_cb)
     const _esp_rmaker_device_t *rmaker_device = (const _esp_rmaker_device_t *)device;
     rmaker_wrapper_ctx_t *rmaker_wrapper = rmaker_device->priv_data;
 
-    rmaker_wrapper->exec_env = exec_env;
+    /* Callbacks may outlive the thread which registers them, keep the module instance */
+    rmaker_wrapper->module_inst = get_module_inst(exec_env);
     rmaker_wrapper->scheme_cb = scheme_cb;
     rmaker_wrapper->write_cb = write_cb;
     rmaker_wrapper->read_cb = read_cb;
@@ -582,7 +552,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_device_cb_src_to_str)
     rmaker_native_get_arg(uint32_t, len);
 
     const char *src_to_str = esp_rmaker_device_cb_src_to_str(src);
-    output = map_string(exec_env, output);
+    output = wm_ext_wasm_native_map_ptr(mem, output);
     if (src_to_str) {
         memcpy(output, src_to_str, len > strlen(src_to_str) ? strlen(src_to_str) : len);
     }
@@ -601,8 +571,8 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_service_create)
     rmaker_native_get_arg(const char *, type);
     rmaker_native_get_arg(void *, priv_data);
 
-    serv_name = map_string(exec_env, serv_name);
-    type = map_string(exec_env, type);
+    serv_name = wm_ext_wasm_native_map_string(mem, serv_name);
+    type = wm_ext_wasm_native_map_string(mem, type);
 
     rmaker_wrapper->priv_data = priv_data;
 
@@ -633,8 +603,8 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_param_create)
     rmaker_native_get_arg(uint32_t, param_val);
     rmaker_native_get_arg(uint8_t, properties);
 
-    param_name = map_string(exec_env, param_name);
-    type = map_string(exec_env, type);
+    param_name = wm_ext_wasm_native_map_string(mem, param_name);
+    type = wm_ext_wasm_native_map_string(mem, type);
 
     val.type = val_type;
     switch (val_type) {
@@ -650,7 +620,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_param_create)
     case RMAKER_VAL_TYPE_STRING:
     case RMAKER_VAL_TYPE_OBJECT:
     case RMAKER_VAL_TYPE_ARRAY:
-        val.val.s = map_string(exec_env, (const char *)param_val);
+        val.val.s = wm_ext_wasm_native_map_string(mem, (const char *)param_val);
         break;
     default:
         break;
@@ -679,7 +649,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_param_set_string)
         ret = esp_rmaker_param_add_array_max_count(param, input);
         break;
     case RMAKER_PARAM_ADD_UI_TYPE:
-        input = (uint32_t)map_string(exec_env, (const char *)input);
+        input = (uint32_t)wm_ext_wasm_native_map_string(mem, (const char *)input);
         ret = esp_rmaker_param_add_ui_type(param, (const char *)input);
         break;
     default:
@@ -710,7 +680,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_param_get_string)
     if (res) {
         rmaker_native_get_arg(char *, output);
         rmaker_native_get_arg(uint32_t, len);
-        output = map_string(exec_env, output);
+        output = wm_ext_wasm_native_map_ptr(mem, output);
         memcpy(output, res, len > strlen(res) ? strlen(res) : len);
     }
 
@@ -741,7 +711,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_param_set_val)
     case RMAKER_VAL_TYPE_STRING:
     case RMAKER_VAL_TYPE_OBJECT:
     case RMAKER_VAL_TYPE_ARRAY:
-        val.val.s = map_string(exec_env, (const char *)param_val);
+        val.val.s = wm_ext_wasm_native_map_string(mem, (const char *)param_val);
         break;
     default:
         break;
@@ -784,7 +754,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_param_get_val)
         rmaker_native_get_arg(char *, val);
         rmaker_native_get_arg(uint32_t, len);
 
-        val = map_string(exec_env, val);
+        val = wm_ext_wasm_native_map_ptr(mem, val);
         if (!validate_app_addr((uint32_t)val_type, sizeof(esp_rmaker_val_type_t))) {
             return ESP_FAIL;
         }
@@ -840,7 +810,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_param_add_bounds)
     case RMAKER_VAL_TYPE_STRING:
     case RMAKER_VAL_TYPE_OBJECT:
     case RMAKER_VAL_TYPE_ARRAY:
-        min.val.s = (char *)map_string(exec_env, (const char *)min_val);
+        min.val.s = (char *)wm_ext_wasm_native_map_string(mem, (const char *)min_val);
         break;
     default:
         break;
@@ -860,7 +830,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_param_add_bounds)
     case RMAKER_VAL_TYPE_STRING:
     case RMAKER_VAL_TYPE_OBJECT:
     case RMAKER_VAL_TYPE_ARRAY:
-        max.val.s = (char *)map_string(exec_env, (const char *)max_val);
+        max.val.s = (char *)wm_ext_wasm_native_map_string(mem, (const char *)max_val);
         break;
     default:
         break;
@@ -880,7 +850,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_param_add_bounds)
     case RMAKER_VAL_TYPE_STRING:
     case RMAKER_VAL_TYPE_OBJECT:
     case RMAKER_VAL_TYPE_ARRAY:
-        step.val.s = (char *)map_string(exec_env, (const char *)step_val);
+        step.val.s = (char *)wm_ext_wasm_native_map_string(mem, (const char *)step_val);
         break;
     default:
         break;
@@ -893,7 +863,7 @@ DEFINE_RMAKER_NATIVE_WRAPPER(rmaker_raise_alert)
 {
     rmaker_native_get_arg(const char *, alert_str);
 
-    alert_str = map_string(exec_env, alert_str);
+    alert_str = wm_ext_wasm_native_map_string(mem, alert_str);
 
     return esp_rmaker_raise_alert(alert_str);
 }
@@ -930,6 +900,8 @@ static const rmaker_func_desc_t rmaker_func_desc_table[] = {
 static int wasm_rmaker_run_wrapper(wasm_exec_env_t exec_env, int mode)
 {
     esp_err_t ret = ESP_OK;
+
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_rmaker_run", mode);
     switch (mode) {
     case RMAKER_COMMON_LOCAL_CTRL_START:
 #ifdef CONFIG_ESP_RMAKER_LOCAL_CTRL_ENABLE
@@ -966,23 +938,34 @@ static int wasm_rmaker_run_wrapper(wasm_exec_env_t exec_env, int mode)
     default:
         break;
     }
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
 
     return ret;
 }
 
 static int wasm_rmaker_param_add_valid_str_list_wrapper(wasm_exec_env_t exec_env, uint32_t param, const char *strs[], uint8_t count)
 {
+    int ret;
     const char *str_list[count];
+    wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
 
     for (int i = 0; i < count; i ++) {
-        strs[i] = map_string(exec_env, strs[i]);
+        strs[i] = wm_ext_wasm_native_map_string(&mem, strs[i]);
+        if (!strs[i]) {
+            return ESP_ERR_INVALID_ARG;
+        }
+
         str_list[i] = strdup(strs[i]);
         if (!str_list[i]) {
             return ESP_ERR_NO_MEM;
         }
     }
 
-    return esp_rmaker_param_add_valid_str_list((const esp_rmaker_param_t *)param, str_list, count);
+    WM_EXT_WASM_NATIVE_TRACE_BEGIN("wasm_rmaker_param_add_valid_str_list", 0, param, count);
+    ret = esp_rmaker_param_add_valid_str_list((const esp_rmaker_param_t *)param, str_list, count);
+    WM_EXT_WASM_NATIVE_TRACE_END(ret);
+
+    return ret;
 }
 
 static int wasm_rmaker_call_native_func_wrapper(wasm_exec_env_t exec_env, int32_t func_id, uint32_t argc, uint32_t *argv)
@@ -1007,6 +990,7 @@ static int wasm_rmaker_call_native_func_wrapper(wasm_exec_env_t exec_env, int32_
         uint32_t size;
         uint32_t argv_copy_buf[RMAKER_ARG_BUF_NUM];
         uint32_t *argv_copy = argv_copy_buf;
+        wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
 
         if (argc > RMAKER_ARG_BUF_NUM) {
             if (argc > RMAKER_ARG_NUM_MAX) {
@@ -1030,7 +1014,11 @@ static int wasm_rmaker_call_native_func_wrapper(wasm_exec_env_t exec_env, int32_
 
         ESP_LOGD(TAG, "func_id=%"PRIx32" is to do", func_id);
 
-        int ret = func_desc->func(exec_env, argv_copy, argv);
+        WM_EXT_WASM_NATIVE_TRACE_BEGIN_ARGV("rmaker", func_id, argv_copy, argc);
+
+        int ret = func_desc->func(exec_env, &mem, argv_copy, argv);
+
+        WM_EXT_WASM_NATIVE_TRACE_END(ret);
 
         if (argv_copy != argv_copy_buf) {
             wasm_runtime_free(argv_copy);
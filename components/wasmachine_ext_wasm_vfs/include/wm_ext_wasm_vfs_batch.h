@@ -0,0 +1,177 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+
+#include "sdkconfig.h"
+#include "wm_ext_wasm_native_common.h"
+
+#ifdef CONFIG_EXTENDED_VFS_I2C
+#include "ioctl/esp_i2c_ioctl.h"
+#endif
+
+#ifdef CONFIG_EXTENDED_VFS_SPI
+#include "ioctl/esp_spi_ioctl.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Batched transaction ioctl commands, the argument is the address of a
+ *        wm_ext_wasm_vfs_batch_t in linear memory instead of a data sequence.
+ */
+#define WM_EXT_WASM_VFS_I2CIOCBATCH         0x5701  /*!< Run I2CIOCEXCHANGE transactions of a batch */
+#define WM_EXT_WASM_VFS_SPIIOCBATCH         0x5702  /*!< Run SPIIOCEXCHANGE transactions of a batch */
+
+/**
+ * @brief Prepared transfer ioctl commands. A transfer is prepared from a
+ *        wm_ext_wasm_vfs_xfer_t in linear memory and the ioctl returns its handle, later
+ *        calls run it by handle and an optional length, ioctl(fd, cmd, handle, len).
+ */
+#define WM_EXT_WASM_VFS_I2CIOCPREPARE       0x5703  /*!< Prepare an I2CIOCEXCHANGE transfer */
+#define WM_EXT_WASM_VFS_SPIIOCPREPARE       0x5704  /*!< Prepare an SPIIOCEXCHANGE transfer */
+#define WM_EXT_WASM_VFS_IOCXFER             0x5705  /*!< Run a prepared transfer */
+#define WM_EXT_WASM_VFS_IOCUNPREPARE        0x5706  /*!< Free a prepared transfer */
+
+#define WM_EXT_WASM_VFS_BATCH_CONTINUE      0x01    /*!< Batch flag, run the rest of a batch after a transaction fails */
+
+#define WM_EXT_WASM_VFS_BATCH_MAX_XFERS     256     /*!< Max number of transactions of a batch */
+
+/**
+ * @brief Transaction of a batch, layout is shared with wasm32 applications.
+ *
+ * An I2C transaction writes tx_size bytes, waits delay_ms and reads rx_size bytes.
+ * An SPI transaction exchanges tx_size bytes, or rx_size bytes if there is no
+ * transmit buffer, and both sizes must be the same if there are both buffers.
+ */
+typedef struct wm_ext_wasm_vfs_xfer {
+    uint16_t addr;                      /*!< I2C device address, SPI ignores it */
+    uint16_t flags;                     /*!< I2C message flags, SPI ignores it */
+    uint32_t tx_buffer;                 /*!< Address of transmit data in linear memory, 0 if none */
+    uint32_t tx_size;                   /*!< Transmit data size */
+    uint32_t rx_buffer;                 /*!< Address of receive buffer in linear memory, 0 if none */
+    uint32_t rx_size;                   /*!< Receive buffer size */
+    uint32_t delay_ms;                  /*!< I2C delay between write and read, SPI ignores it */
+    uint32_t wait_us;                   /*!< Time to wait after the transaction and before the next one */
+    int32_t status;                     /*!< Output, 0 if success or a negative errno value */
+} wm_ext_wasm_vfs_xfer_t;
+
+/**
+ * @brief Batch of transactions, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_vfs_batch {
+    uint32_t xfers;                     /*!< Address of transaction array in linear memory */
+    uint32_t count;                     /*!< Number of transactions */
+    uint32_t flags;                     /*!< WM_EXT_WASM_VFS_BATCH_CONTINUE */
+} wm_ext_wasm_vfs_batch_t;
+
+#if defined(CONFIG_EXTENDED_VFS_I2C) || defined(CONFIG_EXTENDED_VFS_SPI)
+/**
+ * @brief Bus message of a transaction.
+ */
+typedef union wm_ext_wasm_vfs_bus_msg {
+#ifdef CONFIG_EXTENDED_VFS_I2C
+    i2c_ex_msg_t i2c;                   /*!< I2CIOCEXCHANGE message */
+#endif
+#ifdef CONFIG_EXTENDED_VFS_SPI
+    spi_ex_msg_t spi;                   /*!< SPIIOCEXCHANGE message */
+#endif
+} wm_ext_wasm_vfs_bus_msg_t;
+
+/**
+ * @brief Transfer which is checked once and run many times, its bus message is built
+ *        when it's prepared and a run only sets buffer pointers and its length.
+ */
+typedef struct wm_ext_wasm_vfs_prepared {
+    int fd;                             /*!< File descriptor which the transfer is prepared for */
+    int cmd;                            /*!< WM_EXT_WASM_VFS_I2CIOCBATCH or WM_EXT_WASM_VFS_SPIIOCBATCH */
+    wm_ext_wasm_vfs_bus_msg_t msg;      /*!< Bus message, its buffers are NULL */
+    uint32_t tx;                        /*!< Offset of transmit data in linear memory */
+    uint32_t tx_size;                   /*!< Transmit data size, 0 if there is no transmit buffer */
+    uint32_t rx;                        /*!< Offset of receive buffer in linear memory */
+    uint32_t rx_size;                   /*!< Receive buffer size, 0 if there is no receive buffer */
+    uint32_t max_len;                   /*!< Max length of a run */
+    uint64_t end;                       /*!< End of the buffers in linear memory */
+    uint32_t wait_us;                   /*!< Time to wait after the transfer */
+    atomic_bool busy;                   /*!< A native call is running the transfer */
+} wm_ext_wasm_vfs_prepared_t;
+#endif
+
+/**
+ * @brief Run one bus transaction, it's ioctl() on a device of the firmware and a mock
+ *        bus in tests.
+ *
+ * @param  fd file descriptor
+ * @param  cmd I2CIOCEXCHANGE or SPIIOCEXCHANGE
+ * @param  msg i2c_ex_msg_t or spi_ex_msg_t
+ *
+ * @return 0 or positive value if success, or -1 with errno set if failed.
+ */
+typedef int (*wm_ext_wasm_vfs_batch_exec_t)(int fd, int cmd, void *msg);
+
+/**
+  * @brief  Run transactions of a batch back to back.
+  *
+  * All transactions are checked before the first one runs, so a batch with a bad
+  * transaction fails without touching the bus. A failed transaction cancels the rest
+  * of the batch unless WM_EXT_WASM_VFS_BATCH_CONTINUE is set, and status of canceled
+  * transactions is -ECANCELED.
+  *
+  * @param  fd file descriptor
+  * @param  cmd WM_EXT_WASM_VFS_I2CIOCBATCH or WM_EXT_WASM_VFS_SPIIOCBATCH
+  * @param  batch batch, its addresses are in mem
+  * @param  mem linear memory of the native call
+  * @param  exec function which runs one transaction
+  *
+  * @return Number of transactions which succeeded, or -1 with errno set if the batch
+  *         is not valid.
+  */
+int wm_ext_wasm_vfs_batch_run(int fd, int cmd, const wm_ext_wasm_vfs_batch_t *batch,
+                              wm_ext_wasm_native_mem_t *mem, wm_ext_wasm_vfs_batch_exec_t exec);
+
+#if defined(CONFIG_EXTENDED_VFS_I2C) || defined(CONFIG_EXTENDED_VFS_SPI)
+/**
+  * @brief  Check a transaction and keep it to be run many times.
+  *
+  * Buffers are checked against linear memory, which never shrinks, and the bus
+  * message is built, so running the transfer later only adds buffer offsets to the
+  * base address of linear memory, which may move when it grows.
+  *
+  * @param  fd file descriptor
+  * @param  cmd WM_EXT_WASM_VFS_I2CIOCBATCH or WM_EXT_WASM_VFS_SPIIOCBATCH
+  * @param  xfer transaction, its addresses are in mem
+  * @param  mem linear memory of the native call
+  * @param  prepared prepared transfer
+  *
+  * @return 0 if success, or -1 with errno set if the transaction is not valid.
+  */
+int wm_ext_wasm_vfs_xfer_prepare(int fd, int cmd, const wm_ext_wasm_vfs_xfer_t *xfer,
+                                 wm_ext_wasm_native_mem_t *mem, wm_ext_wasm_vfs_prepared_t *prepared);
+
+/**
+  * @brief  Run a prepared transfer.
+  *
+  * @param  prepared prepared transfer
+  * @param  len 0 to run the transfer as it's prepared, or a smaller length of the
+  *             I2C read, the I2C write if there is no read, or the SPI exchange
+  * @param  mem linear memory of the native call
+  * @param  exec function which runs the transaction
+  *
+  * @return 0 if success, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_vfs_xfer_run(const wm_ext_wasm_vfs_prepared_t *prepared, uint32_t len,
+                             wm_ext_wasm_native_mem_t *mem, wm_ext_wasm_vfs_batch_exec_t exec);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,102 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief DMA statistics ioctl command, the argument is the address of a
+ *        wm_ext_wasm_vfs_dma_stats_t in linear memory which receives the counters.
+ */
+#define WM_EXT_WASM_VFS_IOCDMASTATS         0x5707
+
+#define WM_EXT_WASM_VFS_DMA_ALIGN           64      /*!< Alignment and size granularity of bounce buffers, a cache line */
+
+/**
+ * @brief Path which a buffer of linear memory takes to the DMA of the driver.
+ */
+typedef enum wm_ext_wasm_vfs_dma_path {
+    WM_EXT_WASM_VFS_DMA_ZERO_COPY = 0,      /*!< Buffer is DMA-capable and is passed to the driver as it is */
+    WM_EXT_WASM_VFS_DMA_BOUNCE,             /*!< Buffer is copied through a bounce buffer of the pool */
+    WM_EXT_WASM_VFS_DMA_DIRECT,             /*!< No bounce buffer, the driver copies the buffer by itself */
+    WM_EXT_WASM_VFS_DMA_PATH_MAX
+} wm_ext_wasm_vfs_dma_path_t;
+
+/**
+ * @brief DMA statistics, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_vfs_dma_stats {
+    uint32_t path[WM_EXT_WASM_VFS_DMA_PATH_MAX];    /*!< Number of buffers which took each path */
+    uint32_t bounce_bytes;                          /*!< Bytes copied through bounce buffers */
+    uint32_t too_large;                             /*!< Direct buffers which are larger than a bounce buffer */
+    uint32_t pool_empty;                            /*!< Direct buffers which found no free bounce buffer */
+} wm_ext_wasm_vfs_dma_stats_t;
+
+/**
+ * @brief Buffer of linear memory which is mapped for DMA.
+ */
+typedef struct wm_ext_wasm_vfs_dma_buf {
+    void *app;                                      /*!< Buffer in linear memory */
+    void *dma;                                      /*!< Buffer which is passed to the driver */
+    uint32_t size;                                  /*!< Buffer size */
+    int slot;                                       /*!< Bounce buffer slot, -1 if none */
+    wm_ext_wasm_vfs_dma_path_t path;                /*!< Path which the buffer takes */
+} wm_ext_wasm_vfs_dma_buf_t;
+
+/**
+  * @brief  Allocate DMA-capable bounce buffers of the pool.
+  *
+  * @return
+  *     - ESP_OK if at least one bounce buffer is allocated
+  *     - ESP_ERR_NO_MEM if no bounce buffer can be allocated
+  */
+esp_err_t wm_ext_wasm_vfs_dma_init(void);
+
+/**
+  * @brief  Map a buffer of linear memory for DMA. A buffer which is DMA-capable is
+  *         passed to the driver as it is, others take a bounce buffer if there is a
+  *         free one which is large enough.
+  *
+  * @param  buf mapped buffer
+  * @param  app buffer in linear memory, NULL if none
+  * @param  size buffer size
+  * @param  tx true if the driver reads the buffer, and it's copied into the bounce buffer
+  *
+  * @return Path which the buffer takes.
+  */
+wm_ext_wasm_vfs_dma_path_t wm_ext_wasm_vfs_dma_map(wm_ext_wasm_vfs_dma_buf_t *buf, void *app, uint32_t size, bool tx);
+
+/**
+  * @brief  Unmap a buffer and give its bounce buffer back to the pool.
+  *
+  * @param  buf mapped buffer
+  * @param  rx true if the driver wrote the buffer, and the bounce buffer is copied back
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_dma_unmap(wm_ext_wasm_vfs_dma_buf_t *buf, bool rx);
+
+/**
+  * @brief  Get DMA statistics.
+  *
+  * @param  stats statistics
+  * @param  reset true to clear the counters after reading them
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_dma_get_stats(wm_ext_wasm_vfs_dma_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,189 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "esp_err.h"
+#include "wm_ext_wasm_native_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief GPIO ioctl commands of many pins, the argument is the address of a structure
+ *        in linear memory and the file descriptor can be any GPIO device. Only pins of
+ *        CONFIG_WASMACHINE_EXT_VFS_GPIO_APP_PINS can be accessed.
+ */
+#define WM_EXT_WASM_VFS_GPIOCSEVENT         0x5708  /*!< Listen to edges of pins, wm_ext_wasm_vfs_gpio_listen_t */
+#define WM_EXT_WASM_VFS_GPIOCREAD           0x5709  /*!< Read levels of pins, wm_ext_wasm_vfs_gpio_pins_t */
+#define WM_EXT_WASM_VFS_GPIOCWRITE          0x570a  /*!< Write levels of pins, wm_ext_wasm_vfs_gpio_pins_t */
+
+#define WM_EXT_WASM_VFS_GPIO_MAX_PINS       64      /*!< Pins are bits of a 64-bit mask */
+
+#define WM_EXT_WASM_VFS_GPIO_EDGE_NONE      0       /*!< Stop listening */
+#define WM_EXT_WASM_VFS_GPIO_EDGE_RISING    1       /*!< Rising edges, same value as GPIO_INTR_POSEDGE */
+#define WM_EXT_WASM_VFS_GPIO_EDGE_FALLING   2       /*!< Falling edges, same value as GPIO_INTR_NEGEDGE */
+#define WM_EXT_WASM_VFS_GPIO_EDGE_ANY       3       /*!< Both edges, same value as GPIO_INTR_ANYEDGE */
+
+/**
+ * @brief Levels of pins, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_vfs_gpio_pins {
+    uint64_t mask;                          /*!< Bit n selects pin n */
+    uint64_t levels;                        /*!< Bit n is the level of pin n */
+} wm_ext_wasm_vfs_gpio_pins_t;
+
+/**
+ * @brief Edges to listen to, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_vfs_gpio_listen {
+    uint64_t mask;                          /*!< Bit n selects pin n */
+    uint32_t edge;                          /*!< WM_EXT_WASM_VFS_GPIO_EDGE_*, NONE stops listening to the pins */
+    uint32_t events;                        /*!< Address of event array in linear memory, which events are delivered in */
+    uint32_t max_events;                    /*!< Number of events of the array */
+    uint32_t reserved;                      /*!< Must be 0 */
+} wm_ext_wasm_vfs_gpio_listen_t;
+
+/**
+ * @brief Edge of a pin, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_vfs_gpio_event {
+    uint32_t pin;                           /*!< Pin number */
+    uint32_t level;                         /*!< Level of the pin after the edge */
+    int64_t time_us;                        /*!< Time of the edge in microseconds since boot */
+} wm_ext_wasm_vfs_gpio_event_t;
+
+/**
+ * @brief GPIO driver, it's the GPIO driver of ESP-IDF on the firmware and a simulated
+ *        driver in tests.
+ */
+typedef struct wm_ext_wasm_vfs_gpio_driver {
+    int (*get_level)(uint32_t pin);                                                 /*!< Return level, or -1 if pin is invalid */
+    esp_err_t (*set_level)(uint32_t pin, uint32_t level);                           /*!< Set level */
+    esp_err_t (*isr_add)(uint32_t pin, uint32_t edge, void (*isr)(void *), void *arg); /*!< Run isr(arg) at edges of a pin */
+    esp_err_t (*isr_remove)(uint32_t pin);                                          /*!< Stop running the ISR of a pin */
+} wm_ext_wasm_vfs_gpio_driver_t;
+
+/**
+ * @brief Wake the consumer of a ring, it runs in the ISR and returns false if the consumer
+ *        can't be woken, then the next event tries again.
+ */
+typedef bool (*wm_ext_wasm_vfs_gpio_notify_t)(void *arg);
+
+typedef struct wm_ext_wasm_vfs_gpio_ring wm_ext_wasm_vfs_gpio_ring_t;
+
+/**
+  * @brief  Set GPIO driver.
+  *
+  * @param  driver GPIO driver, NULL to use the GPIO driver of ESP-IDF
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_gpio_set_driver(const wm_ext_wasm_vfs_gpio_driver_t *driver);
+
+/**
+  * @brief  Set pins which applications can access.
+  *
+  * @param  mask bit n allows pin n, it's CONFIG_WASMACHINE_EXT_VFS_GPIO_APP_PINS by default
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_gpio_set_pins(uint64_t mask);
+
+/**
+  * @brief  Run WM_EXT_WASM_VFS_GPIOCREAD or WM_EXT_WASM_VFS_GPIOCWRITE of an application.
+  *
+  * @param  cmd ioctl command
+  * @param  addr address of wm_ext_wasm_vfs_gpio_pins_t in linear memory
+  * @param  mem linear memory of the native call
+  *
+  * @return 0 if success, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_vfs_gpio_pins_ioctl(int cmd, uint32_t addr, wm_ext_wasm_native_mem_t *mem);
+
+/**
+  * @brief  Read levels of pins.
+  *
+  * @param  pins pins, levels of pins of mask are written and other bits are cleared
+  *
+  * @return 0 if success, or -1 with errno set if a pin is invalid or not allowed.
+  */
+int wm_ext_wasm_vfs_gpio_read_pins(wm_ext_wasm_vfs_gpio_pins_t *pins);
+
+/**
+  * @brief  Write levels of pins.
+  *
+  * @param  pins pins
+  *
+  * @return 0 if success, or -1 with errno set if a pin is invalid or not allowed.
+  */
+int wm_ext_wasm_vfs_gpio_write_pins(const wm_ext_wasm_vfs_gpio_pins_t *pins);
+
+/**
+  * @brief  Create a single-producer single-consumer event ring. The GPIO ISR produces
+  *         events and calls notify when the consumer has drained the ring.
+  *
+  * @param  size number of events, rounded up to a power of 2
+  * @param  notify function to wake the consumer
+  * @param  arg argument of notify
+  *
+  * @return Ring pointer if success or NULL if failed.
+  */
+wm_ext_wasm_vfs_gpio_ring_t *wm_ext_wasm_vfs_gpio_ring_create(uint32_t size, wm_ext_wasm_vfs_gpio_notify_t notify, void *arg);
+
+/**
+  * @brief  Stop listening to all pins of a ring and free it.
+  *
+  * @param  ring ring pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_gpio_ring_destroy(wm_ext_wasm_vfs_gpio_ring_t *ring);
+
+/**
+  * @brief  Listen to edges of pins, or stop listening to them, and deliver their events
+  *         to a ring.
+  *
+  * @param  ring ring pointer
+  * @param  mask bit n selects pin n
+  * @param  edge WM_EXT_WASM_VFS_GPIO_EDGE_*
+  *
+  * @return 0 if success, or -1 with errno set if a pin is invalid, not allowed or another
+  *         ring listens to it, and then no pin is changed.
+  */
+int wm_ext_wasm_vfs_gpio_listen(wm_ext_wasm_vfs_gpio_ring_t *ring, uint64_t mask, uint32_t edge);
+
+/**
+  * @brief  Take events out of a ring, the ring is armed again so an event which comes
+  *         after it's drained calls notify.
+  *
+  * @param  ring ring pointer
+  * @param  events event array
+  * @param  max number of events of the array
+  * @param  dropped number of events which were dropped because the ring was full since
+  *                 the last call
+  *
+  * @return Number of events.
+  */
+uint32_t wm_ext_wasm_vfs_gpio_ring_pop(wm_ext_wasm_vfs_gpio_ring_t *ring, wm_ext_wasm_vfs_gpio_event_t *events,
+                                       uint32_t max, uint32_t *dropped);
+
+/**
+  * @brief  Arm a ring again after notify succeeded but the consumer failed to be woken.
+  *
+  * @param  ring ring pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_gpio_ring_arm(wm_ext_wasm_vfs_gpio_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,7 @@
 
 #include "sdkconfig.h"
 #include "wasm_export.h"
+#include "wm_ext_wasm_native_common.h"
 
 #ifdef CONFIG_EXTENDED_VFS_GPIO
 #include "ioctl/esp_gpio_ioctl.h"
@@ -41,6 +42,63 @@ int wm_ext_wasm_i2c_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_ar
 int wm_ext_wasm_native_spi_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args);
 #endif
 
+#if defined(CONFIG_EXTENDED_VFS_I2C) || defined(CONFIG_EXTENDED_VFS_SPI)
+/**
+  * @brief  Run or free a prepared bus transfer, by its handle and an optional length
+  *         in va_args.
+  *
+  * @param  exec_env WAMR execution environment pointer
+  * @param  fd file descriptor which the transfer is prepared for
+  * @param  cmd WM_EXT_WASM_VFS_IOCXFER or WM_EXT_WASM_VFS_IOCUNPREPARE
+  * @param  va_args arguments list pointer
+  *
+  * @return 0 if success, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_vfs_xfer_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args);
+#endif
+
+#ifdef CONFIG_EXTENDED_VFS
+/**
+  * @brief  Free all prepared bus transfers and GPIO event rings of a native context,
+  *         and stop streams which sample into its linear memory.
+  *
+  * @param  ctx native context pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx);
+#endif
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_DMA_POOL
+/**
+  * @brief  Copy DMA statistics into a wm_ext_wasm_vfs_dma_stats_t in linear memory,
+  *         whose address is in va_args.
+  *
+  * @param  exec_env WAMR execution environment pointer
+  * @param  fd file descriptor, it's not used
+  * @param  cmd WM_EXT_WASM_VFS_IOCDMASTATS
+  * @param  va_args arguments list pointer
+  *
+  * @return 0 if success, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_vfs_dma_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args);
+#endif
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_STREAM
+/**
+  * @brief  Start, stop or take blocks of a stream, the address of a structure in
+  *         linear memory is in va_args if the command has one.
+  *
+  * @param  exec_env WAMR execution environment pointer
+  * @param  fd file descriptor of a stream
+  * @param  cmd WM_EXT_WASM_VFS_STREAMIOC*
+  * @param  va_args arguments list pointer
+  *
+  * @return 0 if success, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_vfs_stream_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args);
+#endif
+
 #ifdef CONFIG_EXTENDED_VFS_LEDC
 int wm_ext_wasm_native_ledc_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args);
 #endif
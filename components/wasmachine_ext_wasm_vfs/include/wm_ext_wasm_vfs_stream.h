@@ -0,0 +1,212 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <sys/types.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WM_EXT_WASM_VFS_STREAM_PATH         "/dev/stream"   /*!< Each open() of it creates a stream */
+
+/**
+ * @brief Stream ioctl commands, the argument is the address of a structure in linear
+ *        memory if there is one.
+ */
+#define WM_EXT_WASM_VFS_STREAMIOCSTART      0x570b  /*!< Start sampling, wm_ext_wasm_vfs_stream_cfg_t */
+#define WM_EXT_WASM_VFS_STREAMIOCSTOP       0x570c  /*!< Stop sampling, no argument */
+#define WM_EXT_WASM_VFS_STREAMIOCNEXT       0x570d  /*!< Release the last block of the window and take the next one, wm_ext_wasm_vfs_stream_next_t */
+#define WM_EXT_WASM_VFS_STREAMIOCSTATS      0x570e  /*!< Get counters, wm_ext_wasm_vfs_stream_stats_t */
+
+/**
+ * @brief Backend which produces samples.
+ */
+typedef enum wm_ext_wasm_vfs_stream_backend_type {
+    WM_EXT_WASM_VFS_STREAM_ADC = 0,         /*!< ADC unit 1 in continuous mode */
+    WM_EXT_WASM_VFS_STREAM_SIM,             /*!< Simulation, sample n of a stream is n modulo 65536 */
+    WM_EXT_WASM_VFS_STREAM_BACKEND_MAX
+} wm_ext_wasm_vfs_stream_backend_type_t;
+
+/**
+ * @brief Stream configuration, layout is shared with wasm32 applications.
+ *
+ * Samples are 16-bit values, and samples of many channels are interleaved in ascending
+ * order of channels. ADC samples carry the channel in bits 12 to 15 and the raw value in
+ * bits 0 to 11, because frames dropped by the driver shift the interleaving. The ring
+ * has blocks of block_samples samples, and it's an array of blocks in linear memory at
+ * window, or native memory which is read by read() if window is 0.
+ */
+typedef struct wm_ext_wasm_vfs_stream_cfg {
+    uint32_t backend;                       /*!< wm_ext_wasm_vfs_stream_backend_type_t */
+    uint32_t channels;                      /*!< Bit n selects channel n, the simulation ignores it */
+    uint32_t rate_hz;                       /*!< Samples per second of each channel, 0 is as fast as possible for the simulation */
+    uint32_t block_samples;                 /*!< Samples of a block */
+    uint32_t blocks;                        /*!< Blocks of the ring, at least 2 */
+    uint32_t window;                        /*!< Address of the window in linear memory, 0 if none */
+} wm_ext_wasm_vfs_stream_cfg_t;
+
+/**
+ * @brief Next block of the window, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_vfs_stream_next {
+    int32_t timeout_ms;                     /*!< Time to wait for a block, -1 to wait forever */
+    uint32_t index;                         /*!< Index of the block in the window */
+    uint32_t seq;                           /*!< Sequence number of the block, it skips the overrun blocks */
+    uint32_t overruns;                      /*!< Blocks which were dropped because the ring was full */
+} wm_ext_wasm_vfs_stream_next_t;
+
+/**
+ * @brief Stream counters, layout is shared with wasm32 applications.
+ */
+typedef struct wm_ext_wasm_vfs_stream_stats {
+    uint32_t blocks;                        /*!< Blocks which were put into the ring */
+    uint32_t overruns;                      /*!< Blocks which were dropped because the ring was full */
+    uint32_t lost_samples;                  /*!< Samples which the backend lost, such as ADC pool overflows */
+    uint32_t zero_copy;                     /*!< 1 if blocks are sampled into the window directly */
+    uint64_t samples;                       /*!< Samples which the backend produced */
+} wm_ext_wasm_vfs_stream_stats_t;
+
+/**
+ * @brief Argument of WM_EXT_WASM_VFS_STREAMIOCSTART to the VFS device.
+ */
+typedef struct wm_ext_wasm_vfs_stream_start {
+    wm_ext_wasm_vfs_stream_cfg_t cfg;       /*!< Configuration, its window is an offset from mem_base */
+    uint8_t *mem_base;                      /*!< Native address of linear memory */
+    bool fixed;                             /*!< Linear memory can't move, so blocks are sampled into the window */
+    void *owner;                            /*!< Owner of the stream and linear memory, see wm_ext_wasm_vfs_stream_detach() */
+    int fd;                                 /*!< File descriptor which the owner opened the stream by, -1 if none */
+} wm_ext_wasm_vfs_stream_start_t;
+
+/**
+ * @brief Argument of WM_EXT_WASM_VFS_STREAMIOCNEXT to the VFS device.
+ */
+typedef struct wm_ext_wasm_vfs_stream_wait {
+    wm_ext_wasm_vfs_stream_next_t next;     /*!< Next block */
+    uint8_t *mem_base;                      /*!< Native address of linear memory now, which may have moved */
+} wm_ext_wasm_vfs_stream_wait_t;
+
+/**
+ * @brief Sampling backend, it's called by the sampling thread of a stream only.
+ */
+typedef struct wm_ext_wasm_vfs_stream_backend {
+    esp_err_t (*start)(void **priv, const wm_ext_wasm_vfs_stream_cfg_t *cfg);       /*!< Start sampling */
+    int (*read)(void *priv, uint16_t *samples, uint32_t num, uint32_t *lost);       /*!< Read at most num samples, it returns in tens of milliseconds with what it has */
+    void (*stop)(void *priv);                                                       /*!< Stop sampling and free priv */
+} wm_ext_wasm_vfs_stream_backend_t;
+
+typedef struct wm_ext_wasm_vfs_stream wm_ext_wasm_vfs_stream_t;
+
+/**
+  * @brief  Register the stream device to VFS.
+  *
+  * @return
+  *     - ESP_OK if success
+  *     - Others if failed
+  */
+esp_err_t wm_ext_wasm_vfs_stream_register(void);
+
+/**
+  * @brief  Create a stream.
+  *
+  * @return Stream pointer if success or NULL if failed.
+  */
+wm_ext_wasm_vfs_stream_t *wm_ext_wasm_vfs_stream_create(void);
+
+/**
+  * @brief  Stop a stream and free it.
+  *
+  * @param  stream stream pointer
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_stream_destroy(wm_ext_wasm_vfs_stream_t *stream);
+
+/**
+  * @brief  Start sampling of a stream into a new ring, blocks of the last ring are dropped.
+  *
+  * @param  stream stream pointer
+  * @param  start configuration and linear memory
+  *
+  * @return 0 if success, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_vfs_stream_start(wm_ext_wasm_vfs_stream_t *stream, const wm_ext_wasm_vfs_stream_start_t *start);
+
+/**
+  * @brief  Stop sampling of a stream, blocks which are in the ring can still be taken.
+  *
+  * @param  stream stream pointer
+  *
+  * @return 0 if success, or -1 with errno set if failed.
+  */
+int wm_ext_wasm_vfs_stream_stop(wm_ext_wasm_vfs_stream_t *stream);
+
+/**
+  * @brief  Release the block of the window which was taken last, and wait for the
+  *         next one. It's in the window when this returns, so the application reads
+  *         it in place until the next call.
+  *
+  * @param  stream stream pointer
+  * @param  next next block
+  * @param  mem_base native address of linear memory now
+  *
+  * @return 0 if success, or -1 with errno set to EAGAIN or ETIMEDOUT if there is no
+  *         block in time, ENODATA if the stream is stopped and drained, or EINVAL
+  *         if the stream has no window.
+  */
+int wm_ext_wasm_vfs_stream_next(wm_ext_wasm_vfs_stream_t *stream, wm_ext_wasm_vfs_stream_next_t *next, uint8_t *mem_base);
+
+/**
+  * @brief  Read the next block of a stream.
+  *
+  * @param  stream stream pointer
+  * @param  buf buffer
+  * @param  len buffer size, at least the block size
+  * @param  nonblock true to fail with EAGAIN instead of waiting for a block
+  *
+  * @return Block size if success, 0 if the stream is stopped and drained, or -1 with
+  *         errno set if failed.
+  */
+ssize_t wm_ext_wasm_vfs_stream_read(wm_ext_wasm_vfs_stream_t *stream, void *buf, size_t len, bool nonblock);
+
+/**
+  * @brief  Get counters of a stream.
+  *
+  * @param  stream stream pointer
+  * @param  stats counters
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_stream_get_stats(wm_ext_wasm_vfs_stream_t *stream, wm_ext_wasm_vfs_stream_stats_t *stats);
+
+/**
+  * @brief  Destroy all streams of an owner, and close their file descriptors, it must be
+  *         called before linear memory of the owner is freed.
+  *
+  * @param  owner owner of streams
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_stream_detach(void *owner);
+
+/**
+  * @brief  Set the backend of a type, such as a simulated ADC in tests.
+  *
+  * @param  type backend type
+  * @param  backend backend, NULL to use the default one
+  *
+  * @return None.
+  */
+void wm_ext_wasm_vfs_stream_set_backend(wm_ext_wasm_vfs_stream_backend_type_t type, const wm_ext_wasm_vfs_stream_backend_t *backend);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -11,6 +11,14 @@
 #include "wm_ext_wasm_vfs.h"
 #include "ext_vfs.h"
 
+#ifdef CONFIG_WASMACHINE_EXT_VFS_DMA_POOL
+#include "wm_ext_wasm_vfs_dma.h"
+#endif
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_STREAM
+#include "wm_ext_wasm_vfs_stream.h"
+#endif
+
 #ifdef CONFIG_WASMACHINE_EXT_VFS_UART
 #if ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(5, 3, 0)
 #include "esp_vfs_dev.h"
@@ -32,4 +40,12 @@ void wm_ext_wasm_vfs_init(void)
 #ifdef CONFIG_EXTENDED_VFS
     ext_vfs_init();
 #endif
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_DMA_POOL
+    wm_ext_wasm_vfs_dma_init();
+#endif
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_STREAM
+    wm_ext_wasm_vfs_stream_register();
+#endif
 }
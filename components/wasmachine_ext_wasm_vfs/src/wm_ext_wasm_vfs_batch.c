@@ -0,0 +1,252 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#if defined(CONFIG_EXTENDED_VFS_I2C) || defined(CONFIG_EXTENDED_VFS_SPI)
+#include <stddef.h>
+#include <string.h>
+#include <inttypes.h>
+#include <unistd.h>
+#include <sys/param.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+
+#include "wm_ext_wasm_vfs_ioctl.h"
+#include "wm_ext_wasm_vfs_batch.h"
+
+/*
+ * Transactions of a batch are run back to back by the native, so a sensor poll of
+ * many transactions costs one native call and the bus doesn't idle while the
+ * application prepares the next transaction.
+ */
+
+static const char *TAG = "wm_vfs_batch";
+
+/*
+ * Map a buffer of linear memory, a buffer of size 0 is mapped to NULL. Bus buffers and
+ * transactions are always in linear memory, so addresses are never taken as native
+ * pointers, or an application could make the bus read or write firmware memory.
+ */
+static int batch_map(wm_ext_wasm_native_mem_t *mem, uint32_t addr, uint32_t size, void **ptr)
+{
+    *ptr = NULL;
+    if (!size) {
+        return 0;
+    }
+
+    *ptr = wm_ext_wasm_native_map_range(mem, addr, size);
+
+    return *ptr ? 0 : -EFAULT;
+}
+
+/* Check a transaction and build its bus message without buffers, return 0 or a negative errno value */
+static int batch_msg_init(int cmd, const wm_ext_wasm_vfs_xfer_t *xfer, wm_ext_wasm_vfs_bus_msg_t *msg)
+{
+    memset(msg, 0, sizeof(wm_ext_wasm_vfs_bus_msg_t));
+
+#ifdef CONFIG_EXTENDED_VFS_I2C
+    if (cmd == WM_EXT_WASM_VFS_I2CIOCBATCH) {
+        if (xfer->tx_size > UINT16_MAX || xfer->rx_size > UINT16_MAX || (!xfer->tx_size && !xfer->rx_size)) {
+            return -EINVAL;
+        }
+
+        msg->i2c.flags = xfer->flags;
+        msg->i2c.addr = xfer->addr;
+        msg->i2c.delay_ms = xfer->delay_ms;
+        msg->i2c.tx_size = xfer->tx_size;
+        msg->i2c.rx_size = xfer->rx_size;
+
+        return 0;
+    }
+#endif
+
+#ifdef CONFIG_EXTENDED_VFS_SPI
+    if (cmd == WM_EXT_WASM_VFS_SPIIOCBATCH) {
+        if ((xfer->tx_size && xfer->rx_size && xfer->tx_size != xfer->rx_size) ||
+                (!xfer->tx_size && !xfer->rx_size)) {
+            return -EINVAL;
+        }
+
+        msg->spi.size = xfer->tx_size ? xfer->tx_size : xfer->rx_size;
+
+        return 0;
+    }
+#endif
+
+    return -EINVAL;
+}
+
+/* Set buffers of a bus message and run it, return 0 or a negative errno value */
+static int batch_msg_exec(int fd, int cmd, wm_ext_wasm_vfs_bus_msg_t *msg, void *tx, void *rx,
+                          wm_ext_wasm_vfs_batch_exec_t exec)
+{
+#ifdef CONFIG_EXTENDED_VFS_I2C
+    if (cmd == WM_EXT_WASM_VFS_I2CIOCBATCH) {
+        msg->i2c.tx_buffer = tx;
+        msg->i2c.rx_buffer = rx;
+
+        return exec(fd, I2CIOCEXCHANGE, &msg->i2c) < 0 ? -errno : 0;
+    }
+#endif
+
+#ifdef CONFIG_EXTENDED_VFS_SPI
+    if (cmd == WM_EXT_WASM_VFS_SPIIOCBATCH) {
+        msg->spi.tx_buffer = tx;
+        msg->spi.rx_buffer = rx;
+
+        return exec(fd, SPIIOCEXCHANGE, &msg->spi) < 0 ? -errno : 0;
+    }
+#endif
+
+    return -EINVAL;
+}
+
+/* Check a transaction, and run it if exec is not NULL, return 0 or a negative errno value */
+static int batch_xfer(int fd, int cmd, const wm_ext_wasm_vfs_xfer_t *xfer, wm_ext_wasm_native_mem_t *mem,
+                      wm_ext_wasm_vfs_batch_exec_t exec)
+{
+    int ret;
+    void *tx;
+    void *rx;
+    wm_ext_wasm_vfs_bus_msg_t msg;
+
+    if ((ret = batch_map(mem, xfer->tx_buffer, xfer->tx_size, &tx)) < 0 ||
+            (ret = batch_map(mem, xfer->rx_buffer, xfer->rx_size, &rx)) < 0 ||
+            (ret = batch_msg_init(cmd, xfer, &msg)) < 0 || !exec) {
+        return ret;
+    }
+
+    return batch_msg_exec(fd, cmd, &msg, tx, rx, exec);
+}
+
+int wm_ext_wasm_vfs_batch_run(int fd, int cmd, const wm_ext_wasm_vfs_batch_t *batch,
+                              wm_ext_wasm_native_mem_t *mem, wm_ext_wasm_vfs_batch_exec_t exec)
+{
+    int ret;
+    int done = 0;
+    uint8_t *xfers;
+    wm_ext_wasm_vfs_xfer_t xfer;
+    const uint32_t size = sizeof(wm_ext_wasm_vfs_xfer_t);
+
+    if (batch->count > WM_EXT_WASM_VFS_BATCH_MAX_XFERS) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ret = batch_map(mem, batch->xfers, batch->count * size, (void **)&xfers);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+
+    /* Transactions may be unaligned in linear memory */
+    for (uint32_t i = 0; i < batch->count; i++) {
+        memcpy(&xfer, xfers + i * size, size);
+        ret = batch_xfer(fd, cmd, &xfer, mem, NULL);
+        if (ret < 0) {
+            ESP_LOGE(TAG, "transaction %"PRIu32" of batch is invalid", i);
+            memcpy(xfers + i * size + offsetof(wm_ext_wasm_vfs_xfer_t, status), &ret, sizeof(ret));
+            errno = -ret;
+            return -1;
+        }
+    }
+
+    ret = 0;
+    for (uint32_t i = 0; i < batch->count; i++) {
+        memcpy(&xfer, xfers + i * size, size);
+        if (ret < 0 && !(batch->flags & WM_EXT_WASM_VFS_BATCH_CONTINUE)) {
+            xfer.status = -ECANCELED;
+        } else {
+            xfer.status = ret = batch_xfer(fd, cmd, &xfer, mem, exec);
+            if (!ret) {
+                done++;
+            }
+
+            if (xfer.wait_us) {
+                usleep(xfer.wait_us);
+            }
+        }
+        memcpy(xfers + i * size + offsetof(wm_ext_wasm_vfs_xfer_t, status), &xfer.status, sizeof(xfer.status));
+    }
+
+    return done;
+}
+
+int wm_ext_wasm_vfs_xfer_prepare(int fd, int cmd, const wm_ext_wasm_vfs_xfer_t *xfer,
+                                 wm_ext_wasm_native_mem_t *mem, wm_ext_wasm_vfs_prepared_t *prepared)
+{
+    int ret = batch_xfer(fd, cmd, xfer, mem, NULL);
+
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+
+    memset(prepared, 0, sizeof(wm_ext_wasm_vfs_prepared_t));
+    batch_msg_init(cmd, xfer, &prepared->msg);
+    prepared->fd = fd;
+    prepared->cmd = cmd;
+    prepared->tx = xfer->tx_buffer;
+    prepared->tx_size = xfer->tx_size;
+    prepared->rx = xfer->rx_buffer;
+    prepared->rx_size = xfer->rx_size;
+    prepared->max_len = xfer->rx_size ? xfer->rx_size : xfer->tx_size;
+    prepared->end = MAX((uint64_t)xfer->tx_buffer + xfer->tx_size, (uint64_t)xfer->rx_buffer + xfer->rx_size);
+    prepared->wait_us = xfer->wait_us;
+    atomic_init(&prepared->busy, false);
+
+    return 0;
+}
+
+int wm_ext_wasm_vfs_xfer_run(const wm_ext_wasm_vfs_prepared_t *prepared, uint32_t len,
+                             wm_ext_wasm_native_mem_t *mem, wm_ext_wasm_vfs_batch_exec_t exec)
+{
+    int ret;
+    wm_ext_wasm_vfs_bus_msg_t msg = prepared->msg;
+
+    if (len > prepared->max_len) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    /* Linear memory never shrinks, so buffers checked when the transfer was prepared are still in it */
+    if ((!mem->base && !wm_ext_wasm_native_mem_resolve(mem)) || prepared->end > mem->size) {
+        errno = EFAULT;
+        return -1;
+    }
+
+    /* I2C overrides the read, or the write if there is no read, SPI both of them */
+#ifdef CONFIG_EXTENDED_VFS_I2C
+    if (len && prepared->cmd == WM_EXT_WASM_VFS_I2CIOCBATCH) {
+        if (prepared->rx_size) {
+            msg.i2c.rx_size = len;
+        } else {
+            msg.i2c.tx_size = len;
+        }
+    }
+#endif
+#ifdef CONFIG_EXTENDED_VFS_SPI
+    if (len && prepared->cmd == WM_EXT_WASM_VFS_SPIIOCBATCH) {
+        msg.spi.size = len;
+    }
+#endif
+
+    ret = batch_msg_exec(prepared->fd, prepared->cmd, &msg, prepared->tx_size ? mem->base + prepared->tx : NULL,
+                         prepared->rx_size ? mem->base + prepared->rx : NULL, exec);
+    if (ret < 0) {
+        errno = -ret;
+        return -1;
+    }
+
+    if (prepared->wait_us) {
+        usleep(prepared->wait_us);
+    }
+
+    return 0;
+}
+#endif
@@ -0,0 +1,158 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_DMA_POOL
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+
+#include "esp_log.h"
+#ifndef CONFIG_IDF_TARGET_LINUX
+#include "esp_heap_caps.h"
+#include "esp_memory_utils.h"
+#endif
+
+#include "wm_ext_wasm_vfs_dma.h"
+
+/*
+ * Linear memory is usually in PSRAM and its buffers have any alignment, so the SPI
+ * driver allocates and copies a DMA buffer for each transfer. Buffers which the DMA
+ * can't use are copied through a small pool of bounce buffers which are allocated
+ * once in internal DMA-capable memory instead.
+ */
+
+#define DMA_POOL_NUM        CONFIG_WASMACHINE_EXT_VFS_DMA_POOL_NUM
+#define DMA_BUF_SIZE        ((CONFIG_WASMACHINE_EXT_VFS_DMA_POOL_BUF_SIZE + WM_EXT_WASM_VFS_DMA_ALIGN - 1) & \
+                             ~(WM_EXT_WASM_VFS_DMA_ALIGN - 1))
+
+static const char *TAG = "wm_vfs_dma";
+
+static pthread_mutex_t s_dma_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint8_t *s_dma_buf[DMA_POOL_NUM];
+static uint32_t s_dma_free;                 /* Bit n is set if s_dma_buf[n] is free */
+static wm_ext_wasm_vfs_dma_stats_t s_dma_stats;
+
+/* DMA reads and writes whole words of internal memory */
+static bool dma_capable(const void *ptr, uint32_t size)
+{
+    if ((uintptr_t)ptr % 4 || size % 4) {
+        return false;
+    }
+
+#ifdef CONFIG_IDF_TARGET_LINUX
+    return true;
+#else
+    return esp_ptr_dma_capable(ptr) && esp_ptr_dma_capable((const uint8_t *)ptr + size - 1);
+#endif
+}
+
+esp_err_t wm_ext_wasm_vfs_dma_init(void)
+{
+    int num = 0;
+
+    pthread_mutex_lock(&s_dma_lock);
+
+    for (int i = 0; i < DMA_POOL_NUM; i++) {
+        if (!s_dma_buf[i]) {
+#ifdef CONFIG_IDF_TARGET_LINUX
+            s_dma_buf[i] = aligned_alloc(WM_EXT_WASM_VFS_DMA_ALIGN, DMA_BUF_SIZE);
+#else
+            s_dma_buf[i] = heap_caps_aligned_alloc(WM_EXT_WASM_VFS_DMA_ALIGN, DMA_BUF_SIZE,
+                                                   MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+#endif
+            if (!s_dma_buf[i]) {
+                ESP_LOGW(TAG, "failed to allocate bounce buffer %d of %d bytes", i, DMA_BUF_SIZE);
+                break;
+            }
+
+            s_dma_free |= 1u << i;
+        }
+
+        num++;
+    }
+
+    pthread_mutex_unlock(&s_dma_lock);
+
+    ESP_LOGD(TAG, "%d bounce buffers of %d bytes", num, DMA_BUF_SIZE);
+
+    return num ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+wm_ext_wasm_vfs_dma_path_t wm_ext_wasm_vfs_dma_map(wm_ext_wasm_vfs_dma_buf_t *buf, void *app, uint32_t size, bool tx)
+{
+    buf->app = app;
+    buf->dma = app;
+    buf->size = size;
+    buf->slot = -1;
+    buf->path = WM_EXT_WASM_VFS_DMA_ZERO_COPY;
+
+    if (!app || !size) {
+        return buf->path;
+    }
+
+    if (!dma_capable(app, size)) {
+        buf->path = WM_EXT_WASM_VFS_DMA_DIRECT;
+    }
+
+    pthread_mutex_lock(&s_dma_lock);
+
+    if (buf->path == WM_EXT_WASM_VFS_DMA_DIRECT) {
+        if (size > DMA_BUF_SIZE) {
+            s_dma_stats.too_large++;
+        } else if (!s_dma_free) {
+            s_dma_stats.pool_empty++;
+        } else {
+            buf->slot = ffs(s_dma_free) - 1;
+            buf->path = WM_EXT_WASM_VFS_DMA_BOUNCE;
+            buf->dma = s_dma_buf[buf->slot];
+            s_dma_free &= ~(1u << buf->slot);
+            s_dma_stats.bounce_bytes += size;
+        }
+    }
+
+    s_dma_stats.path[buf->path]++;
+
+    pthread_mutex_unlock(&s_dma_lock);
+
+    if (buf->path == WM_EXT_WASM_VFS_DMA_BOUNCE && tx) {
+        memcpy(buf->dma, app, size);
+    }
+
+    return buf->path;
+}
+
+void wm_ext_wasm_vfs_dma_unmap(wm_ext_wasm_vfs_dma_buf_t *buf, bool rx)
+{
+    if (buf->slot < 0) {
+        return;
+    }
+
+    if (rx) {
+        memcpy(buf->app, buf->dma, buf->size);
+    }
+
+    pthread_mutex_lock(&s_dma_lock);
+    s_dma_free |= 1u << buf->slot;
+    pthread_mutex_unlock(&s_dma_lock);
+
+    buf->slot = -1;
+}
+
+void wm_ext_wasm_vfs_dma_get_stats(wm_ext_wasm_vfs_dma_stats_t *stats, bool reset)
+{
+    pthread_mutex_lock(&s_dma_lock);
+
+    *stats = s_dma_stats;
+    if (reset) {
+        memset(&s_dma_stats, 0, sizeof(wm_ext_wasm_vfs_dma_stats_t));
+    }
+
+    pthread_mutex_unlock(&s_dma_lock);
+}
+#endif
@@ -0,0 +1,425 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_EXTENDED_VFS_GPIO
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <sys/errno.h>
+#ifdef CONFIG_IDF_TARGET_LINUX
+#include <sched.h>
+#endif
+
+#include "esp_log.h"
+#ifndef CONFIG_IDF_TARGET_LINUX
+#include "esp_timer.h"
+#include "driver/gpio.h"
+#endif
+
+#include "wm_ext_wasm_vfs_gpio.h"
+
+/*
+ * Edges are captured by the GPIO ISR with their time and level, and pushed into a
+ * lock-free ring of the application which listens to the pin. The ISR only wakes the
+ * consumer when the first event comes after the ring is drained, so a burst of edges
+ * is delivered as one batch.
+ *
+ * The ISR counts itself in s_gpio_in_isr[pin] before it loads the owner, so once the
+ * owner is cleared and the count drops to 0, no ISR can still use the old ring.
+ */
+
+struct wm_ext_wasm_vfs_gpio_ring {
+    uint32_t mask;                          /*!< Number of events minus 1 */
+    atomic_uint head;                       /*!< Next event to write, only the producer writes it */
+    atomic_uint tail;                       /*!< Next event to read, only the consumer writes it */
+    atomic_uint dropped;                    /*!< Events dropped because the ring was full */
+    atomic_bool armed;                      /*!< The next event calls notify */
+    wm_ext_wasm_vfs_gpio_notify_t notify;   /*!< Function to wake the consumer */
+    void *arg;                              /*!< Argument of notify */
+    wm_ext_wasm_vfs_gpio_event_t events[];
+};
+
+static const char *TAG = "wm_vfs_gpio";
+
+static pthread_mutex_t s_gpio_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t s_gpio_app_pins = CONFIG_WASMACHINE_EXT_VFS_GPIO_APP_PINS;
+static wm_ext_wasm_vfs_gpio_ring_t *_Atomic s_gpio_owner[WM_EXT_WASM_VFS_GPIO_MAX_PINS];
+static atomic_uint s_gpio_in_isr[WM_EXT_WASM_VFS_GPIO_MAX_PINS];
+
+#ifndef CONFIG_IDF_TARGET_LINUX
+static int gpio_driver_get_level(uint32_t pin)
+{
+    return GPIO_IS_VALID_GPIO(pin) ? gpio_get_level(pin) : -1;
+}
+
+static esp_err_t gpio_driver_set_level(uint32_t pin, uint32_t level)
+{
+    return gpio_set_level(pin, level);
+}
+
+static esp_err_t gpio_driver_isr_add(uint32_t pin, uint32_t edge, void (*isr)(void *), void *arg)
+{
+    esp_err_t ret;
+
+    /* The service may be installed by the firmware already */
+    ret = gpio_install_isr_service(0);
+    if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
+        return ret;
+    }
+
+    ret = gpio_set_intr_type(pin, (gpio_int_type_t)edge);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    ret = gpio_isr_handler_add(pin, isr, arg);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    return gpio_intr_enable(pin);
+}
+
+static esp_err_t gpio_driver_isr_remove(uint32_t pin)
+{
+    gpio_intr_disable(pin);
+    gpio_set_intr_type(pin, GPIO_INTR_DISABLE);
+
+    return gpio_isr_handler_remove(pin);
+}
+
+static const wm_ext_wasm_vfs_gpio_driver_t s_gpio_esp_driver = {
+    .get_level = gpio_driver_get_level,
+    .set_level = gpio_driver_set_level,
+    .isr_add = gpio_driver_isr_add,
+    .isr_remove = gpio_driver_isr_remove,
+};
+
+static const wm_ext_wasm_vfs_gpio_driver_t *s_gpio_driver = &s_gpio_esp_driver;
+#else
+static const wm_ext_wasm_vfs_gpio_driver_t *s_gpio_driver;
+#endif
+
+static int64_t gpio_now_us(void)
+{
+#ifdef CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+static void gpio_isr_push(wm_ext_wasm_vfs_gpio_ring_t *ring, uint32_t pin)
+{
+    uint32_t head;
+    wm_ext_wasm_vfs_gpio_event_t *event;
+
+    head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    if (head - atomic_load_explicit(&ring->tail, memory_order_acquire) > ring->mask) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+    } else {
+        event = &ring->events[head & ring->mask];
+        event->pin = pin;
+        event->level = s_gpio_driver->get_level(pin);
+        event->time_us = gpio_now_us();
+        atomic_store(&ring->head, head + 1);
+    }
+
+    /* Sequentially consistent with arming and reading head in wm_ext_wasm_vfs_gpio_ring_pop() */
+    if (atomic_exchange(&ring->armed, false) && !ring->notify(ring->arg)) {
+        atomic_store_explicit(&ring->armed, true, memory_order_release);
+    }
+}
+
+static void gpio_isr(void *arg)
+{
+    uint32_t pin = (uint32_t)(uintptr_t)arg;
+    wm_ext_wasm_vfs_gpio_ring_t *ring;
+
+    /* Sequentially consistent with clearing the owner in gpio_release() */
+    atomic_fetch_add(&s_gpio_in_isr[pin], 1);
+
+    ring = atomic_load(&s_gpio_owner[pin]);
+    if (ring) {
+        gpio_isr_push(ring, pin);
+    }
+
+    atomic_fetch_sub_explicit(&s_gpio_in_isr[pin], 1, memory_order_release);
+}
+
+/* Stop delivering edges of a pin, the last ring may be freed when it returns */
+static void gpio_release(uint32_t pin)
+{
+    atomic_store(&s_gpio_owner[pin], NULL);
+    s_gpio_driver->isr_remove(pin);
+
+    /* Wait for an ISR which loaded the owner before it was cleared */
+    while (atomic_load(&s_gpio_in_isr[pin])) {
+#ifdef CONFIG_IDF_TARGET_LINUX
+        sched_yield();
+#endif
+    }
+}
+
+void wm_ext_wasm_vfs_gpio_set_driver(const wm_ext_wasm_vfs_gpio_driver_t *driver)
+{
+#ifndef CONFIG_IDF_TARGET_LINUX
+    s_gpio_driver = driver ? driver : &s_gpio_esp_driver;
+#else
+    s_gpio_driver = driver;
+#endif
+}
+
+void wm_ext_wasm_vfs_gpio_set_pins(uint64_t mask)
+{
+    pthread_mutex_lock(&s_gpio_lock);
+    s_gpio_app_pins = mask;
+    pthread_mutex_unlock(&s_gpio_lock);
+}
+
+/* Only pins of the mask are given to applications, firmware pins and their handlers are kept */
+static bool gpio_pins_allowed(uint64_t mask)
+{
+    bool ret;
+
+    pthread_mutex_lock(&s_gpio_lock);
+    ret = !(mask & ~s_gpio_app_pins);
+    pthread_mutex_unlock(&s_gpio_lock);
+
+    if (!ret) {
+        ESP_LOGE(TAG, "pins 0x%"PRIx64" are not allowed", mask);
+    }
+
+    return ret;
+}
+
+int wm_ext_wasm_vfs_gpio_pins_ioctl(int cmd, uint32_t addr, wm_ext_wasm_native_mem_t *mem)
+{
+    int ret;
+    wm_ext_wasm_vfs_gpio_pins_t pins;
+    void *ptr = wm_ext_wasm_native_map_range(mem, addr, sizeof(wm_ext_wasm_vfs_gpio_pins_t));
+
+    if (!ptr) {
+        errno = EFAULT;
+        return -1;
+    }
+
+    memcpy(&pins, ptr, sizeof(wm_ext_wasm_vfs_gpio_pins_t));
+
+    if (cmd == WM_EXT_WASM_VFS_GPIOCREAD) {
+        ret = wm_ext_wasm_vfs_gpio_read_pins(&pins);
+        if (!ret) {
+            memcpy(ptr, &pins, sizeof(wm_ext_wasm_vfs_gpio_pins_t));
+        }
+    } else if (cmd == WM_EXT_WASM_VFS_GPIOCWRITE) {
+        ret = wm_ext_wasm_vfs_gpio_write_pins(&pins);
+    } else {
+        errno = EINVAL;
+        ret = -1;
+    }
+
+    return ret;
+}
+
+int wm_ext_wasm_vfs_gpio_read_pins(wm_ext_wasm_vfs_gpio_pins_t *pins)
+{
+    int level;
+    uint64_t levels = 0;
+
+    if (!s_gpio_driver) {
+        errno = ENODEV;
+        return -1;
+    } else if (!gpio_pins_allowed(pins->mask)) {
+        errno = EACCES;
+        return -1;
+    }
+
+    for (uint64_t m = pins->mask; m; m &= m - 1) {
+        uint32_t pin = __builtin_ctzll(m);
+
+        level = s_gpio_driver->get_level(pin);
+        if (level < 0) {
+            errno = EINVAL;
+            return -1;
+        }
+
+        levels |= (uint64_t)(level != 0) << pin;
+    }
+
+    pins->levels = levels;
+
+    return 0;
+}
+
+int wm_ext_wasm_vfs_gpio_write_pins(const wm_ext_wasm_vfs_gpio_pins_t *pins)
+{
+    if (!s_gpio_driver) {
+        errno = ENODEV;
+        return -1;
+    } else if (!gpio_pins_allowed(pins->mask)) {
+        errno = EACCES;
+        return -1;
+    }
+
+    for (uint64_t m = pins->mask; m; m &= m - 1) {
+        uint32_t pin = __builtin_ctzll(m);
+
+        if (s_gpio_driver->set_level(pin, (pins->levels >> pin) & 1) != ESP_OK) {
+            errno = EINVAL;
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+wm_ext_wasm_vfs_gpio_ring_t *wm_ext_wasm_vfs_gpio_ring_create(uint32_t size, wm_ext_wasm_vfs_gpio_notify_t notify, void *arg)
+{
+    uint32_t n = 1;
+    wm_ext_wasm_vfs_gpio_ring_t *ring;
+
+    while (n < size) {
+        n <<= 1;
+    }
+
+    ring = calloc(1, sizeof(wm_ext_wasm_vfs_gpio_ring_t) + n * sizeof(wm_ext_wasm_vfs_gpio_event_t));
+    if (!ring) {
+        return NULL;
+    }
+
+    ring->mask = n - 1;
+    ring->notify = notify;
+    ring->arg = arg;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->dropped, 0);
+    atomic_init(&ring->armed, true);
+
+    return ring;
+}
+
+void wm_ext_wasm_vfs_gpio_ring_destroy(wm_ext_wasm_vfs_gpio_ring_t *ring)
+{
+    uint64_t mask = 0;
+
+    pthread_mutex_lock(&s_gpio_lock);
+
+    for (int i = 0; i < WM_EXT_WASM_VFS_GPIO_MAX_PINS; i++) {
+        if (s_gpio_owner[i] == ring) {
+            mask |= 1ull << i;
+        }
+    }
+
+    pthread_mutex_unlock(&s_gpio_lock);
+
+    /* No ISR uses the ring after its pins are released */
+    wm_ext_wasm_vfs_gpio_listen(ring, mask, WM_EXT_WASM_VFS_GPIO_EDGE_NONE);
+    free(ring);
+}
+
+int wm_ext_wasm_vfs_gpio_listen(wm_ext_wasm_vfs_gpio_ring_t *ring, uint64_t mask, uint32_t edge)
+{
+    int ret = 0;
+    uint64_t done = 0;
+
+    if (edge > WM_EXT_WASM_VFS_GPIO_EDGE_ANY) {
+        errno = EINVAL;
+        return -1;
+    } else if (!s_gpio_driver) {
+        errno = ENODEV;
+        return -1;
+    }
+
+    pthread_mutex_lock(&s_gpio_lock);
+
+    /* Pins are released whatever the mask is, so a ring can always be destroyed */
+    if (edge != WM_EXT_WASM_VFS_GPIO_EDGE_NONE && (mask & ~s_gpio_app_pins)) {
+        ESP_LOGE(TAG, "pins 0x%"PRIx64" are not allowed", mask);
+        ret = EACCES;
+        goto out;
+    }
+
+    for (uint64_t m = mask; m; m &= m - 1) {
+        if (s_gpio_owner[__builtin_ctzll(m)] && s_gpio_owner[__builtin_ctzll(m)] != ring) {
+            ret = EBUSY;
+            goto out;
+        }
+    }
+
+    for (uint64_t m = mask; m; m &= m - 1) {
+        uint32_t pin = __builtin_ctzll(m);
+
+        if (edge == WM_EXT_WASM_VFS_GPIO_EDGE_NONE) {
+            if (s_gpio_owner[pin]) {
+                gpio_release(pin);
+            }
+            continue;
+        }
+
+        /* Publish the owner before the ISR can run */
+        atomic_store(&s_gpio_owner[pin], ring);
+        if (s_gpio_driver->isr_add(pin, edge, gpio_isr, (void *)(uintptr_t)pin) != ESP_OK) {
+            ESP_LOGE(TAG, "failed to listen to pin %"PRIu32, pin);
+            gpio_release(pin);
+            ret = EINVAL;
+            break;
+        }
+        done |= 1ull << pin;
+    }
+
+    /* Pins which were added before one failed are removed */
+    if (ret) {
+        for (uint64_t m = done; m; m &= m - 1) {
+            gpio_release(__builtin_ctzll(m));
+        }
+    }
+
+out:
+    pthread_mutex_unlock(&s_gpio_lock);
+
+    if (ret) {
+        errno = ret;
+        return -1;
+    }
+
+    return 0;
+}
+
+uint32_t wm_ext_wasm_vfs_gpio_ring_pop(wm_ext_wasm_vfs_gpio_ring_t *ring, wm_ext_wasm_vfs_gpio_event_t *events,
+                                       uint32_t max, uint32_t *dropped)
+{
+    uint32_t n = 0;
+    uint32_t head;
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    /* Arm before reading, so an event which is pushed after the last read notifies again */
+    atomic_store(&ring->armed, true);
+
+    head = atomic_load(&ring->head);
+    while (n < max && tail != head) {
+        memcpy(&events[n++], &ring->events[tail++ & ring->mask], sizeof(wm_ext_wasm_vfs_gpio_event_t));
+    }
+
+    atomic_store_explicit(&ring->tail, tail, memory_order_release);
+    *dropped = atomic_exchange_explicit(&ring->dropped, 0, memory_order_relaxed);
+
+    return n;
+}
+
+void wm_ext_wasm_vfs_gpio_ring_arm(wm_ext_wasm_vfs_gpio_ring_t *ring)
+{
+    atomic_store_explicit(&ring->armed, true, memory_order_release);
+}
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -8,6 +8,8 @@
 
 #ifdef CONFIG_EXTENDED_VFS
 #include <string.h>
+#include <stdlib.h>
+#include <pthread.h>
 #include <sys/ioctl.h>
 #include <sys/errno.h>
 #include <inttypes.h>
@@ -17,19 +19,311 @@
 
 #include "wm_ext_wasm_vfs_ioctl.h"
 #include "wm_ext_wasm_vfs_data_seq.h"
+#include "wm_ext_wasm_vfs_batch.h"
+#include "wm_ext_wasm_vfs_dma.h"
+#include "wm_ext_wasm_vfs_gpio.h"
+#include "wm_ext_wasm_vfs_stream.h"
 #include "wm_ext_wasm_native_common.h"
 
+#ifdef CONFIG_WASMACHINE_EXT_VFS_GPIO_EVENT
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "bh_common.h"
+#include "bh_platform.h"
+#include "app_manager_export.h"
+#include "module_wasm_app.h"
+#endif
+
 #define DATA_SEQ_POP_LEDC_CFG(ds, t, i, v) \
     DATA_SEQ_POP((ds), DATA_SEQ_LEDC_CFG_CHANNEL_SUB(DATA_SEQ_LEDC_CFG_CHANNEL_CFG, (t), (i)), (v))
 
 static const char *TAG = "wm_vfs_ioctl";
 
 #ifdef CONFIG_EXTENDED_VFS_GPIO
+#ifdef CONFIG_WASMACHINE_EXT_VFS_GPIO_EVENT
+#define GPIO_EVENT_WASM         WASM_Msg_Start + 7
+#define GPIO_EVENT_APPS         CONFIG_WASMACHINE_EXT_VFS_GPIO_EVENT_MAX_APPS
+
+/*
+ * The GPIO ISR can't post to the message queue of a module, so it sends the slot of
+ * the ring to a thread which posts for it, and the module drains the ring in its own
+ * thread and calls on_gpio_events() of the application.
+ */
+typedef struct gpio_event_app {
+    wm_ext_wasm_vfs_gpio_ring_t *ring;      /*!< Event ring, NULL if the slot is free */
+    wm_ext_wasm_native_ctx_t *owner;        /*!< Native context of the owner */
+    uint32_t module_id;                     /*!< Module which events are posted to */
+    uint32_t events;                        /*!< Address of event array in linear memory */
+    uint32_t max_events;                    /*!< Number of events of the array */
+} gpio_event_app_t;
+
+static pthread_mutex_t s_gpio_event_lock = PTHREAD_MUTEX_INITIALIZER;
+static gpio_event_app_t s_gpio_event_app[GPIO_EVENT_APPS];
+static QueueHandle_t s_gpio_event_queue;
+
+static bool gpio_event_notify(void *arg)
+{
+    uint32_t id = (uint32_t)(uintptr_t)arg;
+    BaseType_t woken = pdFALSE;
+    bool ret = xQueueSendFromISR(s_gpio_event_queue, &id, &woken) == pdTRUE;
+
+    if (woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+
+    return ret;
+}
+
+static void *gpio_event_thread(void *arg)
+{
+    uint32_t id;
+    uint32_t module_id;
+    module_data *module;
+    gpio_event_app_t *app;
+
+    while (1) {
+        if (xQueueReceive(s_gpio_event_queue, &id, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        app = &s_gpio_event_app[id];
+        pthread_mutex_lock(&s_gpio_event_lock);
+        module_id = app->ring ? app->module_id : ID_NONE;
+        pthread_mutex_unlock(&s_gpio_event_lock);
+
+        if (module_id == ID_NONE) {
+            continue;
+        }
+
+        /* The slot index is the payload itself, length 0 keeps the receiver from freeing it */
+        module = module_data_list_lookup_id(module_id);
+        if (module && bh_post_msg(module->queue, GPIO_EVENT_WASM, (void *)(uintptr_t)id, 0)) {
+            continue;
+        }
+
+        /* Let the next event notify again */
+        pthread_mutex_lock(&s_gpio_event_lock);
+        if (app->ring && app->module_id == module_id) {
+            wm_ext_wasm_vfs_gpio_ring_arm(app->ring);
+        }
+        pthread_mutex_unlock(&s_gpio_event_lock);
+    }
+
+    return NULL;
+}
+
+static void gpio_event_callback(module_data *m_data, bh_message_t msg)
+{
+    uint32_t n;
+    uint32_t argv[2];
+    uint32_t max_events = 0;
+    wm_ext_wasm_vfs_gpio_event_t *events = NULL;
+    wm_ext_wasm_vfs_gpio_ring_t *ring = NULL;
+    wasm_data *wasm_app_data = (wasm_data *)m_data->internal_data;
+    wasm_module_inst_t inst = wasm_app_data->wasm_module_inst;
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(inst);
+    wasm_function_inst_t func = wm_ext_wasm_native_get_func(inst, WM_EXT_WASM_NATIVE_FUNC_GPIO_DISPATCH);
+
+    bh_assert(GPIO_EVENT_WASM == bh_message_type(msg));
+
+    /* The ring is freed with the module instance, which is after its messages are handled */
+    pthread_mutex_lock(&s_gpio_event_lock);
+    for (int i = 0; i < GPIO_EVENT_APPS; i++) {
+        if (s_gpio_event_app[i].ring && s_gpio_event_app[i].owner == ctx) {
+            ring = s_gpio_event_app[i].ring;
+            events = wasm_runtime_addr_app_to_native(inst, s_gpio_event_app[i].events);
+            max_events = s_gpio_event_app[i].max_events;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_gpio_event_lock);
+
+    if (!ring || !func || !events) {
+        return;
+    }
+
+    do {
+        n = wm_ext_wasm_vfs_gpio_ring_pop(ring, events, max_events, &argv[1]);
+        if (!n && !argv[1]) {
+            break;
+        }
+
+        argv[0] = n;
+        if (!wasm_runtime_call_wasm(wasm_app_data->exec_env, func, 2, argv)) {
+            ESP_LOGE(TAG, "failed to run GPIO event callback: %s", wasm_runtime_get_exception(inst));
+            wasm_runtime_clear_exception(inst);
+            break;
+        }
+    } while (n == max_events);
+}
+
+/* Create the queue and the thread which posts events when the first application listens */
+static int gpio_event_start(void)
+{
+    int ret = 0;
+    pthread_t tid;
+
+    pthread_mutex_lock(&s_gpio_event_lock);
+
+    if (!s_gpio_event_queue) {
+        s_gpio_event_queue = xQueueCreate(GPIO_EVENT_APPS * 2, sizeof(uint32_t));
+        if (!s_gpio_event_queue) {
+            ret = ENOMEM;
+        } else if (pthread_create(&tid, NULL, gpio_event_thread, NULL) != 0) {
+            vQueueDelete(s_gpio_event_queue);
+            s_gpio_event_queue = NULL;
+            ret = ENOMEM;
+        } else {
+            pthread_detach(tid);
+        }
+    }
+
+    pthread_mutex_unlock(&s_gpio_event_lock);
+
+    return ret;
+}
+
+static int wasm_vfs_gpio_event_ioctl(wasm_exec_env_t exec_env, char *va_args)
+{
+    int ret;
+    uint32_t addr;
+    gpio_event_app_t *app = NULL;
+    wm_ext_wasm_vfs_gpio_listen_t listen;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(module_inst);
+    uint32_t module_id = app_manager_get_module_id(Module_WASM_App, module_inst);
+
+    if (!wasm_runtime_validate_native_addr(module_inst, va_args, 4)) {
+        ESP_LOGE(TAG, "failed to check addr of va_args");
+        errno = EINVAL;
+        return -1;
+    }
+
+    addr = WASM_VA_ARG(va_args, uint32_t);
+    if (!wasm_runtime_validate_app_addr(module_inst, addr, sizeof(wm_ext_wasm_vfs_gpio_listen_t))) {
+        errno = EFAULT;
+        return -1;
+    }
+
+    memcpy(&listen, addr_app_to_native(addr), sizeof(wm_ext_wasm_vfs_gpio_listen_t));
+
+    if (!ctx) {
+        errno = ENOMEM;
+        return -1;
+    } else if (module_id == ID_NONE) {
+        errno = ENOTSUP;
+        return -1;
+    } else if (listen.reserved || listen.edge > WM_EXT_WASM_VFS_GPIO_EDGE_ANY) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (listen.edge != WM_EXT_WASM_VFS_GPIO_EDGE_NONE) {
+        if (!listen.max_events || listen.max_events > UINT32_MAX / sizeof(wm_ext_wasm_vfs_gpio_event_t) ||
+                !wm_ext_wasm_native_get_func(module_inst, WM_EXT_WASM_NATIVE_FUNC_GPIO_DISPATCH)) {
+            errno = EINVAL;
+            return -1;
+        }
+
+        if (!wasm_runtime_validate_app_addr(module_inst, listen.events,
+                                            listen.max_events * sizeof(wm_ext_wasm_vfs_gpio_event_t))) {
+            errno = EFAULT;
+            return -1;
+        }
+
+        if (!wasm_register_msg_callback(GPIO_EVENT_WASM, gpio_event_callback) || gpio_event_start()) {
+            errno = ENOMEM;
+            return -1;
+        }
+    }
+
+    pthread_mutex_lock(&s_gpio_event_lock);
+
+    for (int i = 0; i < GPIO_EVENT_APPS; i++) {
+        if (s_gpio_event_app[i].ring && s_gpio_event_app[i].owner == ctx) {
+            app = &s_gpio_event_app[i];
+            break;
+        }
+    }
+
+    for (int i = 0; !app && listen.edge != WM_EXT_WASM_VFS_GPIO_EDGE_NONE && i < GPIO_EVENT_APPS; i++) {
+        if (!s_gpio_event_app[i].ring) {
+            s_gpio_event_app[i].ring = wm_ext_wasm_vfs_gpio_ring_create(CONFIG_WASMACHINE_EXT_VFS_GPIO_EVENT_RING_SIZE,
+                                                                        gpio_event_notify, (void *)(uintptr_t)i);
+            if (s_gpio_event_app[i].ring) {
+                app = &s_gpio_event_app[i];
+                app->owner = ctx;
+                app->module_id = module_id;
+            }
+            break;
+        }
+    }
+
+    if (app) {
+        ret = wm_ext_wasm_vfs_gpio_listen(app->ring, listen.mask, listen.edge);
+        if (!ret && listen.edge != WM_EXT_WASM_VFS_GPIO_EDGE_NONE) {
+            app->events = listen.events;
+            app->max_events = listen.max_events;
+        }
+    } else if (listen.edge == WM_EXT_WASM_VFS_GPIO_EDGE_NONE) {
+        /* The application doesn't listen to any pin */
+        ret = 0;
+    } else {
+        errno = EMFILE;
+        ret = -1;
+    }
+
+    pthread_mutex_unlock(&s_gpio_event_lock);
+
+    return ret;
+}
+
+static void gpio_event_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx)
+{
+    pthread_mutex_lock(&s_gpio_event_lock);
+
+    for (int i = 0; i < GPIO_EVENT_APPS; i++) {
+        if (s_gpio_event_app[i].ring && s_gpio_event_app[i].owner == ctx) {
+            wm_ext_wasm_vfs_gpio_ring_destroy(s_gpio_event_app[i].ring);
+            memset(&s_gpio_event_app[i], 0, sizeof(gpio_event_app_t));
+        }
+    }
+
+    pthread_mutex_unlock(&s_gpio_event_lock);
+}
+#endif
+
+static int wasm_vfs_gpio_pins_ioctl(wasm_exec_env_t exec_env, int cmd, char *va_args)
+{
+    uint32_t addr;
+    wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!wasm_runtime_validate_native_addr(module_inst, va_args, 4)) {
+        ESP_LOGE(TAG, "failed to check addr of va_args");
+        errno = EINVAL;
+        return -1;
+    }
+
+    addr = WASM_VA_ARG(va_args, uint32_t);
+
+    return wm_ext_wasm_vfs_gpio_pins_ioctl(cmd, addr, &mem);
+}
+
 int wm_ext_wasm_gpio_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
 {
     int ret;
     data_seq_t *ds;
 
+    if (cmd == WM_EXT_WASM_VFS_GPIOCREAD || cmd == WM_EXT_WASM_VFS_GPIOCWRITE) {
+        return wasm_vfs_gpio_pins_ioctl(exec_env, cmd, va_args);
+    }
+#ifdef CONFIG_WASMACHINE_EXT_VFS_GPIO_EVENT
+    else if (cmd == WM_EXT_WASM_VFS_GPIOCSEVENT) {
+        return wasm_vfs_gpio_event_ioctl(exec_env, va_args);
+    }
+#endif
+
     ds = wm_ext_wasm_native_get_data_seq(exec_env, va_args);
     if (!ds) {
         errno = EINVAL;
@@ -53,12 +347,340 @@ int wm_ext_wasm_gpio_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_a
 }
 #endif
 
+#if defined(CONFIG_EXTENDED_VFS_I2C) || defined(CONFIG_EXTENDED_VFS_SPI)
+#define PREPARED_XFERS  CONFIG_WASMACHINE_EXT_VFS_PREPARED_XFERS
+
+#ifdef CONFIG_EXTENDED_VFS_SPI
+/* Run an SPI exchange of buffers in linear memory, through bounce buffers if DMA can't use them */
+static int wasm_vfs_spi_exchange(int fd, spi_ex_msg_t *msg)
+{
+#ifdef CONFIG_WASMACHINE_EXT_VFS_DMA_POOL
+    int ret;
+    wm_ext_wasm_vfs_dma_buf_t tx;
+    wm_ext_wasm_vfs_dma_buf_t rx;
+    spi_ex_msg_t dma_msg = *msg;
+
+    wm_ext_wasm_vfs_dma_map(&tx, (void *)msg->tx_buffer, msg->tx_buffer ? msg->size : 0, true);
+    wm_ext_wasm_vfs_dma_map(&rx, msg->rx_buffer, msg->rx_buffer ? msg->size : 0, false);
+    dma_msg.tx_buffer = tx.dma;
+    dma_msg.rx_buffer = rx.dma;
+
+    ret = ioctl(fd, SPIIOCEXCHANGE, &dma_msg);
+
+    wm_ext_wasm_vfs_dma_unmap(&tx, false);
+    wm_ext_wasm_vfs_dma_unmap(&rx, ret >= 0);
+    msg->size = dma_msg.size;
+
+    return ret;
+#else
+    return ioctl(fd, SPIIOCEXCHANGE, msg);
+#endif
+}
+#endif
+
+static int wasm_vfs_batch_exec(int fd, int cmd, void *msg)
+{
+#ifdef CONFIG_EXTENDED_VFS_SPI
+    if (cmd == SPIIOCEXCHANGE) {
+        return wasm_vfs_spi_exchange(fd, (spi_ex_msg_t *)msg);
+    }
+#endif
+
+    return ioctl(fd, cmd, msg);
+}
+
+static int wasm_vfs_batch_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
+{
+    uint32_t addr;
+    wm_ext_wasm_vfs_batch_t batch;
+    wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!wasm_runtime_validate_native_addr(module_inst, va_args, 4)) {
+        ESP_LOGE(TAG, "failed to check addr of va_args");
+        errno = EINVAL;
+        return -1;
+    }
+
+    addr = WASM_VA_ARG(va_args, uint32_t);
+    if (!wasm_runtime_validate_app_addr(module_inst, addr, sizeof(wm_ext_wasm_vfs_batch_t))) {
+        errno = EFAULT;
+        return -1;
+    }
+
+    memcpy(&batch, addr_app_to_native(addr), sizeof(wm_ext_wasm_vfs_batch_t));
+
+    return wm_ext_wasm_vfs_batch_run(fd, cmd, &batch, &mem, wasm_vfs_batch_exec);
+}
+
+static int wasm_vfs_prepare_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
+{
+    int id = -1;
+    uint32_t addr;
+    wm_ext_wasm_vfs_xfer_t xfer;
+    wm_ext_wasm_vfs_prepared_t *prepared;
+    wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(module_inst);
+
+    if (!ctx) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (!wasm_runtime_validate_native_addr(module_inst, va_args, 4)) {
+        ESP_LOGE(TAG, "failed to check addr of va_args");
+        errno = EINVAL;
+        return -1;
+    }
+
+    addr = WASM_VA_ARG(va_args, uint32_t);
+    if (!wasm_runtime_validate_app_addr(module_inst, addr, sizeof(wm_ext_wasm_vfs_xfer_t))) {
+        errno = EFAULT;
+        return -1;
+    }
+
+    memcpy(&xfer, addr_app_to_native(addr), sizeof(wm_ext_wasm_vfs_xfer_t));
+
+    prepared = malloc(sizeof(wm_ext_wasm_vfs_prepared_t));
+    if (!prepared) {
+        errno = ENOMEM;
+        return -1;
+    }
+
+    if (wm_ext_wasm_vfs_xfer_prepare(fd, cmd, &xfer, &mem, prepared) < 0) {
+        free(prepared);
+        return -1;
+    }
+
+    pthread_mutex_lock(&ctx->vfs_xfer_lock);
+
+    for (int i = 0; i < PREPARED_XFERS; i++) {
+        if (!ctx->vfs_xfer[i]) {
+            ctx->vfs_xfer[i] = prepared;
+            id = i;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&ctx->vfs_xfer_lock);
+
+    if (id < 0) {
+        free(prepared);
+        errno = EMFILE;
+    }
+
+    return id;
+}
+
+int wm_ext_wasm_vfs_xfer_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
+{
+    int ret;
+    int id;
+    uint32_t len = 0;
+    wm_ext_wasm_vfs_prepared_t *prepared = NULL;
+    wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    wm_ext_wasm_native_ctx_t *ctx = wm_ext_wasm_native_get_ctx(module_inst);
+    uint32_t args_size = cmd == WM_EXT_WASM_VFS_IOCXFER ? 8 : 4;
+
+    if (!wasm_runtime_validate_native_addr(module_inst, va_args, args_size)) {
+        ESP_LOGE(TAG, "failed to check addr of va_args");
+        errno = EINVAL;
+        return -1;
+    }
+
+    id = WASM_VA_ARG(va_args, int32_t);
+    if (cmd == WM_EXT_WASM_VFS_IOCXFER) {
+        len = WASM_VA_ARG(va_args, uint32_t);
+    }
+
+    if (!ctx || id < 0 || id >= PREPARED_XFERS) {
+        errno = EBADF;
+        return -1;
+    }
+
+    /*
+     * Mark the transfer busy, and take it out of its slot to free it, so other threads
+     * of the application can't free a transfer while it's running. The slot is only
+     * looked up under the lock, a run clears the busy flag without it.
+     */
+    pthread_mutex_lock(&ctx->vfs_xfer_lock);
+
+    prepared = ctx->vfs_xfer[id];
+    if (!prepared || prepared->fd != fd) {
+        prepared = NULL;
+        errno = EBADF;
+    } else if (atomic_exchange(&prepared->busy, true)) {
+        prepared = NULL;
+        errno = EBUSY;
+    } else if (cmd == WM_EXT_WASM_VFS_IOCUNPREPARE) {
+        ctx->vfs_xfer[id] = NULL;
+    }
+
+    pthread_mutex_unlock(&ctx->vfs_xfer_lock);
+
+    if (!prepared) {
+        return -1;
+    } else if (cmd == WM_EXT_WASM_VFS_IOCUNPREPARE) {
+        free(prepared);
+        return 0;
+    }
+
+    ret = wm_ext_wasm_vfs_xfer_run(prepared, len, &mem, wasm_vfs_batch_exec);
+
+    atomic_store_explicit(&prepared->busy, false, memory_order_release);
+
+    return ret;
+}
+
+static void wasm_vfs_xfer_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx)
+{
+    for (int i = 0; i < PREPARED_XFERS; i++) {
+        if (ctx->vfs_xfer[i]) {
+            free(ctx->vfs_xfer[i]);
+            ctx->vfs_xfer[i] = NULL;
+        }
+    }
+}
+#endif
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_DMA_POOL
+int wm_ext_wasm_vfs_dma_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
+{
+    uint32_t addr;
+    wm_ext_wasm_vfs_dma_stats_t stats;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+
+    if (!wasm_runtime_validate_native_addr(module_inst, va_args, 4)) {
+        ESP_LOGE(TAG, "failed to check addr of va_args");
+        errno = EINVAL;
+        return -1;
+    }
+
+    addr = WASM_VA_ARG(va_args, uint32_t);
+    if (!wasm_runtime_validate_app_addr(module_inst, addr, sizeof(wm_ext_wasm_vfs_dma_stats_t))) {
+        errno = EFAULT;
+        return -1;
+    }
+
+    wm_ext_wasm_vfs_dma_get_stats(&stats, false);
+    memcpy(addr_app_to_native(addr), &stats, sizeof(wm_ext_wasm_vfs_dma_stats_t));
+
+    return 0;
+}
+#endif
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_STREAM
+/* Linear memory which can't grow never moves, so the sampling thread can write it */
+static bool wasm_vfs_stream_mem_fixed(wasm_module_inst_t module_inst)
+{
+    wasm_memory_inst_t memory = wasm_runtime_get_default_memory(module_inst);
+
+    return memory && wasm_memory_get_cur_page_count(memory) == wasm_memory_get_max_page_count(memory);
+}
+
+int wm_ext_wasm_vfs_stream_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
+{
+    int ret;
+    uint32_t addr;
+    uint64_t window_size;
+    wm_ext_wasm_vfs_stream_start_t start;
+    wm_ext_wasm_vfs_stream_wait_t wait;
+    wm_ext_wasm_vfs_stream_stats_t stats;
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    wm_ext_wasm_native_mem_t mem = WM_EXT_WASM_NATIVE_MEM_INIT(exec_env);
+
+    if (cmd == WM_EXT_WASM_VFS_STREAMIOCSTOP) {
+        return ioctl(fd, cmd, NULL);
+    }
+
+    if (!wasm_runtime_validate_native_addr(module_inst, va_args, 4)) {
+        ESP_LOGE(TAG, "failed to check addr of va_args");
+        errno = EINVAL;
+        return -1;
+    }
+
+    addr = WASM_VA_ARG(va_args, uint32_t);
+
+    if (cmd == WM_EXT_WASM_VFS_STREAMIOCSTART) {
+        if (!wasm_runtime_validate_app_addr(module_inst, addr, sizeof(wm_ext_wasm_vfs_stream_cfg_t))) {
+            errno = EFAULT;
+            return -1;
+        }
+
+        memset(&start, 0, sizeof(wm_ext_wasm_vfs_stream_start_t));
+        memcpy(&start.cfg, addr_app_to_native(addr), sizeof(wm_ext_wasm_vfs_stream_cfg_t));
+
+        if (start.cfg.window) {
+            window_size = (uint64_t)start.cfg.blocks * start.cfg.block_samples * sizeof(uint16_t);
+            if (window_size > UINT32_MAX ||
+                    !wasm_runtime_validate_app_addr(module_inst, start.cfg.window, window_size)) {
+                errno = EFAULT;
+                return -1;
+            }
+
+            start.fixed = wasm_vfs_stream_mem_fixed(module_inst);
+        }
+
+        /* Streams of the application are closed with its context, see wm_ext_wasm_vfs_ctx_destroy() */
+        start.owner = wm_ext_wasm_native_get_ctx(module_inst);
+        if (!start.owner) {
+            errno = ENOMEM;
+            return -1;
+        }
+
+        start.fd = fd;
+
+        if (!wm_ext_wasm_native_mem_resolve(&mem)) {
+            errno = EFAULT;
+            return -1;
+        }
+
+        start.mem_base = mem.base;
+        ret = ioctl(fd, cmd, &start);
+    } else if (cmd == WM_EXT_WASM_VFS_STREAMIOCNEXT) {
+        if (!wasm_runtime_validate_app_addr(module_inst, addr, sizeof(wm_ext_wasm_vfs_stream_next_t)) ||
+                !wm_ext_wasm_native_mem_resolve(&mem)) {
+            errno = EFAULT;
+            return -1;
+        }
+
+        memcpy(&wait.next, addr_app_to_native(addr), sizeof(wm_ext_wasm_vfs_stream_next_t));
+        wait.mem_base = mem.base;
+
+        ret = ioctl(fd, cmd, &wait);
+        if (!ret) {
+            memcpy(addr_app_to_native(addr), &wait.next, sizeof(wm_ext_wasm_vfs_stream_next_t));
+        }
+    } else {
+        if (!wasm_runtime_validate_app_addr(module_inst, addr, sizeof(wm_ext_wasm_vfs_stream_stats_t))) {
+            errno = EFAULT;
+            return -1;
+        }
+
+        ret = ioctl(fd, cmd, &stats);
+        if (!ret) {
+            memcpy(addr_app_to_native(addr), &stats, sizeof(wm_ext_wasm_vfs_stream_stats_t));
+        }
+    }
+
+    return ret;
+}
+#endif
+
 #ifdef CONFIG_EXTENDED_VFS_I2C
 int wm_ext_wasm_i2c_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char *va_args)
 {
     int ret;
     data_seq_t *ds;
 
+    if (cmd == WM_EXT_WASM_VFS_I2CIOCBATCH) {
+        return wasm_vfs_batch_ioctl(exec_env, fd, cmd, va_args);
+    } else if (cmd == WM_EXT_WASM_VFS_I2CIOCPREPARE) {
+        return wasm_vfs_prepare_ioctl(exec_env, fd, WM_EXT_WASM_VFS_I2CIOCBATCH, va_args);
+    }
+
     ds = wm_ext_wasm_native_get_data_seq(exec_env, va_args);
     if (!ds) {
         errno = EINVAL;
@@ -139,6 +761,12 @@ int wm_ext_wasm_native_spi_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char
     int ret;
     data_seq_t *ds;
 
+    if (cmd == WM_EXT_WASM_VFS_SPIIOCBATCH) {
+        return wasm_vfs_batch_ioctl(exec_env, fd, cmd, va_args);
+    } else if (cmd == WM_EXT_WASM_VFS_SPIIOCPREPARE) {
+        return wasm_vfs_prepare_ioctl(exec_env, fd, WM_EXT_WASM_VFS_SPIIOCBATCH, va_args);
+    }
+
     ds = wm_ext_wasm_native_get_data_seq(exec_env, va_args);
     if (!ds) {
         errno = EINVAL;
@@ -179,7 +807,7 @@ int wm_ext_wasm_native_spi_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, char
             return -1;
         }
 
-        ret = ioctl(fd, cmd, &ex_msg);
+        ret = wasm_vfs_spi_exchange(fd, &ex_msg);
 
         DATA_SEQ_FORCE_UPDATE(ds, DATA_SEQ_SPI_EX_MSG_SIZE, ex_msg.size);
     } else {
@@ -279,4 +907,19 @@ int wm_ext_wasm_native_ledc_ioctl(wasm_exec_env_t exec_env, int fd, int cmd, cha
     return ret;
 }
 #endif
+
+void wm_ext_wasm_vfs_ctx_destroy(wm_ext_wasm_native_ctx_t *ctx)
+{
+#if defined(CONFIG_EXTENDED_VFS_I2C) || defined(CONFIG_EXTENDED_VFS_SPI)
+    wasm_vfs_xfer_ctx_destroy(ctx);
+#endif
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_GPIO_EVENT
+    gpio_event_ctx_destroy(ctx);
+#endif
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_STREAM
+    wm_ext_wasm_vfs_stream_detach(ctx);
+#endif
+}
 #endif
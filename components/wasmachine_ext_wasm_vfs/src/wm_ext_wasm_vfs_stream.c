@@ -0,0 +1,859 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "sdkconfig.h"
+
+#ifdef CONFIG_WASMACHINE_EXT_VFS_STREAM
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+#ifndef CONFIG_IDF_TARGET_LINUX
+#include "esp_vfs.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "esp_idf_version.h"
+#include "soc/soc_caps.h"
+#if SOC_ADC_DMA_SUPPORTED
+#include "esp_adc/adc_continuous.h"
+#endif
+#endif
+
+#include "wm_ext_wasm_vfs_stream.h"
+
+/*
+ * A thread of each stream reads samples from the backend into a ring of blocks. The
+ * ring is the window of the application if its linear memory can't move, so blocks
+ * are sampled into linear memory and taken in place. Otherwise the ring is in native
+ * memory, and a block is copied once into the window or the buffer of read() by the
+ * thread of the application. When the ring is full, blocks are sampled into a spare
+ * block and dropped, so the backend is never stalled.
+ */
+
+#define STREAM_MAX          CONFIG_WASMACHINE_EXT_VFS_STREAM_MAX
+#define STREAM_RING_SIZE    CONFIG_WASMACHINE_EXT_VFS_STREAM_MAX_RING_SIZE
+#define STREAM_POLL_US      10000
+
+struct wm_ext_wasm_vfs_stream {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;                    /*!< Signaled when a block is put or sampling stops */
+    pthread_t tid;
+    bool started;                           /*!< Sampling thread is created and not joined */
+    bool running;                           /*!< Sampling thread is sampling */
+    bool stop;                              /*!< Sampling thread is asked to stop */
+    bool held;                              /*!< Block at tail is taken by the window */
+
+    const wm_ext_wasm_vfs_stream_backend_t *backend;
+    void *priv;
+
+    wm_ext_wasm_vfs_stream_cfg_t cfg;
+    uint32_t block_size;                    /*!< Bytes of a block */
+    uint8_t *ring;                          /*!< Blocks of the ring, in the window if zero_copy */
+    uint8_t *native;                        /*!< Native memory of the ring, NULL if zero_copy */
+    uint8_t *spare;                         /*!< Block which is sampled into when the ring is full */
+    uint32_t *seq;                          /*!< Sequence number of each block of the ring */
+    uint32_t head;                          /*!< Blocks which were put */
+    uint32_t tail;                          /*!< Blocks which were taken */
+    uint32_t next_seq;                      /*!< Sequence number of the block which is sampled */
+    void *owner;                            /*!< Owner of the stream and linear memory of the window */
+    int fd;                                 /*!< File descriptor which the owner opened the stream by */
+
+    wm_ext_wasm_vfs_stream_stats_t stats;
+};
+
+static const char *TAG = "wm_vfs_stream";
+
+static pthread_mutex_t s_stream_lock = PTHREAD_MUTEX_INITIALIZER;
+static wm_ext_wasm_vfs_stream_t *s_stream[STREAM_MAX];
+
+static const wm_ext_wasm_vfs_stream_backend_t *s_stream_backend[WM_EXT_WASM_VFS_STREAM_BACKEND_MAX];
+
+static int64_t stream_now_us(void)
+{
+#ifdef CONFIG_IDF_TARGET_LINUX
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#else
+    return esp_timer_get_time();
+#endif
+}
+
+/* Simulation, which produces samples at rate_hz or as fast as possible if it's 0 */
+typedef struct stream_sim {
+    uint32_t rate_hz;
+    int64_t start_us;
+    uint64_t produced;
+} stream_sim_t;
+
+static esp_err_t stream_sim_start(void **priv, const wm_ext_wasm_vfs_stream_cfg_t *cfg)
+{
+    stream_sim_t *sim = calloc(1, sizeof(stream_sim_t));
+
+    if (!sim) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    sim->rate_hz = cfg->rate_hz;
+    sim->start_us = stream_now_us();
+    *priv = sim;
+
+    return ESP_OK;
+}
+
+static int stream_sim_read(void *priv, uint16_t *samples, uint32_t num, uint32_t *lost)
+{
+    uint64_t due;
+    stream_sim_t *sim = (stream_sim_t *)priv;
+
+    *lost = 0;
+
+    if (sim->rate_hz) {
+        due = (uint64_t)(stream_now_us() - sim->start_us) * sim->rate_hz / 1000000 - sim->produced;
+        if (!due) {
+            /* Sleep until the next sample, but return in time to check for stop */
+            uint64_t wait_us = (sim->produced + 1) * 1000000 / sim->rate_hz -
+                               (uint64_t)(stream_now_us() - sim->start_us);
+
+            usleep(wait_us < STREAM_POLL_US ? wait_us : STREAM_POLL_US);
+            return 0;
+        } else if (due < num) {
+            num = due;
+        }
+    }
+
+    for (uint32_t i = 0; i < num; i++) {
+        samples[i] = (uint16_t)(sim->produced + i);
+    }
+
+    sim->produced += num;
+
+    return num;
+}
+
+static void stream_sim_stop(void *priv)
+{
+    free(priv);
+}
+
+static const wm_ext_wasm_vfs_stream_backend_t s_stream_sim = {
+    .start = stream_sim_start,
+    .read = stream_sim_read,
+    .stop = stream_sim_stop,
+};
+
+#if !defined(CONFIG_IDF_TARGET_LINUX) && SOC_ADC_DMA_SUPPORTED
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define STREAM_ADC_FORMAT       ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define STREAM_ADC_DATA(p)      ((p)->type1.data)
+#define STREAM_ADC_CHANNEL(p)   ((p)->type1.channel)
+#else
+#define STREAM_ADC_FORMAT       ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define STREAM_ADC_DATA(p)      ((p)->type2.data)
+#define STREAM_ADC_CHANNEL(p)   ((p)->type2.channel)
+#endif
+
+#define STREAM_ADC_CHANNEL_SHIFT    12
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 2, 0)
+#define STREAM_ADC_ATTEN        ADC_ATTEN_DB_12
+#else
+#define STREAM_ADC_ATTEN        ADC_ATTEN_DB_11
+#endif
+
+#define STREAM_ADC_RESULT_SIZE  SOC_ADC_DIGI_RESULT_BYTES
+
+/* ADC unit 1 in continuous mode, its driver keeps a pool of frames which DMA fills */
+typedef struct stream_adc {
+    adc_continuous_handle_t handle;
+    uint32_t frame_samples;
+    volatile uint32_t overflows;            /*!< Frames dropped by the driver, counted in ISR */
+    uint32_t overflows_read;
+    uint8_t *raw;
+} stream_adc_t;
+
+static bool IRAM_ATTR stream_adc_on_pool_ovf(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *arg)
+{
+    stream_adc_t *adc = (stream_adc_t *)arg;
+
+    adc->overflows++;
+
+    return false;
+}
+
+static void stream_adc_stop(void *priv)
+{
+    stream_adc_t *adc = (stream_adc_t *)priv;
+
+    if (adc->handle) {
+        adc_continuous_stop(adc->handle);
+        adc_continuous_deinit(adc->handle);
+    }
+
+    free(adc->raw);
+    free(adc);
+}
+
+static esp_err_t stream_adc_start(void **priv, const wm_ext_wasm_vfs_stream_cfg_t *cfg)
+{
+    esp_err_t ret;
+    uint32_t num = 0;
+    stream_adc_t *adc;
+    adc_digi_pattern_config_t pattern[SOC_ADC_PATT_LEN_MAX];
+
+    if (!cfg->channels || cfg->channels >> SOC_ADC_CHANNEL_NUM(0) ||
+            __builtin_popcount(cfg->channels) > SOC_ADC_PATT_LEN_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (uint32_t m = cfg->channels; m; m &= m - 1) {
+        pattern[num].atten = STREAM_ADC_ATTEN;
+        pattern[num].channel = __builtin_ctz(m);
+        pattern[num].unit = ADC_UNIT_1;
+        pattern[num].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        num++;
+    }
+
+    adc = calloc(1, sizeof(stream_adc_t));
+    if (!adc) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    adc->frame_samples = cfg->block_samples;
+    adc->raw = malloc(adc->frame_samples * STREAM_ADC_RESULT_SIZE);
+    if (!adc->raw) {
+        ret = ESP_ERR_NO_MEM;
+        goto errout;
+    }
+
+    adc_continuous_handle_cfg_t handle_cfg = {
+        .max_store_buf_size = adc->frame_samples * STREAM_ADC_RESULT_SIZE * 4,
+        .conv_frame_size = adc->frame_samples * STREAM_ADC_RESULT_SIZE,
+    };
+    ret = adc_continuous_new_handle(&handle_cfg, &adc->handle);
+    if (ret != ESP_OK) {
+        goto errout;
+    }
+
+    adc_continuous_config_t dig_cfg = {
+        .pattern_num = num,
+        .adc_pattern = pattern,
+        .sample_freq_hz = cfg->rate_hz * num,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = STREAM_ADC_FORMAT,
+    };
+    ret = adc_continuous_config(adc->handle, &dig_cfg);
+    if (ret != ESP_OK) {
+        goto errout;
+    }
+
+    adc_continuous_evt_cbs_t cbs = {
+        .on_pool_ovf = stream_adc_on_pool_ovf,
+    };
+    ret = adc_continuous_register_event_callbacks(adc->handle, &cbs, adc);
+    if (ret != ESP_OK) {
+        goto errout;
+    }
+
+    ret = adc_continuous_start(adc->handle);
+    if (ret != ESP_OK) {
+        goto errout;
+    }
+
+    *priv = adc;
+
+    return ESP_OK;
+
+errout:
+    stream_adc_stop(adc);
+    return ret;
+}
+
+static int stream_adc_read(void *priv, uint16_t *samples, uint32_t num, uint32_t *lost)
+{
+    esp_err_t ret;
+    uint32_t n;
+    uint32_t size;
+    uint32_t overflows;
+    stream_adc_t *adc = (stream_adc_t *)priv;
+
+    overflows = adc->overflows;
+    *lost = (overflows - adc->overflows_read) * adc->frame_samples;
+    adc->overflows_read = overflows;
+
+    ret = adc_continuous_read(adc->handle, adc->raw, num * STREAM_ADC_RESULT_SIZE, &size, STREAM_POLL_US / 1000);
+    if (ret == ESP_ERR_TIMEOUT) {
+        return 0;
+    } else if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "failed to read ADC: %s", esp_err_to_name(ret));
+        return -1;
+    }
+
+    n = size / STREAM_ADC_RESULT_SIZE;
+    for (uint32_t i = 0; i < n; i++) {
+        adc_digi_output_data_t *p = (adc_digi_output_data_t *)&adc->raw[i * STREAM_ADC_RESULT_SIZE];
+
+        samples[i] = STREAM_ADC_CHANNEL(p) << STREAM_ADC_CHANNEL_SHIFT | STREAM_ADC_DATA(p);
+    }
+
+    return n;
+}
+
+static const wm_ext_wasm_vfs_stream_backend_t s_stream_adc = {
+    .start = stream_adc_start,
+    .read = stream_adc_read,
+    .stop = stream_adc_stop,
+};
+#endif
+
+static const wm_ext_wasm_vfs_stream_backend_t *stream_get_backend(uint32_t type)
+{
+    if (type >= WM_EXT_WASM_VFS_STREAM_BACKEND_MAX) {
+        return NULL;
+    } else if (s_stream_backend[type]) {
+        return s_stream_backend[type];
+    } else if (type == WM_EXT_WASM_VFS_STREAM_SIM) {
+        return &s_stream_sim;
+    }
+
+#if !defined(CONFIG_IDF_TARGET_LINUX) && SOC_ADC_DMA_SUPPORTED
+    return &s_stream_adc;
+#else
+    return NULL;
+#endif
+}
+
+static void *stream_thread(void *arg)
+{
+    int n;
+    uint32_t lost;
+    uint32_t fill = 0;
+    uint8_t *block = NULL;
+    wm_ext_wasm_vfs_stream_t *stream = (wm_ext_wasm_vfs_stream_t *)arg;
+    uint32_t blocks = stream->cfg.blocks;
+    uint32_t block_samples = stream->cfg.block_samples;
+
+    pthread_mutex_lock(&stream->lock);
+
+    while (!stream->stop) {
+        /* Blocks between tail and head are not written, including the block of the window */
+        if (!block) {
+            block = stream->head - stream->tail < blocks ?
+                    stream->ring + (stream->head % blocks) * stream->block_size : stream->spare;
+            fill = 0;
+        }
+
+        pthread_mutex_unlock(&stream->lock);
+
+        n = stream->backend->read(stream->priv, (uint16_t *)block + fill, block_samples - fill, &lost);
+
+        pthread_mutex_lock(&stream->lock);
+
+        if (n < 0) {
+            break;
+        }
+
+        fill += n;
+        stream->stats.samples += n;
+        stream->stats.lost_samples += lost;
+
+        if (fill == block_samples) {
+            if (block == stream->spare) {
+                stream->stats.overruns++;
+            } else {
+                stream->seq[stream->head % blocks] = stream->next_seq;
+                stream->head++;
+                stream->stats.blocks++;
+                pthread_cond_broadcast(&stream->cond);
+            }
+
+            stream->next_seq++;
+            block = NULL;
+        }
+    }
+
+    stream->running = false;
+    pthread_cond_broadcast(&stream->cond);
+
+    pthread_mutex_unlock(&stream->lock);
+
+    return NULL;
+}
+
+/* Wait for a block with the lock held, it returns 0 or an error number */
+static int stream_wait(wm_ext_wasm_vfs_stream_t *stream, int32_t timeout_ms)
+{
+    struct timespec ts;
+
+    if (timeout_ms > 0) {
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_sec += timeout_ms / 1000;
+        ts.tv_nsec += (timeout_ms % 1000) * 1000000;
+        if (ts.tv_nsec >= 1000000000) {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+    }
+
+    while (stream->head == stream->tail) {
+        if (!stream->running) {
+            return ENODATA;
+        } else if (!timeout_ms) {
+            return EAGAIN;
+        } else if (timeout_ms < 0) {
+            pthread_cond_wait(&stream->cond, &stream->lock);
+        } else if (pthread_cond_timedwait(&stream->cond, &stream->lock, &ts) == ETIMEDOUT) {
+            return stream->head == stream->tail ? ETIMEDOUT : 0;
+        }
+    }
+
+    return 0;
+}
+
+/* Release the block of the window with the lock held */
+static void stream_release(wm_ext_wasm_vfs_stream_t *stream)
+{
+    if (stream->held) {
+        stream->held = false;
+        stream->tail++;
+    }
+}
+
+static void stream_free_ring(wm_ext_wasm_vfs_stream_t *stream)
+{
+    free(stream->native);
+    free(stream->spare);
+    free(stream->seq);
+    stream->native = NULL;
+    stream->ring = NULL;
+    stream->spare = NULL;
+    stream->seq = NULL;
+    stream->head = stream->tail;
+}
+
+wm_ext_wasm_vfs_stream_t *wm_ext_wasm_vfs_stream_create(void)
+{
+    wm_ext_wasm_vfs_stream_t *stream;
+
+    stream = calloc(1, sizeof(wm_ext_wasm_vfs_stream_t));
+    if (!stream) {
+        errno = ENOMEM;
+        return NULL;
+    }
+
+    pthread_mutex_init(&stream->lock, NULL);
+    pthread_cond_init(&stream->cond, NULL);
+
+    pthread_mutex_lock(&s_stream_lock);
+
+    for (int i = 0; i < STREAM_MAX; i++) {
+        if (!s_stream[i]) {
+            s_stream[i] = stream;
+            pthread_mutex_unlock(&s_stream_lock);
+            return stream;
+        }
+    }
+
+    pthread_mutex_unlock(&s_stream_lock);
+
+    pthread_cond_destroy(&stream->cond);
+    pthread_mutex_destroy(&stream->lock);
+    free(stream);
+
+    errno = EMFILE;
+    return NULL;
+}
+
+void wm_ext_wasm_vfs_stream_destroy(wm_ext_wasm_vfs_stream_t *stream)
+{
+    wm_ext_wasm_vfs_stream_stop(stream);
+
+    pthread_mutex_lock(&s_stream_lock);
+
+    for (int i = 0; i < STREAM_MAX; i++) {
+        if (s_stream[i] == stream) {
+            s_stream[i] = NULL;
+        }
+    }
+
+    pthread_mutex_unlock(&s_stream_lock);
+
+    stream_free_ring(stream);
+    pthread_cond_destroy(&stream->cond);
+    pthread_mutex_destroy(&stream->lock);
+    free(stream);
+}
+
+int wm_ext_wasm_vfs_stream_start(wm_ext_wasm_vfs_stream_t *stream, const wm_ext_wasm_vfs_stream_start_t *start)
+{
+    esp_err_t err;
+    int ret = 0;
+    uint64_t ring_size;
+    const wm_ext_wasm_vfs_stream_cfg_t *cfg = &start->cfg;
+    const wm_ext_wasm_vfs_stream_backend_t *backend = stream_get_backend(cfg->backend);
+
+    ring_size = (uint64_t)cfg->blocks * cfg->block_samples * sizeof(uint16_t);
+    if (cfg->blocks < 2 || !cfg->block_samples || ring_size > STREAM_RING_SIZE) {
+        errno = EINVAL;
+        return -1;
+    } else if (!backend) {
+        errno = ENODEV;
+        return -1;
+    }
+
+    pthread_mutex_lock(&stream->lock);
+
+    if (stream->started || stream->running) {
+        ret = EBUSY;
+        goto out;
+    }
+
+    stream_free_ring(stream);
+
+    stream->cfg = *cfg;
+    stream->block_size = cfg->block_samples * sizeof(uint16_t);
+    stream->native = cfg->window && start->fixed ? NULL : malloc(ring_size);
+    stream->ring = stream->native ? stream->native : start->mem_base + cfg->window;
+    stream->spare = malloc(stream->block_size);
+    stream->seq = malloc(cfg->blocks * sizeof(uint32_t));
+    stream->head = 0;
+    stream->tail = 0;
+    stream->held = false;
+    stream->next_seq = 0;
+    stream->owner = start->owner;
+    stream->fd = start->fd;
+    memset(&stream->stats, 0, sizeof(wm_ext_wasm_vfs_stream_stats_t));
+    stream->stats.zero_copy = !stream->native;
+
+    if ((!stream->native && !(cfg->window && start->fixed)) || !stream->spare || !stream->seq) {
+        ret = ENOMEM;
+        goto out;
+    }
+
+    err = backend->start(&stream->priv, cfg);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "failed to start backend %"PRIu32": %s", cfg->backend, esp_err_to_name(err));
+        ret = err == ESP_ERR_NO_MEM ? ENOMEM : err == ESP_ERR_INVALID_ARG ? EINVAL : EIO;
+        goto out;
+    }
+
+    stream->backend = backend;
+    stream->stop = false;
+    stream->running = true;
+    if (pthread_create(&stream->tid, NULL, stream_thread, stream) != 0) {
+        stream->running = false;
+        backend->stop(stream->priv);
+        ret = ENOMEM;
+        goto out;
+    }
+
+    stream->started = true;
+
+out:
+    if (ret && ret != EBUSY) {
+        stream_free_ring(stream);
+    }
+
+    pthread_mutex_unlock(&stream->lock);
+
+    if (ret) {
+        errno = ret;
+        return -1;
+    }
+
+    return 0;
+}
+
+int wm_ext_wasm_vfs_stream_stop(wm_ext_wasm_vfs_stream_t *stream)
+{
+    void *priv;
+    pthread_t tid;
+    const wm_ext_wasm_vfs_stream_backend_t *backend;
+
+    pthread_mutex_lock(&stream->lock);
+
+    if (!stream->started) {
+        pthread_mutex_unlock(&stream->lock);
+        return 0;
+    }
+
+    /* Only one caller joins the thread, and start fails until it has exited */
+    tid = stream->tid;
+    priv = stream->priv;
+    backend = stream->backend;
+    stream->started = false;
+    stream->stop = true;
+
+    pthread_mutex_unlock(&stream->lock);
+
+    pthread_join(tid, NULL);
+    backend->stop(priv);
+
+    return 0;
+}
+
+int wm_ext_wasm_vfs_stream_next(wm_ext_wasm_vfs_stream_t *stream, wm_ext_wasm_vfs_stream_next_t *next, uint8_t *mem_base)
+{
+    int ret;
+    uint32_t index;
+
+    pthread_mutex_lock(&stream->lock);
+
+    if (!stream->cfg.window || !stream->seq) {
+        ret = EINVAL;
+        goto out;
+    }
+
+    stream_release(stream);
+
+    ret = stream_wait(stream, next->timeout_ms);
+    if (ret) {
+        goto out;
+    }
+
+    index = stream->tail % stream->cfg.blocks;
+    if (stream->native) {
+        memcpy(mem_base + stream->cfg.window + index * stream->block_size,
+               stream->native + index * stream->block_size, stream->block_size);
+    }
+
+    stream->held = true;
+    next->index = index;
+    next->seq = stream->seq[index];
+    next->overruns = stream->stats.overruns;
+
+out:
+    pthread_mutex_unlock(&stream->lock);
+
+    if (ret) {
+        errno = ret;
+        return -1;
+    }
+
+    return 0;
+}
+
+ssize_t wm_ext_wasm_vfs_stream_read(wm_ext_wasm_vfs_stream_t *stream, void *buf, size_t len, bool nonblock)
+{
+    int ret;
+    ssize_t size = 0;
+
+    pthread_mutex_lock(&stream->lock);
+
+    if (!stream->seq || len < stream->block_size) {
+        ret = EINVAL;
+        goto out;
+    }
+
+    stream_release(stream);
+
+    ret = stream_wait(stream, nonblock ? 0 : -1);
+    if (ret == ENODATA) {
+        ret = 0;
+        goto out;
+    } else if (ret) {
+        goto out;
+    }
+
+    memcpy(buf, stream->ring + (stream->tail % stream->cfg.blocks) * stream->block_size, stream->block_size);
+    stream->tail++;
+    size = stream->block_size;
+
+out:
+    pthread_mutex_unlock(&stream->lock);
+
+    if (ret) {
+        errno = ret;
+        return -1;
+    }
+
+    return size;
+}
+
+void wm_ext_wasm_vfs_stream_get_stats(wm_ext_wasm_vfs_stream_t *stream, wm_ext_wasm_vfs_stream_stats_t *stats)
+{
+    pthread_mutex_lock(&stream->lock);
+    *stats = stream->stats;
+    pthread_mutex_unlock(&stream->lock);
+}
+
+void wm_ext_wasm_vfs_stream_detach(void *owner)
+{
+    wm_ext_wasm_vfs_stream_t *stream[STREAM_MAX];
+    int fd[STREAM_MAX];
+    int num = 0;
+
+    pthread_mutex_lock(&s_stream_lock);
+
+    for (int i = 0; i < STREAM_MAX; i++) {
+        if (!s_stream[i]) {
+            continue;
+        }
+
+        pthread_mutex_lock(&s_stream[i]->lock);
+        if (owner && s_stream[i]->owner == owner) {
+            stream[num] = s_stream[i];
+            fd[num++] = s_stream[i]->fd;
+        }
+        pthread_mutex_unlock(&s_stream[i]->lock);
+    }
+
+    pthread_mutex_unlock(&s_stream_lock);
+
+    /*
+     * The owner is gone, so nothing else closes its streams. Closing the file descriptor
+     * destroys the stream by stream_vfs_close() and frees the descriptor of VFS as well.
+     */
+    for (int i = 0; i < num; i++) {
+        if (fd[i] >= 0) {
+            close(fd[i]);
+        } else {
+            wm_ext_wasm_vfs_stream_destroy(stream[i]);
+        }
+    }
+}
+
+void wm_ext_wasm_vfs_stream_set_backend(wm_ext_wasm_vfs_stream_backend_type_t type, const wm_ext_wasm_vfs_stream_backend_t *backend)
+{
+    if (type < WM_EXT_WASM_VFS_STREAM_BACKEND_MAX) {
+        s_stream_backend[type] = backend;
+    }
+}
+
+#ifndef CONFIG_IDF_TARGET_LINUX
+static bool s_stream_nonblock[STREAM_MAX];
+
+static wm_ext_wasm_vfs_stream_t *stream_vfs_get(int fd)
+{
+    wm_ext_wasm_vfs_stream_t *stream;
+
+    if (fd < 0 || fd >= STREAM_MAX) {
+        return NULL;
+    }
+
+    pthread_mutex_lock(&s_stream_lock);
+    stream = s_stream[fd];
+    pthread_mutex_unlock(&s_stream_lock);
+
+    return stream;
+}
+
+static int stream_vfs_open(const char *path, int flags, int mode)
+{
+    wm_ext_wasm_vfs_stream_t *stream;
+
+    if (path[0] && strcmp(path, "/")) {
+        errno = ENOENT;
+        return -1;
+    }
+
+    stream = wm_ext_wasm_vfs_stream_create();
+    if (!stream) {
+        return -1;
+    }
+
+    pthread_mutex_lock(&s_stream_lock);
+
+    for (int i = 0; i < STREAM_MAX; i++) {
+        if (s_stream[i] == stream) {
+            s_stream_nonblock[i] = flags & O_NONBLOCK;
+            pthread_mutex_unlock(&s_stream_lock);
+            return i;
+        }
+    }
+
+    pthread_mutex_unlock(&s_stream_lock);
+
+    return -1;
+}
+
+static ssize_t stream_vfs_read(int fd, void *dst, size_t size)
+{
+    wm_ext_wasm_vfs_stream_t *stream = stream_vfs_get(fd);
+
+    if (!stream) {
+        errno = EBADF;
+        return -1;
+    }
+
+    return wm_ext_wasm_vfs_stream_read(stream, dst, size, s_stream_nonblock[fd]);
+}
+
+static int stream_vfs_close(int fd)
+{
+    wm_ext_wasm_vfs_stream_t *stream = stream_vfs_get(fd);
+
+    if (!stream) {
+        errno = EBADF;
+        return -1;
+    }
+
+    wm_ext_wasm_vfs_stream_destroy(stream);
+
+    return 0;
+}
+
+static int stream_vfs_ioctl(int fd, int cmd, va_list args)
+{
+    int ret;
+    wm_ext_wasm_vfs_stream_wait_t *wait;
+    wm_ext_wasm_vfs_stream_t *stream = stream_vfs_get(fd);
+
+    if (!stream) {
+        errno = EBADF;
+        return -1;
+    }
+
+    switch (cmd) {
+    case WM_EXT_WASM_VFS_STREAMIOCSTART:
+        ret = wm_ext_wasm_vfs_stream_start(stream, va_arg(args, const wm_ext_wasm_vfs_stream_start_t *));
+        break;
+    case WM_EXT_WASM_VFS_STREAMIOCSTOP:
+        ret = wm_ext_wasm_vfs_stream_stop(stream);
+        break;
+    case WM_EXT_WASM_VFS_STREAMIOCNEXT:
+        wait = va_arg(args, wm_ext_wasm_vfs_stream_wait_t *);
+        ret = wm_ext_wasm_vfs_stream_next(stream, &wait->next, wait->mem_base);
+        break;
+    case WM_EXT_WASM_VFS_STREAMIOCSTATS:
+        wm_ext_wasm_vfs_stream_get_stats(stream, va_arg(args, wm_ext_wasm_vfs_stream_stats_t *));
+        ret = 0;
+        break;
+    default:
+        errno = EINVAL;
+        ret = -1;
+        break;
+    }
+
+    return ret;
+}
+#endif
+
+esp_err_t wm_ext_wasm_vfs_stream_register(void)
+{
+#ifndef CONFIG_IDF_TARGET_LINUX
+    const esp_vfs_t vfs = {
+        .flags = ESP_VFS_FLAG_DEFAULT,
+        .open = stream_vfs_open,
+        .read = stream_vfs_read,
+        .close = stream_vfs_close,
+        .ioctl = stream_vfs_ioctl,
+    };
+
+    return esp_vfs_register(WM_EXT_WASM_VFS_STREAM_PATH, &vfs, NULL);
+#else
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+#endif
@@ -0,0 +1,216 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <sys/errno.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_EXTENDED_VFS_I2C && CONFIG_EXTENDED_VFS_SPI
+
+#include "wm_ext_wasm_vfs_ioctl.h"
+#include "wm_ext_wasm_vfs_batch.h"
+
+#define TEST_FD             3
+#define TEST_I2C_ADDR       0x44
+#define TEST_I2C_NACK_ADDR  0x77
+
+#define TEST_XFERS          16                      /* Transactions start at offset 16 */
+#define TEST_TX             (TEST_XFERS + 8 * sizeof(wm_ext_wasm_vfs_xfer_t))
+#define TEST_RX             (TEST_TX + 64)
+
+/* Application linear memory, addresses are offsets in it */
+static uint8_t s_mem[TEST_RX + 64];
+static uint8_t s_moved[sizeof(s_mem) * 2];              /* Linear memory after it grows and moves */
+static int s_exec_count;
+
+/*
+ * Mock bus, an I2C device at TEST_I2C_ADDR returns register address plus index for
+ * each read byte after a register address is written, other addresses NACK. SPI
+ * returns transmitted bytes inverted, or 0xa5 if nothing is transmitted.
+ */
+static int test_bus_exec(int fd, int cmd, void *msg)
+{
+    TEST_ASSERT_EQUAL(TEST_FD, fd);
+    s_exec_count++;
+
+    if (cmd == I2CIOCEXCHANGE) {
+        i2c_ex_msg_t *m = (i2c_ex_msg_t *)msg;
+
+        if (m->addr != TEST_I2C_ADDR || m->tx_size != 1) {
+            errno = EIO;
+            return -1;
+        }
+
+        for (int i = 0; i < m->rx_size; i++) {
+            m->rx_buffer[i] = m->tx_buffer[0] + i;
+        }
+    } else if (cmd == SPIIOCEXCHANGE) {
+        spi_ex_msg_t *m = (spi_ex_msg_t *)msg;
+
+        for (int i = 0; m->rx_buffer && i < m->size; i++) {
+            ((uint8_t *)m->rx_buffer)[i] = m->tx_buffer ? ~((const uint8_t *)m->tx_buffer)[i] : 0xa5;
+        }
+    } else {
+        errno = EINVAL;
+        return -1;
+    }
+
+    return 0;
+}
+
+static void test_set_xfer(int i, uint16_t addr, uint32_t tx, uint32_t tx_size, uint32_t rx, uint32_t rx_size)
+{
+    wm_ext_wasm_vfs_xfer_t xfer = {
+        .addr = addr,
+        .tx_buffer = tx,
+        .tx_size = tx_size,
+        .rx_buffer = rx,
+        .rx_size = rx_size,
+        .status = 1,
+    };
+
+    memcpy(s_mem + TEST_XFERS + i * sizeof(xfer), &xfer, sizeof(xfer));
+}
+
+static int32_t test_status(int i)
+{
+    wm_ext_wasm_vfs_xfer_t xfer;
+
+    memcpy(&xfer, s_mem + TEST_XFERS + i * sizeof(xfer), sizeof(xfer));
+
+    return xfer.status;
+}
+
+static int test_run_at(uint32_t xfers, int cmd, uint32_t count, uint32_t flags)
+{
+    wm_ext_wasm_native_mem_t mem = { .exec_env = NULL, .base = s_mem, .size = sizeof(s_mem) };
+    wm_ext_wasm_vfs_batch_t batch = { .xfers = xfers, .count = count, .flags = flags };
+
+    s_exec_count = 0;
+
+    return wm_ext_wasm_vfs_batch_run(TEST_FD, cmd, &batch, &mem, test_bus_exec);
+}
+
+static int test_run(int cmd, uint32_t count, uint32_t flags)
+{
+    return test_run_at(TEST_XFERS, cmd, count, flags);
+}
+
+TEST_CASE("Run batched I2C and SPI transactions on a mock bus", "[vfs]")
+{
+    memset(s_mem, 0, sizeof(s_mem));
+    s_mem[TEST_TX] = 0x10;
+    s_mem[TEST_TX + 1] = 0x20;
+
+    /* Read 4 bytes of two registers, the second device NACKs */
+    test_set_xfer(0, TEST_I2C_ADDR, TEST_TX, 1, TEST_RX, 4);
+    test_set_xfer(1, TEST_I2C_ADDR, TEST_TX + 1, 1, TEST_RX + 4, 4);
+    test_set_xfer(2, TEST_I2C_NACK_ADDR, TEST_TX, 1, TEST_RX + 8, 2);
+    test_set_xfer(3, TEST_I2C_ADDR, TEST_TX, 1, TEST_RX + 10, 2);
+
+    TEST_ASSERT_EQUAL(2, test_run(WM_EXT_WASM_VFS_I2CIOCBATCH, 4, 0));
+    TEST_ASSERT_EQUAL(3, s_exec_count);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(((uint8_t []){ 0x10, 0x11, 0x12, 0x13, 0x20, 0x21, 0x22, 0x23 }), s_mem + TEST_RX, 8);
+    TEST_ASSERT_EQUAL(0, test_status(0));
+    TEST_ASSERT_EQUAL(0, test_status(1));
+    TEST_ASSERT_EQUAL(-EIO, test_status(2));
+    TEST_ASSERT_EQUAL(-ECANCELED, test_status(3));
+
+    TEST_ASSERT_EQUAL(3, test_run(WM_EXT_WASM_VFS_I2CIOCBATCH, 4, WM_EXT_WASM_VFS_BATCH_CONTINUE));
+    TEST_ASSERT_EQUAL(4, s_exec_count);
+    TEST_ASSERT_EQUAL(-EIO, test_status(2));
+    TEST_ASSERT_EQUAL(0, test_status(3));
+
+    /* A bad transaction fails the batch before the bus is touched */
+    test_set_xfer(1, TEST_I2C_ADDR, TEST_TX, 1, sizeof(s_mem) - 2, 4);
+    TEST_ASSERT_EQUAL(-1, test_run(WM_EXT_WASM_VFS_I2CIOCBATCH, 4, 0));
+    TEST_ASSERT_EQUAL(EFAULT, errno);
+    TEST_ASSERT_EQUAL(0, s_exec_count);
+    TEST_ASSERT_EQUAL(-EFAULT, test_status(1));
+
+    /* Firmware addresses are never taken as native pointers */
+    test_set_xfer(1, TEST_I2C_ADDR, 0x3fc88000, 1, TEST_RX, 4);
+    TEST_ASSERT_EQUAL(-1, test_run(WM_EXT_WASM_VFS_I2CIOCBATCH, 4, 0));
+    TEST_ASSERT_EQUAL(EFAULT, errno);
+    TEST_ASSERT_EQUAL(0, s_exec_count);
+    TEST_ASSERT_EQUAL(-1, test_run_at(0x3fc88000, WM_EXT_WASM_VFS_I2CIOCBATCH, 1, 0));
+    TEST_ASSERT_EQUAL(EFAULT, errno);
+    test_set_xfer(1, TEST_I2C_ADDR, TEST_TX, 1, TEST_RX + 4, 4);
+
+    TEST_ASSERT_EQUAL(-1, test_run(WM_EXT_WASM_VFS_I2CIOCBATCH, WM_EXT_WASM_VFS_BATCH_MAX_XFERS + 1, 0));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+    TEST_ASSERT_EQUAL(0, test_run(WM_EXT_WASM_VFS_I2CIOCBATCH, 0, 0));
+
+    /* Full duplex, receive only, and sizes which don't match */
+    test_set_xfer(0, 0, TEST_TX, 2, TEST_RX, 2);
+    test_set_xfer(1, 0, 0, 0, TEST_RX + 2, 3);
+    TEST_ASSERT_EQUAL(2, test_run(WM_EXT_WASM_VFS_SPIIOCBATCH, 2, 0));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(((uint8_t []){ 0xef, 0xdf, 0xa5, 0xa5, 0xa5 }), s_mem + TEST_RX, 5);
+
+    test_set_xfer(1, 0, TEST_TX, 2, TEST_RX, 3);
+    TEST_ASSERT_EQUAL(-1, test_run(WM_EXT_WASM_VFS_SPIIOCBATCH, 2, 0));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+    TEST_ASSERT_EQUAL(0, s_exec_count);
+}
+
+TEST_CASE("Run prepared I2C and SPI transfers on a mock bus", "[vfs]")
+{
+    wm_ext_wasm_vfs_prepared_t i2c;
+    wm_ext_wasm_vfs_prepared_t spi;
+    wm_ext_wasm_native_mem_t mem = { .exec_env = NULL, .base = s_mem, .size = sizeof(s_mem) };
+    wm_ext_wasm_native_mem_t moved = { .exec_env = NULL, .base = s_moved, .size = sizeof(s_moved) };
+    wm_ext_wasm_vfs_xfer_t xfer = { .addr = TEST_I2C_ADDR, .tx_buffer = TEST_TX, .tx_size = 1,
+                                    .rx_buffer = TEST_RX, .rx_size = 4 };
+
+    memset(s_mem, 0, sizeof(s_mem));
+    s_mem[TEST_TX] = 0x30;
+    s_exec_count = 0;
+
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_xfer_prepare(TEST_FD, WM_EXT_WASM_VFS_I2CIOCBATCH, &xfer, &mem, &i2c));
+
+    /* The template is kept, changing it after preparing doesn't change the transfer */
+    xfer.rx_size = 64;
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_xfer_run(&i2c, 0, &mem, test_bus_exec));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(((uint8_t []){ 0x30, 0x31, 0x32, 0x33, 0x00 }), s_mem + TEST_RX, 5);
+
+    /* Transmit data is read from linear memory when the transfer runs */
+    s_mem[TEST_TX] = 0x40;
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_xfer_run(&i2c, 2, &mem, test_bus_exec));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(((uint8_t []){ 0x40, 0x41, 0x32, 0x33 }), s_mem + TEST_RX, 4);
+
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_xfer_run(&i2c, 5, &mem, test_bus_exec));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+    TEST_ASSERT_EQUAL(2, s_exec_count);
+
+    /* Buffers follow linear memory when it moves, and a smaller memory fails the run */
+
+    s_moved[TEST_TX] = 0x50;
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_xfer_run(&i2c, 0, &moved, test_bus_exec));
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(((uint8_t []){ 0x50, 0x51, 0x52, 0x53 }), s_moved + TEST_RX, 4);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(((uint8_t []){ 0x40, 0x41, 0x32, 0x33 }), s_mem + TEST_RX, 4);
+
+    moved.size = TEST_RX + 2;
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_xfer_run(&i2c, 0, &moved, test_bus_exec));
+    TEST_ASSERT_EQUAL(EFAULT, errno);
+    TEST_ASSERT_EQUAL(3, s_exec_count);
+
+    /* A bad template fails to prepare */
+    xfer.rx_buffer = sizeof(s_mem) - 2;
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_xfer_prepare(TEST_FD, WM_EXT_WASM_VFS_I2CIOCBATCH, &xfer, &mem, &i2c));
+    TEST_ASSERT_EQUAL(EFAULT, errno);
+
+    /* Transmit only SPI with a shorter exchange */
+    memset(&xfer, 0, sizeof(xfer));
+    xfer.tx_buffer = TEST_TX;
+    xfer.tx_size = 8;
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_xfer_prepare(TEST_FD, WM_EXT_WASM_VFS_SPIIOCBATCH, &xfer, &mem, &spi));
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_xfer_run(&spi, 3, &mem, test_bus_exec));
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_xfer_run(&spi, 9, &mem, test_bus_exec));
+    TEST_ASSERT_EQUAL(4, s_exec_count);
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_EXT_VFS_DMA_POOL
+
+#include "wm_ext_wasm_vfs_dma.h"
+
+#define TEST_POOL_NUM   CONFIG_WASMACHINE_EXT_VFS_DMA_POOL_NUM
+#define TEST_BUF_SIZE   CONFIG_WASMACHINE_EXT_VFS_DMA_POOL_BUF_SIZE
+
+TEST_CASE("Map SPI buffers of linear memory through DMA bounce buffers", "[vfs]")
+{
+    wm_ext_wasm_vfs_dma_stats_t stats;
+    wm_ext_wasm_vfs_dma_buf_t buf[TEST_POOL_NUM + 1];
+    static uint8_t s_mem[TEST_BUF_SIZE * 2] __attribute__((aligned(WM_EXT_WASM_VFS_DMA_ALIGN)));
+    uint8_t *unaligned = s_mem + 1;
+
+    TEST_ASSERT_EQUAL(ESP_OK, wm_ext_wasm_vfs_dma_init());
+    wm_ext_wasm_vfs_dma_get_stats(&stats, true);
+
+    for (int i = 0; i < sizeof(s_mem); i++) {
+        s_mem[i] = i;
+    }
+
+#ifdef CONFIG_IDF_TARGET_LINUX
+    /* Word aligned host memory is taken as DMA-capable */
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_VFS_DMA_ZERO_COPY, wm_ext_wasm_vfs_dma_map(&buf[0], s_mem, 16, true));
+    TEST_ASSERT_EQUAL_PTR(s_mem, buf[0].dma);
+    wm_ext_wasm_vfs_dma_unmap(&buf[0], true);
+#endif
+
+    /* Unaligned buffers are copied in for transmit and out for receive */
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_VFS_DMA_BOUNCE, wm_ext_wasm_vfs_dma_map(&buf[0], unaligned, 16, true));
+    TEST_ASSERT_TRUE(buf[0].dma != unaligned);
+    TEST_ASSERT_EQUAL(0, (uintptr_t)buf[0].dma % WM_EXT_WASM_VFS_DMA_ALIGN);
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(unaligned, buf[0].dma, 16);
+    memset(buf[0].dma, 0xa5, 16);
+    wm_ext_wasm_vfs_dma_unmap(&buf[0], false);
+    TEST_ASSERT_EQUAL_HEX8(0x01, unaligned[0]);
+
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_VFS_DMA_BOUNCE, wm_ext_wasm_vfs_dma_map(&buf[0], unaligned, 16, false));
+    memset(buf[0].dma, 0x5a, 16);
+    wm_ext_wasm_vfs_dma_unmap(&buf[0], true);
+    TEST_ASSERT_EQUAL_HEX8(0x5a, unaligned[15]);
+    TEST_ASSERT_EQUAL_HEX8(17, unaligned[16]);
+
+    /* Large buffers and buffers which find the pool empty go to the driver directly */
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_VFS_DMA_DIRECT, wm_ext_wasm_vfs_dma_map(&buf[0], unaligned, sizeof(s_mem) - 1, true));
+    TEST_ASSERT_EQUAL_PTR(unaligned, buf[0].dma);
+    wm_ext_wasm_vfs_dma_unmap(&buf[0], true);
+
+    for (int i = 0; i < TEST_POOL_NUM; i++) {
+        TEST_ASSERT_EQUAL(WM_EXT_WASM_VFS_DMA_BOUNCE, wm_ext_wasm_vfs_dma_map(&buf[i], unaligned, 3, true));
+    }
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_VFS_DMA_DIRECT, wm_ext_wasm_vfs_dma_map(&buf[TEST_POOL_NUM], unaligned, 3, true));
+    for (int i = 0; i <= TEST_POOL_NUM; i++) {
+        wm_ext_wasm_vfs_dma_unmap(&buf[i], false);
+    }
+    TEST_ASSERT_EQUAL(WM_EXT_WASM_VFS_DMA_BOUNCE, wm_ext_wasm_vfs_dma_map(&buf[0], unaligned, 3, true));
+    wm_ext_wasm_vfs_dma_unmap(&buf[0], false);
+
+    wm_ext_wasm_vfs_dma_get_stats(&stats, true);
+#ifdef CONFIG_IDF_TARGET_LINUX
+    TEST_ASSERT_EQUAL(1, stats.path[WM_EXT_WASM_VFS_DMA_ZERO_COPY]);
+#endif
+    TEST_ASSERT_EQUAL(TEST_POOL_NUM + 3, stats.path[WM_EXT_WASM_VFS_DMA_BOUNCE]);
+    TEST_ASSERT_EQUAL(2, stats.path[WM_EXT_WASM_VFS_DMA_DIRECT]);
+    TEST_ASSERT_EQUAL(1, stats.too_large);
+    TEST_ASSERT_EQUAL(1, stats.pool_empty);
+    TEST_ASSERT_EQUAL(32 + 3 * (TEST_POOL_NUM + 1), stats.bounce_bytes);
+
+    wm_ext_wasm_vfs_dma_get_stats(&stats, false);
+    TEST_ASSERT_EQUAL(0, stats.path[WM_EXT_WASM_VFS_DMA_BOUNCE]);
+}
+
+#endif
@@ -0,0 +1,369 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <sys/errno.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_EXTENDED_VFS_GPIO && CONFIG_IDF_TARGET_LINUX
+
+#include "wm_ext_wasm_vfs_gpio.h"
+
+#define TEST_PINS           8
+#define TEST_RING_SIZE      16
+#define TEST_STRESS_EDGES   20000
+#define TEST_DESTROY_ROUNDS 2000
+
+/* Simulated GPIO driver, pins which are not below TEST_PINS are invalid */
+static struct {
+    uint32_t level[TEST_PINS];
+    uint32_t edge[TEST_PINS];
+    void (*isr[TEST_PINS])(void *);
+    void *arg[TEST_PINS];
+} s_sim;
+
+static int sim_get_level(uint32_t pin)
+{
+    return pin < TEST_PINS ? (int)s_sim.level[pin] : -1;
+}
+
+static esp_err_t sim_set_level(uint32_t pin, uint32_t level)
+{
+    if (pin >= TEST_PINS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    s_sim.level[pin] = level;
+
+    return ESP_OK;
+}
+
+static esp_err_t sim_isr_add(uint32_t pin, uint32_t edge, void (*isr)(void *), void *arg)
+{
+    if (pin >= TEST_PINS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    /* An ISR which is running may read them, as a real interrupt may fire while it's removed */
+    __atomic_store_n(&s_sim.edge[pin], edge, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_sim.arg[pin], arg, __ATOMIC_RELAXED);
+    __atomic_store_n(&s_sim.isr[pin], isr, __ATOMIC_RELEASE);
+
+    return ESP_OK;
+}
+
+static esp_err_t sim_isr_remove(uint32_t pin)
+{
+    __atomic_store_n(&s_sim.isr[pin], NULL, __ATOMIC_RELEASE);
+
+    return ESP_OK;
+}
+
+static const wm_ext_wasm_vfs_gpio_driver_t s_sim_driver = {
+    .get_level = sim_get_level,
+    .set_level = sim_set_level,
+    .isr_add = sim_isr_add,
+    .isr_remove = sim_isr_remove,
+};
+
+/* Drive a pin from outside, and run its ISR if the edge is listened to */
+static void sim_drive(uint32_t pin, uint32_t level)
+{
+    uint32_t edge = level > s_sim.level[pin] ? WM_EXT_WASM_VFS_GPIO_EDGE_RISING :
+                    level < s_sim.level[pin] ? WM_EXT_WASM_VFS_GPIO_EDGE_FALLING : 0;
+    void (*isr)(void *) = __atomic_load_n(&s_sim.isr[pin], __ATOMIC_ACQUIRE);
+
+    s_sim.level[pin] = level;
+    if (isr && (edge & __atomic_load_n(&s_sim.edge[pin], __ATOMIC_RELAXED))) {
+        isr(__atomic_load_n(&s_sim.arg[pin], __ATOMIC_RELAXED));
+    }
+}
+
+/* Application linear memory, the pins structure is at an offset in it */
+#define TEST_PINS_ADDR      8
+static uint8_t s_mem[64];
+
+static int test_pins_ioctl(int cmd, uint32_t addr, uint64_t mask, uint64_t levels, uint64_t *result)
+{
+    int ret;
+    wm_ext_wasm_native_mem_t mem = { .exec_env = NULL, .base = s_mem, .size = sizeof(s_mem) };
+    wm_ext_wasm_vfs_gpio_pins_t pins = { .mask = mask, .levels = levels };
+
+    memcpy(s_mem + TEST_PINS_ADDR, &pins, sizeof(pins));
+    ret = wm_ext_wasm_vfs_gpio_pins_ioctl(cmd, addr, &mem);
+    memcpy(&pins, s_mem + TEST_PINS_ADDR, sizeof(pins));
+    *result = pins.levels;
+
+    return ret;
+}
+
+static int s_notify_count;
+static sem_t s_notify_sem;
+
+static bool test_notify(void *arg)
+{
+    TEST_ASSERT_EQUAL_PTR(&s_notify_count, arg);
+    __atomic_add_fetch(&s_notify_count, 1, __ATOMIC_RELAXED);
+    sem_post(&s_notify_sem);
+
+    return true;
+}
+
+TEST_CASE("Read and write many GPIO pins of a simulated driver", "[vfs]")
+{
+    wm_ext_wasm_vfs_gpio_pins_t pins = { .mask = 0xf0, .levels = 0x5a };
+
+    memset(&s_sim, 0, sizeof(s_sim));
+    wm_ext_wasm_vfs_gpio_set_driver(&s_sim_driver);
+    wm_ext_wasm_vfs_gpio_set_pins(~0ull);
+
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_write_pins(&pins));
+    TEST_ASSERT_EQUAL(0, s_sim.level[3]);
+    TEST_ASSERT_EQUAL(1, s_sim.level[4]);
+    TEST_ASSERT_EQUAL(0, s_sim.level[5]);
+    TEST_ASSERT_EQUAL(1, s_sim.level[6]);
+
+    s_sim.level[0] = 1;
+    pins.mask = 0xff;
+    pins.levels = ~0ull;
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_read_pins(&pins));
+    TEST_ASSERT_EQUAL_HEX32(0x51, (uint32_t)pins.levels);
+
+    pins.mask = 1ull << TEST_PINS;
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_gpio_read_pins(&pins));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_gpio_write_pins(&pins));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+}
+
+TEST_CASE("Run GPIO pin ioctl commands of pins which applications can access", "[vfs]")
+{
+    uint64_t levels;
+    wm_ext_wasm_vfs_gpio_ring_t *ring;
+
+    memset(&s_sim, 0, sizeof(s_sim));
+    wm_ext_wasm_vfs_gpio_set_driver(&s_sim_driver);
+    wm_ext_wasm_vfs_gpio_set_pins(0x0c);
+
+    /* Levels are written and read back through the structure in linear memory */
+    TEST_ASSERT_EQUAL(0, test_pins_ioctl(WM_EXT_WASM_VFS_GPIOCWRITE, TEST_PINS_ADDR, 0x0c, 0x04, &levels));
+    TEST_ASSERT_EQUAL(1, s_sim.level[2]);
+    TEST_ASSERT_EQUAL(0, s_sim.level[3]);
+    TEST_ASSERT_EQUAL(0, test_pins_ioctl(WM_EXT_WASM_VFS_GPIOCREAD, TEST_PINS_ADDR, 0x0c, ~0ull, &levels));
+    TEST_ASSERT_EQUAL_HEX32(0x04, (uint32_t)levels);
+
+    /* Other pins are rejected and left as they are */
+    s_sim.level[0] = 1;
+    TEST_ASSERT_EQUAL(-1, test_pins_ioctl(WM_EXT_WASM_VFS_GPIOCWRITE, TEST_PINS_ADDR, 0x0d, 0, &levels));
+    TEST_ASSERT_EQUAL(EACCES, errno);
+    TEST_ASSERT_EQUAL(1, s_sim.level[0]);
+    TEST_ASSERT_EQUAL(1, s_sim.level[2]);
+    TEST_ASSERT_EQUAL(-1, test_pins_ioctl(WM_EXT_WASM_VFS_GPIOCREAD, TEST_PINS_ADDR, 0x01, ~0ull, &levels));
+    TEST_ASSERT_EQUAL(EACCES, errno);
+    TEST_ASSERT_EQUAL(~0ull, levels);
+
+    /* The structure must be in linear memory, and unknown commands fail */
+    TEST_ASSERT_EQUAL(-1, test_pins_ioctl(WM_EXT_WASM_VFS_GPIOCREAD, sizeof(s_mem) - 8, 0x04, 0, &levels));
+    TEST_ASSERT_EQUAL(EFAULT, errno);
+    TEST_ASSERT_EQUAL(-1, test_pins_ioctl(WM_EXT_WASM_VFS_GPIOCREAD, 0x3fc88000, 0x04, 0, &levels));
+    TEST_ASSERT_EQUAL(EFAULT, errno);
+    TEST_ASSERT_EQUAL(-1, test_pins_ioctl(WM_EXT_WASM_VFS_GPIOCSEVENT, TEST_PINS_ADDR, 0x04, 0, &levels));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+
+    /* Edges of other pins can't be listened to, so their ISR handlers are kept */
+    ring = wm_ext_wasm_vfs_gpio_ring_create(TEST_RING_SIZE, test_notify, &s_notify_count);
+    TEST_ASSERT_NOT_NULL(ring);
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_gpio_listen(ring, 0x05, WM_EXT_WASM_VFS_GPIO_EDGE_ANY));
+    TEST_ASSERT_EQUAL(EACCES, errno);
+    TEST_ASSERT_NULL(s_sim.isr[0]);
+    TEST_ASSERT_NULL(s_sim.isr[2]);
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_listen(ring, 0x04, WM_EXT_WASM_VFS_GPIO_EDGE_ANY));
+    TEST_ASSERT_NOT_NULL(s_sim.isr[2]);
+
+    /* A ring is still destroyed after its pins are no longer allowed */
+    wm_ext_wasm_vfs_gpio_set_pins(0);
+    wm_ext_wasm_vfs_gpio_ring_destroy(ring);
+    TEST_ASSERT_NULL(s_sim.isr[2]);
+}
+
+TEST_CASE("Deliver GPIO edges of a simulated driver in batches", "[vfs]")
+{
+    uint32_t dropped;
+    wm_ext_wasm_vfs_gpio_event_t events[TEST_RING_SIZE];
+    wm_ext_wasm_vfs_gpio_ring_t *ring;
+    wm_ext_wasm_vfs_gpio_ring_t *other;
+
+    memset(&s_sim, 0, sizeof(s_sim));
+    wm_ext_wasm_vfs_gpio_set_driver(&s_sim_driver);
+    wm_ext_wasm_vfs_gpio_set_pins(~0ull);
+    sem_init(&s_notify_sem, 0, 0);
+    s_notify_count = 0;
+
+    ring = wm_ext_wasm_vfs_gpio_ring_create(TEST_RING_SIZE - 1, test_notify, &s_notify_count);
+    other = wm_ext_wasm_vfs_gpio_ring_create(TEST_RING_SIZE, test_notify, &s_notify_count);
+    TEST_ASSERT_NOT_NULL(ring);
+    TEST_ASSERT_NOT_NULL(other);
+
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_listen(ring, 0x02, WM_EXT_WASM_VFS_GPIO_EDGE_RISING));
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_listen(ring, 0x08, WM_EXT_WASM_VFS_GPIO_EDGE_ANY));
+
+    /* Pins belong to one ring, and a bad pin changes no pin */
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_gpio_listen(other, 0x0a, WM_EXT_WASM_VFS_GPIO_EDGE_ANY));
+    TEST_ASSERT_EQUAL(EBUSY, errno);
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_gpio_listen(other, 0x01 | (1ull << TEST_PINS), WM_EXT_WASM_VFS_GPIO_EDGE_ANY));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+    TEST_ASSERT_NULL(s_sim.isr[0]);
+
+    /* A burst notifies once, falling edges of pin 1 are not listened to */
+    sim_drive(1, 1);
+    sim_drive(3, 1);
+    sim_drive(1, 0);
+    sim_drive(3, 0);
+    sim_drive(2, 1);
+    TEST_ASSERT_EQUAL(1, s_notify_count);
+
+    TEST_ASSERT_EQUAL(3, wm_ext_wasm_vfs_gpio_ring_pop(ring, events, TEST_RING_SIZE, &dropped));
+    TEST_ASSERT_EQUAL(0, dropped);
+    TEST_ASSERT_EQUAL(1, events[0].pin);
+    TEST_ASSERT_EQUAL(1, events[0].level);
+    TEST_ASSERT_EQUAL(3, events[1].pin);
+    TEST_ASSERT_EQUAL(1, events[1].level);
+    TEST_ASSERT_EQUAL(3, events[2].pin);
+    TEST_ASSERT_EQUAL(0, events[2].level);
+    TEST_ASSERT_TRUE(events[0].time_us > 0 && events[2].time_us >= events[0].time_us);
+
+    /* The drained ring notifies again, and a full ring drops and counts edges */
+    for (int i = 0; i < TEST_RING_SIZE + 5; i++) {
+        sim_drive(3, !s_sim.level[3]);
+    }
+    TEST_ASSERT_EQUAL(2, s_notify_count);
+
+    TEST_ASSERT_EQUAL(10, wm_ext_wasm_vfs_gpio_ring_pop(ring, events, 10, &dropped));
+    TEST_ASSERT_EQUAL(5, dropped);
+    TEST_ASSERT_EQUAL(TEST_RING_SIZE - 10, wm_ext_wasm_vfs_gpio_ring_pop(ring, events, TEST_RING_SIZE, &dropped));
+    TEST_ASSERT_EQUAL(0, dropped);
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_ring_pop(ring, events, TEST_RING_SIZE, &dropped));
+
+    /* Stop listening to pin 3, then pin 3 can be given to another ring */
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_listen(ring, 0x08, WM_EXT_WASM_VFS_GPIO_EDGE_NONE));
+    sim_drive(3, !s_sim.level[3]);
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_ring_pop(ring, events, TEST_RING_SIZE, &dropped));
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_listen(other, 0x08, WM_EXT_WASM_VFS_GPIO_EDGE_ANY));
+
+    wm_ext_wasm_vfs_gpio_ring_destroy(ring);
+    wm_ext_wasm_vfs_gpio_ring_destroy(other);
+    TEST_ASSERT_NULL(s_sim.isr[1]);
+    TEST_ASSERT_NULL(s_sim.isr[3]);
+    sem_destroy(&s_notify_sem);
+}
+
+static void *test_edge_thread(void *arg)
+{
+    for (int i = 0; i < TEST_STRESS_EDGES; i++) {
+        sim_drive(5, !s_sim.level[5]);
+    }
+
+    return NULL;
+}
+
+TEST_CASE("Drain GPIO edges while the simulated ISR produces them", "[vfs]")
+{
+    pthread_t tid;
+    uint32_t n;
+    uint32_t dropped;
+    uint32_t received = 0;
+    uint32_t lost = 0;
+    uint32_t level = 1;
+    wm_ext_wasm_vfs_gpio_event_t events[8];
+    wm_ext_wasm_vfs_gpio_ring_t *ring;
+
+    memset(&s_sim, 0, sizeof(s_sim));
+    wm_ext_wasm_vfs_gpio_set_driver(&s_sim_driver);
+    wm_ext_wasm_vfs_gpio_set_pins(~0ull);
+    sem_init(&s_notify_sem, 0, 0);
+    s_notify_count = 0;
+
+    ring = wm_ext_wasm_vfs_gpio_ring_create(TEST_RING_SIZE, test_notify, &s_notify_count);
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_listen(ring, 1u << 5, WM_EXT_WASM_VFS_GPIO_EDGE_ANY));
+    TEST_ASSERT_EQUAL(0, pthread_create(&tid, NULL, test_edge_thread, NULL));
+
+    /* Every edge is received or counted as dropped, and no wakeup is lost */
+    while (received + lost < TEST_STRESS_EDGES) {
+        sem_wait(&s_notify_sem);
+        do {
+            n = wm_ext_wasm_vfs_gpio_ring_pop(ring, events, 8, &dropped);
+            for (int i = 0; i < n; i++) {
+                TEST_ASSERT_EQUAL(5, events[i].pin);
+            }
+            /* Levels alternate unless edges were dropped between them */
+            if (n && !dropped && !lost) {
+                TEST_ASSERT_EQUAL(level, events[0].level);
+            }
+            if (n) {
+                level = !events[n - 1].level;
+            }
+            received += n;
+            lost += dropped;
+        } while (n == 8);
+    }
+
+    pthread_join(tid, NULL);
+    TEST_ASSERT_EQUAL(TEST_STRESS_EDGES, received + lost);
+
+    wm_ext_wasm_vfs_gpio_ring_destroy(ring);
+    sem_destroy(&s_notify_sem);
+}
+
+static bool s_firing;
+
+/* Yield inside the ISR, and fail so that the ISR touches the ring again after it */
+static bool test_notify_slow(void *arg)
+{
+    sched_yield();
+
+    return false;
+}
+
+static void *test_fire_thread(void *arg)
+{
+    while (__atomic_load_n(&s_firing, __ATOMIC_ACQUIRE)) {
+        sim_drive(6, !s_sim.level[6]);
+    }
+
+    return NULL;
+}
+
+TEST_CASE("Destroy GPIO rings while the simulated ISR fires edges", "[vfs]")
+{
+    pthread_t tid;
+    wm_ext_wasm_vfs_gpio_ring_t *ring;
+
+    memset(&s_sim, 0, sizeof(s_sim));
+    wm_ext_wasm_vfs_gpio_set_driver(&s_sim_driver);
+    wm_ext_wasm_vfs_gpio_set_pins(~0ull);
+
+    s_firing = true;
+    TEST_ASSERT_EQUAL(0, pthread_create(&tid, NULL, test_fire_thread, NULL));
+
+    /* The ISR may still run when its handler is removed, the ring must outlive it */
+    for (int i = 0; i < TEST_DESTROY_ROUNDS; i++) {
+        ring = wm_ext_wasm_vfs_gpio_ring_create(TEST_RING_SIZE, test_notify_slow, NULL);
+        TEST_ASSERT_NOT_NULL(ring);
+        TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_gpio_listen(ring, 1u << 6, WM_EXT_WASM_VFS_GPIO_EDGE_ANY));
+        sched_yield();
+        wm_ext_wasm_vfs_gpio_ring_destroy(ring);
+        TEST_ASSERT_NULL(s_sim.isr[6]);
+    }
+
+    __atomic_store_n(&s_firing, false, __ATOMIC_RELEASE);
+    pthread_join(tid, NULL);
+}
+
+#endif
@@ -0,0 +1,260 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/errno.h>
+#include "unity.h"
+#include "sdkconfig.h"
+
+#if CONFIG_WASMACHINE_EXT_VFS_STREAM && CONFIG_IDF_TARGET_LINUX
+
+#include "wm_ext_wasm_vfs_stream.h"
+
+#define TEST_BLOCK_SAMPLES  256
+#define TEST_BLOCKS         4
+#define TEST_WINDOW         64
+#define TEST_READ_BLOCKS    2000
+
+static uint8_t s_mem[TEST_WINDOW + TEST_BLOCKS * TEST_BLOCK_SAMPLES * sizeof(uint16_t)];
+
+/* Samples of the simulation count up, so block seq starts with seq * TEST_BLOCK_SAMPLES */
+static void check_block(const uint16_t *samples, uint32_t first)
+{
+    for (int i = 0; i < TEST_BLOCK_SAMPLES; i++) {
+        TEST_ASSERT_EQUAL((uint16_t)(first + i), samples[i]);
+    }
+}
+
+static int64_t now_us(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (int64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+TEST_CASE("Read blocks of a simulated stream as fast as it samples", "[vfs]")
+{
+    int64_t us;
+    uint32_t gaps = 0;
+    uint32_t received = 0;
+    uint32_t expect = 0;
+    uint16_t block[TEST_BLOCK_SAMPLES];
+    wm_ext_wasm_vfs_stream_stats_t stats;
+    wm_ext_wasm_vfs_stream_start_t start = {
+        .cfg = {
+            .backend = WM_EXT_WASM_VFS_STREAM_SIM,
+            .block_samples = TEST_BLOCK_SAMPLES,
+            .blocks = TEST_BLOCKS,
+        },
+    };
+    wm_ext_wasm_vfs_stream_t *stream = wm_ext_wasm_vfs_stream_create();
+
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_start(stream, &start));
+
+    us = now_us();
+    for (int i = 0; i < TEST_READ_BLOCKS; i++) {
+        TEST_ASSERT_EQUAL(sizeof(block), wm_ext_wasm_vfs_stream_read(stream, block, sizeof(block), false));
+
+        /* A block which doesn't follow the last one follows dropped blocks */
+        gaps += (uint16_t)(block[0] - expect) / TEST_BLOCK_SAMPLES;
+        check_block(block, block[0]);
+        expect = block[0] + TEST_BLOCK_SAMPLES;
+        received++;
+    }
+    us = now_us() - us;
+
+    /* Blocks which are in the ring can be read after stop */
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_stop(stream));
+    while (wm_ext_wasm_vfs_stream_read(stream, block, sizeof(block), false) > 0) {
+        check_block(block, block[0]);
+        received++;
+    }
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_read(stream, block, sizeof(block), true));
+
+    wm_ext_wasm_vfs_stream_get_stats(stream, &stats);
+    TEST_ASSERT_EQUAL(received, stats.blocks);
+    TEST_ASSERT_TRUE(gaps <= stats.overruns);
+    TEST_ASSERT_TRUE(stats.samples >= (uint64_t)(received + stats.overruns) * TEST_BLOCK_SAMPLES);
+    TEST_ASSERT_EQUAL(0, stats.lost_samples);
+    TEST_ASSERT_EQUAL(0, stats.zero_copy);
+
+    printf("stream: %"PRIu32" blocks read in %"PRId64" us, %"PRIu64" samples, %"PRIu32" overruns\n",
+           (uint32_t)TEST_READ_BLOCKS, us, stats.samples, stats.overruns);
+
+    wm_ext_wasm_vfs_stream_destroy(stream);
+}
+
+TEST_CASE("Take blocks of a simulated stream in place from a window", "[vfs]")
+{
+    uint32_t last;
+    uint32_t gaps;
+    wm_ext_wasm_vfs_stream_next_t next;
+    wm_ext_wasm_vfs_stream_stats_t stats;
+    wm_ext_wasm_vfs_stream_start_t start = {
+        .cfg = {
+            .backend = WM_EXT_WASM_VFS_STREAM_SIM,
+            .block_samples = TEST_BLOCK_SAMPLES,
+            .blocks = TEST_BLOCKS,
+            .window = TEST_WINDOW,
+        },
+        .mem_base = s_mem,
+    };
+    wm_ext_wasm_vfs_stream_t *stream = wm_ext_wasm_vfs_stream_create();
+
+    TEST_ASSERT_NOT_NULL(stream);
+
+    /* Blocks are sampled into fixed memory, and copied into memory which may move */
+    for (int fixed = 0; fixed < 2; fixed++) {
+        memset(s_mem, 0, sizeof(s_mem));
+        start.fixed = fixed;
+        TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_start(stream, &start));
+
+        gaps = 0;
+        last = UINT32_MAX;
+        next.timeout_ms = -1;
+        for (int i = 0; i < TEST_READ_BLOCKS; i++) {
+            TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_next(stream, &next, s_mem));
+            TEST_ASSERT_TRUE(next.index < TEST_BLOCKS);
+            check_block((uint16_t *)(s_mem + TEST_WINDOW) + next.index * TEST_BLOCK_SAMPLES,
+                        next.seq * TEST_BLOCK_SAMPLES);
+
+            /* The ring fills while the block is held, so sequence numbers skip dropped blocks */
+            if (i == TEST_READ_BLOCKS / 2) {
+                usleep(20000);
+            }
+
+            gaps += next.seq - last - 1;
+            last = next.seq;
+        }
+        TEST_ASSERT_TRUE(gaps > 0);
+        TEST_ASSERT_TRUE(gaps <= next.overruns);
+
+        TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_stop(stream));
+        wm_ext_wasm_vfs_stream_get_stats(stream, &stats);
+        TEST_ASSERT_EQUAL(fixed, stats.zero_copy);
+    }
+
+    wm_ext_wasm_vfs_stream_destroy(stream);
+}
+
+TEST_CASE("Pace a simulated stream and destroy it with its owner", "[vfs]")
+{
+    int owner;
+    int64_t us;
+    uint16_t block[TEST_BLOCK_SAMPLES];
+    wm_ext_wasm_vfs_stream_next_t next = { .timeout_ms = 0 };
+    wm_ext_wasm_vfs_stream_stats_t stats;
+    wm_ext_wasm_vfs_stream_start_t start = {
+        .cfg = {
+            .backend = WM_EXT_WASM_VFS_STREAM_SIM,
+            .rate_hz = TEST_BLOCK_SAMPLES * 100,
+            .block_samples = TEST_BLOCK_SAMPLES,
+            .blocks = TEST_BLOCKS,
+            .window = TEST_WINDOW,
+        },
+        .mem_base = s_mem,
+        .fixed = true,
+        .owner = &owner,
+        .fd = -1,
+    };
+    wm_ext_wasm_vfs_stream_t *stream = wm_ext_wasm_vfs_stream_create();
+    wm_ext_wasm_vfs_stream_t *streams[CONFIG_WASMACHINE_EXT_VFS_STREAM_MAX];
+
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_start(stream, &start));
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_stream_start(stream, &start));
+    TEST_ASSERT_EQUAL(EBUSY, errno);
+
+    /* A block takes 10 ms */
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_stream_next(stream, &next, s_mem));
+    TEST_ASSERT_EQUAL(EAGAIN, errno);
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_stream_read(stream, block, sizeof(block), true));
+    TEST_ASSERT_EQUAL(EAGAIN, errno);
+
+    us = now_us();
+    next.timeout_ms = 1000;
+    for (int i = 0; i < 5; i++) {
+        TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_next(stream, &next, s_mem));
+        TEST_ASSERT_EQUAL(i, next.seq);
+        TEST_ASSERT_EQUAL(0, next.overruns);
+    }
+    us = now_us() - us;
+    TEST_ASSERT_TRUE(us >= 40000 && us < 500000);
+
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_stream_read(stream, block, sizeof(block) - 1, false));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+
+    wm_ext_wasm_vfs_stream_get_stats(stream, &stats);
+    TEST_ASSERT_EQUAL(1, stats.zero_copy);
+    TEST_ASSERT_TRUE(stats.blocks >= 5);
+
+    /* Streams of another owner stay */
+    wm_ext_wasm_vfs_stream_detach(block);
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_next(stream, &next, s_mem));
+
+    /* The owner exits, so its stream is destroyed and its slot is free */
+    wm_ext_wasm_vfs_stream_detach(&owner);
+    for (int i = 0; i < CONFIG_WASMACHINE_EXT_VFS_STREAM_MAX; i++) {
+        streams[i] = wm_ext_wasm_vfs_stream_create();
+        TEST_ASSERT_NOT_NULL(streams[i]);
+    }
+
+    for (int i = 0; i < CONFIG_WASMACHINE_EXT_VFS_STREAM_MAX; i++) {
+        wm_ext_wasm_vfs_stream_destroy(streams[i]);
+    }
+}
+
+TEST_CASE("Reject bad stream configurations", "[vfs]")
+{
+    wm_ext_wasm_vfs_stream_t *stream[CONFIG_WASMACHINE_EXT_VFS_STREAM_MAX];
+    wm_ext_wasm_vfs_stream_next_t next = { .timeout_ms = 0 };
+    wm_ext_wasm_vfs_stream_start_t start = {
+        .cfg = {
+            .backend = WM_EXT_WASM_VFS_STREAM_SIM,
+            .block_samples = TEST_BLOCK_SAMPLES,
+            .blocks = 1,
+        },
+    };
+
+    for (int i = 0; i < CONFIG_WASMACHINE_EXT_VFS_STREAM_MAX; i++) {
+        stream[i] = wm_ext_wasm_vfs_stream_create();
+        TEST_ASSERT_NOT_NULL(stream[i]);
+    }
+    TEST_ASSERT_NULL(wm_ext_wasm_vfs_stream_create());
+    TEST_ASSERT_EQUAL(EMFILE, errno);
+
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_stream_start(stream[0], &start));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+
+    start.cfg.blocks = CONFIG_WASMACHINE_EXT_VFS_STREAM_MAX_RING_SIZE / (TEST_BLOCK_SAMPLES * 2) + 1;
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_stream_start(stream[0], &start));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+
+    /* There is no ADC on Linux */
+    start.cfg.blocks = TEST_BLOCKS;
+    start.cfg.backend = WM_EXT_WASM_VFS_STREAM_ADC;
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_stream_start(stream[0], &start));
+    TEST_ASSERT_EQUAL(ENODEV, errno);
+
+    /* A stream without window is read only */
+    start.cfg.backend = WM_EXT_WASM_VFS_STREAM_SIM;
+    TEST_ASSERT_EQUAL(0, wm_ext_wasm_vfs_stream_start(stream[0], &start));
+    TEST_ASSERT_EQUAL(-1, wm_ext_wasm_vfs_stream_next(stream[0], &next, s_mem));
+    TEST_ASSERT_EQUAL(EINVAL, errno);
+
+    for (int i = 0; i < CONFIG_WASMACHINE_EXT_VFS_STREAM_MAX; i++) {
+        wm_ext_wasm_vfs_stream_destroy(stream[i]);
+    }
+}
+
+#endif
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -24,3 +24,7 @@ void shell_regitser_cmd_query(void);
 void shell_regitser_cmd_ls(void);
 void shell_regitser_cmd_free(void);
 void shell_regitser_cmd_wifi(void);
+void shell_regitser_cmd_wprof(void);
+void shell_regitser_cmd_wbench(void);
+void shell_regitser_cmd_trace(void);
+void shell_regitser_cmd_dma(void);
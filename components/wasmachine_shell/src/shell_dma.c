@@ -0,0 +1,51 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "shell_cmd.h"
+#include "wm_ext_wasm_vfs_dma.h"
+
+static struct {
+    struct arg_lit *reset;
+    struct arg_end *end;
+} dma_main_arg;
+
+static int dma_main(int argc, char **argv)
+{
+    wm_ext_wasm_vfs_dma_stats_t stats;
+
+    SHELL_CMD_CHECK(dma_main_arg);
+
+    wm_ext_wasm_vfs_dma_get_stats(&stats, dma_main_arg.reset->count > 0);
+
+    printf("%-12s %10"PRIu32"\n", "zero-copy", stats.path[WM_EXT_WASM_VFS_DMA_ZERO_COPY]);
+    printf("%-12s %10"PRIu32" %10"PRIu32" bytes\n", "bounce", stats.path[WM_EXT_WASM_VFS_DMA_BOUNCE],
+           stats.bounce_bytes);
+    printf("%-12s %10"PRIu32" %10"PRIu32" too large %10"PRIu32" pool empty\n", "direct",
+           stats.path[WM_EXT_WASM_VFS_DMA_DIRECT], stats.too_large, stats.pool_empty);
+
+    return 0;
+}
+
+void shell_regitser_cmd_dma(void)
+{
+    int cmd_num = 1;
+
+    dma_main_arg.reset = arg_lit0("r", "reset", "Clear counters after printing them");
+
+    dma_main_arg.end = arg_end(cmd_num);
+
+    const esp_console_cmd_t cmd = {
+        .command = "dma",
+        .help = "Show how SPI buffers of WASM Apps are passed to DMA",
+        .hint = NULL,
+        .func = &dma_main,
+        .argtable = &dma_main_arg
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+}
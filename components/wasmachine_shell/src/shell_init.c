@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -54,5 +54,21 @@ void wm_shell_init(void)
     shell_regitser_cmd_wifi();
 #endif
 
+#ifdef CONFIG_WASMACHINE_SHELL_CMD_WPROF
+    shell_regitser_cmd_wprof();
+#endif
+
+#ifdef CONFIG_WASMACHINE_SHELL_CMD_WBENCH
+    shell_regitser_cmd_wbench();
+#endif
+
+#ifdef CONFIG_WASMACHINE_SHELL_CMD_TRACE
+    shell_regitser_cmd_trace();
+#endif
+
+#ifdef CONFIG_WASMACHINE_SHELL_CMD_DMA
+    shell_regitser_cmd_dma();
+#endif
+
     ESP_ERROR_CHECK(esp_console_start_repl(repl));
 }
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -17,6 +17,9 @@
 #include "shell_utils.h"
 #include "shell_cmd.h"
 #include "wm_wamr.h"
+#ifdef CONFIG_WASMACHINE_WPROF
+#include "wm_wprof.h"
+#endif
 
 #define URL_MAX_LEN 256
 #define INSTALL_TIMEOUT 2000
@@ -34,6 +37,9 @@ static struct {
     struct arg_str *type;
     struct arg_int *max_timers;
     struct arg_int *watchdog_interval;
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    struct arg_str *memory_in;
+#endif
     struct arg_end *end;
 } install_main_arg;
 
@@ -54,6 +60,17 @@ static int install_main(int argc, char **argv)
     }
     m_name = install_main_arg.name->sval[0];
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    if (install_main_arg.memory_in->count) {
+        wm_wamr_mem_region_t region;
+
+        if (wm_wamr_mem_region_from_str(install_main_arg.memory_in->sval[0], &region) != ESP_OK) {
+            ESP_LOGE(TAG, "Memory region %s is not supported", install_main_arg.memory_in->sval[0]);
+            return -1;
+        }
+    }
+#endif
+
     wm_wamr_app_mgr_lock();
     if (app_manager_lookup_module_data(m_name)) {
         ESP_LOGE(TAG, "App %s is already installed", m_name);
@@ -83,6 +100,12 @@ static int install_main(int argc, char **argv)
         snprintf(url + strlen(url), url_remain_space, "&wd=%d",
                  install_main_arg.watchdog_interval->ival[0]);
     }
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    if (install_main_arg.memory_in->count > 0 && url_remain_space > 0) {
+        snprintf(url + strlen(url), url_remain_space, "&mem_caps=%s",
+                 install_main_arg.memory_in->sval[0]);
+    }
+#endif
 
     init_request(request, url, COAP_PUT, FMT_APP_RAW_BINARY, file.payload, file.size);
     request->mid = esp_random();
@@ -101,11 +124,21 @@ static int install_main(int argc, char **argv)
         vTaskDelay(1);
     }
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    wm_wamr_app_mgr_end_install();
+#endif
+
     if (!installed) {
         ESP_LOGE(TAG, "Failed to install App %s", m_name);
         goto fail2;
     }
 
+#ifdef CONFIG_WASMACHINE_WPROF
+    if (wm_wprof_is_running()) {
+        wm_wamr_app_mgr_wprof_attach();
+    }
+#endif
+
     shell_close_file(&file);
     wm_wamr_app_mgr_unlock();
     return 0;
@@ -134,6 +167,13 @@ void shell_regitser_cmd_install(void)
     install_main_arg.watchdog_interval =
         arg_int0(NULL, "watchdog", "<Watchdog Interval>", "Watchdog interval in ms, default is " TOCHAR(DEFAULT_WATCHDOG_INTERVAL));
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    install_main_arg.memory_in =
+        arg_str0(NULL, "memory-in", "<default|dram|psram>", "Memory region of app's module data, linear memory and stack");
+
+    cmd_num += 1;
+#endif
+
     install_main_arg.end = arg_end(cmd_num);
 
     const esp_console_cmd_t cmd = {
@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2022-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -21,6 +21,19 @@
 
 #include "shell_cmd.h"
 #include "shell_utils.h"
+#include "wm_startup_profile.h"
+
+#ifdef CONFIG_WASMACHINE_STARTUP_PROFILE
+#define IWASM_PROFILE_MARK(a, p)    wm_startup_profile_mark((a)->profile, p)
+#else
+#define IWASM_PROFILE_MARK(a, p)
+#endif
+#ifdef CONFIG_WASMACHINE_WPROF
+#include "wm_wprof.h"
+#endif
+#if defined(CONFIG_WASMACHINE_WASM_THREADS) || defined(CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT)
+#include "wm_wamr.h"
+#endif
 
 typedef struct iwasm_main_arg {
     uint8_t *buffer;
@@ -34,6 +47,16 @@ typedef struct iwasm_main_arg {
 #endif
     int argc;
     char **argv;
+#ifdef CONFIG_WASMACHINE_STARTUP_PROFILE
+    wm_startup_profile_t *profile;
+#endif
+#ifdef CONFIG_WASMACHINE_WASM_THREADS
+    int core;
+#endif
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    wm_wamr_mem_region_t stack_region;
+    wm_wamr_mem_region_t memory_region;
+#endif
 } iwasm_main_arg_t;
 
 static const char TAG[] = "shell_iwasm";
@@ -48,6 +71,16 @@ static struct {
     struct arg_str *dir;
     struct arg_str *addrs;
 #endif
+#ifdef CONFIG_WASMACHINE_STARTUP_PROFILE
+    struct arg_lit *profile;
+#endif
+#ifdef CONFIG_WASMACHINE_WASM_THREADS
+    struct arg_int *core;
+#endif
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    struct arg_str *stack_in;
+    struct arg_str *memory_in;
+#endif
 
     struct arg_end *end;
 } iwasm_main_arg;
@@ -154,6 +187,9 @@ static void *iwasm_main_thread(void *p)
     uint32_t size = arg->size;
     package_type_t pkg_type;
     const char *exception;
+#if defined(CONFIG_WASMACHINE_WPROF) || defined(CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT)
+    wasm_exec_env_t exec_env;
+#endif
     wasm_module_t wasm_module;
     wasm_module_inst_t wasm_module_inst;
     char error_buf[128];
@@ -166,6 +202,14 @@ static void *iwasm_main_thread(void *p)
     uint32_t addr_pool_size = 0;
 #endif
 
+#ifdef CONFIG_WASMACHINE_WASM_THREADS
+    /* Threads spawned by the WASM App inherit this configuration */
+    if (wm_wamr_set_thread_cfg(arg->core, CONFIG_WASMACHINE_WASM_THREADS_PRIO) != ESP_OK) {
+        ESP_LOGE(TAG, "failed to set thread configuration core=%d", arg->core);
+        goto fail0;
+    }
+#endif
+
     /* Process options. */
 #if CONFIG_WAMR_ENABLE_LIBC_WASI != 0
     if (arg->dir) {
@@ -244,8 +288,15 @@ static void *iwasm_main_thread(void *p)
         goto fail0;
     }
 
+    IWASM_PROFILE_MARK(arg, WM_STARTUP_PHASE_PKG_DETECT);
+
     ESP_LOGI(TAG, "wasm runtime initialized.");
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    /* Module data and linear memory, including its growth in main function */
+    wm_wamr_set_thread_mem_region(arg->memory_region);
+#endif
+
     if (!(wasm_module = wasm_runtime_load(buffer,
                                           size,
                                           error_buf,
@@ -254,6 +305,8 @@ static void *iwasm_main_thread(void *p)
         goto fail0;
     }
 
+    IWASM_PROFILE_MARK(arg, WM_STARTUP_PHASE_LOAD);
+
     ESP_LOGI(TAG, "wasm runtime load module success.");
 
 #if CONFIG_WAMR_ENABLE_LIBC_WASI != 0
@@ -261,6 +314,8 @@ static void *iwasm_main_thread(void *p)
                                env_list, env_list_size, arg->argv, arg->argc);
 
     wasm_runtime_set_wasi_addr_pool(wasm_module, addr_pool, addr_pool_size);
+
+    IWASM_PROFILE_MARK(arg, WM_STARTUP_PHASE_WASI_SETUP);
 #endif
 
     if (!(wasm_module_inst = wasm_runtime_instantiate(wasm_module,
@@ -272,15 +327,47 @@ static void *iwasm_main_thread(void *p)
         goto fail1;
     }
 
+    IWASM_PROFILE_MARK(arg, WM_STARTUP_PHASE_INSTANTIATE);
+
     ESP_LOGI(TAG, "wasm runtime instantiate module success.");
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    /* Operand stack is allocated along with the execution environment of main function */
+    wm_wamr_set_thread_mem_region(arg->stack_region);
+    exec_env = wasm_runtime_get_exec_env_singleton(wasm_module_inst);
+    wm_wamr_set_thread_mem_region(arg->memory_region);
+    if (!exec_env) {
+        ESP_LOGE(TAG, "failed to create execution environment");
+        goto fail2;
+    }
+#endif
+
+#ifdef CONFIG_WASMACHINE_WPROF
+    /* Main function runs in the singleton execution environment */
+    exec_env = wasm_runtime_get_exec_env_singleton(wasm_module_inst);
+    if (exec_env) {
+        wm_wprof_attach(exec_env, buffer, size);
+    }
+#endif
+
+    IWASM_PROFILE_MARK(arg, WM_STARTUP_PHASE_MAIN_ENTRY);
     wasm_application_execute_main(wasm_module_inst, arg->argc, arg->argv);
+    IWASM_PROFILE_MARK(arg, WM_STARTUP_PHASE_MAIN_EXIT);
+
+#ifdef CONFIG_WASMACHINE_WPROF
+    if (exec_env) {
+        wm_wprof_detach(exec_env);
+    }
+#endif
     if ((exception = wasm_runtime_get_exception(wasm_module_inst))) {
         ESP_LOGE(TAG, "%s", exception);
     }
 
     ESP_LOGI(TAG, "wasm runtime execute app's main function success.");
 
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+fail2:
+#endif
     wasm_runtime_deinstantiate(wasm_module_inst);
     ESP_LOGI(TAG, "wasm runtime deinstantiate module success.");
 
@@ -288,10 +375,14 @@ fail1:
     wasm_runtime_unload(wasm_module);
     ESP_LOGI(TAG, "wasm runtime unload module success.");
 fail0:
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    wm_wamr_set_thread_mem_region(WM_WAMR_MEM_DEFAULT);
+#endif
     return NULL;
 }
 
-static void start_iwasm_thread(const char *str, uint8_t *buffer, uint32_t size)
+static void start_iwasm_thread(const char *str, uint8_t *buffer, uint32_t size,
+                               wm_startup_profile_t *profile)
 {
     int ret;
     pthread_t tid;
@@ -350,6 +441,32 @@ static void start_iwasm_thread(const char *str, uint8_t *buffer, uint32_t size)
     }
 #endif
 
+#ifdef CONFIG_WASMACHINE_STARTUP_PROFILE
+    arg.profile = profile;
+#endif
+
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    if (iwasm_main_arg.stack_in->count &&
+            wm_wamr_mem_region_from_str(iwasm_main_arg.stack_in->sval[0], &arg.stack_region) != ESP_OK) {
+        ESP_LOGE(TAG, "Memory region %s is not supported", iwasm_main_arg.stack_in->sval[0]);
+        goto fail1;
+    }
+
+    if (iwasm_main_arg.memory_in->count &&
+            wm_wamr_mem_region_from_str(iwasm_main_arg.memory_in->sval[0], &arg.memory_region) != ESP_OK) {
+        ESP_LOGE(TAG, "Memory region %s is not supported", iwasm_main_arg.memory_in->sval[0]);
+        goto fail1;
+    }
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_THREADS
+    if (iwasm_main_arg.core->count) {
+        arg.core = iwasm_main_arg.core->ival[0];
+    } else {
+        arg.core = CONFIG_WASMACHINE_WASM_THREADS_CORE;
+    }
+#endif
+
     ret = pthread_create(&tid, &attr, iwasm_main_thread, &arg);
     if (ret != 0) {
         ESP_LOGI(TAG, "failed to create task errno=%d", errno);
@@ -372,15 +489,30 @@ static int iwasm_main(int argc, char **argv)
     int ret;
     shell_file_t file;
     const char *args_str;
+    wm_startup_profile_t *profile = NULL;
+#ifdef CONFIG_WASMACHINE_STARTUP_PROFILE
+    wm_startup_profile_t startup_profile;
+#endif
 
     SHELL_CMD_CHECK(iwasm_main_arg);
 
+#ifdef CONFIG_WASMACHINE_STARTUP_PROFILE
+    if (iwasm_main_arg.profile->count) {
+        profile = &startup_profile;
+        wm_startup_profile_begin(profile);
+    }
+#endif
+
     ret = shell_open_file(&file, iwasm_main_arg.file->sval[0]);
     if (ret < 0) {
         ESP_LOGE(TAG, "Failed to open file %s", iwasm_main_arg.file->sval[0]);
         return ret;
     }
 
+#ifdef CONFIG_WASMACHINE_STARTUP_PROFILE
+    wm_startup_profile_mark(profile, WM_STARTUP_PHASE_FILE_READ);
+#endif
+
     if (iwasm_main_arg.args->count &&
             iwasm_main_arg.args->sval[0] &&
             iwasm_main_arg.args->sval[0][0]) {
@@ -390,10 +522,17 @@ static int iwasm_main(int argc, char **argv)
         args_str = NULL;
     }
 
-    start_iwasm_thread(args_str, file.payload, file.size);
+    start_iwasm_thread(args_str, file.payload, file.size, profile);
 
     shell_close_file(&file);
 
+#ifdef CONFIG_WASMACHINE_STARTUP_PROFILE
+    if (profile) {
+        wm_startup_profile_print(profile);
+        wm_startup_profile_print_json(profile);
+    }
+#endif
+
     return 0;
 }
 
@@ -421,6 +560,29 @@ void shell_regitser_cmd_iwasm(void)
     cmd_num += 3;
 #endif
 
+#ifdef CONFIG_WASMACHINE_STARTUP_PROFILE
+    iwasm_main_arg.profile =
+        arg_lit0("p", "profile", "Print startup phase timing and WAMR memory peak of the WASM App as a table and JSON");
+
+    cmd_num += 1;
+#endif
+
+#ifdef CONFIG_WASMACHINE_WASM_THREADS
+    iwasm_main_arg.core =
+        arg_int0("c", "core", "<core>", "Core which threads spawned by WASM App are pinned to, -1 means any core");
+
+    cmd_num += 1;
+#endif
+
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+    iwasm_main_arg.stack_in =
+        arg_str0(NULL, "stack-in", "<default|dram|psram>", "Memory region of WASM App's operand stack");
+    iwasm_main_arg.memory_in =
+        arg_str0(NULL, "memory-in", "<default|dram|psram>", "Memory region of WASM App's module data and linear memory");
+
+    cmd_num += 2;
+#endif
+
     iwasm_main_arg.end = arg_end(cmd_num);
 
     const esp_console_cmd_t cmd = {
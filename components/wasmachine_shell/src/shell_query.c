@@ -1,5 +1,5 @@
 /*
- * SPDX-FileCopyrightText: 2023-2024 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2023-2026 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
@@ -53,10 +53,18 @@ static int query_main(int argc, char **argv)
         if (!name) {
             printf(",\n\t\"applet%d\":\t\"%s\",\n", i, m_data->module_name);
             printf("\t\"heap%d\":\t%d", i, m_data->heap_size);
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+            printf(",\n\t\"memory%d\":\t\"%s\"", i,
+                   wm_wamr_mem_region_to_str(wm_wamr_app_mgr_get_mem_region(m_data->module_name)));
+#endif
             i++;
         } else if (!strcmp(name, m_data->module_name)) {
             printf("\t\"applet\":\t\"%s\",\n", m_data->module_name);
             printf("\t\"heap\":\t\t%d", m_data->heap_size);
+#ifdef CONFIG_WASMACHINE_WAMR_MEM_PLACEMENT
+            printf(",\n\t\"memory\":\t\"%s\"",
+                   wm_wamr_mem_region_to_str(wm_wamr_app_mgr_get_mem_region(m_data->module_name)));
+#endif
             break;
         }
 
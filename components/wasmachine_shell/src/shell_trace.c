@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "shell_cmd.h"
+#include "wm_ext_wasm_native_trace.h"
+
+static const char TAG[] = "shell_trace";
+
+static struct {
+    struct arg_str *action;
+    struct arg_str *output;
+    struct arg_end *end;
+} trace_main_arg;
+
+static esp_err_t trace_dump(const char *path)
+{
+    esp_err_t ret;
+    FILE *fp;
+
+    if (!path) {
+        return wm_ext_wasm_native_trace_dump(stdout);
+    }
+
+    fp = fopen(path, "w");
+    if (!fp) {
+        ESP_LOGE(TAG, "Failed to open %s", path);
+        return ESP_FAIL;
+    }
+
+    ret = wm_ext_wasm_native_trace_dump(fp);
+    fclose(fp);
+
+    return ret;
+}
+
+static int trace_main(int argc, char **argv)
+{
+    esp_err_t ret;
+    const char *action;
+
+    SHELL_CMD_CHECK(trace_main_arg);
+
+    action = trace_main_arg.action->sval[0];
+    if (!strcmp(action, "start")) {
+        ret = wm_ext_wasm_native_trace_start();
+    } else if (!strcmp(action, "stop")) {
+        ret = wm_ext_wasm_native_trace_stop();
+    } else if (!strcmp(action, "clear")) {
+        ret = wm_ext_wasm_native_trace_clear();
+    } else if (!strcmp(action, "dump")) {
+        ret = trace_dump(trace_main_arg.output->count ? trace_main_arg.output->sval[0] : NULL);
+    } else {
+        ESP_LOGE(TAG, "Unknown action %s", action);
+        return -1;
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to %s trace ret=%d", action, ret);
+        return -1;
+    }
+
+    return 0;
+}
+
+void shell_regitser_cmd_trace(void)
+{
+    int cmd_num = 2;
+
+    trace_main_arg.action =
+        arg_str1(NULL, NULL, "<start|stop|clear|dump>", "start recording, stop recording, drop or dump native calls");
+    trace_main_arg.output =
+        arg_str0("o", "output", "<file>", "Dump Chrome trace JSON into a file instead of console");
+
+    trace_main_arg.end = arg_end(cmd_num);
+
+    const esp_console_cmd_t cmd = {
+        .command = "trace",
+        .help = "Trace native calls of running WASM Apps",
+        .hint = NULL,
+        .func = &trace_main,
+        .argtable = &trace_main_arg
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+}
@@ -0,0 +1,164 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <dirent.h>
+#include <sys/errno.h>
+
+#include "esp_log.h"
+
+#include "shell_cmd.h"
+#include "wm_bench.h"
+
+static const char TAG[] = "shell_wbench";
+
+static struct {
+    struct arg_str *dir;
+    struct arg_int *time;
+    struct arg_int *heap_size;
+    struct arg_str *workload;
+    struct arg_end *end;
+} wbench_main_arg;
+
+static bool wbench_is_workload(const char *file)
+{
+    const char *ext = strrchr(file, '.');
+
+    return ext && (!strcmp(ext, ".wasm") || !strcmp(ext, ".aot"));
+}
+
+static bool wbench_is_selected(const char *file)
+{
+    size_t len = strcspn(file, ".");
+
+    if (!wbench_main_arg.workload->count) {
+        return true;
+    }
+
+    for (int i = 0; i < wbench_main_arg.workload->count; i++) {
+        const char *name = wbench_main_arg.workload->sval[i];
+
+        if (strlen(name) == len && !strncmp(name, file, len)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static int wbench_main(int argc, char **argv)
+{
+    int ret;
+    int failed = 0;
+    DIR *dir;
+    struct dirent *de;
+    char *dir_path;
+    const char *pwd = CONFIG_WASMACHINE_BENCH_DIR;
+    wm_bench_config_t config = WM_BENCH_CONFIG_DEFAULT();
+
+    SHELL_CMD_CHECK(wbench_main_arg);
+
+    if (wbench_main_arg.dir->count) {
+        pwd = wbench_main_arg.dir->sval[0];
+    }
+
+    if (wbench_main_arg.time->count) {
+        config.min_time_ms = wbench_main_arg.time->ival[0];
+    }
+
+    if (wbench_main_arg.heap_size->count) {
+        config.heap_size = wbench_main_arg.heap_size->ival[0];
+    }
+
+    ret = asprintf(&dir_path, SHELL_ROOT_FS_PATH"/%s", pwd);
+    if (ret < 0) {
+        ESP_LOGE(TAG, "failed to asprintf errno=%d", errno);
+        return -1;
+    }
+
+    dir = opendir(dir_path);
+    if (!dir) {
+        ESP_LOGE(TAG, "failed to opendir %s errno=%d", dir_path, errno);
+        free(dir_path);
+        return -1;
+    }
+
+    printf("%-12s %-12s %12s %10s %10s %10s %10s %10s  %s\n", "workload", "mode", "iter/s",
+           "iterations", "time(ms)", "mem(B)", "peak(B)", "checksum", "result");
+
+    while ((de = readdir(dir))) {
+        char *file_path;
+        wm_bench_result_t result = { 0 };
+        esp_err_t err;
+
+        if (de->d_type == DT_DIR || !wbench_is_workload(de->d_name) || !wbench_is_selected(de->d_name)) {
+            continue;
+        }
+
+        ret = asprintf(&file_path, "%s/%s", dir_path, de->d_name);
+        if (ret < 0) {
+            ESP_LOGE(TAG, "failed to asprintf errno=%d", errno);
+            failed++;
+            break;
+        }
+
+        err = wm_bench_run_file(file_path, &config, &result);
+        free(file_path);
+
+        if (err == ESP_ERR_NOT_SUPPORTED) {
+            printf("%-12s %-12s %12s\n", result.name, "-", "skipped");
+            continue;
+        } else if (err != ESP_OK) {
+            printf("%-12s %-12s %12s\n", result.name, result.mode ? result.mode : "-", "error");
+            failed++;
+            continue;
+        }
+
+        printf("%-12s %-12s %12.2f %10" PRIu32 " %10.1f %10u %10u   %08" PRIx32 "  %s\n",
+               result.name, result.mode,
+               result.elapsed_us ? result.iterations * 1000000.0 / result.elapsed_us : 0.0,
+               result.iterations, result.elapsed_us / 1000.0, (unsigned int)result.mem, (unsigned int)result.peak, result.checksum,
+               result.verify == WM_BENCH_VERIFY_OK ? "ok" :
+               result.verify == WM_BENCH_VERIFY_FAIL ? "FAIL" : "unknown");
+
+        if (result.verify == WM_BENCH_VERIFY_FAIL) {
+            failed++;
+        }
+    }
+
+    closedir(dir);
+    free(dir_path);
+
+    return failed ? -1 : 0;
+}
+
+void shell_regitser_cmd_wbench(void)
+{
+    int cmd_num = 4;
+
+    wbench_main_arg.dir =
+        arg_str0("d", "dir", "<dir>", "Directory of workload files, default is " CONFIG_WASMACHINE_BENCH_DIR);
+    wbench_main_arg.time =
+        arg_int0("t", "time", "<ms>", "Minimum measured time of every workload in ms");
+    wbench_main_arg.heap_size =
+        arg_int0("h", "heap_size", "<heap_size>", "WASM workload's heap size in bytes, default is 0");
+    wbench_main_arg.workload =
+        arg_strn(NULL, NULL, "<workload>", 0, 8, "Only run given workloads, e.g. coremark sha256");
+
+    wbench_main_arg.end = arg_end(cmd_num);
+
+    const esp_console_cmd_t cmd = {
+        .command = "wbench",
+        .help = "Run WASM benchmark workloads in every available execution mode",
+        .hint = NULL,
+        .func = &wbench_main,
+        .argtable = &wbench_main_arg
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+}
@@ -0,0 +1,86 @@
+/*
+ * SPDX-FileCopyrightText: 2026 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "shell_cmd.h"
+#include "wm_wprof.h"
+
+#define WPROF_DEFAULT_PERIOD_US     1000
+#define _TOCHAR(_d) # _d
+#define TOCHAR(_d)  _TOCHAR(_d)
+
+static const char TAG[] = "shell_wprof";
+
+static struct {
+    struct arg_str *action;
+    struct arg_int *period;
+    struct arg_lit *folded;
+    struct arg_end *end;
+} wprof_main_arg;
+
+static int wprof_main(int argc, char **argv)
+{
+    esp_err_t ret;
+    const char *action;
+
+    SHELL_CMD_CHECK(wprof_main_arg);
+
+    action = wprof_main_arg.action->sval[0];
+    if (!strcmp(action, "start")) {
+        int period = WPROF_DEFAULT_PERIOD_US;
+
+        if (wprof_main_arg.period->count) {
+            period = wprof_main_arg.period->ival[0];
+        }
+
+        if (period <= 0) {
+            ESP_LOGE(TAG, "Invalid sampling period %d", period);
+            return -1;
+        }
+
+        ret = wm_wprof_start(period);
+    } else if (!strcmp(action, "stop")) {
+        ret = wm_wprof_stop();
+    } else if (!strcmp(action, "dump")) {
+        ret = wm_wprof_dump(stdout, wprof_main_arg.folded->count > 0);
+    } else {
+        ESP_LOGE(TAG, "Unknown action %s", action);
+        return -1;
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to %s profiler ret=%d", action, ret);
+        return -1;
+    }
+
+    return 0;
+}
+
+void shell_regitser_cmd_wprof(void)
+{
+    int cmd_num = 3;
+
+    wprof_main_arg.action =
+        arg_str1(NULL, NULL, "<start|stop|dump>", "start sampling, stop sampling or dump samples");
+    wprof_main_arg.period =
+        arg_int0("i", "interval", "<us>", "Sampling period in microseconds, default is " TOCHAR(WPROF_DEFAULT_PERIOD_US));
+    wprof_main_arg.folded =
+        arg_lit0("f", "folded", "Dump samples in folded-stack format for flamegraph.pl");
+
+    wprof_main_arg.end = arg_end(cmd_num);
+
+    const esp_console_cmd_t cmd = {
+        .command = "wprof",
+        .help = "Sample call stacks of running WASM Apps",
+        .hint = NULL,
+        .func = &wprof_main,
+        .argtable = &wprof_main_arg
+    };
+    ESP_ERROR_CHECK(esp_console_cmd_register(&cmd));
+}
@@ -32,6 +32,7 @@ def get_mr_components(modified_files: str) -> str:
         if (
             file.parts[0] == 'components' and
             file.parts[1] in {
+                'wasmachine_bench',
                 'wasmachine_core',
                 'wasmachine_data_sequence',
                 'wasmachine_ext_wasm_native',